@@ -0,0 +1,368 @@
+/**
+ * @file abstraction_overhead.cpp
+ * @brief Cost of the policy layer: policy_based_cache vs the legacy LRU vs a hand-written LRU
+ *
+ * Every implementation runs the same three workloads (hits on a full cache,
+ * a pure insert stream that evicts on every put, and a 90/10 lookup/put mix
+ * over twice the capacity) through the same contains()/get()/put() calls.
+ * The hand-written LRU on std::unordered_map + std::list is the baseline;
+ * the others pay for the legacy specialization, or for the policy
+ * framework's four unique_ptr indirections and virtual calls.
+ *
+ * Each run reports ns_per_op and, on Linux where perf_event_open is
+ * permitted, instructions_per_op. Baselines are registered first, so later
+ * runs of the same workload and capacity also report ns_delta and instructions_delta
+ * against the hand-written LRU; filtering the baseline out drops the deltas.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cache_abstraction
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using legacy_lru_t = cache_engine::cache<key_t, value_t, cache_engine::algorithm::lru>;
+
+	using policy_hash_t = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+														   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	using policy_reserved_t = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::reserved_hash_storage,
+															   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	using policy_debug_t = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::debug_storage,
+															cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	constexpr std::size_t ops_per_batch = 1024;
+	constexpr std::uint64_t put_every	= 10;
+
+	enum class workload
+	{
+		get_hit,
+		put_evict,
+		mixed
+	};
+
+	/**
+	 * @brief Minimal LRU: one hash probe per operation, list splice on a hit
+	 */
+	class raw_lru
+	{
+	  private:
+		using list_t = std::list<std::pair<key_t, value_t>>;
+
+		std::size_t m_capacity;
+		list_t m_order;
+		std::unordered_map<key_t, list_t::iterator> m_index;
+
+	  public:
+		explicit raw_lru(std::size_t p_capacity) : m_capacity(p_capacity) { m_index.reserve(p_capacity); }
+
+		auto contains(const key_t& p_key) const -> bool { return m_index.find(p_key) != m_index.end(); }
+
+		auto get(const key_t& p_key) -> value_t
+		{
+			auto index_iter = m_index.find(p_key);
+			if (index_iter == m_index.end())
+			{
+				throw std::out_of_range("Key not found in cache");
+			}
+			m_order.splice(m_order.begin(), m_order, index_iter->second);
+			return index_iter->second->second;
+		}
+
+		auto put(const key_t& p_key, const value_t& p_value) -> void
+		{
+			auto index_iter = m_index.find(p_key);
+			if (index_iter != m_index.end())
+			{
+				index_iter->second->second = p_value;
+				m_order.splice(m_order.begin(), m_order, index_iter->second);
+				return;
+			}
+			if (m_index.size() >= m_capacity)
+			{
+				m_index.erase(m_order.back().first);
+				m_order.pop_back();
+			}
+			m_order.emplace_front(p_key, p_value);
+			m_index.emplace(p_key, m_order.begin());
+		}
+	};
+
+	/**
+	 * @brief User-space retired-instruction counter for the calling thread
+	 *
+	 * Unavailable (and silently skipped) off Linux, in containers without
+	 * perf access, or when perf_event_paranoid forbids it.
+	 */
+	class instruction_counter
+	{
+	  private:
+		int m_fd;
+
+	  public:
+		// Constructor
+		instruction_counter() : m_fd(-1)
+		{
+#if defined(__linux__)
+			perf_event_attr attributes;
+			std::memset(&attributes, 0, sizeof(attributes));
+			attributes.type			  = PERF_TYPE_HARDWARE;
+			attributes.size			  = sizeof(attributes);
+			attributes.config		  = PERF_COUNT_HW_INSTRUCTIONS;
+			attributes.disabled		  = 1;
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv	  = 1;
+			m_fd					  = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+		}
+
+		// Destructor
+		~instruction_counter()
+		{
+#if defined(__linux__)
+			if (m_fd >= 0)
+			{
+				close(m_fd);
+			}
+#endif
+		}
+
+		instruction_counter(const instruction_counter&)						 = delete;
+		auto operator=(const instruction_counter&) -> instruction_counter& = delete;
+
+		auto available() const -> bool { return m_fd >= 0; }
+
+		auto start() -> void
+		{
+#if defined(__linux__)
+			if (m_fd >= 0)
+			{
+				ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+
+		auto stop() -> std::uint64_t
+		{
+			std::uint64_t count = 0;
+#if defined(__linux__)
+			if (m_fd >= 0)
+			{
+				ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+				if (read(m_fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+				{
+					count = 0;
+				}
+			}
+#endif
+			return count;
+		}
+	};
+
+	/**
+	 * @brief Per-op figures of the most recent baseline run of a workload at a capacity
+	 */
+	struct baseline_result
+	{
+		double m_ns_per_op;
+		double m_instructions_per_op;
+	};
+
+	std::map<std::pair<workload, std::size_t>, baseline_result> g_baselines;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto next_random(std::uint64_t& p_state) -> std::uint64_t;
+	template <typename cache_t> auto run_batch(cache_t& p_cache, workload p_workload, std::size_t p_capacity, std::uint64_t& p_rng, key_t& p_next_key) -> value_t;
+	template <typename cache_t, bool is_baseline> auto benchmark_workload(benchmark::State& p_state, workload p_workload) -> void;
+	auto benchmark_raw_get_hit(benchmark::State& p_state) -> void;
+	auto benchmark_legacy_get_hit(benchmark::State& p_state) -> void;
+	auto benchmark_policy_hash_get_hit(benchmark::State& p_state) -> void;
+	auto benchmark_policy_reserved_get_hit(benchmark::State& p_state) -> void;
+	auto benchmark_policy_debug_get_hit(benchmark::State& p_state) -> void;
+	auto benchmark_raw_put_evict(benchmark::State& p_state) -> void;
+	auto benchmark_legacy_put_evict(benchmark::State& p_state) -> void;
+	auto benchmark_policy_hash_put_evict(benchmark::State& p_state) -> void;
+	auto benchmark_policy_reserved_put_evict(benchmark::State& p_state) -> void;
+	auto benchmark_policy_debug_put_evict(benchmark::State& p_state) -> void;
+	auto benchmark_raw_mixed(benchmark::State& p_state) -> void;
+	auto benchmark_legacy_mixed(benchmark::State& p_state) -> void;
+	auto benchmark_policy_hash_mixed(benchmark::State& p_state) -> void;
+	auto benchmark_policy_reserved_mixed(benchmark::State& p_state) -> void;
+	auto benchmark_policy_debug_mixed(benchmark::State& p_state) -> void;
+
+	// xorshift64: identical key streams for every implementation
+	auto next_random(std::uint64_t& p_state) -> std::uint64_t
+	{
+		p_state ^= p_state << 13U;
+		p_state ^= p_state >> 7U;
+		p_state ^= p_state << 17U;
+		return p_state;
+	}
+
+	/**
+	 * @brief Run ops_per_batch operations of one workload through the public cache API
+	 */
+	template <typename cache_t> auto run_batch(cache_t& p_cache, workload p_workload, std::size_t p_capacity, std::uint64_t& p_rng, key_t& p_next_key) -> value_t
+	{
+		value_t checksum = 0;
+
+		for (std::size_t idx_for = 0; idx_for < ops_per_batch; ++idx_for)
+		{
+			if (p_workload == workload::get_hit)
+			{
+				checksum += p_cache.get(next_random(p_rng) % p_capacity);
+			}
+			else if (p_workload == workload::put_evict)
+			{
+				p_cache.put(p_next_key, p_next_key);
+				++p_next_key;
+			}
+			else
+			{
+				const std::uint64_t random = next_random(p_rng);
+				const key_t key			   = (random >> 8U) % (p_capacity * 2U);
+				if (random % put_every == 0)
+				{
+					p_cache.put(key, key);
+				}
+				else if (p_cache.contains(key))
+				{
+					checksum += p_cache.get(key);
+				}
+				else
+				{
+					p_cache.put(key, key);
+				}
+			}
+		}
+		return checksum;
+	}
+
+	/**
+	 * @brief Time one implementation on one workload; range(0) = capacity
+	 */
+	template <typename cache_t, bool is_baseline> auto benchmark_workload(benchmark::State& p_state, workload p_workload) -> void
+	{
+		const std::size_t capacity = static_cast<std::size_t>(p_state.range(0));
+		std::unique_ptr<cache_t> cache(new cache_t(capacity));
+		for (key_t idx_for = 0; idx_for < capacity; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+		}
+
+		std::uint64_t rng = 0x9E3779B97F4A7C15ULL;
+		key_t next_key	  = capacity;
+		instruction_counter instructions;
+
+		instructions.start();
+		const auto start_time = std::chrono::steady_clock::now();
+		for (auto _ : p_state)
+		{
+			benchmark::DoNotOptimize(run_batch(*cache, p_workload, capacity, rng, next_key));
+		}
+		const auto elapsed					= std::chrono::steady_clock::now() - start_time;
+		const std::uint64_t instruction_sum = instructions.stop();
+
+		const double operations		  = static_cast<double>(p_state.iterations()) * static_cast<double>(ops_per_batch);
+		const double ns_per_op		  = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / operations;
+		const double instr_per_op	  = static_cast<double>(instruction_sum) / operations;
+		const auto baseline_key		  = std::make_pair(p_workload, capacity);
+		p_state.counters["ns_per_op"] = ns_per_op;
+
+		if (instructions.available())
+		{
+			p_state.counters["instructions_per_op"] = instr_per_op;
+		}
+
+		if (is_baseline)
+		{
+			g_baselines[baseline_key] = baseline_result{ns_per_op, instr_per_op};
+		}
+		else
+		{
+			auto baseline_iter = g_baselines.find(baseline_key);
+			if (baseline_iter != g_baselines.end())
+			{
+				p_state.counters["ns_delta"] = ns_per_op - baseline_iter->second.m_ns_per_op;
+				if (instructions.available())
+				{
+					p_state.counters["instructions_delta"] = instr_per_op - baseline_iter->second.m_instructions_per_op;
+				}
+			}
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(ops_per_batch));
+	}
+
+	auto benchmark_raw_get_hit(benchmark::State& p_state) -> void { benchmark_workload<raw_lru, true>(p_state, workload::get_hit); }
+
+	auto benchmark_legacy_get_hit(benchmark::State& p_state) -> void { benchmark_workload<legacy_lru_t, false>(p_state, workload::get_hit); }
+
+	auto benchmark_policy_hash_get_hit(benchmark::State& p_state) -> void { benchmark_workload<policy_hash_t, false>(p_state, workload::get_hit); }
+
+	auto benchmark_policy_reserved_get_hit(benchmark::State& p_state) -> void { benchmark_workload<policy_reserved_t, false>(p_state, workload::get_hit); }
+
+	auto benchmark_policy_debug_get_hit(benchmark::State& p_state) -> void { benchmark_workload<policy_debug_t, false>(p_state, workload::get_hit); }
+
+	auto benchmark_raw_put_evict(benchmark::State& p_state) -> void { benchmark_workload<raw_lru, true>(p_state, workload::put_evict); }
+
+	auto benchmark_legacy_put_evict(benchmark::State& p_state) -> void { benchmark_workload<legacy_lru_t, false>(p_state, workload::put_evict); }
+
+	auto benchmark_policy_hash_put_evict(benchmark::State& p_state) -> void { benchmark_workload<policy_hash_t, false>(p_state, workload::put_evict); }
+
+	auto benchmark_policy_reserved_put_evict(benchmark::State& p_state) -> void { benchmark_workload<policy_reserved_t, false>(p_state, workload::put_evict); }
+
+	auto benchmark_policy_debug_put_evict(benchmark::State& p_state) -> void { benchmark_workload<policy_debug_t, false>(p_state, workload::put_evict); }
+
+	auto benchmark_raw_mixed(benchmark::State& p_state) -> void { benchmark_workload<raw_lru, true>(p_state, workload::mixed); }
+
+	auto benchmark_legacy_mixed(benchmark::State& p_state) -> void { benchmark_workload<legacy_lru_t, false>(p_state, workload::mixed); }
+
+	auto benchmark_policy_hash_mixed(benchmark::State& p_state) -> void { benchmark_workload<policy_hash_t, false>(p_state, workload::mixed); }
+
+	auto benchmark_policy_reserved_mixed(benchmark::State& p_state) -> void { benchmark_workload<policy_reserved_t, false>(p_state, workload::mixed); }
+
+	auto benchmark_policy_debug_mixed(benchmark::State& p_state) -> void { benchmark_workload<policy_debug_t, false>(p_state, workload::mixed); }
+
+} // namespace cache_abstraction
+
+// Register per workload, baseline first so the others can report deltas against it; range(0) = capacity
+BENCHMARK(cache_abstraction::benchmark_raw_get_hit)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_legacy_get_hit)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_hash_get_hit)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_reserved_get_hit)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_debug_get_hit)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(cache_abstraction::benchmark_raw_put_evict)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_legacy_put_evict)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_hash_put_evict)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_reserved_put_evict)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_debug_put_evict)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(cache_abstraction::benchmark_raw_mixed)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_legacy_mixed)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_hash_mixed)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_reserved_mixed)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_abstraction::benchmark_policy_debug_mixed)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,164 @@
+/**
+ * @file async_cache.cpp
+ * @brief Coroutine async cache benchmarks (C++20 build only)
+ *
+ * Drives 10k concurrent misses through async_get_or_load on a four-thread
+ * executor. The loader suspends a configurable number of times to model a
+ * remote fetch, so all requests are in flight at once and waiters pile up on
+ * the shared pending entries instead of blocking worker threads.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/async/async_cache.hpp>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <latch>
+
+namespace cache_async
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using async_cache_t = cache_engine::async::async_cache<key_t, value_t>;
+
+	constexpr std::size_t in_flight_requests = 10000;
+	constexpr std::size_t executor_threads	 = 4;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto benchmark_in_flight_misses(benchmark::State& p_state) -> void;
+	auto benchmark_warm_hits(benchmark::State& p_state) -> void;
+
+	/**
+	 * @brief Fire-and-forget coroutine used to launch one request per key
+	 */
+	struct spawned_request
+	{
+		struct promise_type
+		{
+			auto get_return_object() const noexcept -> spawned_request { return {}; }
+
+			auto initial_suspend() const noexcept -> std::suspend_never { return {}; }
+
+			auto final_suspend() const noexcept -> std::suspend_never { return {}; }
+
+			auto return_void() const noexcept -> void {}
+
+			auto unhandled_exception() const noexcept -> void { std::terminate(); }
+		};
+	};
+
+	auto expected_value(key_t p_key) -> value_t;
+	auto make_loader(cache_engine::async::executor& p_executor, std::size_t p_hops) -> async_cache_t::loader_t;
+	auto request(cache_engine::async::executor& p_executor, async_cache_t& p_cache, key_t p_key, std::atomic<std::size_t>& p_errors, std::latch& p_done) -> spawned_request;
+
+	auto expected_value(key_t p_key) -> value_t { return p_key * 2654435761ULL; }
+
+	auto make_loader(cache_engine::async::executor& p_executor, std::size_t p_hops) -> async_cache_t::loader_t
+	{
+		return [&p_executor, p_hops](const key_t& p_key) -> cache_engine::async::task<value_t>
+		{
+			const key_t key = p_key;
+			// Each hop stands in for one asynchronous I/O completion
+			for (std::size_t idx_for = 0; idx_for < p_hops; ++idx_for)
+			{
+				co_await p_executor.schedule();
+			}
+			co_return expected_value(key);
+		};
+	}
+
+	auto request(cache_engine::async::executor& p_executor, async_cache_t& p_cache, key_t p_key, std::atomic<std::size_t>& p_errors, std::latch& p_done) -> spawned_request
+	{
+		co_await p_executor.schedule();
+		const value_t value = co_await p_cache.async_get_or_load(p_key);
+		if (value != expected_value(p_key))
+		{
+			p_errors.fetch_add(1, std::memory_order_relaxed);
+		}
+		p_done.count_down();
+	}
+
+	/**
+	 * @brief 10k concurrent misses; range(0) requests share each key, range(1) loader hops
+	 */
+	auto benchmark_in_flight_misses(benchmark::State& p_state) -> void
+	{
+		const std::size_t requests_per_key = static_cast<std::size_t>(p_state.range(0));
+		const std::size_t loader_hops	   = static_cast<std::size_t>(p_state.range(1));
+		const std::size_t distinct_keys	   = in_flight_requests / requests_per_key;
+
+		cache_engine::async::thread_pool_executor executor(executor_threads);
+		std::atomic<std::size_t> errors(0);
+		std::size_t loads	  = 0;
+		std::size_t coalesced = 0;
+
+		for (auto _ : p_state)
+		{
+			p_state.PauseTiming();
+			async_cache_t cache(in_flight_requests, make_loader(executor, loader_hops), executor);
+			std::latch done(static_cast<std::ptrdiff_t>(in_flight_requests));
+			p_state.ResumeTiming();
+
+			for (std::size_t idx_for = 0; idx_for < in_flight_requests; ++idx_for)
+			{
+				request(executor, cache, idx_for % distinct_keys, errors, done);
+			}
+			done.wait();
+
+			p_state.PauseTiming();
+			loads += cache.load_count();
+			coalesced += cache.coalesced_count();
+			p_state.ResumeTiming();
+		}
+
+		if (errors.load() != 0)
+		{
+			p_state.SkipWithError("async_get_or_load returned a wrong value");
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(in_flight_requests));
+		p_state.counters["loads"]	  = benchmark::Counter(static_cast<double>(loads), benchmark::Counter::kAvgIterations);
+		p_state.counters["coalesced"] = benchmark::Counter(static_cast<double>(coalesced), benchmark::Counter::kAvgIterations);
+	}
+
+	/**
+	 * @brief 10k concurrent requests against a fully warmed cache
+	 */
+	auto benchmark_warm_hits(benchmark::State& p_state) -> void
+	{
+		cache_engine::async::thread_pool_executor executor(executor_threads);
+		async_cache_t cache(in_flight_requests, make_loader(executor, 1), executor);
+		std::atomic<std::size_t> errors(0);
+
+		for (key_t idx_for = 0; idx_for < in_flight_requests; ++idx_for)
+		{
+			cache.put(idx_for, expected_value(idx_for));
+		}
+
+		for (auto _ : p_state)
+		{
+			std::latch done(static_cast<std::ptrdiff_t>(in_flight_requests));
+			for (std::size_t idx_for = 0; idx_for < in_flight_requests; ++idx_for)
+			{
+				request(executor, cache, idx_for, errors, done);
+			}
+			done.wait();
+		}
+
+		if (errors.load() != 0 || cache.load_count() != 0)
+		{
+			p_state.SkipWithError("warm cache missed or returned a wrong value");
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(in_flight_requests));
+	}
+
+} // namespace cache_async
+
+// Register in-flight miss benchmarks: {requests per key, loader hops}
+BENCHMARK(cache_async::benchmark_in_flight_misses)->Args({1, 1})->Args({1, 4})->Args({4, 1})->Args({16, 4})->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_async::benchmark_warm_hits)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -156,6 +156,82 @@ namespace cache_benchmark
 		p_state.SetBytesProcessed(static_cast<std::int64_t>(operation_count * (sizeof(std::int32_t) + 20))); // Approximate memory per operation
 	}
 
+	/**
+	 * @brief Put on resident keys only: the update path (find, assign, reorder)
+	 */
+	template<typename algorithm_t>
+	auto benchmark_put_update(benchmark::State& p_state) -> void
+	{
+		using cache_t = cache_engine::cache<std::int32_t, std::int64_t, algorithm_t>;
+
+		const std::size_t cache_size = static_cast<std::size_t>(p_state.range(0));
+		cache_t cache(cache_size);
+		for (std::size_t idx_for = 0; idx_for < cache_size; ++idx_for)
+		{
+			cache.put(static_cast<std::int32_t>(idx_for), static_cast<std::int64_t>(idx_for));
+		}
+
+		std::size_t operation_count = 0;
+		for (auto _ : p_state)
+		{
+			// Stride through the resident keys so every put hits a different entry
+			const auto key = static_cast<std::int32_t>((operation_count * 7919U) % cache_size);
+			cache.put(key, static_cast<std::int64_t>(operation_count));
+			++operation_count;
+		}
+		benchmark::DoNotOptimize(cache.size());
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(operation_count));
+	}
+
+	/**
+	 * @brief Put on fresh keys only: the miss path (find, evict, insert)
+	 */
+	template<typename algorithm_t>
+	auto benchmark_put_evict(benchmark::State& p_state) -> void
+	{
+		using cache_t = cache_engine::cache<std::int32_t, std::int64_t, algorithm_t>;
+
+		const std::size_t cache_size = static_cast<std::size_t>(p_state.range(0));
+		cache_t cache(cache_size);
+
+		std::size_t operation_count = 0;
+		for (auto _ : p_state)
+		{
+			cache.put(static_cast<std::int32_t>(operation_count & 0x3FFFFFFFU), static_cast<std::int64_t>(operation_count));
+			++operation_count;
+		}
+		benchmark::DoNotOptimize(cache.size());
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(operation_count));
+	}
+
+	/**
+	 * @brief Get on resident keys only: the hit path (find, reorder or frequency bump)
+	 */
+	template<typename algorithm_t>
+	auto benchmark_get_hit(benchmark::State& p_state) -> void
+	{
+		using cache_t = cache_engine::cache<std::int32_t, std::int64_t, algorithm_t>;
+
+		const std::size_t cache_size = static_cast<std::size_t>(p_state.range(0));
+		cache_t cache(cache_size);
+		for (std::size_t idx_for = 0; idx_for < cache_size; ++idx_for)
+		{
+			cache.put(static_cast<std::int32_t>(idx_for), static_cast<std::int64_t>(idx_for));
+		}
+
+		std::size_t operation_count = 0;
+		for (auto _ : p_state)
+		{
+			const auto key = static_cast<std::int32_t>((operation_count * 7919U) % cache_size);
+			benchmark::DoNotOptimize(cache.get(key));
+			++operation_count;
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(operation_count));
+	}
+
 	// Forward declarations for benchmark functions
 	auto benchmark_lru_small(benchmark::State& p_state) -> void;
 	auto benchmark_lru_medium(benchmark::State& p_state) -> void;
@@ -183,6 +259,24 @@ namespace cache_benchmark
 	auto benchmark_random_medium(benchmark::State& p_state) -> void;
 	auto benchmark_random_large(benchmark::State& p_state) -> void;
 	auto benchmark_random_xlarge(benchmark::State& p_state) -> void;
+	auto benchmark_put_update_lru(benchmark::State& p_state) -> void;
+	auto benchmark_put_update_fifo(benchmark::State& p_state) -> void;
+	auto benchmark_put_update_lfu(benchmark::State& p_state) -> void;
+	auto benchmark_put_update_mfu(benchmark::State& p_state) -> void;
+	auto benchmark_put_update_mru(benchmark::State& p_state) -> void;
+	auto benchmark_put_update_random(benchmark::State& p_state) -> void;
+	auto benchmark_put_evict_lru(benchmark::State& p_state) -> void;
+	auto benchmark_put_evict_fifo(benchmark::State& p_state) -> void;
+	auto benchmark_put_evict_lfu(benchmark::State& p_state) -> void;
+	auto benchmark_put_evict_mfu(benchmark::State& p_state) -> void;
+	auto benchmark_put_evict_mru(benchmark::State& p_state) -> void;
+	auto benchmark_put_evict_random(benchmark::State& p_state) -> void;
+	auto benchmark_get_hit_lru(benchmark::State& p_state) -> void;
+	auto benchmark_get_hit_fifo(benchmark::State& p_state) -> void;
+	auto benchmark_get_hit_lfu(benchmark::State& p_state) -> void;
+	auto benchmark_get_hit_mfu(benchmark::State& p_state) -> void;
+	auto benchmark_get_hit_mru(benchmark::State& p_state) -> void;
+	auto benchmark_get_hit_random(benchmark::State& p_state) -> void;
 
 	// LRU Cache Benchmarks
 	auto benchmark_lru_small(benchmark::State& p_state) -> void
@@ -320,6 +414,44 @@ namespace cache_benchmark
 		benchmark_cache_throughput<cache_engine::algorithm::random_cache>(p_state, {10000, 50000, 1000000, 0.8}, key_distribution::uniform);
 	}
 
+
+	// Single-path benchmarks isolate the probes done by put and get
+	auto benchmark_put_update_lru(benchmark::State& p_state) -> void { benchmark_put_update<cache_engine::algorithm::lru>(p_state); }
+
+	auto benchmark_put_update_fifo(benchmark::State& p_state) -> void { benchmark_put_update<cache_engine::algorithm::fifo>(p_state); }
+
+	auto benchmark_put_update_lfu(benchmark::State& p_state) -> void { benchmark_put_update<cache_engine::algorithm::lfu>(p_state); }
+
+	auto benchmark_put_update_mfu(benchmark::State& p_state) -> void { benchmark_put_update<cache_engine::algorithm::mfu>(p_state); }
+
+	auto benchmark_put_update_mru(benchmark::State& p_state) -> void { benchmark_put_update<cache_engine::algorithm::mru>(p_state); }
+
+	auto benchmark_put_update_random(benchmark::State& p_state) -> void { benchmark_put_update<cache_engine::algorithm::random_cache>(p_state); }
+
+	auto benchmark_put_evict_lru(benchmark::State& p_state) -> void { benchmark_put_evict<cache_engine::algorithm::lru>(p_state); }
+
+	auto benchmark_put_evict_fifo(benchmark::State& p_state) -> void { benchmark_put_evict<cache_engine::algorithm::fifo>(p_state); }
+
+	auto benchmark_put_evict_lfu(benchmark::State& p_state) -> void { benchmark_put_evict<cache_engine::algorithm::lfu>(p_state); }
+
+	auto benchmark_put_evict_mfu(benchmark::State& p_state) -> void { benchmark_put_evict<cache_engine::algorithm::mfu>(p_state); }
+
+	auto benchmark_put_evict_mru(benchmark::State& p_state) -> void { benchmark_put_evict<cache_engine::algorithm::mru>(p_state); }
+
+	auto benchmark_put_evict_random(benchmark::State& p_state) -> void { benchmark_put_evict<cache_engine::algorithm::random_cache>(p_state); }
+
+	auto benchmark_get_hit_lru(benchmark::State& p_state) -> void { benchmark_get_hit<cache_engine::algorithm::lru>(p_state); }
+
+	auto benchmark_get_hit_fifo(benchmark::State& p_state) -> void { benchmark_get_hit<cache_engine::algorithm::fifo>(p_state); }
+
+	auto benchmark_get_hit_lfu(benchmark::State& p_state) -> void { benchmark_get_hit<cache_engine::algorithm::lfu>(p_state); }
+
+	auto benchmark_get_hit_mfu(benchmark::State& p_state) -> void { benchmark_get_hit<cache_engine::algorithm::mfu>(p_state); }
+
+	auto benchmark_get_hit_mru(benchmark::State& p_state) -> void { benchmark_get_hit<cache_engine::algorithm::mru>(p_state); }
+
+	auto benchmark_get_hit_random(benchmark::State& p_state) -> void { benchmark_get_hit<cache_engine::algorithm::random_cache>(p_state); }
+
 }	// namespace cache_benchmark
 
 // Register LRU benchmarks
@@ -360,4 +492,24 @@ BENCHMARK(cache_benchmark::benchmark_random_medium)->Unit(benchmark::kMicrosecon
 BENCHMARK(cache_benchmark::benchmark_random_large)->Unit(benchmark::kMicrosecond)->UseRealTime();
 BENCHMARK(cache_benchmark::benchmark_random_xlarge)->Unit(benchmark::kMicrosecond)->UseRealTime();
 
+// Register single-path benchmarks
+BENCHMARK(cache_benchmark::benchmark_put_update_lru)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_update_fifo)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_update_lfu)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_update_mfu)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_update_mru)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_update_random)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_evict_lru)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_evict_fifo)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_evict_lfu)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_evict_mfu)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_evict_mru)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_put_evict_random)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_get_hit_lru)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_get_hit_fifo)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_get_hit_lfu)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_get_hit_mfu)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_get_hit_mru)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+BENCHMARK(cache_benchmark::benchmark_get_hit_random)->Arg(1000)->Arg(100000)->Unit(benchmark::kNanosecond)->UseRealTime();
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ * @file clock_cache.cpp
+ * @brief Multi-threaded scaling of the concurrent CLOCK cache against a mutex-wrapped LRU cache
+ *
+ * Threads share one cache and run a read-heavy mix (range(0) percent reads)
+ * over a key space 1.25x the capacity, so the hand keeps turning. Thread
+ * counts go from 1 to 64; counts above the hardware thread count show how
+ * each design degrades under oversubscription.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/concurrent/clock_cache.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace cache_clock
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using clock_cache_t = cache_engine::concurrent::clock_cache<key_t, value_t>;
+	using lru_cache_t	= cache_engine::cache<key_t, value_t, cache_engine::algorithm::lru>;
+
+	constexpr std::size_t cache_capacity = 1U << 16U;
+	constexpr std::size_t key_space		 = cache_capacity + cache_capacity / 4;
+	constexpr std::size_t ops_per_batch	 = 1024;
+
+	/**
+	 * @brief Baseline: the single-threaded LRU cache behind one mutex
+	 */
+	class locked_lru
+	{
+	  private:
+		std::mutex m_mutex;
+		lru_cache_t m_cache;
+
+	  public:
+		explicit locked_lru(std::size_t p_capacity) : m_cache(p_capacity) {}
+
+		auto find(const key_t& p_key, value_t& p_value) -> bool
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_cache.contains(p_key))
+			{
+				return false;
+			}
+			p_value = m_cache.get(p_key);
+			return true;
+		}
+
+		auto put(const key_t& p_key, const value_t& p_value) -> void
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_cache.put(p_key, p_value);
+		}
+	};
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	template <typename shared_t> auto benchmark_mixed(benchmark::State& p_state, std::unique_ptr<shared_t>& p_shared) -> void;
+	auto benchmark_clock_mixed(benchmark::State& p_state) -> void;
+	auto benchmark_locked_lru_mixed(benchmark::State& p_state) -> void;
+
+	/**
+	 * @brief Shared-cache mix: a miss is followed by a put, as a read-through caller would do
+	 */
+	template <typename shared_t> auto benchmark_mixed(benchmark::State& p_state, std::unique_ptr<shared_t>& p_shared) -> void
+	{
+		const std::uint64_t read_percent = static_cast<std::uint64_t>(p_state.range(0));
+
+		if (p_state.thread_index() == 0)
+		{
+			p_shared.reset(new shared_t(cache_capacity));
+			for (key_t idx_for = 0; idx_for < cache_capacity; ++idx_for)
+			{
+				p_shared->put(idx_for, idx_for);
+			}
+		}
+
+		std::uint64_t rng	= 0x9E3779B97F4A7C15ULL * (static_cast<std::uint64_t>(p_state.thread_index()) + 1U);
+		std::size_t hits	= 0;
+		std::size_t lookups = 0;
+		value_t value		= 0;
+
+		for (auto _ : p_state)
+		{
+			for (std::size_t idx_for = 0; idx_for < ops_per_batch; ++idx_for)
+			{
+				rng ^= rng << 13U;
+				rng ^= rng >> 7U;
+				rng ^= rng << 17U;
+				const key_t key = (rng >> 8U) % key_space;
+
+				if (rng % 100U >= read_percent)
+				{
+					p_shared->put(key, key);
+				}
+				else if (p_shared->find(key, value))
+				{
+					++hits;
+					++lookups;
+				}
+				else
+				{
+					p_shared->put(key, key);
+					++lookups;
+				}
+			}
+			benchmark::DoNotOptimize(value);
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(ops_per_batch));
+		p_state.counters["hit_ratio"] = benchmark::Counter((lookups == 0) ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups), benchmark::Counter::kAvgThreads);
+
+		if (p_state.thread_index() == 0)
+		{
+			p_shared.reset();
+		}
+	}
+
+	std::unique_ptr<clock_cache_t> g_clock_cache;
+	std::unique_ptr<locked_lru> g_locked_lru;
+
+	auto benchmark_clock_mixed(benchmark::State& p_state) -> void { benchmark_mixed(p_state, g_clock_cache); }
+
+	auto benchmark_locked_lru_mixed(benchmark::State& p_state) -> void { benchmark_mixed(p_state, g_locked_lru); }
+
+} // namespace cache_clock
+
+// Register scaling benchmarks: range(0) = read percentage, 1 to 64 threads
+BENCHMARK(cache_clock::benchmark_clock_mixed)->Arg(99)->Arg(90)->ThreadRange(1, 64)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_clock::benchmark_locked_lru_mixed)->Arg(99)->Arg(90)->ThreadRange(1, 64)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,307 @@
+/**
+ * @file cold_lifecycle.cpp
+ * @brief Cold-cache lookup latency, construction and teardown cost for every algorithm and storage policy
+ *
+ * The other benchmarks run warm: the working set stays in the CPU caches
+ * across operations. This suite covers what they miss, for every legacy
+ * algorithm, every eviction policy (on hash storage) and every storage
+ * policy (under LRU eviction), with uint64 keys and values:
+ *
+ * - cold/<cache>: a cache of cold_capacity entries is filled, then each
+ *   iteration sweeps a buffer twice the size of the last-level cache to
+ *   evict it and times one get() hit on a random key with steady_clock, so
+ *   neither the sweep nor the key draw is counted. warm/<cache> is the
+ *   same loop without the sweep. A sweep is used instead of clflush
+ *   because node-based caches give no way to enumerate the lines they own.
+ * - construct/<cache>/<n>: constructing a cache of capacity n and filling it.
+ * - clear/<cache>/<n> and destroy/<cache>/<n>: clear() or the destructor
+ *   of a cache filled with n entries; building it is not timed.
+ *
+ * Sizes run from 1K to 20M entries; the 20M rows need several GB for the
+ * node-based caches, so filter them out on small machines.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace cache_lifecycle
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	template <typename... types_t> struct type_list
+	{
+	};
+
+	constexpr std::size_t cold_capacity		= std::size_t(1) << 20U;
+	constexpr std::size_t cold_iterations	= 1000;
+	constexpr std::size_t default_llc_bytes = std::size_t(32) << 20U;
+	constexpr std::size_t cache_line_bytes	= 64;
+	const std::vector<std::int64_t> g_sizes = {1000, 10000, 100000, 1000000, 10000000, 20000000};
+
+	// Cache kinds: every legacy algorithm, every eviction policy on hash storage, every storage policy under LRU
+
+	template <template <typename, typename> class eviction_t, template <typename, typename> class storage_t> struct policy_kind
+	{
+		using cache_t = cache_engine::policy_based_cache<key_t, value_t, eviction_t, storage_t, cache_engine::policy_templates::update_on_access,
+														 cache_engine::policy_templates::fixed_capacity>;
+	};
+
+	template <typename algorithm_t> struct legacy_kind
+	{
+		using cache_t = cache_engine::cache<key_t, value_t, algorithm_t>;
+	};
+
+	struct legacy_lru : legacy_kind<cache_engine::algorithm::lru>
+	{
+		static auto name() -> std::string { return "legacy_lru"; }
+	};
+
+	struct legacy_mru : legacy_kind<cache_engine::algorithm::mru>
+	{
+		static auto name() -> std::string { return "legacy_mru"; }
+	};
+
+	struct legacy_fifo : legacy_kind<cache_engine::algorithm::fifo>
+	{
+		static auto name() -> std::string { return "legacy_fifo"; }
+	};
+
+	struct legacy_lfu : legacy_kind<cache_engine::algorithm::lfu>
+	{
+		static auto name() -> std::string { return "legacy_lfu"; }
+	};
+
+	struct legacy_mfu : legacy_kind<cache_engine::algorithm::mfu>
+	{
+		static auto name() -> std::string { return "legacy_mfu"; }
+	};
+
+	struct legacy_random : legacy_kind<cache_engine::algorithm::random_cache>
+	{
+		static auto name() -> std::string { return "legacy_random"; }
+	};
+
+	struct policy_lru : policy_kind<cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage>
+	{
+		static auto name() -> std::string { return "policy_lru"; }
+	};
+
+	struct policy_mru : policy_kind<cache_engine::policy_templates::mru_eviction, cache_engine::policy_templates::hash_storage>
+	{
+		static auto name() -> std::string { return "policy_mru"; }
+	};
+
+	struct policy_fifo : policy_kind<cache_engine::policy_templates::fifo_eviction, cache_engine::policy_templates::hash_storage>
+	{
+		static auto name() -> std::string { return "policy_fifo"; }
+	};
+
+	struct policy_lfu : policy_kind<cache_engine::policy_templates::lfu_eviction, cache_engine::policy_templates::hash_storage>
+	{
+		static auto name() -> std::string { return "policy_lfu"; }
+	};
+
+	struct policy_mfu : policy_kind<cache_engine::policy_templates::mfu_eviction, cache_engine::policy_templates::hash_storage>
+	{
+		static auto name() -> std::string { return "policy_mfu"; }
+	};
+
+	struct policy_random : policy_kind<cache_engine::policy_templates::random_eviction, cache_engine::policy_templates::hash_storage>
+	{
+		static auto name() -> std::string { return "policy_random"; }
+	};
+
+	struct policy_sampled_lfu : policy_kind<cache_engine::policy_templates::sampled_lfu_eviction, cache_engine::policy_templates::hash_storage>
+	{
+		static auto name() -> std::string { return "policy_sampled_lfu"; }
+	};
+
+	struct policy_reserved_hash : policy_kind<cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::reserved_hash_storage>
+	{
+		static auto name() -> std::string { return "policy_reserved_hash"; }
+	};
+
+	struct policy_compact : policy_kind<cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::compact_storage>
+	{
+		static auto name() -> std::string { return "policy_compact"; }
+	};
+
+	struct policy_debug : policy_kind<cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::debug_storage>
+	{
+		static auto name() -> std::string { return "policy_debug"; }
+	};
+
+	using cache_kinds = type_list<legacy_lru, legacy_mru, legacy_fifo, legacy_lfu, legacy_mfu, legacy_random, policy_lru, policy_mru, policy_fifo, policy_lfu, policy_mfu,
+								  policy_random, policy_sampled_lfu, policy_reserved_hash, policy_compact, policy_debug>;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto llc_bytes() -> std::size_t;
+	auto flush_llc() -> void;
+	template <typename cache_kind_t> auto make_filled(std::size_t p_entries) -> std::unique_ptr<typename cache_kind_t::cache_t>;
+	template <typename cache_kind_t> auto run_lookups(benchmark::State& p_state, bool p_flush) -> void;
+	template <typename cache_kind_t> auto benchmark_cold(benchmark::State& p_state) -> void;
+	template <typename cache_kind_t> auto benchmark_warm(benchmark::State& p_state) -> void;
+	template <typename cache_kind_t> auto benchmark_construct(benchmark::State& p_state) -> void;
+	template <typename cache_kind_t> auto benchmark_clear(benchmark::State& p_state) -> void;
+	template <typename cache_kind_t> auto benchmark_destroy(benchmark::State& p_state) -> void;
+	template <typename... cache_kinds_t> auto register_caches(type_list<cache_kinds_t...>) -> void;
+
+	auto llc_bytes() -> std::size_t
+	{
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+		const long reported = sysconf(_SC_LEVEL3_CACHE_SIZE);
+		if (reported > 0)
+		{
+			return static_cast<std::size_t>(reported);
+		}
+#endif
+		return default_llc_bytes;
+	}
+
+	/**
+	 * @brief Read one byte per line of a buffer twice the LLC size, evicting whatever the cache held
+	 */
+	auto flush_llc() -> void
+	{
+		static std::vector<unsigned char> sweep(2 * llc_bytes(), 1);
+		std::size_t sum = 0;
+		for (std::size_t idx_for = 0; idx_for < sweep.size(); idx_for += cache_line_bytes)
+		{
+			sum += sweep[idx_for];
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+
+	template <typename cache_kind_t> auto make_filled(std::size_t p_entries) -> std::unique_ptr<typename cache_kind_t::cache_t>
+	{
+		std::unique_ptr<typename cache_kind_t::cache_t> cache(new typename cache_kind_t::cache_t(p_entries));
+		for (std::size_t idx_for = 0; idx_for < p_entries; ++idx_for)
+		{
+			cache->put(static_cast<key_t>(idx_for), static_cast<value_t>(idx_for));
+		}
+		return cache;
+	}
+
+	/**
+	 * @brief Time one random get() hit per iteration, after an LLC sweep when p_flush is set
+	 */
+	template <typename cache_kind_t> auto run_lookups(benchmark::State& p_state, bool p_flush) -> void
+	{
+		std::unique_ptr<typename cache_kind_t::cache_t> cache = make_filled<cache_kind_t>(cold_capacity);
+		std::uint64_t rng									  = 0x9E3779B97F4A7C15ULL;
+
+		for (auto _ : p_state)
+		{
+			rng ^= rng << 13U;
+			rng ^= rng >> 7U;
+			rng ^= rng << 17U;
+			const key_t key = static_cast<key_t>((rng >> 8U) % cold_capacity);
+			if (p_flush)
+			{
+				flush_llc();
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			benchmark::DoNotOptimize(cache->get(key));
+			const auto stop = std::chrono::steady_clock::now();
+			p_state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+		}
+		p_state.counters["llc_mb"] = static_cast<double>(llc_bytes()) / (1024.0 * 1024.0);
+	}
+
+	template <typename cache_kind_t> auto benchmark_cold(benchmark::State& p_state) -> void { run_lookups<cache_kind_t>(p_state, true); }
+
+	template <typename cache_kind_t> auto benchmark_warm(benchmark::State& p_state) -> void { run_lookups<cache_kind_t>(p_state, false); }
+
+	template <typename cache_kind_t> auto benchmark_construct(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<typename cache_kind_t::cache_t> cache = make_filled<cache_kind_t>(entries);
+			p_state.PauseTiming();
+			cache.reset();
+			p_state.ResumeTiming();
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(entries));
+	}
+
+	template <typename cache_kind_t> auto benchmark_clear(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		for (auto _ : p_state)
+		{
+			p_state.PauseTiming();
+			std::unique_ptr<typename cache_kind_t::cache_t> cache = make_filled<cache_kind_t>(entries);
+			p_state.ResumeTiming();
+			cache->clear();
+			p_state.PauseTiming();
+			cache.reset();
+			p_state.ResumeTiming();
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(entries));
+	}
+
+	template <typename cache_kind_t> auto benchmark_destroy(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		for (auto _ : p_state)
+		{
+			p_state.PauseTiming();
+			std::unique_ptr<typename cache_kind_t::cache_t> cache = make_filled<cache_kind_t>(entries);
+			p_state.ResumeTiming();
+			cache.reset();
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(entries));
+	}
+
+	/**
+	 * @brief Register cold, warm, construct, clear and destroy for every cache kind
+	 */
+	template <typename... cache_kinds_t> auto register_caches(type_list<cache_kinds_t...>) -> void
+	{
+		const int cold[] = {0, (benchmark::RegisterBenchmark(("cold/" + cache_kinds_t::name()).c_str(), &benchmark_cold<cache_kinds_t>)
+									->Iterations(static_cast<benchmark::IterationCount>(cold_iterations))
+									->UseManualTime()
+									->Unit(benchmark::kNanosecond),
+								0)...};
+		const int warm[] = {0, (benchmark::RegisterBenchmark(("warm/" + cache_kinds_t::name()).c_str(), &benchmark_warm<cache_kinds_t>)
+									->Iterations(static_cast<benchmark::IterationCount>(cold_iterations))
+									->UseManualTime()
+									->Unit(benchmark::kNanosecond),
+								0)...};
+		const int construct[] = {
+			0, (benchmark::RegisterBenchmark(("construct/" + cache_kinds_t::name()).c_str(), &benchmark_construct<cache_kinds_t>)->ArgsProduct({g_sizes})->Unit(benchmark::kMillisecond), 0)...};
+		const int clear[] = {
+			0, (benchmark::RegisterBenchmark(("clear/" + cache_kinds_t::name()).c_str(), &benchmark_clear<cache_kinds_t>)->ArgsProduct({g_sizes})->Unit(benchmark::kMillisecond), 0)...};
+		const int destroy[] = {
+			0, (benchmark::RegisterBenchmark(("destroy/" + cache_kinds_t::name()).c_str(), &benchmark_destroy<cache_kinds_t>)->ArgsProduct({g_sizes})->Unit(benchmark::kMillisecond), 0)...};
+		static_cast<void>(cold);
+		static_cast<void>(warm);
+		static_cast<void>(construct);
+		static_cast<void>(clear);
+		static_cast<void>(destroy);
+	}
+
+} // namespace cache_lifecycle
+
+// Registration is generated at startup, so main replaces BENCHMARK_MAIN
+auto main(int p_argc, char** p_argv) -> int
+{
+	cache_lifecycle::register_caches(cache_lifecycle::cache_kinds());
+	benchmark::Initialize(&p_argc, p_argv);
+	if (benchmark::ReportUnrecognizedArguments(p_argc, p_argv))
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file durable_cache.cpp
+ * @brief Put cost of a durable_cache against the plain cache, and recovery time
+ *
+ * Put benchmarks compare the plain policy-based cache behind a mutex with
+ * a durable_cache that returns once its record is framed (group commit in
+ * the background) and one that waits for each record's fdatasync. The
+ * "syncs" counter shows how many records each sync covered. Recovery
+ * benchmarks reopen a directory holding Arg records, once from the log
+ * alone and once from a checkpoint segment.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/durable/durable_cache.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+
+namespace cache_durable
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::string;
+
+	using lru_t		= cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+													   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+	using durable_t = cache_engine::durable::durable_cache<key_t, value_t, lru_t>;
+
+	constexpr std::size_t capacity = 1U << 20U;
+
+	/**
+	 * @brief Benchmark directory, emptied on construction and removed at destruction
+	 */
+	class bench_directory
+	{
+	  private:
+		std::string m_path;
+
+	  public:
+		explicit bench_directory(const std::string& p_name) : m_path("durable_benchmark_" + p_name)
+		{
+			this->clean();
+			cache_engine::durable::detail::file_io::make_directory(m_path);
+		}
+
+		~bench_directory()
+		{
+			this->clean();
+			::rmdir(m_path.c_str());
+		}
+
+		bench_directory(const bench_directory&)					   = delete;
+		auto operator=(const bench_directory&) -> bench_directory& = delete;
+
+		auto path() const -> const std::string& { return m_path; }
+
+	  private:
+		auto clean() -> void
+		{
+			if (::access(m_path.c_str(), F_OK) != 0)
+			{
+				return;
+			}
+			for (const char* suffix : {".log", ".seg", ".seg.tmp"})
+			{
+				for (const char* prefix : {"wal-", "ckpt-"})
+				{
+					for (const auto& file : cache_engine::durable::detail::file_io::list_numbered(m_path, prefix, suffix))
+					{
+						std::remove(file.second.c_str());
+					}
+				}
+			}
+		}
+	};
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto manual_options() -> cache_engine::durable::durability_options;
+	auto run_durable_puts(benchmark::State& p_state, bool p_wait) -> void;
+	auto run_recovery(benchmark::State& p_state, bool p_checkpoint) -> void;
+	auto benchmark_put_plain(benchmark::State& p_state) -> void;
+	auto benchmark_put_durable(benchmark::State& p_state) -> void;
+	auto benchmark_put_durable_wait(benchmark::State& p_state) -> void;
+	auto benchmark_recovery_log(benchmark::State& p_state) -> void;
+	auto benchmark_recovery_checkpoint(benchmark::State& p_state) -> void;
+
+	auto manual_options() -> cache_engine::durable::durability_options
+	{
+		cache_engine::durable::durability_options options;
+		options.m_checkpoint_interval = std::chrono::milliseconds(0);
+		return options;
+	}
+
+	auto benchmark_put_plain(benchmark::State& p_state) -> void
+	{
+		std::mutex mutex;
+		std::unique_ptr<lru_t> cache(new lru_t(capacity));
+		const value_t value(64, 'v');
+		key_t key = 0;
+
+		for (auto _ : p_state)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			cache->put(key++ % capacity, value);
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()));
+	}
+
+	auto run_durable_puts(benchmark::State& p_state, bool p_wait) -> void
+	{
+		const bench_directory directory(p_wait ? "put_wait" : "put");
+		cache_engine::durable::durability_options options = manual_options();
+		options.m_wait_for_durability					  = p_wait;
+
+		std::unique_ptr<durable_t> cache(new durable_t(directory.path(), lru_t(capacity), options));
+		const value_t value(64, 'v');
+		key_t key = 0;
+
+		for (auto _ : p_state)
+		{
+			cache->put(key++ % capacity, value);
+		}
+		cache->sync();
+
+		const cache_engine::durable::log_stats stats = cache->stats().m_log;
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()));
+		p_state.counters["syncs"]			 = static_cast<double>(stats.m_syncs);
+		p_state.counters["records_per_sync"] = stats.m_syncs == 0 ? 0.0 : static_cast<double>(stats.m_records) / static_cast<double>(stats.m_syncs);
+	}
+
+	auto run_recovery(benchmark::State& p_state, bool p_checkpoint) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		const bench_directory directory(p_checkpoint ? "recover_checkpoint" : "recover_log");
+		{
+			std::unique_ptr<durable_t> cache(new durable_t(directory.path(), lru_t(capacity), manual_options()));
+			const value_t value(64, 'v');
+			for (std::size_t idx_for = 0; idx_for < entries; ++idx_for)
+			{
+				cache->put(static_cast<key_t>(idx_for), value);
+			}
+			cache->sync();
+			if (p_checkpoint)
+			{
+				cache->checkpoint();
+			}
+		}
+
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<durable_t> cache(new durable_t(directory.path(), lru_t(capacity), manual_options()));
+			benchmark::DoNotOptimize(cache->size());
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(entries));
+	}
+
+	auto benchmark_put_durable(benchmark::State& p_state) -> void { run_durable_puts(p_state, false); }
+
+	auto benchmark_put_durable_wait(benchmark::State& p_state) -> void { run_durable_puts(p_state, true); }
+
+	auto benchmark_recovery_log(benchmark::State& p_state) -> void { run_recovery(p_state, false); }
+
+	auto benchmark_recovery_checkpoint(benchmark::State& p_state) -> void { run_recovery(p_state, true); }
+
+} // namespace cache_durable
+
+BENCHMARK(cache_durable::benchmark_put_plain);
+BENCHMARK(cache_durable::benchmark_put_durable);
+BENCHMARK(cache_durable::benchmark_put_durable_wait)->Iterations(2000);
+BENCHMARK(cache_durable::benchmark_recovery_log)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_durable::benchmark_recovery_checkpoint)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
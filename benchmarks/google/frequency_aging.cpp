@@ -0,0 +1,195 @@
+/**
+ * @file frequency_aging.cpp
+ * @brief Frequency counter aging and LFU victim selection benchmarks
+ *
+ * Compares halving frequency counters stored in a node-based map (the layout
+ * used by lfu_eviction_policy and threshold_access_policy) against the dense
+ * structure-of-arrays counters used by the sampled LFU policy, both through
+ * the vectorized and the scalar code paths. Also compares victim selection
+ * cost of the sampled LFU policy against the exact bucketed LFU policy.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/policies/all_policies.hpp>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace cache_frequency_aging
+{
+	using key_t = std::uint64_t;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto benchmark_map_aging(benchmark::State& p_state) -> void;
+	auto benchmark_dense_u8_aging(benchmark::State& p_state) -> void;
+	auto benchmark_dense_u16_aging(benchmark::State& p_state) -> void;
+	auto benchmark_scalar_u8_aging(benchmark::State& p_state) -> void;
+	auto benchmark_scalar_u16_aging(benchmark::State& p_state) -> void;
+	auto benchmark_lfu_victim_selection(benchmark::State& p_state) -> void;
+	auto benchmark_sampled_lfu_victim_selection(benchmark::State& p_state) -> void;
+	auto benchmark_sampled_lfu16_victim_selection(benchmark::State& p_state) -> void;
+
+	/**
+	 * @brief Fill a counter array with a skewed, reproducible frequency distribution
+	 */
+	template <typename counter_t> auto make_counters(std::size_t p_count) -> std::vector<counter_t>
+	{
+		std::mt19937 generator(42);
+		std::geometric_distribution<unsigned> distribution(0.05);
+		std::vector<counter_t> counters(p_count);
+		for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+		{
+			const unsigned value = distribution(generator) + 1U;
+			counters[idx_for]	 = static_cast<counter_t>(value > 255U ? 255U : value);
+		}
+		return counters;
+	}
+
+	template <typename counter_t> auto report_aging(benchmark::State& p_state, std::size_t p_count) -> void
+	{
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(p_count));
+		p_state.SetBytesProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(p_count * sizeof(counter_t)));
+		p_state.counters["entries"] = static_cast<double>(p_count);
+	}
+
+	/**
+	 * @brief Baseline: halve frequencies held as unordered_map values
+	 */
+	auto benchmark_map_aging(benchmark::State& p_state) -> void
+	{
+		const std::size_t count						= static_cast<std::size_t>(p_state.range(0));
+		const std::vector<std::uint8_t> seed_counts = make_counters<std::uint8_t>(count);
+
+		std::unordered_map<key_t, std::size_t> frequencies;
+		frequencies.reserve(count);
+		for (std::size_t idx_for = 0; idx_for < count; ++idx_for)
+		{
+			frequencies[idx_for] = seed_counts[idx_for];
+		}
+
+		for (auto _ : p_state)
+		{
+			for (auto& entry : frequencies)
+			{
+				entry.second >>= 1U;
+			}
+			benchmark::ClobberMemory();
+		}
+
+		report_aging<std::size_t>(p_state, count);
+	}
+
+	template <typename counter_t> auto benchmark_dense_aging(benchmark::State& p_state) -> void
+	{
+		const std::size_t count					 = static_cast<std::size_t>(p_state.range(0));
+		const std::vector<counter_t> seed_counts = make_counters<counter_t>(count);
+
+		cache_engine::policies::dense_frequency_counters<counter_t> counters;
+		counters.reserve(count);
+		for (std::size_t idx_for = 0; idx_for < count; ++idx_for)
+		{
+			counters.push_back(seed_counts[idx_for]);
+		}
+
+		for (auto _ : p_state)
+		{
+			counters.halve_all();
+			benchmark::ClobberMemory();
+		}
+
+		report_aging<counter_t>(p_state, count);
+		p_state.SetLabel(cache_engine::policies::dense_frequency_counters<counter_t>::simd_backend());
+	}
+
+	template <typename counter_t> auto benchmark_scalar_aging(benchmark::State& p_state) -> void
+	{
+		const std::size_t count			= static_cast<std::size_t>(p_state.range(0));
+		std::vector<counter_t> counters = make_counters<counter_t>(count);
+
+		for (auto _ : p_state)
+		{
+			cache_engine::policies::detail::scalar_frequency_ops<counter_t>::halve(counters.data(), counters.size());
+			benchmark::ClobberMemory();
+		}
+
+		report_aging<counter_t>(p_state, count);
+		p_state.SetLabel("scalar");
+	}
+
+	auto benchmark_dense_u8_aging(benchmark::State& p_state) -> void { benchmark_dense_aging<std::uint8_t>(p_state); }
+
+	auto benchmark_dense_u16_aging(benchmark::State& p_state) -> void { benchmark_dense_aging<std::uint16_t>(p_state); }
+
+	auto benchmark_scalar_u8_aging(benchmark::State& p_state) -> void { benchmark_scalar_aging<std::uint8_t>(p_state); }
+
+	auto benchmark_scalar_u16_aging(benchmark::State& p_state) -> void { benchmark_scalar_aging<std::uint16_t>(p_state); }
+
+	/**
+	 * @brief Populate an eviction policy with a skewed access history
+	 */
+	template <typename policy_t> auto populate_policy(policy_t& p_policy, std::size_t p_count) -> void
+	{
+		const std::vector<std::uint8_t> seed_counts = make_counters<std::uint8_t>(p_count);
+		for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+		{
+			p_policy.on_insert(idx_for);
+			for (std::uint8_t idx_access = 1; idx_access < seed_counts[idx_for] && idx_access < 8; ++idx_access)
+			{
+				p_policy.on_access(idx_for);
+			}
+		}
+	}
+
+	/**
+	 * @brief Steady-state eviction: select and remove a victim, then insert a fresh key
+	 */
+	template <typename policy_t> auto benchmark_victim_selection(benchmark::State& p_state) -> void
+	{
+		const std::size_t count = static_cast<std::size_t>(p_state.range(0));
+		policy_t policy;
+		populate_policy(policy, count);
+
+		key_t next_key = count;
+		for (auto _ : p_state)
+		{
+			const key_t victim = policy.select_victim();
+			policy.remove_key(victim);
+			policy.on_insert(next_key++);
+			benchmark::DoNotOptimize(victim);
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()));
+		p_state.counters["entries"] = static_cast<double>(count);
+	}
+
+	auto benchmark_lfu_victim_selection(benchmark::State& p_state) -> void
+	{
+		benchmark_victim_selection<cache_engine::policies::lfu_eviction_policy<key_t, int>>(p_state);
+	}
+
+	auto benchmark_sampled_lfu_victim_selection(benchmark::State& p_state) -> void
+	{
+		benchmark_victim_selection<cache_engine::policies::sampled_lfu_eviction_policy<key_t, int>>(p_state);
+	}
+
+	auto benchmark_sampled_lfu16_victim_selection(benchmark::State& p_state) -> void
+	{
+		benchmark_victim_selection<cache_engine::policies::sampled_lfu16_eviction_policy<key_t, int>>(p_state);
+	}
+
+} // namespace cache_frequency_aging
+
+// Register aging benchmarks (up to 10M tracked keys)
+BENCHMARK(cache_frequency_aging::benchmark_map_aging)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_frequency_aging::benchmark_dense_u8_aging)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_frequency_aging::benchmark_dense_u16_aging)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_frequency_aging::benchmark_scalar_u8_aging)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_frequency_aging::benchmark_scalar_u16_aging)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Register victim selection benchmarks
+BENCHMARK(cache_frequency_aging::benchmark_lfu_victim_selection)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_frequency_aging::benchmark_sampled_lfu_victim_selection)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_frequency_aging::benchmark_sampled_lfu16_victim_selection)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+/**
+ * @file hedged_loads.cpp
+ * @brief Miss latency percentiles of async_cache with and without hedged loads (C++20 build only)
+ *
+ * A single caller misses on a fresh key every request, waiting for each
+ * value before asking for the next. The simulated backend answers in
+ * 200 us, except for one load in 25 that stalls for 4 ms, so without
+ * hedging the p99 of a miss is a stall. Hedged loads issue a second load
+ * once the first one is late (fixed 500 us, or the tracked p95) within a
+ * budget of 10% of loads; the second load usually lands on a fast
+ * backend and wins, and the stalled one is discarded.
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cache_engine/async/async_cache.hpp>
+#include <cache_engine/async/hedged_loader.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace cache_hedged
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using async_cache_t	  = cache_engine::async::async_cache<key_t, value_t>;
+	using hedged_loader_t = cache_engine::async::hedged_loader<key_t, value_t>;
+
+	constexpr std::size_t request_count	   = 2048;
+	constexpr std::size_t executor_threads = 4;
+	constexpr std::uint64_t stall_one_in   = 25;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto expected_value(key_t p_key) -> value_t;
+	auto backend_delay() -> std::chrono::microseconds;
+	auto make_backend(cache_engine::async::executor& p_executor) -> async_cache_t::loader_t;
+	auto percentile(std::vector<double> p_samples, double p_rank) -> double;
+	auto run_requests(benchmark::State& p_state, const async_cache_t::loader_t& p_loader, cache_engine::async::executor& p_executor) -> void;
+	auto benchmark_unhedged(benchmark::State& p_state) -> void;
+	auto benchmark_hedged_fixed(benchmark::State& p_state) -> void;
+	auto benchmark_hedged_tracked(benchmark::State& p_state) -> void;
+
+	auto expected_value(key_t p_key) -> value_t { return p_key * 2654435761ULL; }
+
+	/**
+	 * @brief Latency of one backend call; every call draws independently, so a hedge rarely stalls too
+	 */
+	auto backend_delay() -> std::chrono::microseconds
+	{
+		static std::atomic<std::uint64_t> s_calls(0);
+		std::uint64_t state = (s_calls.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B97F4A7C15ULL;
+		state ^= state >> 31U;
+		state *= 0xBF58476D1CE4E5B9ULL;
+		state ^= state >> 29U;
+		return (state % stall_one_in == 0) ? std::chrono::microseconds(4000) : std::chrono::microseconds(200);
+	}
+
+	auto make_backend(cache_engine::async::executor& p_executor) -> async_cache_t::loader_t
+	{
+		return [&p_executor](const key_t& p_key) -> cache_engine::async::task<value_t>
+		{
+			const key_t key = p_key;
+			co_await p_executor.schedule();
+			std::this_thread::sleep_for(backend_delay());
+			co_return expected_value(key);
+		};
+	}
+
+	auto percentile(std::vector<double> p_samples, double p_rank) -> double
+	{
+		const std::size_t rank = static_cast<std::size_t>(p_rank * static_cast<double>(p_samples.size() - 1));
+		std::nth_element(p_samples.begin(), p_samples.begin() + static_cast<std::ptrdiff_t>(rank), p_samples.end());
+		return p_samples[rank];
+	}
+
+	/**
+	 * @brief Time every miss of a fresh cache and report the latency percentiles in microseconds
+	 */
+	auto run_requests(benchmark::State& p_state, const async_cache_t::loader_t& p_loader, cache_engine::async::executor& p_executor) -> void
+	{
+		std::vector<double> latencies;
+		latencies.reserve(request_count);
+		std::size_t errors = 0;
+		key_t next_key	   = 0;
+
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<async_cache_t> cache(new async_cache_t(request_count, p_loader, p_executor));
+			for (std::size_t idx_for = 0; idx_for < request_count; ++idx_for, ++next_key)
+			{
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				errors += (cache_engine::async::sync_wait(cache->async_get_or_load(next_key)) != expected_value(next_key)) ? 1U : 0U;
+				latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+			}
+		}
+
+		if (errors != 0)
+		{
+			p_state.SkipWithError("async_get_or_load returned a wrong value");
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(latencies.size()));
+		p_state.counters["p50_us"]	= percentile(latencies, 0.50);
+		p_state.counters["p99_us"]	= percentile(latencies, 0.99);
+		p_state.counters["p999_us"] = percentile(latencies, 0.999);
+	}
+
+	auto benchmark_unhedged(benchmark::State& p_state) -> void
+	{
+		cache_engine::async::thread_pool_executor executor(executor_threads);
+		run_requests(p_state, make_backend(executor), executor);
+	}
+
+	auto benchmark_hedged_fixed(benchmark::State& p_state) -> void
+	{
+		cache_engine::async::thread_pool_executor executor(executor_threads);
+		cache_engine::async::hedge_options options;
+		options.m_delay = std::chrono::microseconds(500);
+		std::unique_ptr<hedged_loader_t> hedged(new hedged_loader_t(make_backend(executor), executor, options));
+		run_requests(p_state, hedged->loader(), executor);
+
+		const cache_engine::async::hedge_stats stats = hedged->stats();
+		p_state.counters["hedge_rate"]				 = static_cast<double>(stats.m_hedges) / static_cast<double>(stats.m_loads);
+		p_state.counters["hedge_wins"]				 = static_cast<double>(stats.m_hedge_wins);
+	}
+
+	auto benchmark_hedged_tracked(benchmark::State& p_state) -> void
+	{
+		cache_engine::async::thread_pool_executor executor(executor_threads);
+		std::unique_ptr<hedged_loader_t> hedged(new hedged_loader_t(make_backend(executor), executor));
+		run_requests(p_state, hedged->loader(), executor);
+
+		const cache_engine::async::hedge_stats stats = hedged->stats();
+		p_state.counters["hedge_rate"]				 = static_cast<double>(stats.m_hedges) / static_cast<double>(stats.m_loads);
+		p_state.counters["hedge_wins"]				 = static_cast<double>(stats.m_hedge_wins);
+		p_state.counters["hedge_delay_us"]			 = std::chrono::duration<double, std::micro>(hedged->hedge_delay()).count();
+	}
+
+} // namespace cache_hedged
+
+BENCHMARK(cache_hedged::benchmark_unhedged)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(cache_hedged::benchmark_hedged_fixed)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(cache_hedged::benchmark_hedged_tracked)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,144 @@
+/**
+ * @file hyperbolic.cpp
+ * @brief Hit ratio of hyperbolic eviction against LRU and LFU on popularity-drift traces
+ *
+ * Each iteration replays a whole trace against a fresh policy_based_cache,
+ * caching every miss, and counts hits after the first phase. Requests are
+ * Zipf(0.99) over popularity ranks; the trace kind decides which key holds
+ * each rank in each phase:
+ * - Arg 0 (stationary): ranks never move, the case LFU is built for.
+ * - Arg 1 (arrivals): every phase new keys take the top ranks and older
+ *   keys slide down, so yesterday's heavy hitters keep large stale counts.
+ * - Arg 2 (reshuffle): every phase assigns ranks to keys at random.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "workload.hpp"
+
+namespace cache_hyperbolic
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	template <template <typename, typename> class eviction_t>
+	using cache_for =
+		cache_engine::policy_based_cache<key_t, value_t, eviction_t, cache_engine::policy_templates::hash_storage, cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	using lru_cache_t		  = cache_for<cache_engine::policy_templates::lru_eviction>;
+	using lfu_cache_t		  = cache_for<cache_engine::policy_templates::lfu_eviction>;
+	using sampled_lfu_cache_t = cache_for<cache_engine::policy_templates::sampled_lfu_eviction>;
+	using hyperbolic_cache_t  = cache_for<cache_engine::policy_templates::hyperbolic_eviction>;
+
+	constexpr std::size_t cache_capacity = 4096;
+	constexpr std::size_t rank_count	 = cache_capacity * 16;
+	constexpr std::size_t phase_length	 = std::size_t(1) << 15U;
+	constexpr std::size_t phase_count	 = 32;
+	constexpr std::size_t arrival_shift	 = cache_capacity / 4;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto key_for(std::size_t p_kind, std::size_t p_phase, std::size_t p_rank) -> key_t;
+	auto make_trace(std::size_t p_kind) -> std::vector<key_t>;
+	template <typename cache_t> auto run_trace(benchmark::State& p_state) -> void;
+	auto benchmark_lru(benchmark::State& p_state) -> void;
+	auto benchmark_lfu(benchmark::State& p_state) -> void;
+	auto benchmark_sampled_lfu(benchmark::State& p_state) -> void;
+	auto benchmark_hyperbolic(benchmark::State& p_state) -> void;
+
+	auto key_for(std::size_t p_kind, std::size_t p_phase, std::size_t p_rank) -> key_t
+	{
+		switch (p_kind)
+		{
+			case 0:
+				return static_cast<key_t>(p_rank);
+			case 1:
+				// Rank 0 is the newest key; each phase pushes every key arrival_shift ranks down
+				return static_cast<key_t>(rank_count + p_phase * arrival_shift - p_rank);
+			default:
+			{
+				// Mix phase and rank so that every phase maps ranks to unrelated keys
+				key_t mixed = (static_cast<key_t>(p_phase) << 32U) ^ static_cast<key_t>(p_rank);
+				mixed ^= mixed >> 33U;
+				mixed *= 0xFF51AFD7ED558CCDULL;
+				mixed ^= mixed >> 33U;
+				return mixed % (rank_count * 4);
+			}
+		}
+	}
+
+	auto make_trace(std::size_t p_kind) -> std::vector<key_t>
+	{
+		cache_workload::zipf_sampler sampler(rank_count);
+		std::vector<key_t> trace;
+		trace.reserve(phase_length * phase_count);
+		for (std::size_t idx_phase = 0; idx_phase < phase_count; ++idx_phase)
+		{
+			for (std::size_t idx_for = 0; idx_for < phase_length; ++idx_for)
+			{
+				trace.push_back(key_for(p_kind, idx_phase, sampler.next_rank()));
+			}
+		}
+		return trace;
+	}
+
+	/**
+	 * @brief Replay the trace of range(0) through a fresh cache per iteration
+	 */
+	template <typename cache_t> auto run_trace(benchmark::State& p_state) -> void
+	{
+		static const char* const labels[] = {"stationary", "arrivals", "reshuffle"};
+		const std::size_t kind			  = static_cast<std::size_t>(p_state.range(0));
+		const std::vector<key_t> trace	  = make_trace(kind);
+
+		std::size_t hits	 = 0;
+		std::size_t measured = 0;
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<cache_t> cache(new cache_t(cache_capacity));
+			for (std::size_t idx_for = 0; idx_for < trace.size(); ++idx_for)
+			{
+				const key_t key = trace[idx_for];
+				const bool hit	= cache->contains(key);
+				if (hit)
+				{
+					benchmark::DoNotOptimize(cache->get(key));
+				}
+				else
+				{
+					cache->put(key, key);
+				}
+
+				// The first phase only warms the cache
+				if (idx_for >= phase_length)
+				{
+					hits += hit ? 1U : 0U;
+					++measured;
+				}
+			}
+		}
+
+		p_state.SetLabel(labels[kind]);
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(trace.size()));
+		p_state.counters["hit_ratio"] = static_cast<double>(hits) / static_cast<double>(measured);
+	}
+
+	auto benchmark_lru(benchmark::State& p_state) -> void { run_trace<lru_cache_t>(p_state); }
+
+	auto benchmark_lfu(benchmark::State& p_state) -> void { run_trace<lfu_cache_t>(p_state); }
+
+	auto benchmark_sampled_lfu(benchmark::State& p_state) -> void { run_trace<sampled_lfu_cache_t>(p_state); }
+
+	auto benchmark_hyperbolic(benchmark::State& p_state) -> void { run_trace<hyperbolic_cache_t>(p_state); }
+
+} // namespace cache_hyperbolic
+
+BENCHMARK(cache_hyperbolic::benchmark_lru)->Arg(0)->Arg(1)->Arg(2)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_hyperbolic::benchmark_lfu)->Arg(0)->Arg(1)->Arg(2)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_hyperbolic::benchmark_sampled_lfu)->Arg(0)->Arg(1)->Arg(2)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_hyperbolic::benchmark_hyperbolic)->Arg(0)->Arg(1)->Arg(2)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
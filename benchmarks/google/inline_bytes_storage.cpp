@@ -0,0 +1,111 @@
+/**
+ * @file inline_bytes_storage.cpp
+ * @brief Probe throughput of inline_bytes_storage_policy against hash_storage_policy with string values
+ *
+ * Both storages are filled with Arg 0 entries whose values are 8-24
+ * bytes, except Arg 1 percent of them which are 64-512 bytes, and then
+ * probed in random order: one find() per item, half of them for absent
+ * keys. A hit reads the value's size, as a caller deciding whether to
+ * copy it would. The inline storage keeps small values in its slots and
+ * large ones in a separate value heap, so probes never pull large values
+ * into the cache; hash_storage_policy chases a node per lookup.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace cache_inline_bytes
+{
+	using key_t			   = std::uint64_t;
+	using bytes_t		   = cache_engine::policies::inline_bytes;
+	using hash_storage_t   = cache_engine::policies::hash_storage_policy<key_t, std::string>;
+	using inline_storage_t = cache_engine::policies::inline_bytes_storage_policy<key_t, bytes_t>;
+
+	constexpr std::size_t probe_count = std::size_t(1) << 16U;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto make_values(std::size_t p_entries, std::size_t p_large_percent) -> std::vector<std::string>;
+	auto make_probes(std::size_t p_entries) -> std::vector<key_t>;
+	template <typename storage_t, typename wrap_t> auto run_probes(benchmark::State& p_state, const wrap_t& p_wrap) -> void;
+	auto benchmark_probe_hash_storage(benchmark::State& p_state) -> void;
+	auto benchmark_probe_inline_storage(benchmark::State& p_state) -> void;
+
+	auto make_values(std::size_t p_entries, std::size_t p_large_percent) -> std::vector<std::string>
+	{
+		std::mt19937_64 rng(11);
+		std::vector<std::string> values;
+		values.reserve(p_entries);
+		for (std::size_t idx_for = 0; idx_for < p_entries; ++idx_for)
+		{
+			const bool large		= rng() % 100 < p_large_percent;
+			const std::size_t bytes = large ? 64 + static_cast<std::size_t>(rng() % 449) : 8 + static_cast<std::size_t>(rng() % 17);
+			values.emplace_back(bytes, static_cast<char>('a' + idx_for % 26));
+		}
+		return values;
+	}
+
+	// Keys 0..2n-1 in random order: entries are stored under even keys, so half the probes miss
+	auto make_probes(std::size_t p_entries) -> std::vector<key_t>
+	{
+		std::mt19937_64 rng(13);
+		std::vector<key_t> probes(probe_count);
+		for (key_t& key : probes)
+		{
+			key = rng() % (2 * p_entries);
+		}
+		return probes;
+	}
+
+	template <typename storage_t, typename wrap_t> auto run_probes(benchmark::State& p_state, const wrap_t& p_wrap) -> void
+	{
+		const std::size_t entries			  = static_cast<std::size_t>(p_state.range(0));
+		const std::vector<std::string> values = make_values(entries, static_cast<std::size_t>(p_state.range(1)));
+		const std::vector<key_t> probes		  = make_probes(entries);
+
+		std::unique_ptr<storage_t> storage(new storage_t(cache_engine::policies::containers::make_policy_context<key_t, std::string>(entries)));
+		for (std::size_t idx_for = 0; idx_for < entries; ++idx_for)
+		{
+			storage->insert(static_cast<key_t>(2 * idx_for), p_wrap(values[idx_for]));
+		}
+
+		std::size_t hits  = 0;
+		std::size_t bytes = 0;
+		for (auto _ : p_state)
+		{
+			for (const key_t key : probes)
+			{
+				const auto* value = storage->find(key);
+				if (value != nullptr)
+				{
+					++hits;
+					bytes += value->size();
+				}
+			}
+			benchmark::DoNotOptimize(bytes);
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(probe_count));
+		p_state.counters["hit_ratio"] = static_cast<double>(hits) / (static_cast<double>(p_state.iterations()) * static_cast<double>(probe_count));
+	}
+
+	auto benchmark_probe_hash_storage(benchmark::State& p_state) -> void
+	{
+		run_probes<hash_storage_t>(p_state, [](const std::string& p_value) -> const std::string& { return p_value; });
+	}
+
+	auto benchmark_probe_inline_storage(benchmark::State& p_state) -> void
+	{
+		run_probes<inline_storage_t>(p_state, [](const std::string& p_value) { return bytes_t(p_value); });
+	}
+
+} // namespace cache_inline_bytes
+
+BENCHMARK(cache_inline_bytes::benchmark_probe_hash_storage)->ArgsProduct({{100000, 1000000}, {0, 20, 100}})->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_inline_bytes::benchmark_probe_inline_storage)->ArgsProduct({{100000, 1000000}, {0, 20, 100}})->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+/**
+ * @file lazy_value.cpp
+ * @brief Bulk-load time and memory of lazy_value against decoding every value on put()
+ *
+ * A dump of serialized records (eight comma-separated text fields) is
+ * loaded into an LRU cache, then Arg percent of the keys are read back.
+ * The eager cache decodes every record before put(); the lazy cache stores
+ * lazy_value wrappers on the ledger_capacity policy and decodes on first
+ * read. The accounted_mb counter reports the bytes the entries account
+ * for (decoded sizes for eager, the ledger for lazy).
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/lazy/lazy_value.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cache_lazy
+{
+	using key_t = std::uint64_t;
+
+	/**
+	 * @brief Decoded form of a dump record
+	 */
+	struct record
+	{
+		std::vector<std::string> m_fields;
+	};
+
+	/**
+	 * @brief Splits "a,b,c" into fields
+	 */
+	struct record_decoder
+	{
+		auto operator()(const char* p_data, std::size_t p_bytes, record& p_value) const -> bool
+		{
+			p_value.m_fields.clear();
+			std::size_t start = 0;
+			for (std::size_t idx_for = 0; idx_for <= p_bytes; ++idx_for)
+			{
+				if (idx_for == p_bytes || p_data[idx_for] == ',')
+				{
+					p_value.m_fields.emplace_back(p_data + start, idx_for - start);
+					start = idx_for + 1;
+				}
+			}
+			return true;
+		}
+	};
+
+	struct record_size
+	{
+		auto operator()(const record& p_value) const -> std::size_t
+		{
+			std::size_t bytes = sizeof(record) + p_value.m_fields.capacity() * sizeof(std::string);
+			for (const std::string& field : p_value.m_fields)
+			{
+				bytes += field.capacity() > 15 ? field.capacity() + 1 : 0;
+			}
+			return bytes;
+		}
+	};
+
+	using lazy_t		= cache_engine::lazy::lazy_value<record, record_decoder, record_size>;
+	using eager_cache_t = cache_engine::policy_based_cache<key_t, record, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+														   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+	using lazy_cache_t	= cache_engine::policy_based_cache<key_t, lazy_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+														   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::ledger_capacity>;
+
+	constexpr std::size_t dump_entries = 200000;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto make_dump() -> const std::vector<std::string>&;
+	auto benchmark_load_eager(benchmark::State& p_state) -> void;
+	auto benchmark_load_lazy(benchmark::State& p_state) -> void;
+
+	auto make_dump() -> const std::vector<std::string>&
+	{
+		static std::vector<std::string> dump;
+		if (dump.empty())
+		{
+			dump.reserve(dump_entries);
+			for (std::size_t idx_for = 0; idx_for < dump_entries; ++idx_for)
+			{
+				std::string line;
+				for (std::size_t idx_field = 0; idx_field < 8; ++idx_field)
+				{
+					line += (idx_field == 0 ? "" : ",") + std::string("field-") + std::to_string(idx_for * 8 + idx_field) + "-value";
+				}
+				dump.push_back(line);
+			}
+		}
+		return dump;
+	}
+
+	auto benchmark_load_eager(benchmark::State& p_state) -> void
+	{
+		const std::vector<std::string>& dump = make_dump();
+		const std::size_t read_every		 = p_state.range(0) == 0 ? 0 : static_cast<std::size_t>(100 / p_state.range(0));
+		std::size_t accounted				 = 0;
+
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<eager_cache_t> cache(new eager_cache_t(dump_entries));
+			for (std::size_t idx_for = 0; idx_for < dump.size(); ++idx_for)
+			{
+				record value;
+				record_decoder()(dump[idx_for].data(), dump[idx_for].size(), value);
+				cache->put(static_cast<key_t>(idx_for), value);
+			}
+			accounted = 0;
+			for (std::size_t idx_for = 0; idx_for < dump.size(); ++idx_for)
+			{
+				if (read_every != 0 && idx_for % read_every == 0)
+				{
+					benchmark::DoNotOptimize(cache->get(static_cast<key_t>(idx_for)).m_fields.size());
+				}
+			}
+			for (std::size_t idx_for = 0; idx_for < dump.size(); idx_for += 97)
+			{
+				accounted += record_size()(cache->get(static_cast<key_t>(idx_for)));
+			}
+			accounted = accounted * 97;
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(dump.size()));
+		p_state.counters["accounted_mb"] = static_cast<double>(accounted) / (1024.0 * 1024.0);
+	}
+
+	auto benchmark_load_lazy(benchmark::State& p_state) -> void
+	{
+		const std::vector<std::string>& dump = make_dump();
+		const std::size_t read_every		 = p_state.range(0) == 0 ? 0 : static_cast<std::size_t>(100 / p_state.range(0));
+		std::size_t accounted				 = 0;
+
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<lazy_cache_t> cache(new lazy_cache_t(dump_entries));
+			const std::shared_ptr<cache_engine::lazy::byte_ledger>& ledger = cache->capacity_policy().ledger();
+			for (std::size_t idx_for = 0; idx_for < dump.size(); ++idx_for)
+			{
+				cache->put(static_cast<key_t>(idx_for), lazy_t(dump[idx_for], ledger));
+			}
+			for (std::size_t idx_for = 0; idx_for < dump.size(); ++idx_for)
+			{
+				if (read_every != 0 && idx_for % read_every == 0)
+				{
+					benchmark::DoNotOptimize(cache->get(static_cast<key_t>(idx_for)).get().m_fields.size());
+				}
+			}
+			accounted = ledger->bytes();
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(dump.size()));
+		p_state.counters["accounted_mb"] = static_cast<double>(accounted) / (1024.0 * 1024.0);
+	}
+
+} // namespace cache_lazy
+
+BENCHMARK(cache_lazy::benchmark_load_eager)->Arg(0)->Arg(10)->Arg(100)->Iterations(3)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_lazy::benchmark_load_lazy)->Arg(0)->Arg(10)->Arg(100)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,211 @@
+/**
+ * @file mph_table.cpp
+ * @brief Startup and lookup cost of an mmap-loaded mph_table against filling a cache with put()
+ *
+ * Startup benchmarks measure what a process pays before its first lookup:
+ * put() of every entry into an LRU or policy-based cache, or mapping the
+ * prebuilt file (lazy and prefaulted). Lookup benchmarks measure random
+ * hits on the filled structures, and a tiered cache whose upper LRU holds
+ * a tenth of the keys in front of the table. Arg is the entry count.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/immutable/mph_table.hpp>
+#include <cache_engine/immutable/tiered_cache.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace cache_mph
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using table_t  = cache_engine::immutable::mph_table<key_t, value_t>;
+	using lru_t	   = cache_engine::cache<key_t, value_t, cache_engine::algorithm::lru>;
+	using policy_t = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::reserved_hash_storage,
+													  cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+	using tiered_t = cache_engine::immutable::tiered_cache<lru_t, table_t>;
+
+	constexpr std::size_t lookups_per_batch = 1024;
+
+	/**
+	 * @brief Table files built once per entry count and removed at exit
+	 */
+	class table_files
+	{
+	  private:
+		std::map<std::size_t, std::string> m_paths;
+
+	  public:
+		table_files() {}
+
+		~table_files()
+		{
+			for (const auto& entry : m_paths)
+			{
+				std::remove(entry.second.c_str());
+			}
+		}
+
+		table_files(const table_files&)					   = delete;
+		auto operator=(const table_files&) -> table_files& = delete;
+
+		auto path_for(std::size_t p_entries) -> const std::string&
+		{
+			auto iter = m_paths.find(p_entries);
+			if (iter == m_paths.end())
+			{
+				cache_engine::immutable::mph_builder<key_t, value_t> builder(p_entries);
+				for (std::size_t idx_for = 0; idx_for < p_entries; ++idx_for)
+				{
+					builder.add(key_for(idx_for), idx_for);
+				}
+				const std::string path = "mph_table_benchmark_" + std::to_string(p_entries) + ".mph";
+				builder.write(path);
+				iter = m_paths.emplace(p_entries, path).first;
+			}
+			return iter->second;
+		}
+
+		static auto key_for(std::size_t p_index) -> key_t { return static_cast<key_t>(p_index) * 0x9E3779B97F4A7C15ULL + 1U; }
+	};
+
+	table_files g_files;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto benchmark_startup_lru_put(benchmark::State& p_state) -> void;
+	auto benchmark_startup_policy_put(benchmark::State& p_state) -> void;
+	auto benchmark_startup_mph_lazy(benchmark::State& p_state) -> void;
+	auto benchmark_startup_mph_prefault(benchmark::State& p_state) -> void;
+	template <typename lookup_t> auto run_lookups(benchmark::State& p_state, std::size_t p_entries, const lookup_t& p_lookup) -> void;
+	auto benchmark_lookup_lru(benchmark::State& p_state) -> void;
+	auto benchmark_lookup_mph(benchmark::State& p_state) -> void;
+	auto benchmark_lookup_tiered(benchmark::State& p_state) -> void;
+
+	auto benchmark_startup_lru_put(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<lru_t> cache(new lru_t(entries));
+			for (std::size_t idx_for = 0; idx_for < entries; ++idx_for)
+			{
+				cache->put(table_files::key_for(idx_for), idx_for);
+			}
+			benchmark::DoNotOptimize(cache->size());
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(entries));
+	}
+
+	auto benchmark_startup_policy_put(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<policy_t> cache(new policy_t(entries));
+			for (std::size_t idx_for = 0; idx_for < entries; ++idx_for)
+			{
+				cache->put(table_files::key_for(idx_for), idx_for);
+			}
+			benchmark::DoNotOptimize(cache->size());
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(entries));
+	}
+
+	auto benchmark_startup_mph_lazy(benchmark::State& p_state) -> void
+	{
+		const std::string& path = g_files.path_for(static_cast<std::size_t>(p_state.range(0)));
+		for (auto _ : p_state)
+		{
+			const table_t table(path);
+			benchmark::DoNotOptimize(table.contains(table_files::key_for(0)));
+		}
+	}
+
+	auto benchmark_startup_mph_prefault(benchmark::State& p_state) -> void
+	{
+		const std::string& path = g_files.path_for(static_cast<std::size_t>(p_state.range(0)));
+		for (auto _ : p_state)
+		{
+			const table_t table(path, cache_engine::immutable::mph_open_mode::prefault);
+			benchmark::DoNotOptimize(table.contains(table_files::key_for(0)));
+		}
+	}
+
+	/**
+	 * @brief Random hits over p_entries keys through p_lookup(key, value&)
+	 */
+	template <typename lookup_t> auto run_lookups(benchmark::State& p_state, std::size_t p_entries, const lookup_t& p_lookup) -> void
+	{
+		std::uint64_t rng = 0x2545F4914F6CDD1DULL;
+		std::size_t hits  = 0;
+		value_t value	  = 0;
+
+		for (auto _ : p_state)
+		{
+			for (std::size_t idx_for = 0; idx_for < lookups_per_batch; ++idx_for)
+			{
+				rng ^= rng << 13U;
+				rng ^= rng >> 7U;
+				rng ^= rng << 17U;
+				hits += p_lookup(table_files::key_for(static_cast<std::size_t>(rng % p_entries)), value) ? 1U : 0U;
+			}
+			benchmark::DoNotOptimize(value);
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(lookups_per_batch));
+		p_state.counters["hit_ratio"] = static_cast<double>(hits) / (static_cast<double>(p_state.iterations()) * static_cast<double>(lookups_per_batch));
+	}
+
+	auto benchmark_lookup_lru(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		std::unique_ptr<lru_t> cache(new lru_t(entries));
+		for (std::size_t idx_for = 0; idx_for < entries; ++idx_for)
+		{
+			cache->put(table_files::key_for(idx_for), idx_for);
+		}
+		run_lookups(p_state, entries,
+					[&cache](const key_t& p_key, value_t& p_value)
+					{
+						if (!cache->contains(p_key))
+						{
+							return false;
+						}
+						p_value = cache->get(p_key);
+						return true;
+					});
+	}
+
+	auto benchmark_lookup_mph(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		const table_t table(g_files.path_for(entries), cache_engine::immutable::mph_open_mode::prefault);
+		run_lookups(p_state, entries, [&table](const key_t& p_key, value_t& p_value) { return table.find(p_key, p_value); });
+	}
+
+	auto benchmark_lookup_tiered(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		std::shared_ptr<const table_t> lower(new table_t(g_files.path_for(entries), cache_engine::immutable::mph_open_mode::prefault));
+		std::unique_ptr<tiered_t> tiered(new tiered_t(lru_t(entries / 10), lower));
+		run_lookups(p_state, entries, [&tiered](const key_t& p_key, value_t& p_value) { return tiered->find(p_key, p_value); });
+		p_state.counters["upper_hits"] = static_cast<double>(tiered->upper_hits());
+	}
+
+} // namespace cache_mph
+
+// Register startup and lookup benchmarks for 100K and 1M entries
+BENCHMARK(cache_mph::benchmark_startup_lru_put)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_mph::benchmark_startup_policy_put)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_mph::benchmark_startup_mph_lazy)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_mph::benchmark_startup_mph_prefault)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_mph::benchmark_lookup_lru)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_mph::benchmark_lookup_mph)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cache_mph::benchmark_lookup_tiered)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+/**
+ * @file parallel_scan.cpp
+ * @brief Thread scaling of policy_based_cache::for_each and erase_if over a large cache
+ *
+ * A policy-based LRU cache holding entry_count entries is scanned with
+ * one thread up to the hardware thread count (Arg is the thread count).
+ * for_each sums every value; erase_if removes a quarter of the entries,
+ * which are put back outside the timed region. entries/s counts scanned
+ * entries.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace cache_scan
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using cache_t = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+													 cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	constexpr std::size_t entry_count = 1000000;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto max_threads() -> int;
+	auto make_filled_cache() -> std::unique_ptr<cache_t>;
+	auto benchmark_for_each(benchmark::State& p_state) -> void;
+	auto benchmark_erase_if(benchmark::State& p_state) -> void;
+
+	auto max_threads() -> int
+	{
+		const unsigned int hardware = std::thread::hardware_concurrency();
+		return (hardware == 0) ? 1 : static_cast<int>(hardware);
+	}
+
+	auto make_filled_cache() -> std::unique_ptr<cache_t>
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(entry_count));
+		for (key_t idx_for = 0; idx_for < entry_count; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+		}
+		return cache;
+	}
+
+	auto benchmark_for_each(benchmark::State& p_state) -> void
+	{
+		std::unique_ptr<cache_t> cache = make_filled_cache();
+		cache_engine::scan_options options;
+		options.m_threads = static_cast<std::size_t>(p_state.range(0));
+
+		for (auto _ : p_state)
+		{
+			std::atomic<std::uint64_t> total(0);
+			cache->for_each(
+				[&total](const key_t&, const value_t& p_value)
+				{
+					// Relaxed per-entry add keeps the visitor thread-safe without dominating the scan
+					if ((p_value & 0xFFU) == 0)
+					{
+						total.fetch_add(p_value, std::memory_order_relaxed);
+					}
+				},
+				options);
+			benchmark::DoNotOptimize(total.load());
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(entry_count));
+	}
+
+	auto benchmark_erase_if(benchmark::State& p_state) -> void
+	{
+		std::unique_ptr<cache_t> cache = make_filled_cache();
+		cache_engine::scan_options options;
+		options.m_threads = static_cast<std::size_t>(p_state.range(0));
+
+		std::size_t erased = 0;
+		for (auto _ : p_state)
+		{
+			erased = cache->erase_if([](const key_t& p_key, const value_t&) { return (p_key & 3U) == 0; }, options);
+
+			p_state.PauseTiming();
+			for (key_t idx_for = 0; idx_for < entry_count; idx_for += 4)
+			{
+				cache->put(idx_for, idx_for);
+			}
+			p_state.ResumeTiming();
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(entry_count));
+		p_state.counters["erased"] = static_cast<double>(erased);
+	}
+
+} // namespace cache_scan
+
+// Register scan benchmarks, 1 thread up to every hardware thread
+BENCHMARK(cache_scan::benchmark_for_each)->DenseRange(1, cache_scan::max_threads())->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(cache_scan::benchmark_erase_if)->DenseRange(1, cache_scan::max_threads())->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
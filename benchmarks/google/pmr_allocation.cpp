@@ -0,0 +1,214 @@
+/**
+ * @file pmr_allocation.cpp
+ * @brief Allocation cost and RSS of policy_based_cache on memory resources (C++17 build only)
+ *
+ * Compares the same cache with its policy containers on the default resource
+ * (global new/delete), on std::pmr::unsynchronized_pool_resource, and on a
+ * cache_arena (node_pool_resource over a monotonic buffer). Measures churn
+ * throughput (insert with eviction), teardown time and resident memory.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/memory/cache_arena.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace cache_pmr
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using lru_cache = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+													   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	using lfu_cache = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lfu_eviction, cache_engine::policy_templates::hash_storage,
+													   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	enum class resource_kind
+	{
+		default_resource,
+		pool_resource,
+		arena_resource
+	};
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto resident_bytes() -> std::size_t;
+	template <typename cache_t, resource_kind kind> auto benchmark_churn(benchmark::State& p_state) -> void;
+	template <typename cache_t, resource_kind kind> auto benchmark_teardown(benchmark::State& p_state) -> void;
+	auto benchmark_churn_lru_default(benchmark::State& p_state) -> void;
+	auto benchmark_churn_lru_pool(benchmark::State& p_state) -> void;
+	auto benchmark_churn_lru_arena(benchmark::State& p_state) -> void;
+	auto benchmark_churn_lfu_default(benchmark::State& p_state) -> void;
+	auto benchmark_churn_lfu_arena(benchmark::State& p_state) -> void;
+	auto benchmark_teardown_lru_default(benchmark::State& p_state) -> void;
+	auto benchmark_teardown_lru_pool(benchmark::State& p_state) -> void;
+	auto benchmark_teardown_lru_arena(benchmark::State& p_state) -> void;
+
+	/**
+	 * @brief Current resident set size, 0 where unavailable
+	 */
+	auto resident_bytes() -> std::size_t
+	{
+#if defined(__linux__)
+		std::FILE* p_file = std::fopen("/proc/self/statm", "r");
+		if (p_file == nullptr)
+		{
+			return 0;
+		}
+		unsigned long total_pages	 = 0;
+		unsigned long resident_pages = 0;
+		const int fields			 = std::fscanf(p_file, "%lu %lu", &total_pages, &resident_pages);
+		std::fclose(p_file);
+		return (fields == 2) ? static_cast<std::size_t>(resident_pages) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+		return 0;
+#endif
+	}
+
+	/**
+	 * @brief Owns the resource under test and builds caches on it
+	 */
+	template <typename cache_t, resource_kind kind> class resource_fixture
+	{
+	  private:
+		std::unique_ptr<std::pmr::unsynchronized_pool_resource> m_pool;
+		std::unique_ptr<cache_engine::memory::cache_arena> m_arena;
+
+	  public:
+		resource_fixture()
+		{
+			if (kind == resource_kind::pool_resource)
+			{
+				m_pool.reset(new std::pmr::unsynchronized_pool_resource());
+			}
+			else if (kind == resource_kind::arena_resource)
+			{
+				m_arena.reset(new cache_engine::memory::cache_arena(1U << 20U));
+			}
+		}
+
+		auto make_cache(std::size_t p_capacity) -> std::unique_ptr<cache_t>
+		{
+			if (kind == resource_kind::pool_resource)
+			{
+				return std::unique_ptr<cache_t>(new cache_t(p_capacity, m_pool.get()));
+			}
+			if (kind == resource_kind::arena_resource)
+			{
+				return std::unique_ptr<cache_t>(new cache_t(p_capacity, m_arena->resource()));
+			}
+			return std::unique_ptr<cache_t>(new cache_t(p_capacity));
+		}
+
+		auto release() -> void
+		{
+			if (m_pool)
+			{
+				m_pool->release();
+			}
+			if (m_arena)
+			{
+				m_arena->release();
+			}
+		}
+
+		auto arena_bytes() const -> std::size_t { return m_arena ? m_arena->peak_bytes() : 0; }
+	};
+
+	/**
+	 * @brief Build a cache, push 4x capacity keys through it (3/4 evict), then destroy it
+	 */
+	template <typename cache_t, resource_kind kind> auto benchmark_churn(benchmark::State& p_state) -> void
+	{
+		const std::size_t capacity = static_cast<std::size_t>(p_state.range(0));
+		const std::size_t inserts  = capacity * 4;
+		std::size_t rss_delta	   = 0;
+		std::size_t arena_bytes	   = 0;
+
+		for (auto _ : p_state)
+		{
+			resource_fixture<cache_t, kind> fixture;
+			const std::size_t rss_before = resident_bytes();
+			{
+				std::unique_ptr<cache_t> cache = fixture.make_cache(capacity);
+				for (std::size_t idx_for = 0; idx_for < inserts; ++idx_for)
+				{
+					cache->put(idx_for, idx_for);
+				}
+				benchmark::DoNotOptimize(cache->size());
+
+				const std::size_t rss_after = resident_bytes();
+				rss_delta					= (rss_after > rss_before) ? rss_after - rss_before : 0;
+			}
+			arena_bytes = fixture.arena_bytes();
+			fixture.release();
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(inserts));
+		p_state.counters["rss_delta_kb"] = static_cast<double>(rss_delta) / 1024.0;
+		p_state.counters["arena_kb"]	 = static_cast<double>(arena_bytes) / 1024.0;
+	}
+
+	/**
+	 * @brief Time only destruction of a full cache plus release of its resource
+	 */
+	template <typename cache_t, resource_kind kind> auto benchmark_teardown(benchmark::State& p_state) -> void
+	{
+		const std::size_t capacity = static_cast<std::size_t>(p_state.range(0));
+
+		for (auto _ : p_state)
+		{
+			p_state.PauseTiming();
+			resource_fixture<cache_t, kind> fixture;
+			std::unique_ptr<cache_t> cache = fixture.make_cache(capacity);
+			for (std::size_t idx_for = 0; idx_for < capacity; ++idx_for)
+			{
+				cache->put(idx_for, idx_for);
+			}
+			p_state.ResumeTiming();
+
+			cache.reset();
+			fixture.release();
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(capacity));
+	}
+
+	auto benchmark_churn_lru_default(benchmark::State& p_state) -> void { benchmark_churn<lru_cache, resource_kind::default_resource>(p_state); }
+
+	auto benchmark_churn_lru_pool(benchmark::State& p_state) -> void { benchmark_churn<lru_cache, resource_kind::pool_resource>(p_state); }
+
+	auto benchmark_churn_lru_arena(benchmark::State& p_state) -> void { benchmark_churn<lru_cache, resource_kind::arena_resource>(p_state); }
+
+	auto benchmark_churn_lfu_default(benchmark::State& p_state) -> void { benchmark_churn<lfu_cache, resource_kind::default_resource>(p_state); }
+
+	auto benchmark_churn_lfu_arena(benchmark::State& p_state) -> void { benchmark_churn<lfu_cache, resource_kind::arena_resource>(p_state); }
+
+	auto benchmark_teardown_lru_default(benchmark::State& p_state) -> void { benchmark_teardown<lru_cache, resource_kind::default_resource>(p_state); }
+
+	auto benchmark_teardown_lru_pool(benchmark::State& p_state) -> void { benchmark_teardown<lru_cache, resource_kind::pool_resource>(p_state); }
+
+	auto benchmark_teardown_lru_arena(benchmark::State& p_state) -> void { benchmark_teardown<lru_cache, resource_kind::arena_resource>(p_state); }
+
+} // namespace cache_pmr
+
+// Register churn benchmarks
+BENCHMARK(cache_pmr::benchmark_churn_lru_default)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_pmr::benchmark_churn_lru_pool)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_pmr::benchmark_churn_lru_arena)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_pmr::benchmark_churn_lfu_default)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_pmr::benchmark_churn_lfu_arena)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Register teardown benchmarks
+BENCHMARK(cache_pmr::benchmark_teardown_lru_default)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_pmr::benchmark_teardown_lru_pool)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_pmr::benchmark_teardown_lru_arena)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
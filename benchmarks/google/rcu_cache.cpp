@@ -0,0 +1,229 @@
+/**
+ * @file rcu_cache.cpp
+ * @brief Reader scaling of rcu_cache against a mutex-wrapped LRU cache while a writer publishes every 10 ms
+ *
+ * Every benchmark thread is a reader doing lookups over a resident key set.
+ * A background writer, started by thread 0, changes a few entries every
+ * 10 ms: rcu_cache stages them and publishes a new table, the baseline puts
+ * them under its mutex. Reader counts go from one to the hardware thread
+ * count. publishes reports how many versions the writer produced during
+ * the run.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/concurrent/rcu_cache.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cache_rcu
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using rcu_cache_t = cache_engine::concurrent::rcu_cache<key_t, value_t>;
+	using lru_cache_t = cache_engine::cache<key_t, value_t, cache_engine::algorithm::lru>;
+
+	constexpr std::size_t key_space		  = 100000;
+	constexpr std::size_t ops_per_batch	  = 1024;
+	constexpr std::size_t writes_per_tick = 16;
+	constexpr auto publish_interval		  = std::chrono::milliseconds(10);
+
+	/**
+	 * @brief Background thread that calls a write step every publish_interval until stopped
+	 */
+	class periodic_writer
+	{
+	  private:
+		std::atomic<bool> m_stop;
+		std::atomic<std::size_t> m_ticks;
+		std::thread m_thread;
+
+	  public:
+		periodic_writer() : m_stop(false), m_ticks(0) {}
+
+		~periodic_writer() { this->stop(); }
+
+		template <typename step_t> auto start(step_t p_step) -> void
+		{
+			m_thread = std::thread(
+				[this, p_step]()
+				{
+					std::uint64_t tick = 0;
+					while (!m_stop.load(std::memory_order_relaxed))
+					{
+						std::this_thread::sleep_for(publish_interval);
+						p_step(tick++);
+						m_ticks.fetch_add(1, std::memory_order_relaxed);
+					}
+				});
+		}
+
+		auto stop() -> void
+		{
+			m_stop.store(true);
+			if (m_thread.joinable())
+			{
+				m_thread.join();
+			}
+		}
+
+		auto ticks() const -> std::size_t { return m_ticks.load(std::memory_order_relaxed); }
+	};
+
+	/**
+	 * @brief rcu_cache with one reader handle per benchmark thread
+	 */
+	class rcu_fixture
+	{
+	  private:
+		rcu_cache_t m_cache;
+		std::vector<std::unique_ptr<rcu_cache_t::reader>> m_readers;
+		periodic_writer m_writer;
+
+	  public:
+		explicit rcu_fixture(std::size_t p_threads) : m_cache(p_threads)
+		{
+			for (key_t idx_for = 0; idx_for < key_space; ++idx_for)
+			{
+				m_cache.stage_put(idx_for, idx_for);
+			}
+			m_cache.publish();
+			for (std::size_t idx_for = 0; idx_for < p_threads; ++idx_for)
+			{
+				m_readers.emplace_back(new rcu_cache_t::reader(m_cache.make_reader()));
+			}
+			m_writer.start(
+				[this](std::uint64_t p_tick)
+				{
+					for (std::size_t idx_for = 0; idx_for < writes_per_tick; ++idx_for)
+					{
+						m_cache.stage_put((p_tick * writes_per_tick + idx_for) % key_space, p_tick);
+					}
+					m_cache.publish();
+				});
+		}
+
+		~rcu_fixture()
+		{
+			m_writer.stop();
+			m_readers.clear();
+		}
+
+		auto find(std::size_t p_thread, const key_t& p_key, value_t& p_value) -> bool { return m_readers[p_thread]->find(p_key, p_value); }
+
+		auto writes() const -> std::size_t { return m_writer.ticks(); }
+	};
+
+	/**
+	 * @brief Baseline: the LRU cache behind one mutex, written under the same lock
+	 */
+	class locked_fixture
+	{
+	  private:
+		std::mutex m_mutex;
+		lru_cache_t m_cache;
+		periodic_writer m_writer;
+
+	  public:
+		explicit locked_fixture(std::size_t) : m_cache(key_space)
+		{
+			for (key_t idx_for = 0; idx_for < key_space; ++idx_for)
+			{
+				m_cache.put(idx_for, idx_for);
+			}
+			m_writer.start(
+				[this](std::uint64_t p_tick)
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					for (std::size_t idx_for = 0; idx_for < writes_per_tick; ++idx_for)
+					{
+						m_cache.put((p_tick * writes_per_tick + idx_for) % key_space, p_tick);
+					}
+				});
+		}
+
+		~locked_fixture() { m_writer.stop(); }
+
+		auto find(std::size_t, const key_t& p_key, value_t& p_value) -> bool
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_cache.contains(p_key))
+			{
+				return false;
+			}
+			p_value = m_cache.get(p_key);
+			return true;
+		}
+
+		auto writes() const -> std::size_t { return m_writer.ticks(); }
+	};
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto max_threads() -> int;
+	template <typename fixture_t> auto benchmark_readers(benchmark::State& p_state, std::unique_ptr<fixture_t>& p_shared) -> void;
+	auto benchmark_rcu_readers(benchmark::State& p_state) -> void;
+	auto benchmark_locked_lru_readers(benchmark::State& p_state) -> void;
+
+	auto max_threads() -> int
+	{
+		const unsigned int hardware = std::thread::hardware_concurrency();
+		return (hardware == 0) ? 1 : static_cast<int>(hardware);
+	}
+
+	/**
+	 * @brief Lookups only on the benchmark threads; thread 0 owns the fixture and its writer
+	 */
+	template <typename fixture_t> auto benchmark_readers(benchmark::State& p_state, std::unique_ptr<fixture_t>& p_shared) -> void
+	{
+		if (p_state.thread_index() == 0)
+		{
+			p_shared.reset(new fixture_t(static_cast<std::size_t>(p_state.threads())));
+		}
+
+		const std::size_t thread = static_cast<std::size_t>(p_state.thread_index());
+		std::uint64_t rng		 = 0x9E3779B97F4A7C15ULL * (static_cast<std::uint64_t>(thread) + 1U);
+		std::size_t hits		 = 0;
+		value_t value			 = 0;
+
+		for (auto _ : p_state)
+		{
+			for (std::size_t idx_for = 0; idx_for < ops_per_batch; ++idx_for)
+			{
+				rng ^= rng << 13U;
+				rng ^= rng >> 7U;
+				rng ^= rng << 17U;
+				hits += p_shared->find(thread, rng % key_space, value) ? 1U : 0U;
+			}
+			benchmark::DoNotOptimize(value);
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(ops_per_batch));
+		p_state.counters["hits"] = benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgThreads);
+
+		if (p_state.thread_index() == 0)
+		{
+			p_state.counters["publishes"] = static_cast<double>(p_shared->writes());
+			p_shared.reset();
+		}
+	}
+
+	std::unique_ptr<rcu_fixture> g_rcu_fixture;
+	std::unique_ptr<locked_fixture> g_locked_fixture;
+
+	auto benchmark_rcu_readers(benchmark::State& p_state) -> void { benchmark_readers(p_state, g_rcu_fixture); }
+
+	auto benchmark_locked_lru_readers(benchmark::State& p_state) -> void { benchmark_readers(p_state, g_locked_fixture); }
+
+} // namespace cache_rcu
+
+// Register reader scaling benchmarks, 1 reader up to every hardware thread
+BENCHMARK(cache_rcu::benchmark_rcu_readers)->ThreadRange(1, cache_rcu::max_threads())->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_rcu::benchmark_locked_lru_readers)->ThreadRange(1, cache_rcu::max_threads())->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,201 @@
+/**
+ * @file read_ahead.cpp
+ * @brief Misses and prefetch accuracy of read_ahead_cache against async_cache (C++20 build only)
+ *
+ * A single caller walks a trace through a cold cache, waiting for each
+ * value before asking for the next. Every loader call, single-key or
+ * batch, sleeps for one simulated round trip on a two-thread executor.
+ * Arg 0 is one sequential scan, Arg 1 four cursors scanning separate
+ * ranges in turn (one stream each), Arg 2 uniformly random keys. With a
+ * cold cache every distinct key misses without read-ahead, so
+ * miss_reduction is 1 - misses / distinct keys.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/async/read_ahead_cache.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace cache_read_ahead
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using async_cache_t		 = cache_engine::async::async_cache<key_t, value_t>;
+	using read_ahead_cache_t = cache_engine::async::read_ahead_cache<key_t, value_t>;
+
+	constexpr std::size_t trace_length	   = 4096;
+	constexpr std::size_t cursor_count	   = 4;
+	constexpr std::size_t executor_threads = 2;
+
+	/**
+	 * @brief One request: the key and the cursor (stream) asking for it
+	 */
+	struct request
+	{
+		key_t m_key;
+		std::uint64_t m_stream;
+	};
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto expected_value(key_t p_key) -> value_t;
+	auto round_trip() -> void;
+	auto make_trace(std::size_t p_kind) -> std::vector<request>;
+	auto distinct_keys(const std::vector<request>& p_trace) -> std::size_t;
+	auto benchmark_async_cache(benchmark::State& p_state) -> void;
+	auto benchmark_read_ahead(benchmark::State& p_state) -> void;
+
+	auto expected_value(key_t p_key) -> value_t { return p_key * 2654435761ULL; }
+
+	auto round_trip() -> void { std::this_thread::sleep_for(std::chrono::microseconds(20)); }
+
+	auto make_trace(std::size_t p_kind) -> std::vector<request>
+	{
+		std::vector<request> trace;
+		trace.reserve(trace_length);
+		std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+		for (std::size_t idx_for = 0; idx_for < trace_length; ++idx_for)
+		{
+			if (p_kind == 0)
+			{
+				trace.push_back(request{static_cast<key_t>(idx_for), 0});
+			}
+			else if (p_kind == 1)
+			{
+				const std::uint64_t cursor = idx_for % cursor_count;
+				trace.push_back(request{cursor * 1000000 + idx_for / cursor_count, cursor});
+			}
+			else
+			{
+				state ^= state << 13U;
+				state ^= state >> 7U;
+				state ^= state << 17U;
+				trace.push_back(request{state % 1000000, 0});
+			}
+		}
+		return trace;
+	}
+
+	auto distinct_keys(const std::vector<request>& p_trace) -> std::size_t
+	{
+		std::unordered_set<key_t> keys;
+		for (const request& next : p_trace)
+		{
+			keys.insert(next.m_key);
+		}
+		return keys.size();
+	}
+
+	/**
+	 * @brief Baseline: every miss waits for its own round trip
+	 */
+	auto benchmark_async_cache(benchmark::State& p_state) -> void
+	{
+		static const char* const labels[] = {"sequential", "four_cursors", "random"};
+		const std::vector<request> trace  = make_trace(static_cast<std::size_t>(p_state.range(0)));
+		cache_engine::async::thread_pool_executor executor(executor_threads);
+		std::size_t misses = 0;
+		std::size_t errors = 0;
+
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<async_cache_t> cache(new async_cache_t(
+				trace_length,
+				[&executor](const key_t& p_key) -> cache_engine::async::task<value_t>
+				{
+					const key_t key = p_key;
+					co_await executor.schedule();
+					round_trip();
+					co_return expected_value(key);
+				},
+				executor));
+			for (const request& next : trace)
+			{
+				errors += (cache_engine::async::sync_wait(cache->async_get_or_load(next.m_key)) != expected_value(next.m_key)) ? 1U : 0U;
+			}
+			misses += cache->load_count();
+		}
+
+		if (errors != 0)
+		{
+			p_state.SkipWithError("async_get_or_load returned a wrong value");
+		}
+		p_state.SetLabel(labels[p_state.range(0)]);
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(trace.size()));
+		p_state.counters["misses"]		   = benchmark::Counter(static_cast<double>(misses), benchmark::Counter::kAvgIterations);
+		p_state.counters["miss_reduction"] = 1.0 - static_cast<double>(misses) / (static_cast<double>(p_state.iterations()) * static_cast<double>(distinct_keys(trace)));
+	}
+
+	/**
+	 * @brief Read-ahead: sequential streams are served from batches loaded while the caller works
+	 */
+	auto benchmark_read_ahead(benchmark::State& p_state) -> void
+	{
+		static const char* const labels[] = {"sequential", "four_cursors", "random"};
+		const std::vector<request> trace  = make_trace(static_cast<std::size_t>(p_state.range(0)));
+		cache_engine::async::thread_pool_executor executor(executor_threads);
+		cache_engine::async::read_ahead_stats totals;
+		std::size_t errors = 0;
+
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<read_ahead_cache_t> cache(new read_ahead_cache_t(
+				trace_length,
+				[&executor](const key_t& p_key) -> cache_engine::async::task<value_t>
+				{
+					const key_t key = p_key;
+					co_await executor.schedule();
+					round_trip();
+					co_return expected_value(key);
+				},
+				[&executor](key_t p_first, std::size_t p_count) -> cache_engine::async::task<std::vector<value_t>>
+				{
+					co_await executor.schedule();
+					round_trip();
+					std::vector<value_t> values(p_count);
+					for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+					{
+						values[idx_for] = expected_value(p_first + idx_for);
+					}
+					co_return values;
+				},
+				executor));
+			for (const request& next : trace)
+			{
+				errors += (cache_engine::async::sync_wait(cache->async_get(next.m_key, next.m_stream)) != expected_value(next.m_key)) ? 1U : 0U;
+			}
+			cache->wait_idle();
+
+			const cache_engine::async::read_ahead_stats stats = cache->stats();
+			totals.m_misses += stats.m_misses;
+			totals.m_batches += stats.m_batches;
+			totals.m_issued += stats.m_issued;
+			totals.m_useful += stats.m_useful;
+			totals.m_late += stats.m_late;
+			totals.m_wasted += stats.m_wasted;
+		}
+
+		if (errors != 0)
+		{
+			p_state.SkipWithError("async_get returned a wrong value");
+		}
+		p_state.SetLabel(labels[p_state.range(0)]);
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(trace.size()));
+		p_state.counters["misses"]		   = benchmark::Counter(static_cast<double>(totals.m_misses), benchmark::Counter::kAvgIterations);
+		p_state.counters["batches"]		   = benchmark::Counter(static_cast<double>(totals.m_batches), benchmark::Counter::kAvgIterations);
+		p_state.counters["late"]		   = benchmark::Counter(static_cast<double>(totals.m_late), benchmark::Counter::kAvgIterations);
+		p_state.counters["wasted"]		   = benchmark::Counter(static_cast<double>(totals.m_wasted), benchmark::Counter::kAvgIterations);
+		p_state.counters["accuracy"]	   = totals.accuracy();
+		p_state.counters["miss_reduction"] = 1.0 - static_cast<double>(totals.m_misses) / (static_cast<double>(p_state.iterations()) * static_cast<double>(distinct_keys(trace)));
+	}
+
+} // namespace cache_read_ahead
+
+BENCHMARK(cache_read_ahead::benchmark_async_cache)->Arg(0)->Arg(1)->Arg(2)->Iterations(2)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(cache_read_ahead::benchmark_read_ahead)->Arg(0)->Arg(1)->Arg(2)->Iterations(2)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
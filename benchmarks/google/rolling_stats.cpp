@@ -0,0 +1,114 @@
+/**
+ * @file rolling_stats.cpp
+ * @brief Cost of recording into rolling_stats from several threads, and of reading a window
+ *
+ * Each thread records a hit or miss per item through its own recorder;
+ * the baseline bumps shared atomic hit and miss counters, which is what
+ * cumulative counters shared by all threads cost. The read benchmark
+ * runs on a clock advanced by hand so that one recorder has filled all
+ * 15 minutes of buckets; a window read sums 16 slots of 900 buckets.
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cache_engine/stats/rolling_stats.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace cache_rolling
+{
+	using stats_t = cache_engine::stats::rolling_stats<>;
+
+	/**
+	 * @brief Clock the read benchmark moves by hand
+	 */
+	struct manual_clock
+	{
+		using rep						= std::int64_t;
+		using period					= std::nano;
+		using duration					= std::chrono::nanoseconds;
+		using time_point				= std::chrono::time_point<manual_clock>;
+		static constexpr bool is_steady = true;
+
+		static std::int64_t s_now;
+
+		static auto now() -> time_point { return time_point(duration(s_now)); }
+	};
+
+	std::int64_t manual_clock::s_now = 0;
+
+	constexpr std::size_t ops_per_batch = 1024;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto shared_stats() -> stats_t&;
+	auto benchmark_record_shared_atomics(benchmark::State& p_state) -> void;
+	auto benchmark_record_rolling(benchmark::State& p_state) -> void;
+	auto benchmark_read_window(benchmark::State& p_state) -> void;
+
+	auto shared_stats() -> stats_t&
+	{
+		static stats_t stats;
+		return stats;
+	}
+
+	auto benchmark_record_shared_atomics(benchmark::State& p_state) -> void
+	{
+		static std::atomic<std::uint64_t> hits(0);
+		static std::atomic<std::uint64_t> misses(0);
+		for (auto _ : p_state)
+		{
+			for (std::size_t idx_for = 0; idx_for < ops_per_batch; ++idx_for)
+			{
+				std::atomic<std::uint64_t>& counter = (idx_for % 8 == 0) ? misses : hits;
+				counter.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(ops_per_batch));
+	}
+
+	auto benchmark_record_rolling(benchmark::State& p_state) -> void
+	{
+		stats_t::recorder recorder = shared_stats().make_recorder();
+		for (auto _ : p_state)
+		{
+			for (std::size_t idx_for = 0; idx_for < ops_per_batch; ++idx_for)
+			{
+				if (idx_for % 8 == 0)
+				{
+					recorder.record_miss();
+				}
+				else
+				{
+					recorder.record_hit();
+				}
+			}
+		}
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(ops_per_batch));
+	}
+
+	auto benchmark_read_window(benchmark::State& p_state) -> void
+	{
+		std::unique_ptr<cache_engine::stats::rolling_stats<manual_clock>> stats(new cache_engine::stats::rolling_stats<manual_clock>());
+		{
+			cache_engine::stats::rolling_stats<manual_clock>::recorder recorder = stats->make_recorder();
+			for (std::size_t idx_second = 0; idx_second < 20 * 60; ++idx_second)
+			{
+				recorder.record_hit();
+				recorder.record_load(std::chrono::microseconds(200));
+				manual_clock::s_now += 1000000000;
+			}
+		}
+		for (auto _ : p_state)
+		{
+			benchmark::DoNotOptimize(stats->window(std::chrono::seconds(15 * 60)).m_load_p99);
+		}
+	}
+
+} // namespace cache_rolling
+
+BENCHMARK(cache_rolling::benchmark_record_shared_atomics)->Threads(1)->Threads(4)->UseRealTime();
+BENCHMARK(cache_rolling::benchmark_record_rolling)->Threads(1)->Threads(4)->UseRealTime();
+BENCHMARK(cache_rolling::benchmark_read_window)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,147 @@
+/**
+ * @file scan_resistance.cpp
+ * @brief Hit ratio of the working set under LRU and midpoint-insertion LRU when full scans run through the cache
+ *
+ * Each iteration replays a whole trace against a fresh policy_based_cache,
+ * caching every miss. The trace alternates Zipf(0.99) lookups over a hot
+ * set as large as the cache with, for Arg 1, a sequential scan of a
+ * table four times the cache capacity; the scan reads each key twice in a
+ * row, like rows sharing a page. The reported hit ratio counts working-set
+ * lookups only, so it shows how much of the hot set survives the scans.
+ * Arg 0 runs the same lookups without scans to show the policies' cost.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "workload.hpp"
+
+namespace cache_scan
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using lru_cache_t = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+														 cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+	using midpoint_cache_t =
+		cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::midpoint_lru_eviction, cache_engine::policy_templates::hash_storage,
+										 cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	constexpr std::size_t cache_capacity = 4096;
+	constexpr std::size_t hot_keys		 = cache_capacity;
+	constexpr std::size_t table_keys	 = cache_capacity * 4;
+	constexpr std::size_t lookups		 = cache_capacity * 4;
+	constexpr std::size_t rounds		 = 16;
+	constexpr key_t table_base			 = key_t(1) << 32U;
+
+	/**
+	 * @brief One request of the trace; scan reads do not count towards the hit ratio
+	 */
+	struct request
+	{
+		key_t m_key;
+		bool m_scan;
+	};
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto make_trace(bool p_with_scans) -> std::vector<request>;
+	template <typename cache_t, typename configure_t> auto run_trace(benchmark::State& p_state, const configure_t& p_configure) -> void;
+	auto benchmark_lru(benchmark::State& p_state) -> void;
+	auto benchmark_midpoint(benchmark::State& p_state) -> void;
+	auto benchmark_midpoint_scan_detection(benchmark::State& p_state) -> void;
+
+	auto make_trace(bool p_with_scans) -> std::vector<request>
+	{
+		cache_workload::zipf_sampler sampler(hot_keys);
+		std::vector<request> trace;
+		trace.reserve(rounds * (lookups + table_keys * 2));
+		for (std::size_t idx_round = 0; idx_round < rounds; ++idx_round)
+		{
+			for (std::size_t idx_for = 0; idx_for < lookups; ++idx_for)
+			{
+				// Spread ranks over the key space so that the hot set never looks monotonic
+				const request lookup = {static_cast<key_t>(sampler.next_rank()) * 0x9E3779B97F4A7C15ULL % table_base, false};
+				trace.push_back(lookup);
+			}
+			for (std::size_t idx_for = 0; p_with_scans && idx_for < table_keys; ++idx_for)
+			{
+				const request read = {table_base + idx_for, true};
+				trace.push_back(read);
+				trace.push_back(read);
+			}
+		}
+		return trace;
+	}
+
+	/**
+	 * @brief Replay the trace of range(0) through a fresh, configured cache per iteration
+	 */
+	template <typename cache_t, typename configure_t> auto run_trace(benchmark::State& p_state, const configure_t& p_configure) -> void
+	{
+		const std::vector<request> trace = make_trace(p_state.range(0) != 0);
+
+		std::size_t hits	 = 0;
+		std::size_t measured = 0;
+		for (auto _ : p_state)
+		{
+			std::unique_ptr<cache_t> cache(new cache_t(cache_capacity));
+			p_configure(*cache);
+			for (std::size_t idx_for = 0; idx_for < trace.size(); ++idx_for)
+			{
+				const request& next = trace[idx_for];
+				const bool hit		= cache->contains(next.m_key);
+				if (hit)
+				{
+					benchmark::DoNotOptimize(cache->get(next.m_key));
+				}
+				else
+				{
+					cache->put(next.m_key, next.m_key);
+				}
+
+				// The first round only warms the cache
+				if (!next.m_scan && idx_for >= lookups)
+				{
+					hits += hit ? 1U : 0U;
+					++measured;
+				}
+			}
+		}
+
+		p_state.SetLabel(p_state.range(0) != 0 ? "scans" : "no_scans");
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(trace.size()));
+		p_state.counters["hot_hit_ratio"] = static_cast<double>(hits) / static_cast<double>(measured);
+	}
+
+	auto benchmark_lru(benchmark::State& p_state) -> void
+	{
+		run_trace<lru_cache_t>(p_state, [](lru_cache_t&) {});
+	}
+
+	auto benchmark_midpoint(benchmark::State& p_state) -> void
+	{
+		// Dwell just long enough to ignore the back-to-back reads of one scan step
+		run_trace<midpoint_cache_t>(p_state,
+									[](midpoint_cache_t& p_cache)
+									{
+										p_cache.eviction_policy().set_min_dwell(std::chrono::microseconds(1));
+										p_cache.eviction_policy().set_scan_detection(0);
+									});
+	}
+
+	auto benchmark_midpoint_scan_detection(benchmark::State& p_state) -> void
+	{
+		run_trace<midpoint_cache_t>(p_state, [](midpoint_cache_t& p_cache) { p_cache.eviction_policy().set_min_dwell(std::chrono::microseconds(1)); });
+	}
+
+} // namespace cache_scan
+
+BENCHMARK(cache_scan::benchmark_lru)->Arg(0)->Arg(1)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_scan::benchmark_midpoint)->Arg(0)->Arg(1)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_scan::benchmark_midpoint_scan_detection)->Arg(0)->Arg(1)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
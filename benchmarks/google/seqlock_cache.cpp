@@ -0,0 +1,142 @@
+/**
+ * @file seqlock_cache.cpp
+ * @brief Read-mostly scaling of seqlock_cache against a mutex-wrapped LRU cache
+ *
+ * Every thread runs the same 99% get / 1% put mix over a shared cache whose
+ * working set fits, from one thread up to the hardware thread count. The
+ * baseline is the legacy cache<..., algorithm::lru> behind a single mutex,
+ * which is what callers have to do today to share a cache between threads.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/concurrent/seqlock_cache.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cache_seqlock
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::array<std::uint64_t, 4>;
+
+	using seqlock_cache_t = cache_engine::concurrent::seqlock_cache<key_t, value_t>;
+	using lru_cache_t	  = cache_engine::cache<key_t, value_t, cache_engine::algorithm::lru>;
+
+	constexpr std::size_t cache_capacity = 1U << 16U;
+	constexpr std::size_t key_space		 = cache_capacity / 2;
+	constexpr std::size_t ops_per_batch	 = 1024;
+	constexpr std::uint64_t write_every	 = 100;
+
+	/**
+	 * @brief Baseline: the single-threaded cache behind one mutex
+	 */
+	class locked_lru
+	{
+	  private:
+		mutable std::mutex m_mutex;
+		lru_cache_t m_cache;
+
+	  public:
+		explicit locked_lru(std::size_t p_capacity) : m_cache(p_capacity) {}
+
+		auto find(const key_t& p_key, value_t& p_value) -> bool
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_cache.contains(p_key))
+			{
+				return false;
+			}
+			p_value = m_cache.get(p_key);
+			return true;
+		}
+
+		auto put(const key_t& p_key, const value_t& p_value) -> void
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_cache.put(p_key, p_value);
+		}
+	};
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto max_threads() -> int;
+	auto make_value(key_t p_key) -> value_t;
+	template <typename shared_t> auto benchmark_read_mostly(benchmark::State& p_state, std::unique_ptr<shared_t>& p_shared) -> void;
+	auto benchmark_seqlock_read_mostly(benchmark::State& p_state) -> void;
+	auto benchmark_locked_lru_read_mostly(benchmark::State& p_state) -> void;
+
+	auto max_threads() -> int
+	{
+		const unsigned int hardware = std::thread::hardware_concurrency();
+		return (hardware == 0) ? 1 : static_cast<int>(hardware);
+	}
+
+	auto make_value(key_t p_key) -> value_t { return value_t{{p_key, p_key + 1, p_key + 2, p_key + 3}}; }
+
+	/**
+	 * @brief 99% reads, 1% writes over a shared cache; thread 0 owns setup and teardown
+	 */
+	template <typename shared_t> auto benchmark_read_mostly(benchmark::State& p_state, std::unique_ptr<shared_t>& p_shared) -> void
+	{
+		if (p_state.thread_index() == 0)
+		{
+			p_shared.reset(new shared_t(cache_capacity));
+			for (key_t idx_for = 0; idx_for < key_space; ++idx_for)
+			{
+				p_shared->put(idx_for, make_value(idx_for));
+			}
+		}
+
+		// xorshift64: cheap enough not to dominate a lock-free hit
+		std::uint64_t rng	= 0x9E3779B97F4A7C15ULL * (static_cast<std::uint64_t>(p_state.thread_index()) + 1U);
+		std::size_t hits	= 0;
+		std::size_t lookups = 0;
+		value_t value		= value_t();
+
+		for (auto _ : p_state)
+		{
+			for (std::size_t idx_for = 0; idx_for < ops_per_batch; ++idx_for)
+			{
+				rng ^= rng << 13U;
+				rng ^= rng >> 7U;
+				rng ^= rng << 17U;
+				const key_t key = rng % key_space;
+
+				if (rng % write_every == 0)
+				{
+					p_shared->put(key, make_value(key));
+				}
+				else
+				{
+					hits += p_shared->find(key, value) ? 1U : 0U;
+					++lookups;
+				}
+			}
+			benchmark::DoNotOptimize(value);
+		}
+
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(ops_per_batch));
+		p_state.counters["hit_ratio"] = benchmark::Counter((lookups == 0) ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups), benchmark::Counter::kAvgThreads);
+
+		if (p_state.thread_index() == 0)
+		{
+			p_shared.reset();
+		}
+	}
+
+	std::unique_ptr<seqlock_cache_t> g_seqlock_cache;
+	std::unique_ptr<locked_lru> g_locked_lru;
+
+	auto benchmark_seqlock_read_mostly(benchmark::State& p_state) -> void { benchmark_read_mostly(p_state, g_seqlock_cache); }
+
+	auto benchmark_locked_lru_read_mostly(benchmark::State& p_state) -> void { benchmark_read_mostly(p_state, g_locked_lru); }
+
+} // namespace cache_seqlock
+
+// Register read-mostly scaling benchmarks, 1 thread up to every hardware thread
+BENCHMARK(cache_seqlock::benchmark_seqlock_read_mostly)->ThreadRange(1, cache_seqlock::max_threads())->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(cache_seqlock::benchmark_locked_lru_read_mostly)->ThreadRange(1, cache_seqlock::max_threads())->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+/**
+ * @file sharded_lru.cpp
+ * @brief Hit ratio of a sharded LRU cache with independent and global eviction on skewed traces
+ *
+ * Each benchmark replays a trace against one cache, caching every miss,
+ * and reports the steady-state hit ratio after one warm-up pass. The
+ * single LRU is the reference the sharded caches try to match. Arg 0 is a
+ * Zipf(0.99) trace over keys spread evenly across shards; Arg 1 sends 90%
+ * of requests, Zipf-distributed, to keys of a quarter of the shards and
+ * the rest uniformly to the others, so independent shards waste most of
+ * their capacity on the cold shards.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/concurrent/sharded_lru_cache.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "workload.hpp"
+
+namespace cache_sharded
+{
+	using key_t	  = std::uint64_t;
+	using value_t = std::uint64_t;
+
+	using sharded_t = cache_engine::concurrent::sharded_lru_cache<key_t, value_t>;
+	using lru_t		= cache_engine::cache<key_t, value_t, cache_engine::algorithm::lru>;
+
+	constexpr std::size_t cache_capacity	 = 4096;
+	constexpr std::size_t shard_count		 = 16;
+	constexpr std::size_t key_space			 = cache_capacity * 10;
+	constexpr std::size_t trace_length		 = std::size_t(1) << 18U;
+	constexpr std::size_t accesses_per_batch = 1024;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto make_trace(std::size_t p_kind) -> std::vector<key_t>;
+	template <typename access_t> auto run_trace(benchmark::State& p_state, const access_t& p_access) -> void;
+	auto benchmark_single_lru(benchmark::State& p_state) -> void;
+	auto benchmark_sharded_independent(benchmark::State& p_state) -> void;
+	auto benchmark_sharded_global(benchmark::State& p_state) -> void;
+
+	auto make_trace(std::size_t p_kind) -> std::vector<key_t>
+	{
+		std::vector<key_t> trace;
+		trace.reserve(trace_length);
+
+		if (p_kind == 0)
+		{
+			cache_workload::zipf_sampler sampler(key_space);
+			for (std::size_t idx_for = 0; idx_for < trace_length; ++idx_for)
+			{
+				trace.push_back(static_cast<key_t>(sampler.next_rank()) * 0x9E3779B97F4A7C15ULL + 1U);
+			}
+			return trace;
+		}
+
+		// Split keys by the shard they land in; a probe cache has the same shard mapping
+		const sharded_t probe(cache_capacity, cache_engine::concurrent::shard_eviction::global, shard_count);
+		std::vector<key_t> hot_keys;
+		std::vector<key_t> cold_keys;
+		for (key_t key = 1; hot_keys.size() < key_space / 2 || cold_keys.size() < key_space / 2; ++key)
+		{
+			std::vector<key_t>& pool = probe.shard_index(key) < shard_count / 4 ? hot_keys : cold_keys;
+			if (pool.size() < key_space / 2)
+			{
+				pool.push_back(key);
+			}
+		}
+
+		cache_workload::zipf_sampler sampler(hot_keys.size());
+		for (std::size_t idx_for = 0; idx_for < trace_length; ++idx_for)
+		{
+			if (sampler.next_uniform() < 0.9)
+			{
+				trace.push_back(hot_keys[sampler.next_rank()]);
+			}
+			else
+			{
+				trace.push_back(cold_keys[static_cast<std::size_t>(sampler.next_uniform() * static_cast<double>(cold_keys.size())) % cold_keys.size()]);
+			}
+		}
+		return trace;
+	}
+
+	/**
+	 * @brief Replay the trace of range(0) through p_access(key) -> hit, after one warm-up pass
+	 */
+	template <typename access_t> auto run_trace(benchmark::State& p_state, const access_t& p_access) -> void
+	{
+		const std::vector<key_t> trace = make_trace(static_cast<std::size_t>(p_state.range(0)));
+		for (const key_t key : trace)
+		{
+			p_access(key);
+		}
+
+		std::size_t position = 0;
+		std::size_t hits	 = 0;
+		for (auto _ : p_state)
+		{
+			for (std::size_t idx_for = 0; idx_for < accesses_per_batch; ++idx_for)
+			{
+				hits += p_access(trace[position]) ? 1U : 0U;
+				position = position + 1 == trace.size() ? 0 : position + 1;
+			}
+		}
+
+		p_state.SetLabel(p_state.range(0) == 0 ? "zipf" : "hot_shards");
+		p_state.SetItemsProcessed(static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(accesses_per_batch));
+		p_state.counters["hit_ratio"] = static_cast<double>(hits) / (static_cast<double>(p_state.iterations()) * static_cast<double>(accesses_per_batch));
+	}
+
+	auto benchmark_single_lru(benchmark::State& p_state) -> void
+	{
+		std::unique_ptr<lru_t> cache(new lru_t(cache_capacity));
+		run_trace(p_state,
+				  [&cache](const key_t& p_key)
+				  {
+					  if (cache->contains(p_key))
+					  {
+						  benchmark::DoNotOptimize(cache->get(p_key));
+						  return true;
+					  }
+					  cache->put(p_key, p_key);
+					  return false;
+				  });
+	}
+
+	auto benchmark_sharded_independent(benchmark::State& p_state) -> void
+	{
+		std::unique_ptr<sharded_t> cache(new sharded_t(cache_capacity, cache_engine::concurrent::shard_eviction::independent, shard_count));
+		value_t value = 0;
+		run_trace(p_state,
+				  [&cache, &value](const key_t& p_key)
+				  {
+					  if (cache->find(p_key, value))
+					  {
+						  return true;
+					  }
+					  cache->put(p_key, p_key);
+					  return false;
+				  });
+	}
+
+	auto benchmark_sharded_global(benchmark::State& p_state) -> void
+	{
+		std::unique_ptr<sharded_t> cache(new sharded_t(cache_capacity, cache_engine::concurrent::shard_eviction::global, shard_count));
+		value_t value = 0;
+		run_trace(p_state,
+				  [&cache, &value](const key_t& p_key)
+				  {
+					  if (cache->find(p_key, value))
+					  {
+						  return true;
+					  }
+					  cache->put(p_key, p_key);
+					  return false;
+				  });
+		p_state.counters["cross_shard_evictions"] = static_cast<double>(cache->cross_shard_evictions());
+	}
+
+} // namespace cache_sharded
+
+BENCHMARK(cache_sharded::benchmark_single_lru)->Arg(0)->Arg(1);
+BENCHMARK(cache_sharded::benchmark_sharded_independent)->Arg(0)->Arg(1);
+BENCHMARK(cache_sharded::benchmark_sharded_global)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
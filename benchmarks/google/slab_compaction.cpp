@@ -0,0 +1,161 @@
+/**
+ * @file slab_compaction.cpp
+ * @brief RSS over a fill, shrink and compact cycle of slab_lru_cache against a node-based LRU
+ *
+ * Each run fills a cache with Arg entries (8-byte keys, 56-byte values),
+ * touches every tenth key, shrinks the capacity to a tenth and, for the
+ * slab cache, compacts in steps of 4096 moves. Counters report the RSS
+ * growth over the starting point after the fill, after the shrink and at
+ * a quarter, half, three quarters and the end of compaction, plus the
+ * mean step time. The node-based policy cache has no compaction, so its
+ * shrunk RSS is where it stays.
+ */
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/memory/slab_lru_cache.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <unistd.h>
+#include <vector>
+
+namespace cache_slab
+{
+	using key_t = std::uint64_t;
+
+	struct value_t
+	{
+		std::uint64_t m_words[7];
+	};
+
+	using slab_t = cache_engine::memory::slab_lru_cache<key_t, value_t>;
+	using node_t = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+													cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	constexpr std::size_t compact_budget = 4096;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto resident_bytes() -> std::size_t;
+	auto megabytes_over(std::size_t p_bytes, std::size_t p_base) -> double;
+	auto benchmark_slab_fill_shrink_compact(benchmark::State& p_state) -> void;
+	auto benchmark_node_fill_shrink(benchmark::State& p_state) -> void;
+
+	/**
+	 * @brief Current resident set size, 0 where unavailable
+	 */
+	auto resident_bytes() -> std::size_t
+	{
+#if defined(__linux__)
+		std::FILE* p_file = std::fopen("/proc/self/statm", "r");
+		if (p_file == nullptr)
+		{
+			return 0;
+		}
+		unsigned long total_pages	 = 0;
+		unsigned long resident_pages = 0;
+		const int fields			 = std::fscanf(p_file, "%lu %lu", &total_pages, &resident_pages);
+		std::fclose(p_file);
+		return (fields == 2) ? static_cast<std::size_t>(resident_pages) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+		return 0;
+#endif
+	}
+
+	auto megabytes_over(std::size_t p_bytes, std::size_t p_base) -> double { return p_bytes > p_base ? static_cast<double>(p_bytes - p_base) / (1024.0 * 1024.0) : 0.0; }
+
+	auto benchmark_slab_fill_shrink_compact(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		const value_t value		  = {{1, 2, 3, 4, 5, 6, 7}};
+		std::size_t base		  = 0;
+		std::size_t filled		  = 0;
+		std::size_t shrunk		  = 0;
+		std::array<std::size_t, 4> quarters{{0, 0, 0, 0}};
+		std::size_t steps	 = 0;
+		double step_seconds	 = 0.0;
+		std::size_t released = 0;
+
+		for (auto _ : p_state)
+		{
+			base = resident_bytes();
+			std::unique_ptr<slab_t> cache(new slab_t(entries));
+			for (std::size_t idx_for = 0; idx_for < entries; ++idx_for)
+			{
+				cache->put(static_cast<key_t>(idx_for), value);
+			}
+			for (std::size_t idx_for = 0; idx_for < entries; idx_for += 10)
+			{
+				benchmark::DoNotOptimize(cache->get(static_cast<key_t>(idx_for)));
+			}
+			filled = resident_bytes();
+
+			cache->set_capacity(entries / 10);
+			shrunk = resident_bytes();
+
+			std::vector<std::size_t> timeline;
+			const auto start = std::chrono::steady_clock::now();
+			for (bool done = false; !done;)
+			{
+				const cache_engine::memory::compaction_progress progress = cache->compact_step(compact_budget);
+				done													 = progress.m_done;
+				timeline.push_back(resident_bytes());
+			}
+			step_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			steps		 = timeline.size();
+			for (std::size_t idx_for = 0; idx_for < quarters.size(); ++idx_for)
+			{
+				quarters[idx_for] = timeline[(timeline.size() * (idx_for + 1)) / 4 - ((idx_for + 1 == quarters.size()) ? 1 : 0)];
+			}
+			released = cache->stats().m_released_blocks;
+		}
+
+		p_state.counters["rss_filled_mb"]	  = megabytes_over(filled, base);
+		p_state.counters["rss_shrunk_mb"]	  = megabytes_over(shrunk, base);
+		p_state.counters["rss_compact_25_mb"] = megabytes_over(quarters[0], base);
+		p_state.counters["rss_compact_50_mb"] = megabytes_over(quarters[1], base);
+		p_state.counters["rss_compact_75_mb"] = megabytes_over(quarters[2], base);
+		p_state.counters["rss_compacted_mb"]  = megabytes_over(quarters[3], base);
+		p_state.counters["steps"]			  = static_cast<double>(steps);
+		p_state.counters["us_per_step"]		  = steps == 0 ? 0.0 : step_seconds * 1e6 / static_cast<double>(steps);
+		p_state.counters["released_blocks"]	  = static_cast<double>(released);
+	}
+
+	auto benchmark_node_fill_shrink(benchmark::State& p_state) -> void
+	{
+		const std::size_t entries = static_cast<std::size_t>(p_state.range(0));
+		const value_t value		  = {{1, 2, 3, 4, 5, 6, 7}};
+		std::size_t base		  = 0;
+		std::size_t filled		  = 0;
+		std::size_t shrunk		  = 0;
+
+		for (auto _ : p_state)
+		{
+			base = resident_bytes();
+			std::unique_ptr<node_t> cache(new node_t(entries));
+			for (std::size_t idx_for = 0; idx_for < entries; ++idx_for)
+			{
+				cache->put(static_cast<key_t>(idx_for), value);
+			}
+			for (std::size_t idx_for = 0; idx_for < entries; idx_for += 10)
+			{
+				benchmark::DoNotOptimize(cache->get(static_cast<key_t>(idx_for)));
+			}
+			filled = resident_bytes();
+
+			cache->set_capacity(entries / 10);
+			shrunk = resident_bytes();
+		}
+
+		p_state.counters["rss_filled_mb"] = megabytes_over(filled, base);
+		p_state.counters["rss_shrunk_mb"] = megabytes_over(shrunk, base);
+	}
+
+} // namespace cache_slab
+
+BENCHMARK(cache_slab::benchmark_slab_fill_shrink_compact)->Arg(1000000)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(cache_slab::benchmark_node_fill_shrink)->Arg(1000000)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,365 @@
+/**
+ * @file type_matrix.cpp
+ * @brief Throughput and memory per entry across key types, value sizes, algorithms and storage policies
+ *
+ * The other benchmarks use small integer keys and small values. This matrix
+ * crosses five key types (int32, uint64, a 16-byte POD, 32- and 128-byte
+ * strings) with four value sizes (8 B, 256 B, 4 KB, 64 KB) and runs every
+ * combination against every legacy algorithm and every storage policy
+ * (under LRU eviction). Registrations are generated from the three type
+ * lists at startup, so adding a type to a list adds its whole row.
+ *
+ * Each run fills the cache, then does an 80/20 get/put mix over twice the
+ * capacity. Capacity shrinks with the value size so a 64 KB row stays near
+ * 32 MB. bytes_per_entry is the heap growth of the filled cache divided by
+ * its size, measured by counting operator new in this binary (glibc only);
+ * payload_per_entry is the key and value bytes that growth has to carry.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cache_engine/cache.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace cache_matrix
+{
+	std::atomic<std::size_t> g_live_bytes(0);
+} // namespace cache_matrix
+
+#if defined(__GLIBC__)
+// Count live heap bytes so bytes_per_entry includes node, bucket and allocator overhead
+auto operator new(std::size_t p_size) -> void*
+{
+	void* p_memory = std::malloc((p_size == 0) ? 1 : p_size);
+	if (p_memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	cache_matrix::g_live_bytes.fetch_add(malloc_usable_size(p_memory), std::memory_order_relaxed);
+	return p_memory;
+}
+
+auto operator delete(void* p_memory) noexcept -> void
+{
+	if (p_memory != nullptr)
+	{
+		cache_matrix::g_live_bytes.fetch_sub(malloc_usable_size(p_memory), std::memory_order_relaxed);
+		std::free(p_memory);
+	}
+}
+#endif
+
+namespace cache_matrix
+{
+	/**
+	 * @brief 16-byte trivially copyable key
+	 */
+	struct pod16_key
+	{
+		std::uint64_t m_high;
+		std::uint64_t m_low;
+
+		auto operator==(const pod16_key& p_other) const -> bool { return m_high == p_other.m_high && m_low == p_other.m_low; }
+	};
+} // namespace cache_matrix
+
+namespace std
+{
+	template <> struct hash<cache_matrix::pod16_key>
+	{
+		auto operator()(const cache_matrix::pod16_key& p_key) const noexcept -> std::size_t { return std::hash<std::uint64_t>()(p_key.m_high ^ (p_key.m_low * 0x9E3779B97F4A7C15ULL)); }
+	};
+} // namespace std
+
+namespace cache_matrix
+{
+	template <typename... types_t> struct type_list
+	{
+	};
+
+	constexpr std::size_t ops_per_batch	   = 1024;
+	constexpr std::size_t row_budget_bytes = 32U << 20U;
+	constexpr std::size_t min_capacity	   = 256;
+	constexpr std::size_t max_capacity	   = 4096;
+	constexpr std::uint64_t put_every	   = 5;
+
+	// Key kinds: type, label, payload size and a generator from an index
+
+	struct int32_keys
+	{
+		using type = std::int32_t;
+
+		static auto name() -> std::string { return "int32"; }
+
+		static auto payload_bytes() -> std::size_t { return sizeof(type); }
+
+		static auto make(std::uint64_t p_index) -> type { return static_cast<type>(p_index); }
+	};
+
+	struct uint64_keys
+	{
+		using type = std::uint64_t;
+
+		static auto name() -> std::string { return "uint64"; }
+
+		static auto payload_bytes() -> std::size_t { return sizeof(type); }
+
+		static auto make(std::uint64_t p_index) -> type { return p_index; }
+	};
+
+	struct pod16_keys
+	{
+		using type = pod16_key;
+
+		static auto name() -> std::string { return "pod16"; }
+
+		static auto payload_bytes() -> std::size_t { return sizeof(type); }
+
+		static auto make(std::uint64_t p_index) -> type { return pod16_key{p_index, ~p_index}; }
+	};
+
+	template <std::size_t length> struct string_keys
+	{
+		using type = std::string;
+
+		static auto name() -> std::string { return "string" + std::to_string(length); }
+
+		static auto payload_bytes() -> std::size_t { return length; }
+
+		// Fixed-length key with the index in its tail, so keys share a long common prefix
+		static auto make(std::uint64_t p_index) -> type
+		{
+			type key(length, 'k');
+			for (std::size_t idx_for = length; idx_for > 0 && p_index != 0; --idx_for)
+			{
+				key[idx_for - 1] = static_cast<char>('0' + static_cast<char>(p_index % 10U));
+				p_index /= 10U;
+			}
+			return key;
+		}
+	};
+
+	// Value kinds: fixed-size inline payloads
+
+	template <std::size_t bytes> struct blob_values
+	{
+		using type = std::array<unsigned char, bytes>;
+
+		static auto name() -> std::string { return (bytes >= 1024U) ? std::to_string(bytes / 1024U) + "KB" : std::to_string(bytes) + "B"; }
+
+		static auto payload_bytes() -> std::size_t { return bytes; }
+
+		static auto make(std::uint64_t p_index) -> type
+		{
+			type value;
+			value.fill(0xA5);
+			std::memcpy(value.data(), &p_index, std::min(sizeof(p_index), bytes));
+			return value;
+		}
+	};
+
+	// Cache kinds: every legacy algorithm, then every storage policy under LRU eviction
+
+	template <template <typename, typename> class storage_t> struct storage_kind
+	{
+		template <typename key_t, typename value_t>
+		using cache_t = cache_engine::policy_based_cache<key_t, value_t, cache_engine::policy_templates::lru_eviction, storage_t, cache_engine::policy_templates::update_on_access,
+														 cache_engine::policy_templates::fixed_capacity>;
+	};
+
+	struct legacy_lru
+	{
+		template <typename key_t, typename value_t> using cache_t = cache_engine::cache<key_t, value_t, cache_engine::algorithm::lru>;
+
+		static auto name() -> std::string { return "legacy_lru"; }
+	};
+
+	struct legacy_mru
+	{
+		template <typename key_t, typename value_t> using cache_t = cache_engine::cache<key_t, value_t, cache_engine::algorithm::mru>;
+
+		static auto name() -> std::string { return "legacy_mru"; }
+	};
+
+	struct legacy_fifo
+	{
+		template <typename key_t, typename value_t> using cache_t = cache_engine::cache<key_t, value_t, cache_engine::algorithm::fifo>;
+
+		static auto name() -> std::string { return "legacy_fifo"; }
+	};
+
+	struct legacy_lfu
+	{
+		template <typename key_t, typename value_t> using cache_t = cache_engine::cache<key_t, value_t, cache_engine::algorithm::lfu>;
+
+		static auto name() -> std::string { return "legacy_lfu"; }
+	};
+
+	struct legacy_mfu
+	{
+		template <typename key_t, typename value_t> using cache_t = cache_engine::cache<key_t, value_t, cache_engine::algorithm::mfu>;
+
+		static auto name() -> std::string { return "legacy_mfu"; }
+	};
+
+	struct legacy_random
+	{
+		template <typename key_t, typename value_t> using cache_t = cache_engine::cache<key_t, value_t, cache_engine::algorithm::random_cache>;
+
+		static auto name() -> std::string { return "legacy_random"; }
+	};
+
+	struct policy_hash : storage_kind<cache_engine::policy_templates::hash_storage>
+	{
+		static auto name() -> std::string { return "policy_hash"; }
+	};
+
+	struct policy_reserved_hash : storage_kind<cache_engine::policy_templates::reserved_hash_storage>
+	{
+		static auto name() -> std::string { return "policy_reserved_hash"; }
+	};
+
+	struct policy_compact : storage_kind<cache_engine::policy_templates::compact_storage>
+	{
+		static auto name() -> std::string { return "policy_compact"; }
+	};
+
+	struct policy_debug : storage_kind<cache_engine::policy_templates::debug_storage>
+	{
+		static auto name() -> std::string { return "policy_debug"; }
+	};
+
+	using key_kinds	  = type_list<int32_keys, uint64_keys, pod16_keys, string_keys<32>, string_keys<128>>;
+	using value_kinds = type_list<blob_values<8>, blob_values<256>, blob_values<4096>, blob_values<65536>>;
+	using cache_kinds =
+		type_list<legacy_lru, legacy_mru, legacy_fifo, legacy_lfu, legacy_mfu, legacy_random, policy_hash, policy_reserved_hash, policy_compact, policy_debug>;
+
+	// Declarations keep -Wmissing-declarations quiet for the registered functions
+	auto capacity_for(std::size_t p_value_bytes) -> std::size_t;
+	template <typename cache_kind_t, typename key_kind_t, typename value_kind_t> auto benchmark_matrix(benchmark::State& p_state) -> void;
+	template <typename cache_kind_t, typename key_kind_t, typename... value_kinds_t> auto register_values(type_list<value_kinds_t...>) -> void;
+	template <typename cache_kind_t, typename... key_kinds_t> auto register_keys(type_list<key_kinds_t...>) -> void;
+	template <typename... cache_kinds_t> auto register_caches(type_list<cache_kinds_t...>) -> void;
+	auto register_matrix() -> void;
+
+	auto capacity_for(std::size_t p_value_bytes) -> std::size_t { return std::max(min_capacity, std::min(max_capacity, row_budget_bytes / p_value_bytes)); }
+
+	/**
+	 * @brief Fill, then 80/20 get/put over twice the capacity; a miss on get becomes a put
+	 */
+	template <typename cache_kind_t, typename key_kind_t, typename value_kind_t> auto benchmark_matrix(benchmark::State& p_state) -> void
+	{
+		using key_t	  = typename key_kind_t::type;
+		using value_t = typename value_kind_t::type;
+		using cache_t = typename cache_kind_t::template cache_t<key_t, value_t>;
+
+		const std::size_t capacity	= capacity_for(value_kind_t::payload_bytes());
+		const std::size_t key_space = capacity * 2U;
+
+		std::vector<key_t> keys;
+		keys.reserve(key_space);
+		for (std::uint64_t idx_for = 0; idx_for < key_space; ++idx_for)
+		{
+			keys.push_back(key_kind_t::make(idx_for));
+		}
+		std::unique_ptr<value_t> value(new value_t(value_kind_t::make(0)));
+
+		const std::size_t live_before = g_live_bytes.load(std::memory_order_relaxed);
+		std::unique_ptr<cache_t> cache(new cache_t(capacity));
+		for (std::size_t idx_for = 0; idx_for < capacity; ++idx_for)
+		{
+			cache->put(keys[idx_for], *value);
+		}
+		const std::size_t live_after = g_live_bytes.load(std::memory_order_relaxed);
+
+		std::uint64_t rng = 0x9E3779B97F4A7C15ULL;
+		std::size_t hits  = 0;
+
+		for (auto _ : p_state)
+		{
+			for (std::size_t idx_for = 0; idx_for < ops_per_batch; ++idx_for)
+			{
+				rng ^= rng << 13U;
+				rng ^= rng >> 7U;
+				rng ^= rng << 17U;
+				const key_t& key = keys[(rng >> 8U) % key_space];
+
+				if (rng % put_every == 0 || !cache->contains(key))
+				{
+					cache->put(key, *value);
+				}
+				else
+				{
+					benchmark::DoNotOptimize(cache->get(key));
+					++hits;
+				}
+			}
+		}
+
+		const std::int64_t operations = static_cast<std::int64_t>(p_state.iterations()) * static_cast<std::int64_t>(ops_per_batch);
+		p_state.SetItemsProcessed(operations);
+		p_state.SetBytesProcessed(operations * static_cast<std::int64_t>(value_kind_t::payload_bytes()));
+		p_state.counters["capacity"]		  = static_cast<double>(capacity);
+		p_state.counters["hit_ratio"]		  = static_cast<double>(hits) / static_cast<double>(operations);
+		p_state.counters["payload_per_entry"] = static_cast<double>(key_kind_t::payload_bytes() + value_kind_t::payload_bytes());
+#if defined(__GLIBC__)
+		p_state.counters["bytes_per_entry"] = static_cast<double>(live_after - live_before) / static_cast<double>(capacity);
+#else
+		static_cast<void>(live_after - live_before);
+#endif
+	}
+
+	template <typename cache_kind_t, typename key_kind_t, typename... value_kinds_t> auto register_values(type_list<value_kinds_t...>) -> void
+	{
+		const int expand[] = {0, (benchmark::RegisterBenchmark(("matrix/" + cache_kind_t::name() + "/" + key_kind_t::name() + "/" + value_kinds_t::name()).c_str(),
+															   &benchmark_matrix<cache_kind_t, key_kind_t, value_kinds_t>)
+									  ->Unit(benchmark::kMicrosecond),
+								  0)...};
+		static_cast<void>(expand);
+	}
+
+	template <typename cache_kind_t, typename... key_kinds_t> auto register_keys(type_list<key_kinds_t...>) -> void
+	{
+		const int expand[] = {0, (register_values<cache_kind_t, key_kinds_t>(value_kinds()), 0)...};
+		static_cast<void>(expand);
+	}
+
+	template <typename... cache_kinds_t> auto register_caches(type_list<cache_kinds_t...>) -> void
+	{
+		const int expand[] = {0, (register_keys<cache_kinds_t>(key_kinds()), 0)...};
+		static_cast<void>(expand);
+	}
+
+	/**
+	 * @brief Register cache_kinds x key_kinds x value_kinds, named matrix/<cache>/<key>/<value>
+	 */
+	auto register_matrix() -> void { register_caches(cache_kinds()); }
+
+} // namespace cache_matrix
+
+// Registration is generated at startup, so main replaces BENCHMARK_MAIN
+auto main(int p_argc, char** p_argv) -> int
+{
+	cache_matrix::register_matrix();
+	benchmark::Initialize(&p_argc, p_argv);
+	if (benchmark::ReportUnrecognizedArguments(p_argc, p_argv))
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
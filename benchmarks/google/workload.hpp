@@ -0,0 +1,57 @@
+// File: benchmarks/google/workload.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cache_workload
+{
+	/**
+	 * @brief Draws ranks 0..n-1 with probability proportional to 1 / (rank + 1)^0.99
+	 *
+	 * Every sampler starts from the same seed, so a benchmark replays the
+	 * same trace on every run.
+	 */
+	class zipf_sampler
+	{
+	  private:
+		std::vector<double> m_cdf;
+		std::uint64_t m_state;
+
+	  public:
+		explicit zipf_sampler(std::size_t p_count) : m_cdf(p_count), m_state(0x9E3779B97F4A7C15ULL)
+		{
+			double total = 0.0;
+			for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+			{
+				total += 1.0 / std::pow(static_cast<double>(idx_for + 1), 0.99);
+				m_cdf[idx_for] = total;
+			}
+			for (double& bound : m_cdf)
+			{
+				bound /= total;
+			}
+		}
+
+		/**
+		 * @brief Draw a uniform number in [0, 1) from the sampler's generator
+		 */
+		auto next_uniform() -> double
+		{
+			m_state ^= m_state << 13U;
+			m_state ^= m_state >> 7U;
+			m_state ^= m_state << 17U;
+			return static_cast<double>(m_state >> 11U) / 9007199254740992.0;
+		}
+
+		auto next_rank() -> std::size_t
+		{
+			const auto bound = std::lower_bound(m_cdf.begin(), m_cdf.end(), this->next_uniform());
+			return std::min(static_cast<std::size_t>(bound - m_cdf.begin()), m_cdf.size() - 1);
+		}
+	};
+} // namespace cache_workload
@@ -1,384 +1,835 @@
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "cache_engine/cache.hpp"
-
+#include "cache_engine/concurrent/clock_cache.hpp"
+#include "cache_engine/policies/all_policies.hpp"
+
+/**
+ * cache_benchmark: configurable load driver
+ *
+ * Runs one cache configuration under a synthetic load and prints a JSON
+ * result. Every knob is a --name=value flag (see --help), so capacity,
+ * distribution and mix experiments need no recompile. Keys are uint64,
+ * values are strings of --value-size bytes. Each thread draws its keys from
+ * its own RNG seeded from --seed, so a run is reproducible. Operations are
+ * timed in batches of --batch calls to keep clock reads out of the numbers.
+ * The legacy and policy caches are not thread-safe; with more than one
+ * thread they run behind a single mutex, as a caller would have to.
+ */
 namespace benchmark
 {
-	// Constants for formatting and calculations
-	constexpr std::size_t algorithm_width	= 10;
-	constexpr std::size_t hit_rate_width	= 12;
-	constexpr std::size_t throughput_width	= 15;
-	constexpr std::size_t separator_width	= 52;
-	constexpr double percentage_multiplier	= 100.0;
-	constexpr double nanoseconds_per_second = 1e9;
-	constexpr int precision_decimal			= 1;
-	constexpr int precision_integer			= 0;
-
-	struct cache_stats
-	{
-	private:
-		std::size_t m_hits						  = 0;
-		std::size_t m_misses					  = 0;
-		std::chrono::nanoseconds m_total_put_time = std::chrono::nanoseconds::zero();
-		std::chrono::nanoseconds m_total_get_time = std::chrono::nanoseconds::zero();
-		std::size_t m_put_operations			  = 0;
-		std::size_t m_get_operations			  = 0;
-
-	public:
-		auto increment_hits() -> void { m_hits++; }
-
-		auto increment_misses() -> void { m_misses++; }
+	using key_t	  = std::uint64_t;
+	using value_t = std::string;
 
-		auto increment_put_operations() -> void { m_put_operations++; }
+	constexpr int json_precision = 6;
 
-		auto increment_get_operations() -> void { m_get_operations++; }
-
-		auto add_put_time(std::chrono::nanoseconds p_time) -> void { m_total_put_time += p_time; }
+	/**
+	 * @brief Parsed command line; defaults give a short single-threaded LRU run
+	 */
+	struct driver_options
+	{
+		std::string m_engine	   = "legacy";
+		std::string m_algorithm	   = "lru";
+		std::string m_eviction	   = "lru";
+		std::string m_storage	   = "hash";
+		std::string m_access	   = "update";
+		std::size_t m_capacity	   = 10000;
+		std::size_t m_key_range	   = 50000;
+		std::string m_distribution = "uniform";
+		double m_zipf_theta		   = 0.99;
+		double m_read_ratio		   = 0.9;
+		bool m_fill_on_miss		   = true;
+		std::size_t m_threads	   = 1;
+		double m_duration_seconds  = 0.0;
+		std::size_t m_operations   = 10000000;
+		std::size_t m_warmup	   = 100000;
+		std::size_t m_batch		   = 1024;
+		std::size_t m_value_size   = 16;
+		std::uint64_t m_seed	   = 42;
+		std::string m_output;
+		bool m_help = false;
+
+		// Out of line: -Winline rejects inlining seven string members at every call site
+		driver_options();
+		~driver_options();
+		driver_options(const driver_options&) = default;
+	};
 
-		auto add_get_time(std::chrono::nanoseconds p_time) -> void { m_total_get_time += p_time; }
+	driver_options::driver_options()  = default;
+	driver_options::~driver_options() = default;
 
-		auto get_hits() const -> std::size_t { return m_hits; }
+	/**
+	 * @brief Counters and batch timings gathered by one worker thread
+	 */
+	struct worker_result
+	{
+		std::size_t m_gets		 = 0;
+		std::size_t m_hits		 = 0;
+		std::size_t m_puts		 = 0;
+		std::size_t m_operations = 0;
+		std::vector<double> m_batch_ns_per_op;
+	};
 
-		auto get_misses() const -> std::size_t { return m_misses; }
+	/**
+	 * @brief Aggregate of one measured run
+	 */
+	struct load_result
+	{
+		std::size_t m_gets		 = 0;
+		std::size_t m_hits		 = 0;
+		std::size_t m_puts		 = 0;
+		std::size_t m_operations = 0;
+		std::size_t m_final_size = 0;
+		double m_elapsed_seconds = 0.0;
+		std::vector<double> m_batch_ns_per_op;
+	};
 
-		auto hit_rate() const -> double
+	/**
+	 * @brief Zipfian constants (Gray et al., as in YCSB); the O(key_range) zeta sum is computed once
+	 */
+	class zipf_constants
+	{
+	  private:
+		std::uint64_t m_range;
+		double m_theta;
+		double m_alpha;
+		double m_zeta_n;
+		double m_eta;
+
+	  public:
+		zipf_constants(std::uint64_t p_range, double p_theta) : m_range(p_range), m_theta(p_theta), m_alpha(1.0 / (1.0 - p_theta)), m_zeta_n(0.0), m_eta(0.0)
 		{
-			if (m_hits + m_misses == 0)
+			for (std::uint64_t idx_for = 1; idx_for <= p_range; ++idx_for)
 			{
-				return 0.0;
+				m_zeta_n += 1.0 / std::pow(static_cast<double>(idx_for), p_theta);
 			}
-			return static_cast<double>(m_hits) / static_cast<double>(m_hits + m_misses);
+			const double zeta_2 = 1.0 + 1.0 / std::pow(2.0, p_theta);
+			m_eta				= (1.0 - std::pow(2.0 / static_cast<double>(p_range), 1.0 - p_theta)) / (1.0 - zeta_2 / m_zeta_n);
 		}
 
-		auto avg_put_time_ns() const -> double
+		/**
+		 * @brief Map a uniform draw in [0, 1) to a rank in [0, range), rank 0 the hottest
+		 */
+		auto rank(double p_uniform) const -> std::uint64_t
 		{
-			if (m_put_operations == 0)
+			const double scaled = p_uniform * m_zeta_n;
+			if (scaled < 1.0)
 			{
-				return 0.0;
+				return 0;
 			}
-			return static_cast<double>(m_total_put_time.count()) / static_cast<double>(m_put_operations);
-		}
-
-		auto avg_get_time_ns() const -> double
-		{
-			if (m_get_operations == 0)
+			if (scaled < 1.0 + std::pow(0.5, m_theta))
 			{
-				return 0.0;
+				return 1;
 			}
-			return static_cast<double>(m_total_get_time.count()) / static_cast<double>(m_get_operations);
+			const auto rank_value = static_cast<std::uint64_t>(static_cast<double>(m_range) * std::pow(m_eta * p_uniform - m_eta + 1.0, m_alpha));
+			return std::min(rank_value, m_range - 1);
 		}
+	};
 
-		auto put_throughput_ops_per_sec() const -> double
+	/**
+	 * @brief Per-thread key stream: uniform, zipf or sequential over [0, key_range)
+	 */
+	class key_generator
+	{
+	  private:
+		enum class distribution
+		{
+			uniform,
+			zipf,
+			sequential
+		};
+
+		distribution m_kind;
+		std::uint64_t m_range;
+		std::uint64_t m_next;
+		std::mt19937_64 m_rng;
+		std::uniform_int_distribution<std::uint64_t> m_uniform;
+		std::uniform_real_distribution<double> m_unit;
+		const zipf_constants* m_zipf;
+
+	  public:
+		key_generator(const driver_options& p_options, const zipf_constants* p_zipf, std::uint64_t p_seed, std::uint64_t p_offset)
+			: m_kind(distribution::uniform), m_range(p_options.m_key_range), m_next(p_offset % p_options.m_key_range), m_rng(p_seed), m_uniform(0, p_options.m_key_range - 1),
+			  m_unit(0.0, 1.0), m_zipf(p_zipf)
 		{
-			if (m_total_put_time.count() == 0)
+			if (p_options.m_distribution == "zipf")
 			{
-				return 0.0;
+				m_kind = distribution::zipf;
+			}
+			else if (p_options.m_distribution == "sequential")
+			{
+				m_kind = distribution::sequential;
 			}
-			return static_cast<double>(m_put_operations) * nanoseconds_per_second / static_cast<double>(m_total_put_time.count());
 		}
 
-		auto get_throughput_ops_per_sec() const -> double
+		auto next() -> key_t
 		{
-			if (m_total_get_time.count() == 0)
+			switch (m_kind)
 			{
-				return 0.0;
+				case distribution::zipf:
+					return m_zipf->rank(m_unit(m_rng));
+				case distribution::sequential:
+				{
+					const key_t key = m_next;
+					m_next			= (m_next + 1 == m_range) ? 0 : m_next + 1;
+					return key;
+				}
+				case distribution::uniform:
+				default:
+					return m_uniform(m_rng);
 			}
-			return static_cast<double>(m_get_operations) * nanoseconds_per_second / static_cast<double>(m_total_get_time.count());
 		}
+
+		auto draw_unit() -> double { return m_unit(m_rng); }
 	};
 
-	struct data_size_t
+	/**
+	 * @brief Single-threaded cache behind an optional mutex, probed through its public API
+	 */
+	template <typename cache_t> class locked_cache
 	{
-	private:
-		std::size_t m_value;
+	  private:
+		std::mutex m_mutex;
+		bool m_locked;
+		cache_t m_cache;
 
-	public:
-		explicit data_size_t(std::size_t p_value) : m_value(p_value) {}
+	  public:
+		locked_cache(std::size_t p_capacity, bool p_locked) : m_locked(p_locked), m_cache(p_capacity) {}
 
-		operator std::size_t() const { return m_value; }
+		auto find(const key_t& p_key, value_t& p_value) -> bool
+		{
+			std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+			if (m_locked)
+			{
+				lock.lock();
+			}
+			if (!m_cache.contains(p_key))
+			{
+				return false;
+			}
+			p_value = m_cache.get(p_key);
+			return true;
+		}
 
-		auto operator++() -> data_size_t&
+		auto put(const key_t& p_key, const value_t& p_value) -> void
 		{
-			++m_value;
-			return *this;
+			std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+			if (m_locked)
+			{
+				lock.lock();
+			}
+			m_cache.put(p_key, p_value);
 		}
 
-		auto operator++(int) -> data_size_t
+		auto size() -> std::size_t
 		{
-			data_size_t temp(*this);
-			++m_value;
-			return temp;
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_cache.size();
 		}
 	};
 
-	struct key_range_t
+	/**
+	 * @brief The concurrent CLOCK cache is already thread-safe
+	 */
+	class clock_adapter
 	{
-	private:
-		std::size_t m_value;
+	  private:
+		cache_engine::concurrent::clock_cache<key_t, value_t> m_cache;
+
+	  public:
+		clock_adapter(std::size_t p_capacity, bool) : m_cache(p_capacity) {}
 
-	public:
-		explicit key_range_t(std::size_t p_value) : m_value(p_value) {}
+		auto find(const key_t& p_key, value_t& p_value) -> bool { return m_cache.find(p_key, p_value); }
 
-		operator std::size_t() const { return m_value; }
+		auto put(const key_t& p_key, const value_t& p_value) -> void { m_cache.put(p_key, p_value); }
+
+		auto size() -> std::size_t { return m_cache.size(); }
 	};
 
 	namespace
 	{
-		template <typename cache_t>
-		auto benchmark_cache(cache_t& p_cache, const std::vector<std::pair<int, std::string>>& p_operations, const std::vector<int>& p_get_keys, const std::string& p_algorithm_name)
-			-> cache_stats
+		auto print_usage(std::ostream& p_stream) -> void
 		{
-			cache_stats stats;
+			p_stream << "Usage: cache_benchmark [--name=value ...]\n"
+					 << "  --engine=legacy|policy|clock                            cache implementation (default legacy)\n"
+					 << "  --algorithm=lru|mru|fifo|lfu|mfu|random                 legacy algorithm (default lru)\n"
+					 << "  --eviction=lru|mru|fifo|lfu|mfu|random|sampled_lfu      policy eviction (default lru)\n"
+					 << "  --storage=hash|reserved_hash|compact|debug              policy storage (default hash)\n"
+					 << "  --access=update|none                                    policy access (default update)\n"
+					 << "  --capacity=N                                            entries (default 10000)\n"
+					 << "  --key-range=N                                           distinct keys (default 50000)\n"
+					 << "  --distribution=uniform|zipf|sequential                  key distribution (default uniform)\n"
+					 << "  --zipf-theta=X                                          zipf skew, 0 < X < 1 (default 0.99)\n"
+					 << "  --read-ratio=X                                          fraction of gets, 0..1 (default 0.9)\n"
+					 << "  --fill-on-miss=0|1                                      put after a get miss (default 1)\n"
+					 << "  --threads=N                                             worker threads (default 1)\n"
+					 << "  --duration=SECONDS                                      run for a time instead of --ops\n"
+					 << "  --ops=N                                                 total measured operations (default 10000000)\n"
+					 << "  --warmup=N                                              unmeasured operations per thread (default 100000)\n"
+					 << "  --batch=N                                               operations per timed batch (default 1024)\n"
+					 << "  --value-size=N                                          value bytes (default 16)\n"
+					 << "  --seed=N                                                RNG seed (default 42)\n"
+					 << "  --output=PATH                                           write JSON to PATH instead of stdout\n";
+		}
 
-			std::cout << "Benchmarking " << p_algorithm_name << " cache..." << '\n';
-			for (const auto& operation : p_operations)
+		auto parse_unsigned(const std::string& p_name, const std::string& p_text) -> std::uint64_t
+		{
+			std::size_t consumed	 = 0;
+			unsigned long long value = 0;
+			try
 			{
-				const auto put_start = std::chrono::high_resolution_clock::now();
-				p_cache.put(operation.first, operation.second);
-				const auto put_end = std::chrono::high_resolution_clock::now();
+				value = std::stoull(p_text, &consumed);
+			}
+			catch (const std::exception&)
+			{
+				throw std::invalid_argument("--" + p_name + " expects an unsigned integer, got '" + p_text + "'");
+			}
+			if (consumed != p_text.size() || p_text.find('-') != std::string::npos)
+			{
+				throw std::invalid_argument("--" + p_name + " expects an unsigned integer, got '" + p_text + "'");
+			}
+			return static_cast<std::uint64_t>(value);
+		}
 
-				stats.add_put_time(std::chrono::duration_cast<std::chrono::nanoseconds>(put_end - put_start));
-				stats.increment_put_operations();
+		auto parse_real(const std::string& p_name, const std::string& p_text) -> double
+		{
+			std::size_t consumed = 0;
+			double value		 = 0.0;
+			try
+			{
+				value = std::stod(p_text, &consumed);
+			}
+			catch (const std::exception&)
+			{
+				throw std::invalid_argument("--" + p_name + " expects a number, got '" + p_text + "'");
 			}
+			if (consumed != p_text.size())
+			{
+				throw std::invalid_argument("--" + p_name + " expects a number, got '" + p_text + "'");
+			}
+			return value;
+		}
 
-			for (const auto& key : p_get_keys)
+		auto parse_options(int p_argc, char** p_argv) -> driver_options
+		{
+			driver_options options;
+
+			for (int idx_for = 1; idx_for < p_argc; ++idx_for)
 			{
-				const auto get_start = std::chrono::high_resolution_clock::now();
-				try
+				const std::string argument(p_argv[idx_for]);
+				if (argument == "--help" || argument == "-h")
 				{
-					p_cache.get(key);
-					stats.increment_hits();
+					options.m_help = true;
+					continue;
 				}
-				catch (const std::out_of_range&)
+
+				const std::size_t equals = argument.find('=');
+				if (argument.compare(0, 2, "--") != 0 || equals == std::string::npos)
 				{
-					stats.increment_misses();
+					throw std::invalid_argument("Expected --name=value, got '" + argument + "'");
 				}
-				const auto get_end = std::chrono::high_resolution_clock::now();
+				const std::string name	= argument.substr(2, equals - 2);
+				const std::string value = argument.substr(equals + 1);
 
-				stats.add_get_time(std::chrono::duration_cast<std::chrono::nanoseconds>(get_end - get_start));
-				stats.increment_get_operations();
+				if (name == "engine")
+				{
+					options.m_engine = value;
+				}
+				else if (name == "algorithm")
+				{
+					options.m_algorithm = value;
+				}
+				else if (name == "eviction")
+				{
+					options.m_eviction = value;
+				}
+				else if (name == "storage")
+				{
+					options.m_storage = value;
+				}
+				else if (name == "access")
+				{
+					options.m_access = value;
+				}
+				else if (name == "capacity")
+				{
+					options.m_capacity = static_cast<std::size_t>(parse_unsigned(name, value));
+				}
+				else if (name == "key-range")
+				{
+					options.m_key_range = static_cast<std::size_t>(parse_unsigned(name, value));
+				}
+				else if (name == "distribution")
+				{
+					options.m_distribution = value;
+				}
+				else if (name == "zipf-theta")
+				{
+					options.m_zipf_theta = parse_real(name, value);
+				}
+				else if (name == "read-ratio")
+				{
+					options.m_read_ratio = parse_real(name, value);
+				}
+				else if (name == "fill-on-miss")
+				{
+					options.m_fill_on_miss = parse_unsigned(name, value) != 0;
+				}
+				else if (name == "threads")
+				{
+					options.m_threads = static_cast<std::size_t>(parse_unsigned(name, value));
+				}
+				else if (name == "duration")
+				{
+					options.m_duration_seconds = parse_real(name, value);
+				}
+				else if (name == "ops")
+				{
+					options.m_operations = static_cast<std::size_t>(parse_unsigned(name, value));
+				}
+				else if (name == "warmup")
+				{
+					options.m_warmup = static_cast<std::size_t>(parse_unsigned(name, value));
+				}
+				else if (name == "batch")
+				{
+					options.m_batch = static_cast<std::size_t>(parse_unsigned(name, value));
+				}
+				else if (name == "value-size")
+				{
+					options.m_value_size = static_cast<std::size_t>(parse_unsigned(name, value));
+				}
+				else if (name == "seed")
+				{
+					options.m_seed = parse_unsigned(name, value);
+				}
+				else if (name == "output")
+				{
+					options.m_output = value;
+				}
+				else
+				{
+					throw std::invalid_argument("Unknown flag --" + name);
+				}
+			}
+
+			if (options.m_capacity == 0 || options.m_key_range == 0 || options.m_threads == 0 || options.m_batch == 0)
+			{
+				throw std::invalid_argument("--capacity, --key-range, --threads and --batch must be greater than zero");
+			}
+			if (options.m_read_ratio < 0.0 || options.m_read_ratio > 1.0)
+			{
+				throw std::invalid_argument("--read-ratio must be within [0, 1]");
+			}
+			if (options.m_distribution != "uniform" && options.m_distribution != "zipf" && options.m_distribution != "sequential")
+			{
+				throw std::invalid_argument("Unknown --distribution '" + options.m_distribution + "'");
+			}
+			if (options.m_distribution == "zipf" && (options.m_zipf_theta <= 0.0 || options.m_zipf_theta >= 1.0))
+			{
+				throw std::invalid_argument("--zipf-theta must be within (0, 1)");
+			}
+			if (options.m_duration_seconds < 0.0)
+			{
+				throw std::invalid_argument("--duration must not be negative");
 			}
 
-			return stats;
+			return options;
 		}
 
-		auto generate_test_data(data_size_t p_size, key_range_t p_key_range) -> std::vector<std::pair<int, std::string>>
+		// splitmix64: decorrelates the per-thread seeds derived from --seed
+		auto thread_seed(std::uint64_t p_seed, std::size_t p_thread) -> std::uint64_t
 		{
-			std::vector<std::pair<int, std::string>> data;
-			std::random_device random_device;
-			std::mt19937 gen(random_device());
-			std::uniform_int_distribution<int> dis(1, static_cast<int>(p_key_range));
+			std::uint64_t mixed = p_seed + 0x9E3779B97F4A7C15ULL * (static_cast<std::uint64_t>(p_thread) + 1U);
+			mixed				= (mixed ^ (mixed >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+			mixed				= (mixed ^ (mixed >> 27U)) * 0x94D049BB133111EBULL;
+			return mixed ^ (mixed >> 31U);
+		}
 
-			data.reserve(p_size);
-			for (std::size_t idx_for = 0; idx_for < p_size; ++idx_for)
+		/**
+		 * @brief One get-or-put step of the configured mix
+		 */
+		template <typename adapter_t>
+		auto run_operation(adapter_t& p_cache, key_generator& p_keys, const driver_options& p_options, const value_t& p_value, value_t& p_scratch, worker_result& p_result) -> void
+		{
+			const key_t key = p_keys.next();
+			if (p_keys.draw_unit() < p_options.m_read_ratio)
 			{
-				const int key			= dis(gen);
-				const std::string value = "value_" + std::to_string(key);
-				data.emplace_back(key, value);
+				++p_result.m_gets;
+				if (p_cache.find(key, p_scratch))
+				{
+					++p_result.m_hits;
+				}
+				else if (p_options.m_fill_on_miss)
+				{
+					p_cache.put(key, p_value);
+					++p_result.m_puts;
+				}
+			}
+			else
+			{
+				p_cache.put(key, p_value);
+				++p_result.m_puts;
 			}
-
-			return data;
 		}
 
-		auto generate_get_keys(data_size_t p_size, key_range_t p_key_range) -> std::vector<int>
+		/**
+		 * @brief Warm up, wait for the start signal, then run timed batches until the op budget or deadline
+		 */
+		template <typename adapter_t>
+		auto run_worker(adapter_t& p_cache, const driver_options& p_options, const zipf_constants* p_zipf, std::size_t p_thread, std::atomic<std::size_t>& p_ready,
+						const std::atomic<bool>& p_start, std::chrono::steady_clock::time_point& p_deadline, worker_result& p_result) -> void
 		{
-			std::vector<int> keys;
-			std::random_device random_device;
-			std::mt19937 gen(random_device());
-			std::uniform_int_distribution<int> dis(1, static_cast<int>(p_key_range));
+			key_generator keys(p_options, p_zipf, thread_seed(p_options.m_seed, p_thread), p_thread * (p_options.m_key_range / p_options.m_threads));
+			const value_t value(p_options.m_value_size, 'v');
+			value_t scratch;
 
-			keys.reserve(p_size);
-			for (std::size_t idx_for = 0; idx_for < p_size; ++idx_for)
+			worker_result warmup;
+			for (std::size_t idx_for = 0; idx_for < p_options.m_warmup; ++idx_for)
 			{
-				keys.push_back(dis(gen));
+				run_operation(p_cache, keys, p_options, value, scratch, warmup);
 			}
 
-			return keys;
+			p_ready.fetch_add(1);
+			while (!p_start.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+
+			const bool timed_run	 = p_options.m_duration_seconds > 0.0;
+			const std::size_t budget = p_options.m_operations / p_options.m_threads + ((p_thread < p_options.m_operations % p_options.m_threads) ? 1U : 0U);
+			std::size_t remaining	 = budget;
+
+			while (timed_run || remaining > 0)
+			{
+				const std::size_t batch_size = timed_run ? p_options.m_batch : std::min(remaining, p_options.m_batch);
+				const auto batch_start		 = std::chrono::steady_clock::now();
+				for (std::size_t idx_for = 0; idx_for < batch_size; ++idx_for)
+				{
+					run_operation(p_cache, keys, p_options, value, scratch, p_result);
+				}
+				const auto batch_end = std::chrono::steady_clock::now();
+
+				p_result.m_operations += batch_size;
+				p_result.m_batch_ns_per_op.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(batch_end - batch_start).count()) /
+													 static_cast<double>(batch_size));
+
+				if (timed_run)
+				{
+					if (batch_end >= p_deadline)
+					{
+						break;
+					}
+				}
+				else
+				{
+					remaining -= batch_size;
+				}
+			}
 		}
 
-		auto print_results(const std::string& p_algorithm, const cache_stats& p_stats) -> void
+		/**
+		 * @brief Build the cache, run every worker and merge their results
+		 */
+		template <typename adapter_t> auto run_load(const driver_options& p_options) -> load_result
 		{
-			std::cout << std::fixed << std::setprecision(2);
-			std::cout << "=== " << p_algorithm << " Results ===" << '\n';
-			std::cout << "Hit Rate: " << (p_stats.hit_rate() * percentage_multiplier) << "%" << '\n';
-			std::cout << "Cache Hits: " << p_stats.get_hits() << ", Misses: " << p_stats.get_misses() << '\n';
-			std::cout << "Avg PUT time: " << p_stats.avg_put_time_ns() << " ns" << '\n';
-			std::cout << "Avg GET time: " << p_stats.avg_get_time_ns() << " ns" << '\n';
-			std::cout << "PUT throughput: " << p_stats.put_throughput_ops_per_sec() << " ops/sec" << '\n';
-			std::cout << "GET throughput: " << p_stats.get_throughput_ops_per_sec() << " ops/sec" << '\n';
-			std::cout << '\n';
+			std::unique_ptr<adapter_t> cache(new adapter_t(p_options.m_capacity, p_options.m_threads > 1));
+			std::unique_ptr<zipf_constants> zipf;
+			if (p_options.m_distribution == "zipf")
+			{
+				zipf.reset(new zipf_constants(p_options.m_key_range, p_options.m_zipf_theta));
+			}
+
+			std::vector<worker_result> results(p_options.m_threads);
+			std::vector<std::thread> workers;
+			std::atomic<std::size_t> ready(0);
+			std::atomic<bool> start(false);
+			std::chrono::steady_clock::time_point deadline;
+
+			for (std::size_t idx_for = 0; idx_for < p_options.m_threads; ++idx_for)
+			{
+				workers.emplace_back(
+					[&cache, &p_options, &zipf, idx_for, &ready, &start, &deadline, &results]()
+					{ run_worker(*cache, p_options, zipf.get(), idx_for, ready, start, deadline, results[idx_for]); });
+			}
+
+			while (ready.load() != p_options.m_threads)
+			{
+				std::this_thread::yield();
+			}
+
+			const auto start_time = std::chrono::steady_clock::now();
+			deadline			  = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(p_options.m_duration_seconds));
+			start.store(true, std::memory_order_release);
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+			const auto end_time = std::chrono::steady_clock::now();
+
+			load_result merged;
+			merged.m_elapsed_seconds = std::chrono::duration<double>(end_time - start_time).count();
+			merged.m_final_size		 = cache->size();
+			for (const auto& result : results)
+			{
+				merged.m_gets += result.m_gets;
+				merged.m_hits += result.m_hits;
+				merged.m_puts += result.m_puts;
+				merged.m_operations += result.m_operations;
+				merged.m_batch_ns_per_op.insert(merged.m_batch_ns_per_op.end(), result.m_batch_ns_per_op.begin(), result.m_batch_ns_per_op.end());
+			}
+			std::sort(merged.m_batch_ns_per_op.begin(), merged.m_batch_ns_per_op.end());
+			return merged;
 		}
 
-		auto run_comprehensive_benchmark() -> void
+		template <typename cache_t> auto run_cache(const driver_options& p_options) -> load_result { return run_load<locked_cache<cache_t>>(p_options); }
+
+		template <template <typename, typename> class eviction_t, template <typename, typename> class storage_t> auto dispatch_access(const driver_options& p_options) -> load_result
 		{
-			constexpr std::size_t cache_size		 = 100;
-			constexpr std::size_t num_operations	 = 10000000;
-			constexpr std::size_t key_range			 = 500;
-			constexpr std::size_t num_get_operations = 100000000;
-
-			std::cout << "=== Comprehensive Cache Benchmark ===" << '\n';
-			std::cout << "Cache Size: " << cache_size << '\n';
-			std::cout << "PUT Operations: " << num_operations << '\n';
-			std::cout << "GET Operations: " << num_get_operations << '\n';
-			std::cout << "Key Range: 1-" << key_range << '\n';
-			std::cout << '\n';
-
-			const auto put_data = generate_test_data(data_size_t(num_operations), key_range_t(key_range));
-			const auto get_keys = generate_get_keys(data_size_t(num_get_operations), key_range_t(key_range));
-
-			cache_engine::cache<int, std::string, cache_engine::algorithm::lru> lru_cache(cache_size);
-			const auto lru_stats = benchmark_cache(lru_cache, put_data, get_keys, "LRU");
-			print_results("LRU", lru_stats);
-
-			cache_engine::cache<int, std::string, cache_engine::algorithm::fifo> fifo_cache(cache_size);
-			const auto fifo_stats = benchmark_cache(fifo_cache, put_data, get_keys, "FIFO");
-			print_results("FIFO", fifo_stats);
-
-			cache_engine::cache<int, std::string, cache_engine::algorithm::lfu> lfu_cache(cache_size);
-			const auto lfu_stats = benchmark_cache(lfu_cache, put_data, get_keys, "LFU");
-			print_results("LFU", lfu_stats);
-
-			cache_engine::cache<int, std::string, cache_engine::algorithm::mfu> mfu_cache(cache_size);
-			const auto mfu_stats = benchmark_cache(mfu_cache, put_data, get_keys, "MFU");
-			print_results("MFU", mfu_stats);
-
-			cache_engine::cache<int, std::string, cache_engine::algorithm::mru> mru_cache(cache_size);
-			const auto mru_stats = benchmark_cache(mru_cache, put_data, get_keys, "MRU");
-			print_results("MRU", mru_stats);
-
-			cache_engine::cache<int, std::string, cache_engine::algorithm::random_cache> random_cache(cache_size);
-			const auto random_stats = benchmark_cache(random_cache, put_data, get_keys, "RANDOM");
-			print_results("RANDOM", random_stats);
-
-			std::cout << "=== Performance Comparison ===" << '\n';
-			std::cout << std::left << std::setw(algorithm_width) << "Algorithm" << std::setw(hit_rate_width) << "Hit Rate %" << std::setw(throughput_width) << "PUT ops/sec"
-					  << std::setw(throughput_width) << "GET ops/sec" << '\n';
-			std::cout << std::string(separator_width, '-') << '\n';
-
-			const std::vector<std::pair<std::string, cache_stats>> all_stats = {
-				{"LRU", lru_stats}, {"FIFO", fifo_stats}, {"LFU", lfu_stats}, {"MFU", mfu_stats}, {"MRU", mru_stats}, {"RANDOM", random_stats}};
-
-			for (const auto& all_stat : all_stats)
-			{
-				const auto& algorithm = all_stat.first;
-				const auto& stats	  = all_stat.second;
-				std::cout << std::left << std::setw(algorithm_width) << algorithm << std::setw(hit_rate_width) << std::fixed << std::setprecision(precision_decimal)
-						  << (stats.hit_rate() * percentage_multiplier) << std::setw(throughput_width) << std::fixed << std::setprecision(precision_integer)
-						  << stats.put_throughput_ops_per_sec() << std::setw(throughput_width) << std::fixed << std::setprecision(precision_integer) << stats.get_throughput_ops_per_sec()
-						  << '\n';
+			using cache_engine::policy_templates::fixed_capacity;
+
+			if (p_options.m_access == "update")
+			{
+				return run_cache<cache_engine::policy_based_cache<key_t, value_t, eviction_t, storage_t, cache_engine::policy_templates::update_on_access, fixed_capacity>>(p_options);
 			}
+			if (p_options.m_access == "none")
+			{
+				return run_cache<cache_engine::policy_based_cache<key_t, value_t, eviction_t, storage_t, cache_engine::policy_templates::no_update_on_access, fixed_capacity>>(p_options);
+			}
+			throw std::invalid_argument("Unknown --access '" + p_options.m_access + "'");
 		}
 
-		auto test_algorithm_correctness() -> void
+		template <template <typename, typename> class eviction_t> auto dispatch_storage(const driver_options& p_options) -> load_result
 		{
-			std::cout << "=== Algorithm Correctness Tests ===" << '\n';
-
-			std::cout << "Testing FIFO eviction..." << '\n';
-			cache_engine::cache<int, std::string, cache_engine::algorithm::fifo> fifo_test(2);
-			fifo_test.put(1, "one");
-			fifo_test.put(2, "two");
-			fifo_test.put(3, "three");
-			try
+			if (p_options.m_storage == "hash")
 			{
-				fifo_test.get(1);
-				std::cout << "ERROR: Key 1 should have been evicted!" << '\n';
+				return dispatch_access<eviction_t, cache_engine::policy_templates::hash_storage>(p_options);
 			}
-			catch (const std::out_of_range&)
+			if (p_options.m_storage == "reserved_hash")
 			{
-				std::cout << "PASS: FIFO correctly evicted key 1" << '\n';
+				return dispatch_access<eviction_t, cache_engine::policy_templates::reserved_hash_storage>(p_options);
 			}
+			if (p_options.m_storage == "compact")
+			{
+				return dispatch_access<eviction_t, cache_engine::policy_templates::compact_storage>(p_options);
+			}
+			if (p_options.m_storage == "debug")
+			{
+				return dispatch_access<eviction_t, cache_engine::policy_templates::debug_storage>(p_options);
+			}
+			throw std::invalid_argument("Unknown --storage '" + p_options.m_storage + "'");
+		}
 
-			std::cout << "Testing LRU eviction..." << '\n';
-			cache_engine::cache<int, std::string, cache_engine::algorithm::lru> lru_test(2);
-			lru_test.put(1, "one");
-			lru_test.put(2, "two");
-			lru_test.get(1);
-			lru_test.put(3, "three");
-			try
+		auto dispatch_eviction(const driver_options& p_options) -> load_result
+		{
+			if (p_options.m_eviction == "lru")
+			{
+				return dispatch_storage<cache_engine::policy_templates::lru_eviction>(p_options);
+			}
+			if (p_options.m_eviction == "mru")
 			{
-				lru_test.get(2);
-				std::cout << "ERROR: Key 2 should have been evicted!" << '\n';
+				return dispatch_storage<cache_engine::policy_templates::mru_eviction>(p_options);
 			}
-			catch (const std::out_of_range&)
+			if (p_options.m_eviction == "fifo")
 			{
-				std::cout << "PASS: LRU correctly evicted key 2" << '\n';
+				return dispatch_storage<cache_engine::policy_templates::fifo_eviction>(p_options);
 			}
+			if (p_options.m_eviction == "lfu")
+			{
+				return dispatch_storage<cache_engine::policy_templates::lfu_eviction>(p_options);
+			}
+			if (p_options.m_eviction == "mfu")
+			{
+				return dispatch_storage<cache_engine::policy_templates::mfu_eviction>(p_options);
+			}
+			if (p_options.m_eviction == "random")
+			{
+				return dispatch_storage<cache_engine::policy_templates::random_eviction>(p_options);
+			}
+			if (p_options.m_eviction == "sampled_lfu")
+			{
+				return dispatch_storage<cache_engine::policy_templates::sampled_lfu_eviction>(p_options);
+			}
+			throw std::invalid_argument("Unknown --eviction '" + p_options.m_eviction + "'");
+		}
 
-			std::cout << "Testing MRU eviction..." << '\n';
-			cache_engine::cache<int, std::string, cache_engine::algorithm::mru> mru_test(2);
-			mru_test.put(1, "one");
-			mru_test.put(2, "two");
-			mru_test.get(1);
-			mru_test.put(3, "three");
-			try
+		auto dispatch_algorithm(const driver_options& p_options) -> load_result
+		{
+			if (p_options.m_algorithm == "lru")
 			{
-				mru_test.get(1);
-				std::cout << "ERROR: Key 1 should have been evicted!" << '\n';
+				return run_cache<cache_engine::cache<key_t, value_t, cache_engine::algorithm::lru>>(p_options);
 			}
-			catch (const std::out_of_range&)
+			if (p_options.m_algorithm == "mru")
 			{
-				std::cout << "PASS: MRU correctly evicted key 1" << '\n';
+				return run_cache<cache_engine::cache<key_t, value_t, cache_engine::algorithm::mru>>(p_options);
 			}
+			if (p_options.m_algorithm == "fifo")
+			{
+				return run_cache<cache_engine::cache<key_t, value_t, cache_engine::algorithm::fifo>>(p_options);
+			}
+			if (p_options.m_algorithm == "lfu")
+			{
+				return run_cache<cache_engine::cache<key_t, value_t, cache_engine::algorithm::lfu>>(p_options);
+			}
+			if (p_options.m_algorithm == "mfu")
+			{
+				return run_cache<cache_engine::cache<key_t, value_t, cache_engine::algorithm::mfu>>(p_options);
+			}
+			if (p_options.m_algorithm == "random")
+			{
+				return run_cache<cache_engine::cache<key_t, value_t, cache_engine::algorithm::random_cache>>(p_options);
+			}
+			throw std::invalid_argument("Unknown --algorithm '" + p_options.m_algorithm + "'");
+		}
 
-			std::cout << "Testing LFU frequency tracking..." << '\n';
-			cache_engine::cache<int, std::string, cache_engine::algorithm::lfu> lfu_test(2);
-			lfu_test.put(1, "one");
-			lfu_test.put(2, "two");
-			lfu_test.get(1);
-			lfu_test.get(1);
-			lfu_test.put(3, "three");
-			try
+		auto run_engine(const driver_options& p_options) -> load_result
+		{
+			if (p_options.m_engine == "legacy")
+			{
+				return dispatch_algorithm(p_options);
+			}
+			if (p_options.m_engine == "policy")
 			{
-				lfu_test.get(2);
-				std::cout << "ERROR: Key 2 should have been evicted!" << '\n';
+				return dispatch_eviction(p_options);
 			}
-			catch (const std::out_of_range&)
+			if (p_options.m_engine == "clock")
 			{
-				std::cout << "PASS: LFU correctly evicted least frequent key 2" << '\n';
+				return run_load<clock_adapter>(p_options);
 			}
+			throw std::invalid_argument("Unknown --engine '" + p_options.m_engine + "'");
+		}
 
-			std::cout << "Testing key update behavior..." << '\n';
-			cache_engine::cache<int, std::string, cache_engine::algorithm::fifo> update_test(2);
-			update_test.put(1, "one");
-			update_test.put(2, "two");
-			update_test.put(1, "one_updated");
-			try
+		auto percentile(const std::vector<double>& p_sorted, double p_fraction) -> double
+		{
+			if (p_sorted.empty())
 			{
-				const std::string result = update_test.get(1);
-				if (result == "one_updated")
-				{
-					std::cout << "PASS: Key update working correctly" << '\n';
-				}
-				else
+				return 0.0;
+			}
+			const auto index = static_cast<std::size_t>(p_fraction * static_cast<double>(p_sorted.size() - 1) + 0.5);
+			return p_sorted[std::min(index, p_sorted.size() - 1)];
+		}
+
+		auto json_string(const std::string& p_text) -> std::string
+		{
+			std::string quoted("\"");
+			for (const char character : p_text)
+			{
+				if (character == '"' || character == '\\')
 				{
-					std::cout << "ERROR: Key update failed" << '\n';
+					quoted.push_back('\\');
 				}
+				quoted.push_back(character);
 			}
-			catch (const std::out_of_range&)
+			quoted.push_back('"');
+			return quoted;
+		}
+
+		auto write_json(std::ostream& p_stream, const driver_options& p_options, const load_result& p_result) -> void
+		{
+			double mean_ns = 0.0;
+			for (const double sample : p_result.m_batch_ns_per_op)
 			{
-				std::cout << "ERROR: Updated key should still be accessible" << '\n';
+				mean_ns += sample;
 			}
-
-			std::cout << '\n';
+			mean_ns = p_result.m_batch_ns_per_op.empty() ? 0.0 : mean_ns / static_cast<double>(p_result.m_batch_ns_per_op.size());
+
+			const double throughput = (p_result.m_elapsed_seconds > 0.0) ? static_cast<double>(p_result.m_operations) / p_result.m_elapsed_seconds : 0.0;
+			const double hit_ratio	= (p_result.m_gets == 0) ? 0.0 : static_cast<double>(p_result.m_hits) / static_cast<double>(p_result.m_gets);
+
+			p_stream << std::setprecision(json_precision) << std::fixed;
+			p_stream << "{\n"
+					 << "  \"config\": {\n"
+					 << "    \"engine\": " << json_string(p_options.m_engine) << ",\n"
+					 << "    \"algorithm\": " << json_string(p_options.m_algorithm) << ",\n"
+					 << "    \"eviction\": " << json_string(p_options.m_eviction) << ",\n"
+					 << "    \"storage\": " << json_string(p_options.m_storage) << ",\n"
+					 << "    \"access\": " << json_string(p_options.m_access) << ",\n"
+					 << "    \"capacity\": " << p_options.m_capacity << ",\n"
+					 << "    \"key_range\": " << p_options.m_key_range << ",\n"
+					 << "    \"distribution\": " << json_string(p_options.m_distribution) << ",\n"
+					 << "    \"zipf_theta\": " << p_options.m_zipf_theta << ",\n"
+					 << "    \"read_ratio\": " << p_options.m_read_ratio << ",\n"
+					 << "    \"fill_on_miss\": " << (p_options.m_fill_on_miss ? "true" : "false") << ",\n"
+					 << "    \"threads\": " << p_options.m_threads << ",\n"
+					 << "    \"duration_seconds\": " << p_options.m_duration_seconds << ",\n"
+					 << "    \"ops\": " << p_options.m_operations << ",\n"
+					 << "    \"warmup\": " << p_options.m_warmup << ",\n"
+					 << "    \"batch\": " << p_options.m_batch << ",\n"
+					 << "    \"value_size\": " << p_options.m_value_size << ",\n"
+					 << "    \"seed\": " << p_options.m_seed << "\n"
+					 << "  },\n"
+					 << "  \"results\": {\n"
+					 << "    \"operations\": " << p_result.m_operations << ",\n"
+					 << "    \"gets\": " << p_result.m_gets << ",\n"
+					 << "    \"hits\": " << p_result.m_hits << ",\n"
+					 << "    \"puts\": " << p_result.m_puts << ",\n"
+					 << "    \"hit_ratio\": " << hit_ratio << ",\n"
+					 << "    \"final_size\": " << p_result.m_final_size << ",\n"
+					 << "    \"elapsed_seconds\": " << p_result.m_elapsed_seconds << ",\n"
+					 << "    \"throughput_ops_per_sec\": " << throughput << ",\n"
+					 << "    \"batches\": " << p_result.m_batch_ns_per_op.size() << ",\n"
+					 << "    \"batch_ns_per_op\": {\n"
+					 << "      \"mean\": " << mean_ns << ",\n"
+					 << "      \"p50\": " << percentile(p_result.m_batch_ns_per_op, 0.50) << ",\n"
+					 << "      \"p90\": " << percentile(p_result.m_batch_ns_per_op, 0.90) << ",\n"
+					 << "      \"p99\": " << percentile(p_result.m_batch_ns_per_op, 0.99) << ",\n"
+					 << "      \"max\": " << (p_result.m_batch_ns_per_op.empty() ? 0.0 : p_result.m_batch_ns_per_op.back()) << "\n"
+					 << "    }\n"
+					 << "  }\n"
+					 << "}\n";
 		}
-	}	 // anonymous namespace
-}	 // namespace benchmark
+	} // anonymous namespace
+} // namespace benchmark
 
-auto main() -> int
+auto main(int p_argc, char** p_argv) -> int
 {
 	try
 	{
-		benchmark::test_algorithm_correctness();
-		benchmark::run_comprehensive_benchmark();
+		const benchmark::driver_options options = benchmark::parse_options(p_argc, p_argv);
+		if (options.m_help)
+		{
+			benchmark::print_usage(std::cout);
+			return 0;
+		}
+
+		const benchmark::load_result result = benchmark::run_engine(options);
+
+		if (options.m_output.empty())
+		{
+			benchmark::write_json(std::cout, options, result);
+		}
+		else
+		{
+			std::ofstream output(options.m_output);
+			if (!output)
+			{
+				throw std::runtime_error("Cannot open output file '" + options.m_output + "'");
+			}
+			benchmark::write_json(output, options, result);
+		}
+	}
+	catch (const std::invalid_argument& e)
+	{
+		std::cerr << "Error: " << e.what() << '\n';
+		benchmark::print_usage(std::cerr);
+		return 1;
 	}
 	catch (const std::exception& e)
 	{
@@ -392,4 +843,4 @@ auto main() -> int
 	}
 
 	return 0;
-}
\ No newline at end of file
+}
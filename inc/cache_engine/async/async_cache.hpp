@@ -0,0 +1,285 @@
+// File: inc/cache_engine/async/async_cache.hpp
+
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../cache.hpp"
+#include "executor.hpp"
+#include "task.hpp"
+
+namespace cache_engine
+{
+	namespace async
+	{
+		/**
+		 * @brief Coroutine front end for a synchronous cache with request coalescing
+		 *
+		 * A miss does not block the calling thread: the first coroutine asking for
+		 * a key awaits the asynchronous loader, every later coroutine asking for the
+		 * same key suspends on the shared pending entry. When the load completes the
+		 * value is inserted into the underlying cache and all waiters are handed to
+		 * the executor for resumption. A failed load is rethrown to every waiter and
+		 * nothing is cached.
+		 *
+		 * The underlying cache is only touched under an internal mutex, so any
+		 * single-threaded cache with put/get/contains works, including the legacy
+		 * cache specializations and policy_based_cache.
+		 *
+		 * @tparam key_t Key type (must be hashable)
+		 * @tparam value_t Value type (must be copyable)
+		 * @tparam cache_t Synchronous cache type, constructible from a capacity
+		 */
+		template <typename key_t, typename value_t, typename cache_t = cache<key_t, value_t, algorithm::lru>> class async_cache
+		{
+		  public:
+			using self_t   = async_cache<key_t, value_t, cache_t>;
+			using loader_t = std::function<task<value_t>(const key_t&)>;
+
+		  private:
+			/**
+			 * @brief In-flight load shared by every coroutine that missed on the same key
+			 */
+			struct pending_entry
+			{
+				std::mutex m_mutex;
+				bool m_ready = false;
+				std::optional<value_t> m_value;
+				std::exception_ptr m_exception;
+				std::vector<std::coroutine_handle<>> m_waiters;
+			};
+
+			/**
+			 * @brief Suspends the awaiting coroutine until the pending entry is completed
+			 */
+			struct pending_awaiter
+			{
+				pending_entry* m_entry;
+
+				auto await_ready() const noexcept -> bool { return false; }
+
+				auto await_suspend(std::coroutine_handle<> p_handle) const -> bool
+				{
+					std::lock_guard<std::mutex> lock(m_entry->m_mutex);
+					if (m_entry->m_ready)
+					{
+						// Completed between the map lookup and now; continue without suspending
+						return false;
+					}
+					m_entry->m_waiters.push_back(p_handle);
+					return true;
+				}
+
+				auto await_resume() const -> value_t
+				{
+					if (m_entry->m_exception)
+					{
+						std::rethrow_exception(m_entry->m_exception);
+					}
+					return *m_entry->m_value;
+				}
+			};
+
+			mutable std::mutex m_mutex;
+			cache_t m_cache;
+			std::unordered_map<key_t, std::shared_ptr<pending_entry>> m_pending;
+			loader_t m_loader;
+			executor* m_executor;
+			std::size_t m_hit_count;
+			std::size_t m_load_count;
+			std::size_t m_coalesced_count;
+
+		  public:
+			// Constructor
+			async_cache(std::size_t p_capacity, loader_t p_loader, executor& p_executor)
+				: m_cache(p_capacity), m_loader(std::move(p_loader)), m_executor(&p_executor), m_hit_count(0), m_load_count(0), m_coalesced_count(0)
+			{
+				if (!m_loader)
+				{
+					throw std::invalid_argument("Async cache requires a loader");
+				}
+			}
+
+			// Destructor
+			~async_cache() = default;
+
+			// Deleted copy/move: suspended coroutines hold a pointer to this cache
+			async_cache(const self_t&)				 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+			async_cache(self_t&&)					 = delete;
+			auto operator=(self_t&&) -> self_t&		 = delete;
+
+		  public:
+			/**
+			 * @brief Get a value, loading it asynchronously on a miss
+			 *
+			 * The key is taken by value because the coroutine may outlive the
+			 * caller's argument.
+			 *
+			 * @param p_key The key to look up
+			 * @return A task producing the cached or freshly loaded value
+			 */
+			auto async_get_or_load(key_t p_key) -> task<value_t>
+			{
+				std::shared_ptr<pending_entry> entry;
+				bool is_owner = false;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (m_cache.contains(p_key))
+					{
+						++m_hit_count;
+						co_return m_cache.get(p_key);
+					}
+
+					auto pending_iter = m_pending.find(p_key);
+					if (pending_iter != m_pending.end())
+					{
+						entry = pending_iter->second;
+						++m_coalesced_count;
+					}
+					else
+					{
+						entry = std::make_shared<pending_entry>();
+						m_pending.emplace(p_key, entry);
+						is_owner = true;
+						++m_load_count;
+					}
+				}
+
+				if (!is_owner)
+				{
+					// The awaiter borrows the entry; the local shared_ptr keeps it alive across the suspension
+					co_return co_await pending_awaiter{entry.get()};
+				}
+
+				std::optional<value_t> loaded;
+				std::exception_ptr exception;
+				try
+				{
+					loaded.emplace(co_await m_loader(p_key));
+				}
+				catch (...)
+				{
+					exception = std::current_exception();
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (!exception)
+					{
+						m_cache.put(p_key, *loaded);
+					}
+					m_pending.erase(p_key);
+				}
+
+				this->complete(*entry, loaded, exception);
+
+				if (exception)
+				{
+					std::rethrow_exception(exception);
+				}
+				co_return std::move(*loaded);
+			}
+
+			/**
+			 * @brief Synchronous lookup that never loads
+			 * @param p_key The key to look up
+			 * @param p_value Receives the value on a hit
+			 * @return true on a hit
+			 */
+			auto try_get(const key_t& p_key, value_t& p_value) -> bool
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!m_cache.contains(p_key))
+				{
+					return false;
+				}
+				++m_hit_count;
+				p_value = m_cache.get(p_key);
+				return true;
+			}
+
+			auto put(const key_t& p_key, const value_t& p_value) -> void
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_cache.put(p_key, p_value);
+			}
+
+			auto contains(const key_t& p_key) const -> bool
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_cache.contains(p_key);
+			}
+
+			auto size() const -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_cache.size();
+			}
+
+			/**
+			 * @brief Get the number of keys with a load in flight
+			 * @return The pending key count
+			 */
+			auto pending_count() const -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_pending.size();
+			}
+
+			auto hit_count() const -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_hit_count;
+			}
+
+			/**
+			 * @brief Get the number of loader invocations
+			 * @return The load count
+			 */
+			auto load_count() const -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_load_count;
+			}
+
+			/**
+			 * @brief Get the number of misses that joined an already pending load
+			 * @return The coalesced miss count
+			 */
+			auto coalesced_count() const -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_coalesced_count;
+			}
+
+		  private:
+			auto complete(pending_entry& p_entry, const std::optional<value_t>& p_value, const std::exception_ptr& p_exception) -> void
+			{
+				std::vector<std::coroutine_handle<>> waiters;
+				{
+					std::lock_guard<std::mutex> lock(p_entry.m_mutex);
+					p_entry.m_value		= p_value;
+					p_entry.m_exception = p_exception;
+					p_entry.m_ready		= true;
+					waiters.swap(p_entry.m_waiters);
+				}
+
+				for (auto& waiter : waiters)
+				{
+					m_executor->post(waiter);
+				}
+			}
+		};
+	} // namespace async
+} // namespace cache_engine
@@ -0,0 +1,156 @@
+// File: inc/cache_engine/async/executor.hpp
+
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace cache_engine
+{
+	namespace async
+	{
+		/**
+		 * @brief Base class for objects that resume suspended coroutines
+		 *
+		 * The async cache never resumes a waiting coroutine on the thread that
+		 * completed a load; it hands the coroutine to an executor instead, so the
+		 * loading coroutine is not held up by the continuations of its waiters.
+		 */
+		class executor
+		{
+		  public:
+			// Constructor
+			executor() = default;
+
+			// Destructor
+			virtual ~executor() = default;
+
+			// Deleted copy constructor and assignment operator
+			executor(const executor&)					 = delete;
+			auto operator=(const executor&) -> executor& = delete;
+
+			/**
+			 * @brief Schedule a suspended coroutine for resumption
+			 * @param p_handle The coroutine to resume
+			 */
+			virtual auto post(std::coroutine_handle<> p_handle) -> void = 0;
+
+			/**
+			 * @brief Awaiter that moves the awaiting coroutine onto this executor
+			 */
+			struct schedule_awaiter
+			{
+				executor* m_executor;
+
+				auto await_ready() const noexcept -> bool { return false; }
+
+				auto await_suspend(std::coroutine_handle<> p_handle) const -> void { m_executor->post(p_handle); }
+
+				auto await_resume() const noexcept -> void {}
+			};
+
+			/**
+			 * @brief Reschedule the current coroutine on this executor
+			 * @return An awaitable; `co_await exec.schedule()` resumes on the executor
+			 */
+			auto schedule() -> schedule_awaiter { return schedule_awaiter{this}; }
+		};
+
+		/**
+		 * @brief Executor that resumes coroutines immediately on the posting thread
+		 */
+		class inline_executor : public executor
+		{
+		  public:
+			auto post(std::coroutine_handle<> p_handle) -> void override { p_handle.resume(); }
+		};
+
+		/**
+		 * @brief Fixed-size pool of worker threads draining a shared FIFO queue
+		 */
+		class thread_pool_executor : public executor
+		{
+		  private:
+			std::mutex m_mutex;
+			std::condition_variable m_condition;
+			std::deque<std::coroutine_handle<>> m_queue;
+			std::vector<std::thread> m_workers;
+			bool m_stopping;
+
+		  public:
+			// Constructor
+			explicit thread_pool_executor(std::size_t p_thread_count) : m_stopping(false)
+			{
+				if (p_thread_count == 0)
+				{
+					throw std::invalid_argument("Thread pool executor needs at least one thread");
+				}
+
+				m_workers.reserve(p_thread_count);
+				for (std::size_t idx_for = 0; idx_for < p_thread_count; ++idx_for)
+				{
+					m_workers.emplace_back([this] { this->run(); });
+				}
+			}
+
+			// Destructor
+			~thread_pool_executor() override
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_stopping = true;
+				}
+				m_condition.notify_all();
+
+				for (auto& worker : m_workers)
+				{
+					worker.join();
+				}
+			}
+
+		  public:
+			auto post(std::coroutine_handle<> p_handle) -> void override
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_queue.push_back(p_handle);
+				}
+				m_condition.notify_one();
+			}
+
+			/**
+			 * @brief Get the number of worker threads
+			 * @return The thread count
+			 */
+			auto thread_count() const -> std::size_t { return m_workers.size(); }
+
+		  private:
+			auto run() -> void
+			{
+				for (;;)
+				{
+					std::coroutine_handle<> handle;
+					{
+						std::unique_lock<std::mutex> lock(m_mutex);
+						m_condition.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+
+						// Drain queued work before stopping so no coroutine is leaked suspended
+						if (m_queue.empty())
+						{
+							return;
+						}
+						handle = m_queue.front();
+						m_queue.pop_front();
+					}
+					handle.resume();
+				}
+			}
+		};
+	} // namespace async
+} // namespace cache_engine
@@ -0,0 +1,379 @@
+// File: inc/cache_engine/async/hedged_loader.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "executor.hpp"
+#include "task.hpp"
+
+namespace cache_engine
+{
+	namespace async
+	{
+		/**
+		 * @brief When hedged_loader issues a second load, and how many it may issue
+		 */
+		struct hedge_options
+		{
+			std::chrono::nanoseconds m_delay = std::chrono::nanoseconds::zero(); // Fixed hedge delay; zero uses the tracked percentile
+			double m_percentile				 = 0.95;								 // Load latency percentile used as the delay
+			double m_budget					 = 0.1;									 // Hedges allowed per load
+			std::size_t m_min_samples		 = 64;									 // Loads measured before the percentile is trusted
+			std::size_t m_window			 = 1024;								 // Most recent load latencies the percentile covers
+		};
+
+		/**
+		 * @brief Counters of a hedged_loader
+		 */
+		struct hedge_stats
+		{
+			std::size_t m_loads			= 0; // load calls
+			std::size_t m_hedges		= 0; // Second loads issued
+			std::size_t m_hedge_wins	= 0; // Loads answered by the second load
+			std::size_t m_budget_denied = 0; // Hedges skipped because the budget was spent
+		};
+
+		/**
+		 * @brief Loader wrapper that races a second load against a slow first one
+		 *
+		 * When a load has not finished after the hedge delay, the same key is
+		 * loaded again and the first successful result is returned; the other
+		 * one is discarded when it arrives (a loader task cannot be cancelled
+		 * mid-flight). The delay is either fixed or the running percentile of
+		 * the latencies of first loads, which keep being measured when they
+		 * lose. Hedges are capped at m_budget per load overall. A failed load
+		 * only fails the lookup once no other load for it is running.
+		 *
+		 * Plugs into async_cache (and read_ahead_cache) through loader(), so the
+		 * winning value is what fills the cache. One timer thread per instance
+		 * fires the hedges; the loads themselves run on the executor.
+		 *
+		 * @tparam key_t Key type (must be copyable)
+		 * @tparam value_t Value type (must be copyable)
+		 */
+		template <typename key_t, typename value_t> class hedged_loader
+		{
+		  public:
+			using self_t   = hedged_loader<key_t, value_t>;
+			using loader_t = std::function<task<value_t>(const key_t&)>;
+			using clock_t  = std::chrono::steady_clock;
+
+		  private:
+			/**
+			 * @brief Outcome shared by the loads racing for one lookup
+			 */
+			struct race_state
+			{
+				std::mutex m_mutex;
+				bool m_done				= false;
+				std::size_t m_running	= 0;
+				std::optional<value_t> m_value;
+				std::exception_ptr m_exception;
+				std::coroutine_handle<> m_waiter;
+			};
+
+			/**
+			 * @brief Suspends the lookup until one of its loads has produced the outcome
+			 */
+			struct race_awaiter
+			{
+				race_state* m_race;
+
+				auto await_ready() const noexcept -> bool { return false; }
+
+				auto await_suspend(std::coroutine_handle<> p_handle) const -> bool
+				{
+					std::lock_guard<std::mutex> lock(m_race->m_mutex);
+					if (m_race->m_done)
+					{
+						return false;
+					}
+					m_race->m_waiter = p_handle;
+					return true;
+				}
+
+				auto await_resume() const -> value_t
+				{
+					if (m_race->m_exception)
+					{
+						std::rethrow_exception(m_race->m_exception);
+					}
+					return *m_race->m_value;
+				}
+			};
+
+			/**
+			 * @brief Hedge waiting for its deadline on the timer thread
+			 */
+			struct pending_hedge
+			{
+				clock_t::time_point m_deadline;
+				std::shared_ptr<race_state> m_race;
+				key_t m_key;
+
+				auto operator>(const pending_hedge& p_other) const -> bool { return m_deadline > p_other.m_deadline; }
+			};
+
+			loader_t m_loader;
+			executor* m_executor;
+			hedge_options m_options;
+
+			mutable std::mutex m_mutex;
+			std::condition_variable m_idle;
+			hedge_stats m_stats;
+			std::vector<std::int64_t> m_latencies;
+			std::size_t m_latency_next;
+			std::size_t m_latency_count;
+			std::chrono::nanoseconds m_tracked_delay;
+			std::size_t m_loads_in_flight;
+
+			std::mutex m_timer_mutex;
+			std::condition_variable m_timer_condition;
+			std::priority_queue<pending_hedge, std::vector<pending_hedge>, std::greater<pending_hedge>> m_timers;
+			bool m_stopping;
+			std::thread m_timer_thread;
+
+		  public:
+			// Constructor
+			hedged_loader(loader_t p_loader, executor& p_executor, const hedge_options& p_options = hedge_options())
+				: m_loader(std::move(p_loader)), m_executor(&p_executor), m_options(p_options), m_latencies(p_options.m_window, 0), m_latency_next(0), m_latency_count(0),
+				  m_tracked_delay(std::chrono::nanoseconds::zero()), m_loads_in_flight(0), m_stopping(false)
+			{
+				if (!m_loader)
+				{
+					throw std::invalid_argument("Hedged loader requires a loader");
+				}
+				if (!(m_options.m_percentile > 0.0 && m_options.m_percentile < 1.0) || !(m_options.m_budget >= 0.0 && m_options.m_budget <= 1.0) || m_options.m_window == 0 ||
+					m_options.m_delay < std::chrono::nanoseconds::zero())
+				{
+					throw std::invalid_argument("Hedge percentile must be in (0, 1), budget in [0, 1], the window non-empty and the delay non-negative");
+				}
+				m_timer_thread = std::thread([this] { this->run_timer(); });
+			}
+
+			// Destructor: stops firing hedges, then waits for the loads still running
+			~hedged_loader()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_timer_mutex);
+					m_stopping = true;
+				}
+				m_timer_condition.notify_one();
+				m_timer_thread.join();
+
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_idle.wait(lock, [this] { return m_loads_in_flight == 0; });
+			}
+
+			// Deleted copy/move: running loads hold a pointer to this loader
+			hedged_loader(const self_t&)			 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+			hedged_loader(self_t&&)					 = delete;
+			auto operator=(self_t&&) -> self_t&		 = delete;
+
+		  public:
+			/**
+			 * @brief Load a key, hedging if the first load is slow
+			 * @param p_key The key to load (by value: the coroutine may outlive the caller's argument)
+			 * @return A task producing the first successfully loaded value
+			 */
+			auto load(key_t p_key) -> task<value_t>
+			{
+				std::shared_ptr<race_state> race = std::make_shared<race_state>();
+				race->m_running					 = 1;
+
+				std::chrono::nanoseconds delay = std::chrono::nanoseconds::zero();
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					++m_stats.m_loads;
+					++m_loads_in_flight;
+					delay = (m_options.m_delay > std::chrono::nanoseconds::zero()) ? m_options.m_delay : m_tracked_delay;
+				}
+
+				if (delay > std::chrono::nanoseconds::zero())
+				{
+					{
+						std::lock_guard<std::mutex> lock(m_timer_mutex);
+						m_timers.push(pending_hedge{clock_t::now() + delay, race, p_key});
+					}
+					m_timer_condition.notify_one();
+				}
+
+				this->run_load(race, p_key, false);
+				co_return co_await race_awaiter{race.get()};
+			}
+
+			/**
+			 * @brief Get a loader function for async_cache that goes through this hedged loader
+			 * @return The loader; it must not outlive this object
+			 */
+			auto loader() -> loader_t
+			{
+				return [this](const key_t& p_key) { return this->load(p_key); };
+			}
+
+			/**
+			 * @brief Get a snapshot of the hedging counters
+			 * @return The counters
+			 */
+			auto stats() const -> hedge_stats
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_stats;
+			}
+
+			/**
+			 * @brief Get the delay after which the next load would be hedged
+			 * @return The fixed or tracked delay (zero while too few loads have been measured)
+			 */
+			auto hedge_delay() const -> std::chrono::nanoseconds
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return (m_options.m_delay > std::chrono::nanoseconds::zero()) ? m_options.m_delay : m_tracked_delay;
+			}
+
+		  private:
+			auto run_load(std::shared_ptr<race_state> p_race, key_t p_key, bool p_hedge) -> detail::detached_task
+			{
+				co_await m_executor->schedule();
+
+				const clock_t::time_point start = clock_t::now();
+				std::optional<value_t> value;
+				std::exception_ptr exception;
+				try
+				{
+					value.emplace(co_await m_loader(p_key));
+				}
+				catch (...)
+				{
+					exception = std::current_exception();
+				}
+				const std::chrono::nanoseconds elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - start);
+
+				// The first success wins; a failure only counts once nothing else is running
+				std::coroutine_handle<> waiter;
+				bool won = false;
+				{
+					std::lock_guard<std::mutex> lock(p_race->m_mutex);
+					--p_race->m_running;
+					if (!p_race->m_done && (value || p_race->m_running == 0))
+					{
+						won			   = value.has_value();
+						p_race->m_done = true;
+						if (won)
+						{
+							p_race->m_value = std::move(value);
+						}
+						else
+						{
+							p_race->m_exception = exception;
+						}
+						waiter = std::exchange(p_race->m_waiter, nullptr);
+					}
+				}
+
+				// Settle the counters before the lookup resumes, so its caller sees them; once the
+				// in-flight count drops the destructor may run, so only locals are used after that
+				executor* const resume_on = m_executor;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (!p_hedge && !exception)
+					{
+						this->record_latency(elapsed);
+					}
+					m_stats.m_hedge_wins += (p_hedge && won) ? 1U : 0U;
+					--m_loads_in_flight;
+					m_idle.notify_all();
+				}
+				if (waiter)
+				{
+					resume_on->post(waiter);
+				}
+			}
+
+			auto record_latency(std::chrono::nanoseconds p_elapsed) -> void
+			{
+				m_latencies[m_latency_next] = p_elapsed.count();
+				m_latency_next				= (m_latency_next + 1 == m_latencies.size()) ? 0 : m_latency_next + 1;
+				m_latency_count				= std::min(m_latency_count + 1, m_latencies.size());
+
+				// Refresh the percentile every 32 samples; a selection over the window is cheap at that rate
+				if (m_latency_count >= m_options.m_min_samples && m_latency_next % 32 == 0)
+				{
+					std::vector<std::int64_t> samples(m_latencies.begin(), m_latencies.begin() + static_cast<std::ptrdiff_t>(m_latency_count));
+					const std::size_t rank = static_cast<std::size_t>(m_options.m_percentile * static_cast<double>(samples.size() - 1));
+					std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(rank), samples.end());
+					m_tracked_delay = std::chrono::nanoseconds(samples[rank]);
+				}
+			}
+
+			auto fire(const pending_hedge& p_hedge) -> void
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (static_cast<double>(m_stats.m_hedges + 1) > m_options.m_budget * static_cast<double>(m_stats.m_loads))
+					{
+						// Only count denials for loads that are actually still slow
+						std::lock_guard<std::mutex> race_lock(p_hedge.m_race->m_mutex);
+						m_stats.m_budget_denied += p_hedge.m_race->m_done ? 0U : 1U;
+						return;
+					}
+
+					std::lock_guard<std::mutex> race_lock(p_hedge.m_race->m_mutex);
+					if (p_hedge.m_race->m_done)
+					{
+						return;
+					}
+					++p_hedge.m_race->m_running;
+					++m_stats.m_hedges;
+					++m_loads_in_flight;
+				}
+				this->run_load(p_hedge.m_race, p_hedge.m_key, true);
+			}
+
+			auto run_timer() -> void
+			{
+				std::unique_lock<std::mutex> lock(m_timer_mutex);
+				for (;;)
+				{
+					if (m_stopping)
+					{
+						return;
+					}
+					if (m_timers.empty())
+					{
+						m_timer_condition.wait(lock);
+						continue;
+					}
+					if (clock_t::now() < m_timers.top().m_deadline)
+					{
+						m_timer_condition.wait_until(lock, m_timers.top().m_deadline);
+						continue;
+					}
+
+					const pending_hedge due = m_timers.top();
+					m_timers.pop();
+					lock.unlock();
+					this->fire(due);
+					lock.lock();
+				}
+			}
+		};
+	} // namespace async
+} // namespace cache_engine
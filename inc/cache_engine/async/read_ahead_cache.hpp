@@ -0,0 +1,374 @@
+// File: inc/cache_engine/async/read_ahead_cache.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "async_cache.hpp"
+
+namespace cache_engine
+{
+	namespace async
+	{
+		/**
+		 * @brief Tuning of read_ahead_cache stream detection and window sizing
+		 */
+		struct read_ahead_options
+		{
+			std::size_t m_trigger_run	 = 2;	// Consecutive +1 steps before a stream gets its first window
+			std::size_t m_initial_window = 8;	// Keys in the first window of a stream
+			std::size_t m_min_window	 = 2;	// Smallest window after shrinking
+			std::size_t m_max_window	 = 256;	// Largest window after growing
+			std::size_t m_max_streams	 = 64;	// Streams tracked at once; a new stream beyond this drops an old one
+		};
+
+		/**
+		 * @brief Counters of a read_ahead_cache
+		 */
+		struct read_ahead_stats
+		{
+			std::size_t m_requests = 0;	// async_get calls
+			std::size_t m_misses   = 0;	// Requests that went to the single-key loader
+			std::size_t m_batches  = 0;	// Batch loader calls
+			std::size_t m_issued   = 0;	// Keys requested from the batch loader
+			std::size_t m_useful   = 0;	// Prefetched keys that were requested and hit
+			std::size_t m_late	   = 0;	// Prefetched keys requested before their batch arrived
+			std::size_t m_wasted   = 0;	// Prefetched keys dropped when their stream broke off
+
+			/**
+			 * @brief Share of issued keys that were hit before they were dropped
+			 * @return useful / issued, 0 before any prefetch
+			 */
+			auto accuracy() const -> double { return (m_issued == 0) ? 0.0 : static_cast<double>(m_useful) / static_cast<double>(m_issued); }
+		};
+
+		/**
+		 * @brief async_cache with sequential read-ahead for integral keys
+		 *
+		 * Each request names a stream (a caller, a cursor, a connection).
+		 * Once a stream has asked for m_trigger_run + 1 consecutive keys, the
+		 * next window of keys is loaded with one batch loader call on the
+		 * executor while the caller carries on. When the stream reaches the
+		 * middle of its window the read-ahead is confirmed: the window doubles,
+		 * up to m_max_window, and the following window is issued. When the
+		 * stream breaks off, the prefetched keys it never asked for are counted
+		 * as wasted and its window halves, down to m_min_window.
+		 *
+		 * Prefetched values go into the same cache as demand loads. A key whose
+		 * stream broke off before its batch arrived is not inserted, so an
+		 * abandoned window does not evict anything.
+		 *
+		 * @tparam key_t Integral key type
+		 * @tparam value_t Value type (must be copyable)
+		 * @tparam cache_t Synchronous cache type, constructible from a capacity
+		 */
+		template <typename key_t, typename value_t, typename cache_t = cache<key_t, value_t, algorithm::lru>> class read_ahead_cache
+		{
+			static_assert(std::is_integral<key_t>::value, "read_ahead_cache requires integral keys");
+
+		  public:
+			using self_t		 = read_ahead_cache<key_t, value_t, cache_t>;
+			using loader_t		 = typename async_cache<key_t, value_t, cache_t>::loader_t;
+			using batch_loader_t = std::function<task<std::vector<value_t>>(key_t, std::size_t)>;
+			using stream_id_t	 = std::uint64_t;
+
+		  private:
+			/**
+			 * @brief Position and read-ahead state of one sequential stream
+			 */
+			struct stream_state
+			{
+				key_t m_last;			 // Last key the stream asked for
+				std::size_t m_run;		 // Consecutive +1 steps up to m_last
+				std::size_t m_window;	 // Size of the next window
+				bool m_ahead;			 // Whether a window is outstanding
+				key_t m_ahead_end;		 // One past the last key issued for the stream
+				key_t m_trigger;		 // Key whose request confirms the outstanding window
+				std::uint64_t m_touched; // Request counter value at the last request
+			};
+
+			mutable std::mutex m_mutex;
+			std::condition_variable m_idle;
+			async_cache<key_t, value_t, cache_t> m_cache;
+			batch_loader_t m_batch_loader;
+			executor* m_executor;
+			read_ahead_options m_options;
+			std::unordered_map<stream_id_t, stream_state> m_streams;
+			std::unordered_set<key_t> m_ahead_keys;
+			read_ahead_stats m_stats;
+			std::size_t m_batches_in_flight;
+
+		  public:
+			// Constructor
+			read_ahead_cache(std::size_t p_capacity, loader_t p_loader, batch_loader_t p_batch_loader, executor& p_executor, const read_ahead_options& p_options = read_ahead_options())
+				: m_cache(p_capacity, std::move(p_loader), p_executor), m_batch_loader(std::move(p_batch_loader)), m_executor(&p_executor), m_options(p_options),
+				  m_batches_in_flight(0)
+			{
+				if (!m_batch_loader)
+				{
+					throw std::invalid_argument("Read-ahead cache requires a batch loader");
+				}
+				if (m_options.m_min_window == 0 || m_options.m_min_window > m_options.m_max_window || m_options.m_initial_window < m_options.m_min_window ||
+					m_options.m_initial_window > m_options.m_max_window || m_options.m_max_streams == 0)
+				{
+					throw std::invalid_argument("Read-ahead windows must satisfy 0 < min <= initial <= max, with at least one stream");
+				}
+			}
+
+			// Destructor: batches in flight hold a pointer to this cache
+			~read_ahead_cache()
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_idle.wait(lock, [this] { return m_batches_in_flight == 0; });
+			}
+
+			// Deleted copy/move: suspended coroutines hold a pointer to this cache
+			read_ahead_cache(const self_t&)			 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+			read_ahead_cache(self_t&&)				 = delete;
+			auto operator=(self_t&&) -> self_t&		 = delete;
+
+		  public:
+			/**
+			 * @brief Get a value as part of a stream, loading it on a miss and reading ahead on sequential access
+			 * @param p_key The key to look up
+			 * @param p_stream The stream the request belongs to
+			 * @return A task producing the cached or freshly loaded value
+			 */
+			auto async_get(key_t p_key, stream_id_t p_stream = 0) -> task<value_t>
+			{
+				value_t value{};
+				const bool hit = m_cache.try_get(p_key, value);
+
+				key_t first		  = key_t();
+				std::size_t count = 0;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					++m_stats.m_requests;
+					m_stats.m_misses += hit ? 0U : 1U;
+					this->observe(p_stream, p_key, hit, first, count);
+					m_batches_in_flight += (count > 0) ? 1U : 0U;
+				}
+
+				if (count > 0)
+				{
+					this->run_batch(first, count);
+				}
+
+				if (hit)
+				{
+					co_return value;
+				}
+				co_return co_await m_cache.async_get_or_load(p_key);
+			}
+
+			/**
+			 * @brief Synchronous lookup that never loads and does not feed stream detection
+			 */
+			auto try_get(const key_t& p_key, value_t& p_value) -> bool { return m_cache.try_get(p_key, p_value); }
+
+			auto contains(const key_t& p_key) const -> bool { return m_cache.contains(p_key); }
+
+			auto size() const -> std::size_t { return m_cache.size(); }
+
+			/**
+			 * @brief Get a snapshot of the read-ahead counters
+			 * @return The counters
+			 */
+			auto stats() const -> read_ahead_stats
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_stats;
+			}
+
+			/**
+			 * @brief Get the window size the next read-ahead of a stream will use
+			 * @param p_stream The stream
+			 * @return The window size (0 for an unknown stream)
+			 */
+			auto window(stream_id_t p_stream) const -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				auto stream_iter = m_streams.find(p_stream);
+				return (stream_iter != m_streams.end()) ? stream_iter->second.m_window : 0;
+			}
+
+			/**
+			 * @brief Block until every issued batch has been loaded and inserted
+			 */
+			auto wait_idle() -> void
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_idle.wait(lock, [this] { return m_batches_in_flight == 0; });
+			}
+
+		  private:
+			/**
+			 * @brief Advance a stream by one request and decide which keys to read ahead
+			 * @param p_first Receives the first key to load
+			 * @param p_count Receives the number of keys to load (0 for none)
+			 */
+			auto observe(stream_id_t p_stream, key_t p_key, bool p_hit, key_t& p_first, std::size_t& p_count) -> void
+			{
+				// Account for the key first: it may belong to any stream's window
+				if (m_ahead_keys.erase(p_key) > 0)
+				{
+					++(p_hit ? m_stats.m_useful : m_stats.m_late);
+				}
+
+				auto stream_iter = m_streams.find(p_stream);
+				if (stream_iter == m_streams.end())
+				{
+					if (m_streams.size() >= m_options.m_max_streams)
+					{
+						this->drop_oldest_stream();
+					}
+					const stream_state fresh = {p_key, 0, m_options.m_initial_window, false, key_t(), key_t(), m_stats.m_requests};
+					m_streams.emplace(p_stream, fresh);
+					return;
+				}
+
+				stream_state& stream = stream_iter->second;
+				stream.m_touched	 = m_stats.m_requests;
+				if (p_key == stream.m_last)
+				{
+					return;
+				}
+				if (stream.m_last == std::numeric_limits<key_t>::max() || p_key != static_cast<key_t>(stream.m_last + 1))
+				{
+					// The stream broke off: whatever it did not reach was read ahead for nothing
+					this->retire(stream);
+					stream.m_last = p_key;
+					stream.m_run  = 0;
+					return;
+				}
+
+				stream.m_last = p_key;
+				++stream.m_run;
+				if (!stream.m_ahead)
+				{
+					if (stream.m_run >= m_options.m_trigger_run && p_key != std::numeric_limits<key_t>::max())
+					{
+						this->issue(stream, static_cast<key_t>(p_key + 1), p_first, p_count);
+					}
+				}
+				else if (p_key >= stream.m_trigger)
+				{
+					// Confirmed: the stream is consuming its window, so the next one may be larger
+					stream.m_window = std::min(stream.m_window * 2, m_options.m_max_window);
+					this->issue(stream, stream.m_ahead_end, p_first, p_count);
+				}
+			}
+
+			auto issue(stream_state& p_stream, key_t p_first, key_t& p_out_first, std::size_t& p_out_count) -> void
+			{
+				// Stop short of the end of the key range; unsigned subtraction is exact for signed keys too
+				const std::uintmax_t room = static_cast<std::uintmax_t>(std::numeric_limits<key_t>::max()) - static_cast<std::uintmax_t>(p_first);
+				const std::size_t count	  = static_cast<std::size_t>(std::min<std::uintmax_t>(p_stream.m_window, room));
+				if (count == 0)
+				{
+					// End of the key range: nothing more to read ahead, and no window left for retire() to walk
+					p_stream.m_ahead = false;
+					return;
+				}
+
+				for (std::size_t idx_for = 0; idx_for < count; ++idx_for)
+				{
+					m_ahead_keys.insert(static_cast<key_t>(p_first + static_cast<key_t>(idx_for)));
+				}
+				p_stream.m_ahead	 = true;
+				p_stream.m_ahead_end = static_cast<key_t>(p_first + static_cast<key_t>(count));
+				p_stream.m_trigger	 = static_cast<key_t>(p_first + static_cast<key_t>(count / 2));
+				m_stats.m_batches += 1;
+				m_stats.m_issued += count;
+				p_out_first = p_first;
+				p_out_count = count;
+			}
+
+			auto retire(stream_state& p_stream) -> void
+			{
+				// A stream at or past the end of its window has nothing left to waste, and m_last + 1 may overflow
+				if (!p_stream.m_ahead || p_stream.m_last >= p_stream.m_ahead_end)
+				{
+					p_stream.m_ahead = false;
+					return;
+				}
+
+				std::size_t wasted = 0;
+				for (key_t key = static_cast<key_t>(p_stream.m_last + 1); key != p_stream.m_ahead_end; ++key)
+				{
+					wasted += m_ahead_keys.erase(key);
+				}
+				m_stats.m_wasted += wasted;
+				if (wasted > 0)
+				{
+					p_stream.m_window = std::max(p_stream.m_window / 2, m_options.m_min_window);
+				}
+				p_stream.m_ahead = false;
+			}
+
+			auto drop_oldest_stream() -> void
+			{
+				auto oldest = m_streams.begin();
+				for (auto stream_iter = m_streams.begin(); stream_iter != m_streams.end(); ++stream_iter)
+				{
+					oldest = (stream_iter->second.m_touched < oldest->second.m_touched) ? stream_iter : oldest;
+				}
+				this->retire(oldest->second);
+				m_streams.erase(oldest);
+			}
+
+			auto run_batch(key_t p_first, std::size_t p_count) -> detail::detached_task
+			{
+				// Hop onto the executor so the requesting coroutine is not held up by the batch
+				co_await m_executor->schedule();
+
+				std::vector<value_t> values;
+				bool loaded = true;
+				try
+				{
+					values = co_await m_batch_loader(p_first, p_count);
+				}
+				catch (...)
+				{
+					loaded = false;
+				}
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+				{
+					const key_t key = static_cast<key_t>(p_first + static_cast<key_t>(idx_for));
+					if (m_ahead_keys.count(key) == 0)
+					{
+						// Dropped with its stream, or already loaded on demand
+						continue;
+					}
+					if (loaded && idx_for < values.size())
+					{
+						m_cache.put(key, values[idx_for]);
+					}
+					else
+					{
+						// A failed or short batch is waste; demand loads will fetch these keys
+						m_ahead_keys.erase(key);
+						++m_stats.m_wasted;
+					}
+				}
+				--m_batches_in_flight;
+				m_idle.notify_all();
+			}
+		};
+	} // namespace async
+} // namespace cache_engine
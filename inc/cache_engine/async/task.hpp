@@ -0,0 +1,297 @@
+// File: inc/cache_engine/async/task.hpp
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) || (__cplusplus < 202002L)
+#error "cache_engine/async requires C++20 coroutines (enable CACHE_ENGINE_BUILD_COROUTINES)"
+#endif
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace cache_engine
+{
+	namespace async
+	{
+		template <typename value_t> class task;
+
+		namespace detail
+		{
+			/**
+			 * @brief State shared by every task promise: continuation and captured exception
+			 */
+			struct task_promise_base
+			{
+				std::coroutine_handle<> m_continuation;
+				std::exception_ptr m_exception;
+
+				/**
+				 * @brief Resumes the awaiting coroutine by symmetric transfer when the task finishes
+				 */
+				struct final_awaiter
+				{
+					auto await_ready() const noexcept -> bool { return false; }
+
+					template <typename promise_t> auto await_suspend(std::coroutine_handle<promise_t> p_handle) noexcept -> std::coroutine_handle<>
+					{
+						std::coroutine_handle<> continuation = p_handle.promise().m_continuation;
+						return continuation ? continuation : std::noop_coroutine();
+					}
+
+					auto await_resume() const noexcept -> void {}
+				};
+
+				auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+
+				auto final_suspend() const noexcept -> final_awaiter { return {}; }
+
+				auto unhandled_exception() noexcept -> void { m_exception = std::current_exception(); }
+			};
+
+			template <typename value_t> struct task_promise : task_promise_base
+			{
+				std::optional<value_t> m_value;
+
+				auto get_return_object() noexcept -> task<value_t>;
+
+				template <typename result_t> auto return_value(result_t&& p_value) -> void { m_value.emplace(std::forward<result_t>(p_value)); }
+
+				auto result() -> value_t
+				{
+					if (m_exception)
+					{
+						std::rethrow_exception(m_exception);
+					}
+					return std::move(*m_value);
+				}
+			};
+
+			template <> struct task_promise<void> : task_promise_base
+			{
+				auto get_return_object() noexcept -> task<void>;
+
+				auto return_void() const noexcept -> void {}
+
+				auto result() -> void
+				{
+					if (m_exception)
+					{
+						std::rethrow_exception(m_exception);
+					}
+				}
+			};
+
+			/**
+			 * @brief Eagerly started, self-destroying coroutine used to drive a task from synchronous code
+			 */
+			struct detached_task
+			{
+				struct promise_type
+				{
+					auto get_return_object() const noexcept -> detached_task { return {}; }
+
+					auto initial_suspend() const noexcept -> std::suspend_never { return {}; }
+
+					auto final_suspend() const noexcept -> std::suspend_never { return {}; }
+
+					auto return_void() const noexcept -> void {}
+
+					auto unhandled_exception() const noexcept -> void { std::terminate(); }
+				};
+			};
+		} // namespace detail
+
+		/**
+		 * @brief Lazily started, single-consumer coroutine task
+		 *
+		 * The coroutine body does not run until the task is awaited. Completion
+		 * resumes the awaiter by symmetric transfer, so long await chains do not
+		 * grow the stack. Exceptions thrown by the body are rethrown at the
+		 * co_await site.
+		 *
+		 * @tparam value_t Result type (void allowed)
+		 */
+		template <typename value_t> class task
+		{
+		  public:
+			using self_t	   = task<value_t>;
+			using promise_type = detail::task_promise<value_t>;
+			using handle_t	   = std::coroutine_handle<promise_type>;
+
+		  private:
+			handle_t m_handle;
+
+		  public:
+			// Constructor
+			task() noexcept : m_handle(nullptr) {}
+
+			explicit task(handle_t p_handle) noexcept : m_handle(p_handle) {}
+
+			// Destructor
+			~task()
+			{
+				if (m_handle)
+				{
+					m_handle.destroy();
+				}
+			}
+
+			// Deleted copy constructor and assignment operator
+			task(const self_t&)						 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			// Move constructor and assignment operator
+			task(self_t&& p_other) noexcept : m_handle(std::exchange(p_other.m_handle, nullptr)) {}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					if (m_handle)
+					{
+						m_handle.destroy();
+					}
+					m_handle = std::exchange(p_other.m_handle, nullptr);
+				}
+				return *this;
+			}
+
+		  public:
+			/**
+			 * @brief Awaiter that starts the task and resumes the caller when it finishes
+			 */
+			struct awaiter
+			{
+				handle_t m_handle;
+
+				auto await_ready() const noexcept -> bool { return !m_handle || m_handle.done(); }
+
+				auto await_suspend(std::coroutine_handle<> p_continuation) noexcept -> std::coroutine_handle<>
+				{
+					m_handle.promise().m_continuation = p_continuation;
+					return m_handle;
+				}
+
+				auto await_resume() -> value_t { return m_handle.promise().result(); }
+			};
+
+			auto operator co_await() const& noexcept -> awaiter { return awaiter{m_handle}; }
+
+			/**
+			 * @brief Check whether the task owns a coroutine
+			 * @return true if the task can be awaited
+			 */
+			auto valid() const noexcept -> bool { return static_cast<bool>(m_handle); }
+
+			/**
+			 * @brief Check whether the coroutine has run to completion
+			 * @return true if the result is available
+			 */
+			auto done() const noexcept -> bool { return m_handle && m_handle.done(); }
+		};
+
+		namespace detail
+		{
+			template <typename value_t> auto task_promise<value_t>::get_return_object() noexcept -> task<value_t>
+			{
+				return task<value_t>(std::coroutine_handle<task_promise<value_t>>::from_promise(*this));
+			}
+
+			inline auto task_promise<void>::get_return_object() noexcept -> task<void> { return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this)); }
+
+			/**
+			 * @brief Completion flag a blocking caller waits on
+			 */
+			struct sync_wait_event
+			{
+				std::mutex m_mutex;
+				std::condition_variable m_condition;
+				bool m_done = false;
+
+				auto set() -> void
+				{
+					// Notify under the lock: the waiter owns this object and may destroy it as soon as it sees m_done
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_done = true;
+					m_condition.notify_one();
+				}
+
+				auto wait() -> void
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_condition.wait(lock, [this] { return m_done; });
+				}
+			};
+
+			template <typename value_t>
+			auto sync_wait_runner(task<value_t>& p_task, std::optional<value_t>& p_result, std::exception_ptr& p_exception, sync_wait_event& p_event) -> detached_task
+			{
+				try
+				{
+					p_result.emplace(co_await p_task);
+				}
+				catch (...)
+				{
+					p_exception = std::current_exception();
+				}
+				p_event.set();
+			}
+
+			inline auto sync_wait_runner(task<void>& p_task, std::exception_ptr& p_exception, sync_wait_event& p_event) -> detached_task
+			{
+				try
+				{
+					co_await p_task;
+				}
+				catch (...)
+				{
+					p_exception = std::current_exception();
+				}
+				p_event.set();
+			}
+		} // namespace detail
+
+		/**
+		 * @brief Block the calling thread until a task completes
+		 *
+		 * Intended for the edges of a program (main, tests, benchmarks); the task
+		 * may finish on any executor thread.
+		 *
+		 * @param p_task The task to run
+		 * @return The task result
+		 */
+		template <typename value_t> auto sync_wait(task<value_t> p_task) -> value_t
+		{
+			std::optional<value_t> result;
+			std::exception_ptr exception;
+			detail::sync_wait_event event;
+
+			detail::sync_wait_runner(p_task, result, exception, event);
+			event.wait();
+
+			if (exception)
+			{
+				std::rethrow_exception(exception);
+			}
+			return std::move(*result);
+		}
+
+		inline auto sync_wait(task<void> p_task) -> void
+		{
+			std::exception_ptr exception;
+			detail::sync_wait_event event;
+
+			detail::sync_wait_runner(p_task, exception, event);
+			event.wait();
+
+			if (exception)
+			{
+				std::rethrow_exception(exception);
+			}
+		}
+	} // namespace async
+} // namespace cache_engine
@@ -27,14 +27,22 @@
  */
 
 // Core includes for both template specialization and policy-based implementations
+#include <atomic>
 #include <cstdlib>
 #include <ctime>
+#include <exception>
+#include <functional>
+#include <iterator>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <stdexcept>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include "policies/policy_interfaces.hpp"
 #include "policies/policy_traits.hpp"
@@ -56,6 +64,81 @@ namespace cache_engine
 		class random_cache; // Random Replacement
 	} // namespace algorithm
 
+	/**
+	 * @brief Bytes a cache holds on the heap, per component
+	 *
+	 * Returned by memory_usage() of policy_based_cache and of the cache
+	 * specializations. Every figure comes from sizes the containers and the
+	 * caches already keep, so a report costs O(1) and can be exported
+	 * continuously. Container bytes are estimates of the standard library
+	 * node layouts (see policies::containers::heap_bytes); heap owned by the
+	 * keys and values themselves is only known once a heap size function is
+	 * set, and is 0 otherwise.
+	 */
+	struct memory_report
+	{
+		std::size_t m_storage_nodes		= 0; // Entry nodes or slots, with the keys and values stored in them
+		std::size_t m_bucket_arrays		= 0; // Hash bucket (or control byte) arrays of the storage
+		std::size_t m_eviction_metadata = 0; // Recency lists, frequency buckets and victim indexes
+		std::size_t m_access_metadata	= 0; // Per-key state of the access policy
+		std::size_t m_owned_heap		= 0; // Heap owned by keys and values, from the heap size function
+
+		auto total() const -> std::size_t { return m_storage_nodes + m_bucket_arrays + m_eviction_metadata + m_access_metadata + m_owned_heap; }
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Running total of the heap owned by the cached keys and values
+		 *
+		 * A cache calls add() for every entry it stores and remove() for every
+		 * entry that leaves, so the total is read in O(1). Without a size
+		 * function each call is a single branch.
+		 */
+		template <typename key_t, typename value_t> class heap_meter
+		{
+		  public:
+			using size_function = std::function<std::size_t(const key_t&, const value_t&)>;
+
+		  private:
+			size_function m_size_of;
+			std::size_t m_bytes;
+
+		  public:
+			// Constructor
+			heap_meter() : m_size_of(), m_bytes(0) {}
+
+			auto enabled() const -> bool { return static_cast<bool>(m_size_of); }
+
+			auto add(const key_t& p_key, const value_t& p_value) -> void
+			{
+				if (m_size_of)
+				{
+					m_bytes += m_size_of(p_key, p_value);
+				}
+			}
+
+			auto remove(const key_t& p_key, const value_t& p_value) -> void
+			{
+				if (m_size_of)
+				{
+					m_bytes -= m_size_of(p_key, p_value);
+				}
+			}
+
+			// Start over with a new function (or none); the caller adds the current entries again
+			auto reset(size_function p_size_of) -> void
+			{
+				m_size_of = std::move(p_size_of);
+				m_bytes	  = 0;
+			}
+
+			auto clear() -> void { m_bytes = 0; }
+
+			auto bytes() const -> std::size_t { return m_bytes; }
+		};
+	} // namespace detail
+
 	template <typename key_t, typename value_t, typename algorithm_t = algorithm::lru> class cache;
 
 	template <typename key_t, typename value_t> class cache<key_t, value_t, algorithm::lru>
@@ -67,8 +150,11 @@ namespace cache_engine
 		std::list<key_t> m_list;
 		std::unordered_map<key_t, std::pair<value_t, typename std::list<key_t>::iterator>> m_map;
 		std::size_t m_capacity;
+		detail::heap_meter<key_t, value_t> m_heap_meter;
 
 	  public:
+		using size_function = typename detail::heap_meter<key_t, value_t>::size_function;
+
 		explicit cache(std::size_t p_capacity) : m_capacity(p_capacity) {}
 
 		// Destructor
@@ -79,32 +165,61 @@ namespace cache_engine
 		auto operator=(const self_t&) -> self_t& = delete;
 
 		// Move constructor and assignment operator
-		cache(self_t&& p_other) noexcept : m_list(std::move(p_other.m_list)), m_map(std::move(p_other.m_map)), m_capacity(p_other.m_capacity) {}
+		cache(self_t&& p_other) noexcept
+			: m_list(std::move(p_other.m_list)), m_map(std::move(p_other.m_map)), m_capacity(p_other.m_capacity), m_heap_meter(std::move(p_other.m_heap_meter))
+		{
+		}
 
 		auto operator=(self_t&& p_other) noexcept -> self_t&
 		{
 			if (this != &p_other)
 			{
-				m_list	   = std::move(p_other.m_list);
-				m_map	   = std::move(p_other.m_map);
-				m_capacity = p_other.m_capacity;
+				m_list		 = std::move(p_other.m_list);
+				m_map		 = std::move(p_other.m_map);
+				m_capacity	 = p_other.m_capacity;
+				m_heap_meter = std::move(p_other.m_heap_meter);
 			}
 			return *this;
 		}
 
 		auto put(const key_t& p_key, const value_t& p_value) -> void
 		{
-			if (m_map.find(p_key) != m_map.end())
+			if (m_capacity == 0)
+			{
+				return;
+			}
+
+			// Before C++17 emplace builds the node ahead of the probe and frees it again on an update,
+			// which costs more than a second probe, so an existing key is looked up first there
+#if __cplusplus >= 201703L
+			const auto emplaced = m_map.try_emplace(p_key, p_value, m_list.end());
+#else
+			auto emplaced = std::make_pair(m_map.find(p_key), false);
+			if (emplaced.first == m_map.end())
 			{
-				m_list.erase(m_map[p_key].second);
+				emplaced = m_map.emplace(std::piecewise_construct, std::forward_as_tuple(p_key), std::forward_as_tuple(p_value, m_list.end()));
 			}
-			else if (m_map.size() >= m_capacity)
+#endif
+			auto& slot = emplaced.first->second;
+			if (!emplaced.second)
 			{
-				m_map.erase(m_list.back());
+				m_heap_meter.remove(p_key, slot.first);
+				slot.first = p_value;
+				m_heap_meter.add(p_key, slot.first);
+				m_list.splice(m_list.begin(), m_list, slot.second);
+				return;
+			}
+			if (m_map.size() > m_capacity)
+			{
+				// The new key is not linked yet, so the victim is never the key being put
+				const auto victim = m_map.find(m_list.back());
+				m_heap_meter.remove(victim->first, victim->second.first);
+				m_map.erase(victim);
 				m_list.pop_back();
 			}
 			m_list.push_front(p_key);
-			m_map[p_key] = {p_value, m_list.begin()};
+			slot.second = m_list.begin();
+			m_heap_meter.add(p_key, slot.first);
 		}
 
 		auto get(const key_t& p_key) -> value_t
@@ -131,6 +246,34 @@ namespace cache_engine
 		{
 			m_map.clear();
 			m_list.clear();
+			m_heap_meter.clear();
+		}
+
+		/**
+		 * @brief Count the heap owned by keys and values in memory_usage()
+		 * @param p_size_of Heap bytes of one entry, the same for an entry when stored and when removed; empty to stop counting
+		 */
+		auto set_heap_size_function(size_function p_size_of) -> void
+		{
+			m_heap_meter.reset(std::move(p_size_of));
+			for (const auto& entry : m_map)
+			{
+				m_heap_meter.add(entry.first, entry.second.first);
+			}
+		}
+
+		/**
+		 * @brief Get the heap bytes of the cache per component, in O(1)
+		 * @return The map nodes and buckets, the recency list and the owned heap
+		 */
+		auto memory_usage() const -> memory_report
+		{
+			memory_report report;
+			report.m_storage_nodes	   = policies::containers::node_bytes(m_map);
+			report.m_bucket_arrays	   = policies::containers::bucket_bytes(m_map);
+			report.m_eviction_metadata = policies::containers::heap_bytes(m_list);
+			report.m_owned_heap		   = m_heap_meter.bytes();
+			return report;
 		}
 	};
 
@@ -143,8 +286,11 @@ namespace cache_engine
 		std::unordered_map<key_t, value_t> m_map;
 		std::queue<key_t> m_queue;
 		std::size_t m_capacity;
+		detail::heap_meter<key_t, value_t> m_heap_meter;
 
 	  public:
+		using size_function = typename detail::heap_meter<key_t, value_t>::size_function;
+
 		explicit cache(std::size_t p_capacity) : m_capacity(p_capacity) {}
 
 		// Destructor
@@ -155,35 +301,57 @@ namespace cache_engine
 		auto operator=(const self_t&) -> self_t& = delete;
 
 		// Move constructor and assignment operator
-		cache(self_t&& p_other) noexcept : m_map(std::move(p_other.m_map)), m_queue(std::move(p_other.m_queue)), m_capacity(p_other.m_capacity) {}
+		cache(self_t&& p_other) noexcept
+			: m_map(std::move(p_other.m_map)), m_queue(std::move(p_other.m_queue)), m_capacity(p_other.m_capacity), m_heap_meter(std::move(p_other.m_heap_meter))
+		{
+		}
 
 		auto operator=(self_t&& p_other) noexcept -> self_t&
 		{
 			if (this != &p_other)
 			{
-				m_map	   = std::move(p_other.m_map);
-				m_queue	   = std::move(p_other.m_queue);
-				m_capacity = p_other.m_capacity;
+				m_map		 = std::move(p_other.m_map);
+				m_queue		 = std::move(p_other.m_queue);
+				m_capacity	 = p_other.m_capacity;
+				m_heap_meter = std::move(p_other.m_heap_meter);
 			}
 			return *this;
 		}
 
 		auto put(const key_t& p_key, const value_t& p_value) -> void
 		{
-			if (m_map.find(p_key) != m_map.end())
+			if (m_capacity == 0)
 			{
-				m_map[p_key] = p_value;
 				return;
 			}
 
-			if (m_map.size() >= m_capacity)
+#if __cplusplus >= 201703L
+			const auto emplaced = m_map.try_emplace(p_key, p_value);
+#else
+			auto emplaced = std::make_pair(m_map.find(p_key), false);
+			if (emplaced.first == m_map.end())
+			{
+				emplaced = m_map.emplace(std::piecewise_construct, std::forward_as_tuple(p_key), std::forward_as_tuple(p_value));
+			}
+#endif
+			auto& value = emplaced.first->second;
+			if (!emplaced.second)
 			{
-				m_map.erase(m_queue.front());
+				m_heap_meter.remove(p_key, value);
+				value = p_value;
+				m_heap_meter.add(p_key, value);
+				return;
+			}
+			if (m_map.size() > m_capacity)
+			{
+				// The new key is not queued yet, so the victim is never the key being put
+				const auto victim = m_map.find(m_queue.front());
+				m_heap_meter.remove(victim->first, victim->second);
+				m_map.erase(victim);
 				m_queue.pop();
 			}
-
-			m_map[p_key] = p_value;
 			m_queue.push(p_key);
+			m_heap_meter.add(p_key, value);
 		}
 
 		auto get(const key_t& p_key) -> value_t { return m_map.at(p_key); }
@@ -204,6 +372,34 @@ namespace cache_engine
 			{
 				m_queue.pop();
 			}
+			m_heap_meter.clear();
+		}
+
+		/**
+		 * @brief Count the heap owned by keys and values in memory_usage()
+		 * @param p_size_of Heap bytes of one entry, the same for an entry when stored and when removed; empty to stop counting
+		 */
+		auto set_heap_size_function(size_function p_size_of) -> void
+		{
+			m_heap_meter.reset(std::move(p_size_of));
+			for (const auto& entry : m_map)
+			{
+				m_heap_meter.add(entry.first, entry.second);
+			}
+		}
+
+		/**
+		 * @brief Get the heap bytes of the cache per component, in O(1)
+		 * @return The map nodes and buckets, the insertion queue and the owned heap
+		 */
+		auto memory_usage() const -> memory_report
+		{
+			memory_report report;
+			report.m_storage_nodes	   = policies::containers::node_bytes(m_map);
+			report.m_bucket_arrays	   = policies::containers::bucket_bytes(m_map);
+			report.m_eviction_metadata = policies::containers::heap_bytes(m_queue);
+			report.m_owned_heap		   = m_heap_meter.bytes();
+			return report;
 		}
 	};
 
@@ -213,11 +409,29 @@ namespace cache_engine
 		using self_t = cache<key_t, value_t, algorithm::lfu>;
 
 	  private:
-		std::unordered_map<key_t, std::pair<value_t, std::size_t>> m_map;
-		std::map<std::size_t, std::list<key_t>> m_freq_map;
+		using key_list_t = std::list<key_t>;
+		using freq_map_t = std::map<std::size_t, key_list_t>;
+
+		/**
+		 * @brief Entry with direct handles to its frequency bucket and its position in that bucket
+		 */
+		struct entry
+		{
+			value_t m_value;
+			typename freq_map_t::iterator m_bucket;
+			typename key_list_t::iterator m_position;
+
+			entry(const value_t& p_value, typename freq_map_t::iterator p_bucket, typename key_list_t::iterator p_position) : m_value(p_value), m_bucket(p_bucket), m_position(p_position) {}
+		};
+
+		std::unordered_map<key_t, entry> m_map;
+		freq_map_t m_freq_map;
 		std::size_t m_capacity;
+		detail::heap_meter<key_t, value_t> m_heap_meter;
 
 	  public:
+		using size_function = typename detail::heap_meter<key_t, value_t>::size_function;
+
 		explicit cache(std::size_t p_capacity) : m_capacity(p_capacity) {}
 
 		// Destructor
@@ -228,15 +442,19 @@ namespace cache_engine
 		auto operator=(const self_t&) -> self_t& = delete;
 
 		// Move constructor and assignment operator
-		cache(self_t&& p_other) noexcept : m_map(std::move(p_other.m_map)), m_freq_map(std::move(p_other.m_freq_map)), m_capacity(p_other.m_capacity) {}
+		cache(self_t&& p_other) noexcept
+			: m_map(std::move(p_other.m_map)), m_freq_map(std::move(p_other.m_freq_map)), m_capacity(p_other.m_capacity), m_heap_meter(std::move(p_other.m_heap_meter))
+		{
+		}
 
 		auto operator=(self_t&& p_other) noexcept -> self_t&
 		{
 			if (this != &p_other)
 			{
-				m_map	   = std::move(p_other.m_map);
-				m_freq_map = std::move(p_other.m_freq_map);
-				m_capacity = p_other.m_capacity;
+				m_map		 = std::move(p_other.m_map);
+				m_freq_map	 = std::move(p_other.m_freq_map);
+				m_capacity	 = p_other.m_capacity;
+				m_heap_meter = std::move(p_other.m_heap_meter);
 			}
 			return *this;
 		}
@@ -248,33 +466,46 @@ namespace cache_engine
 				return;
 			}
 
-			if (m_map.find(p_key) != m_map.end())
+#if __cplusplus >= 201703L
+			const auto emplaced = m_map.try_emplace(p_key, p_value, m_freq_map.end(), typename key_list_t::iterator());
+#else
+			auto emplaced = std::make_pair(m_map.find(p_key), false);
+			if (emplaced.first == m_map.end())
 			{
-				m_map[p_key].first = p_value;
-
-				auto& freq = m_map[p_key].second;
-				m_freq_map[freq].remove(p_key);
-				if (m_freq_map[freq].empty())
-				{
-					m_freq_map.erase(freq);
-				}
-				freq++;
-				m_freq_map[freq].push_back(p_key);
-
+				emplaced = m_map.emplace(std::piecewise_construct, std::forward_as_tuple(p_key), std::forward_as_tuple(p_value, m_freq_map.end(), typename key_list_t::iterator()));
+			}
+#endif
+			entry& slot = emplaced.first->second;
+			if (!emplaced.second)
+			{
+				m_heap_meter.remove(p_key, slot.m_value);
+				slot.m_value = p_value;
+				m_heap_meter.add(p_key, slot.m_value);
+				this->touch(slot);
 				return;
 			}
-			if (m_map.size() >= m_capacity)
+			if (m_map.size() > m_capacity)
 			{
+				// The new key is in no bucket yet, so the victim is never the key being put
 				auto& least_freq_list = m_freq_map.begin()->second;
-				m_map.erase(least_freq_list.front());
+				const auto victim	  = m_map.find(least_freq_list.front());
+				m_heap_meter.remove(victim->first, victim->second.m_value);
+				m_map.erase(victim);
 				least_freq_list.pop_front();
 				if (least_freq_list.empty())
 				{
 					m_freq_map.erase(m_freq_map.begin());
 				}
 			}
-			m_map[p_key] = {p_value, 1};
-			m_freq_map[1].push_back(p_key);
+			auto bucket = m_freq_map.begin();
+			if (bucket == m_freq_map.end() || bucket->first != 1)
+			{
+				bucket = m_freq_map.emplace_hint(bucket, 1, key_list_t());
+			}
+			bucket->second.push_back(p_key);
+			slot.m_bucket	= bucket;
+			slot.m_position = std::prev(bucket->second.end());
+			m_heap_meter.add(p_key, slot.m_value);
 		}
 
 		auto get(const key_t& p_key) -> value_t
@@ -285,18 +516,8 @@ namespace cache_engine
 				throw std::out_of_range("Key not found");
 			}
 
-			auto& freq = iter->second.second;
-			auto& val  = iter->second.first;
-
-			m_freq_map[freq].remove(p_key);
-			if (m_freq_map[freq].empty())
-			{
-				m_freq_map.erase(freq);
-			}
-
-			freq++;
-			m_freq_map[freq].push_back(p_key);
-			return val;
+			this->touch(iter->second);
+			return iter->second.m_value;
 		}
 
 		// Additional utility methods
@@ -312,6 +533,58 @@ namespace cache_engine
 		{
 			m_map.clear();
 			m_freq_map.clear();
+			m_heap_meter.clear();
+		}
+
+		/**
+		 * @brief Count the heap owned by keys and values in memory_usage()
+		 * @param p_size_of Heap bytes of one entry, the same for an entry when stored and when removed; empty to stop counting
+		 */
+		auto set_heap_size_function(size_function p_size_of) -> void
+		{
+			m_heap_meter.reset(std::move(p_size_of));
+			for (const auto& item : m_map)
+			{
+				m_heap_meter.add(item.first, item.second.m_value);
+			}
+		}
+
+		/**
+		 * @brief Get the heap bytes of the cache per component, in O(1)
+		 * @return The map nodes and buckets, the frequency buckets with their key lists and the owned heap
+		 */
+		auto memory_usage() const -> memory_report
+		{
+			memory_report report;
+			report.m_storage_nodes = policies::containers::node_bytes(m_map);
+			report.m_bucket_arrays = policies::containers::bucket_bytes(m_map);
+			// Every key sits in exactly one frequency list
+			report.m_eviction_metadata = policies::containers::heap_bytes(m_freq_map) + m_map.size() * policies::containers::list_node_bytes<key_t>();
+			report.m_owned_heap		   = m_heap_meter.bytes();
+			return report;
+		}
+
+	  private:
+		/**
+		 * @brief Move an entry to the next frequency bucket without searching either bucket
+		 */
+		auto touch(entry& p_entry) -> void
+		{
+			const auto current				 = p_entry.m_bucket;
+			const std::size_t next_frequency = current->first + 1;
+
+			auto next = std::next(current);
+			if (next == m_freq_map.end() || next->first != next_frequency)
+			{
+				next = m_freq_map.emplace_hint(next, next_frequency, key_list_t());
+			}
+			next->second.splice(next->second.end(), current->second, p_entry.m_position);
+			p_entry.m_bucket = next;
+
+			if (current->second.empty())
+			{
+				m_freq_map.erase(current);
+			}
 		}
 	};
 
@@ -321,11 +594,29 @@ namespace cache_engine
 		using self_t = cache<key_t, value_t, algorithm::mfu>;
 
 	  private:
-		std::unordered_map<key_t, std::pair<value_t, std::size_t>> m_map;
-		std::map<std::size_t, std::list<key_t>> m_freq_map;
+		using key_list_t = std::list<key_t>;
+		using freq_map_t = std::map<std::size_t, key_list_t>;
+
+		/**
+		 * @brief Entry with direct handles to its frequency bucket and its position in that bucket
+		 */
+		struct entry
+		{
+			value_t m_value;
+			typename freq_map_t::iterator m_bucket;
+			typename key_list_t::iterator m_position;
+
+			entry(const value_t& p_value, typename freq_map_t::iterator p_bucket, typename key_list_t::iterator p_position) : m_value(p_value), m_bucket(p_bucket), m_position(p_position) {}
+		};
+
+		std::unordered_map<key_t, entry> m_map;
+		freq_map_t m_freq_map;
 		std::size_t m_capacity;
+		detail::heap_meter<key_t, value_t> m_heap_meter;
 
 	  public:
+		using size_function = typename detail::heap_meter<key_t, value_t>::size_function;
+
 		explicit cache(std::size_t p_capacity) : m_capacity(p_capacity) {}
 
 		// Destructor
@@ -336,15 +627,19 @@ namespace cache_engine
 		auto operator=(const self_t&) -> self_t& = delete;
 
 		// Move constructor and assignment operator
-		cache(self_t&& p_other) noexcept : m_map(std::move(p_other.m_map)), m_freq_map(std::move(p_other.m_freq_map)), m_capacity(p_other.m_capacity) {}
+		cache(self_t&& p_other) noexcept
+			: m_map(std::move(p_other.m_map)), m_freq_map(std::move(p_other.m_freq_map)), m_capacity(p_other.m_capacity), m_heap_meter(std::move(p_other.m_heap_meter))
+		{
+		}
 
 		auto operator=(self_t&& p_other) noexcept -> self_t&
 		{
 			if (this != &p_other)
 			{
-				m_map	   = std::move(p_other.m_map);
-				m_freq_map = std::move(p_other.m_freq_map);
-				m_capacity = p_other.m_capacity;
+				m_map		 = std::move(p_other.m_map);
+				m_freq_map	 = std::move(p_other.m_freq_map);
+				m_capacity	 = p_other.m_capacity;
+				m_heap_meter = std::move(p_other.m_heap_meter);
 			}
 			return *this;
 		}
@@ -356,33 +651,46 @@ namespace cache_engine
 				return;
 			}
 
-			if (m_map.find(p_key) != m_map.end())
+#if __cplusplus >= 201703L
+			const auto emplaced = m_map.try_emplace(p_key, p_value, m_freq_map.end(), typename key_list_t::iterator());
+#else
+			auto emplaced = std::make_pair(m_map.find(p_key), false);
+			if (emplaced.first == m_map.end())
 			{
-				m_map[p_key].first = p_value;
-
-				auto& freq = m_map[p_key].second;
-				m_freq_map[freq].remove(p_key);
-				if (m_freq_map[freq].empty())
-				{
-					m_freq_map.erase(freq);
-				}
-				freq++;
-				m_freq_map[freq].push_back(p_key);
-
+				emplaced = m_map.emplace(std::piecewise_construct, std::forward_as_tuple(p_key), std::forward_as_tuple(p_value, m_freq_map.end(), typename key_list_t::iterator()));
+			}
+#endif
+			entry& slot = emplaced.first->second;
+			if (!emplaced.second)
+			{
+				m_heap_meter.remove(p_key, slot.m_value);
+				slot.m_value = p_value;
+				m_heap_meter.add(p_key, slot.m_value);
+				this->touch(slot);
 				return;
 			}
-			if (m_map.size() >= m_capacity)
+			if (m_map.size() > m_capacity)
 			{
-				auto& most_freq_list = m_freq_map.rbegin()->second;
-				m_map.erase(most_freq_list.front());
-				most_freq_list.pop_front();
-				if (most_freq_list.empty())
+				// The new key is in no bucket yet, so the victim is never the key being put
+				const auto most_freq = std::prev(m_freq_map.end());
+				const auto victim	 = m_map.find(most_freq->second.front());
+				m_heap_meter.remove(victim->first, victim->second.m_value);
+				m_map.erase(victim);
+				most_freq->second.pop_front();
+				if (most_freq->second.empty())
 				{
-					m_freq_map.erase(std::prev(m_freq_map.end()));
+					m_freq_map.erase(most_freq);
 				}
 			}
-			m_map[p_key] = {p_value, 1};
-			m_freq_map[1].push_back(p_key);
+			auto bucket = m_freq_map.begin();
+			if (bucket == m_freq_map.end() || bucket->first != 1)
+			{
+				bucket = m_freq_map.emplace_hint(bucket, 1, key_list_t());
+			}
+			bucket->second.push_back(p_key);
+			slot.m_bucket	= bucket;
+			slot.m_position = std::prev(bucket->second.end());
+			m_heap_meter.add(p_key, slot.m_value);
 		}
 
 		auto get(const key_t& p_key) -> value_t
@@ -393,17 +701,8 @@ namespace cache_engine
 				throw std::out_of_range("Key not found");
 			}
 
-			auto& freq = iter->second.second;
-			auto& val  = iter->second.first;
-
-			m_freq_map[freq].remove(p_key);
-			if (m_freq_map[freq].empty())
-			{
-				m_freq_map.erase(freq);
-			}
-			freq++;
-			m_freq_map[freq].push_back(p_key);
-			return val;
+			this->touch(iter->second);
+			return iter->second.m_value;
 		}
 
 		// Additional utility methods
@@ -419,6 +718,58 @@ namespace cache_engine
 		{
 			m_map.clear();
 			m_freq_map.clear();
+			m_heap_meter.clear();
+		}
+
+		/**
+		 * @brief Count the heap owned by keys and values in memory_usage()
+		 * @param p_size_of Heap bytes of one entry, the same for an entry when stored and when removed; empty to stop counting
+		 */
+		auto set_heap_size_function(size_function p_size_of) -> void
+		{
+			m_heap_meter.reset(std::move(p_size_of));
+			for (const auto& item : m_map)
+			{
+				m_heap_meter.add(item.first, item.second.m_value);
+			}
+		}
+
+		/**
+		 * @brief Get the heap bytes of the cache per component, in O(1)
+		 * @return The map nodes and buckets, the frequency buckets with their key lists and the owned heap
+		 */
+		auto memory_usage() const -> memory_report
+		{
+			memory_report report;
+			report.m_storage_nodes = policies::containers::node_bytes(m_map);
+			report.m_bucket_arrays = policies::containers::bucket_bytes(m_map);
+			// Every key sits in exactly one frequency list
+			report.m_eviction_metadata = policies::containers::heap_bytes(m_freq_map) + m_map.size() * policies::containers::list_node_bytes<key_t>();
+			report.m_owned_heap		   = m_heap_meter.bytes();
+			return report;
+		}
+
+	  private:
+		/**
+		 * @brief Move an entry to the next frequency bucket without searching either bucket
+		 */
+		auto touch(entry& p_entry) -> void
+		{
+			const auto current				 = p_entry.m_bucket;
+			const std::size_t next_frequency = current->first + 1;
+
+			auto next = std::next(current);
+			if (next == m_freq_map.end() || next->first != next_frequency)
+			{
+				next = m_freq_map.emplace_hint(next, next_frequency, key_list_t());
+			}
+			next->second.splice(next->second.end(), current->second, p_entry.m_position);
+			p_entry.m_bucket = next;
+
+			if (current->second.empty())
+			{
+				m_freq_map.erase(current);
+			}
 		}
 	};
 
@@ -431,8 +782,11 @@ namespace cache_engine
 		std::list<key_t> m_list;
 		std::unordered_map<key_t, std::pair<value_t, typename std::list<key_t>::iterator>> m_map;
 		std::size_t m_capacity;
+		detail::heap_meter<key_t, value_t> m_heap_meter;
 
 	  public:
+		using size_function = typename detail::heap_meter<key_t, value_t>::size_function;
+
 		explicit cache(std::size_t p_capacity) : m_capacity(p_capacity) {}
 
 		// Destructor
@@ -443,32 +797,59 @@ namespace cache_engine
 		auto operator=(const self_t&) -> self_t& = delete;
 
 		// Move constructor and assignment operator
-		cache(self_t&& p_other) noexcept : m_list(std::move(p_other.m_list)), m_map(std::move(p_other.m_map)), m_capacity(p_other.m_capacity) {}
+		cache(self_t&& p_other) noexcept
+			: m_list(std::move(p_other.m_list)), m_map(std::move(p_other.m_map)), m_capacity(p_other.m_capacity), m_heap_meter(std::move(p_other.m_heap_meter))
+		{
+		}
 
 		auto operator=(self_t&& p_other) noexcept -> self_t&
 		{
 			if (this != &p_other)
 			{
-				m_list	   = std::move(p_other.m_list);
-				m_map	   = std::move(p_other.m_map);
-				m_capacity = p_other.m_capacity;
+				m_list		 = std::move(p_other.m_list);
+				m_map		 = std::move(p_other.m_map);
+				m_capacity	 = p_other.m_capacity;
+				m_heap_meter = std::move(p_other.m_heap_meter);
 			}
 			return *this;
 		}
 
 		auto put(const key_t& p_key, const value_t& p_value) -> void
 		{
-			if (m_map.find(p_key) != m_map.end())
+			if (m_capacity == 0)
 			{
-				m_list.erase(m_map[p_key].second);
+				return;
 			}
-			else if (m_map.size() >= m_capacity)
+
+#if __cplusplus >= 201703L
+			const auto emplaced = m_map.try_emplace(p_key, p_value, m_list.end());
+#else
+			auto emplaced = std::make_pair(m_map.find(p_key), false);
+			if (emplaced.first == m_map.end())
 			{
-				m_map.erase(m_list.front());
+				emplaced = m_map.emplace(std::piecewise_construct, std::forward_as_tuple(p_key), std::forward_as_tuple(p_value, m_list.end()));
+			}
+#endif
+			auto& slot = emplaced.first->second;
+			if (!emplaced.second)
+			{
+				m_heap_meter.remove(p_key, slot.first);
+				slot.first = p_value;
+				m_heap_meter.add(p_key, slot.first);
+				m_list.splice(m_list.begin(), m_list, slot.second);
+				return;
+			}
+			if (m_map.size() > m_capacity)
+			{
+				// The new key is not linked yet, so the victim is never the key being put
+				const auto victim = m_map.find(m_list.front());
+				m_heap_meter.remove(victim->first, victim->second.first);
+				m_map.erase(victim);
 				m_list.pop_front();
 			}
 			m_list.push_front(p_key);
-			m_map[p_key] = {p_value, m_list.begin()};
+			slot.second = m_list.begin();
+			m_heap_meter.add(p_key, slot.first);
 		}
 
 		auto get(const key_t& p_key) -> value_t
@@ -495,6 +876,34 @@ namespace cache_engine
 		{
 			m_map.clear();
 			m_list.clear();
+			m_heap_meter.clear();
+		}
+
+		/**
+		 * @brief Count the heap owned by keys and values in memory_usage()
+		 * @param p_size_of Heap bytes of one entry, the same for an entry when stored and when removed; empty to stop counting
+		 */
+		auto set_heap_size_function(size_function p_size_of) -> void
+		{
+			m_heap_meter.reset(std::move(p_size_of));
+			for (const auto& entry : m_map)
+			{
+				m_heap_meter.add(entry.first, entry.second.first);
+			}
+		}
+
+		/**
+		 * @brief Get the heap bytes of the cache per component, in O(1)
+		 * @return The map nodes and buckets, the recency list and the owned heap
+		 */
+		auto memory_usage() const -> memory_report
+		{
+			memory_report report;
+			report.m_storage_nodes	   = policies::containers::node_bytes(m_map);
+			report.m_bucket_arrays	   = policies::containers::bucket_bytes(m_map);
+			report.m_eviction_metadata = policies::containers::heap_bytes(m_list);
+			report.m_owned_heap		   = m_heap_meter.bytes();
+			return report;
 		}
 	};
 
@@ -504,11 +913,17 @@ namespace cache_engine
 		using self_t = cache<key_t, value_t, algorithm::random_cache>;
 
 	  private:
-		std::unordered_map<key_t, std::pair<value_t, std::size_t>> m_map;
-		std::vector<key_t> m_keys;
+		using map_t = std::unordered_map<key_t, std::pair<value_t, std::size_t>>;
+
+		map_t m_map;
+		// Element pointers into m_map stay valid across rehashing, so swap-and-pop needs no lookup
+		std::vector<typename map_t::value_type*> m_keys;
 		std::size_t m_capacity;
+		detail::heap_meter<key_t, value_t> m_heap_meter;
 
 	  public:
+		using size_function = typename detail::heap_meter<key_t, value_t>::size_function;
+
 		explicit cache(std::size_t p_capacity) : m_capacity(p_capacity) { std::srand(static_cast<unsigned int>(std::time(nullptr))); }
 
 		// Destructor
@@ -519,49 +934,69 @@ namespace cache_engine
 		auto operator=(const self_t&) -> self_t& = delete;
 
 		// Move constructor and assignment operator
-		cache(self_t&& p_other) noexcept : m_map(std::move(p_other.m_map)), m_keys(std::move(p_other.m_keys)), m_capacity(p_other.m_capacity) {}
+		cache(self_t&& p_other) noexcept
+			: m_map(std::move(p_other.m_map)), m_keys(std::move(p_other.m_keys)), m_capacity(p_other.m_capacity), m_heap_meter(std::move(p_other.m_heap_meter))
+		{
+		}
 
 		auto operator=(self_t&& p_other) noexcept -> self_t&
 		{
 			if (this != &p_other)
 			{
-				m_map	   = std::move(p_other.m_map);
-				m_keys	   = std::move(p_other.m_keys);
-				m_capacity = p_other.m_capacity;
+				m_map		 = std::move(p_other.m_map);
+				m_keys		 = std::move(p_other.m_keys);
+				m_capacity	 = p_other.m_capacity;
+				m_heap_meter = std::move(p_other.m_heap_meter);
 			}
 			return *this;
 		}
 
 		auto put(const key_t& p_key, const value_t& p_value) -> void
 		{
-			auto map_iter = m_map.find(p_key);
-			if (map_iter != m_map.end())
+			if (m_capacity == 0)
 			{
-				map_iter->second.first = p_value;
 				return;
 			}
 
-			if (m_map.size() >= m_capacity && !m_keys.empty())
+#if __cplusplus >= 201703L
+			const auto emplaced = m_map.try_emplace(p_key, p_value, m_keys.size());
+#else
+			auto emplaced = std::make_pair(m_map.find(p_key), false);
+			if (emplaced.first == m_map.end())
 			{
+				emplaced = m_map.emplace(std::piecewise_construct, std::forward_as_tuple(p_key), std::forward_as_tuple(p_value, m_keys.size()));
+			}
+#endif
+			auto& slot = emplaced.first->second;
+			if (!emplaced.second)
+			{
+				m_heap_meter.remove(p_key, slot.first);
+				slot.first = p_value;
+				m_heap_meter.add(p_key, slot.first);
+				return;
+			}
+			if (m_map.size() > m_capacity && !m_keys.empty())
+			{
+				// The new key is not in m_keys yet, so the victim is never the key being put
 				// Optimized random eviction: swap-and-pop for O(1) removal
 				const std::size_t random_index = static_cast<std::size_t>(std::rand()) % m_keys.size();
-				const key_t victim_key		   = m_keys[random_index];
+				const key_t victim_key		   = m_keys[random_index]->first;
+				m_heap_meter.remove(victim_key, m_keys[random_index]->second.first);
 
 				// Update the index mapping for the swapped element
 				if (random_index < m_keys.size() - 1)
 				{
-					const key_t last_key   = m_keys.back();
-					m_keys[random_index]   = last_key;
-					m_map[last_key].second = random_index;
+					m_keys[random_index]				= m_keys.back();
+					m_keys[random_index]->second.second = random_index;
 				}
 
 				m_keys.pop_back();
 				m_map.erase(victim_key);
 			}
 
-			const std::size_t new_index = m_keys.size();
-			m_map[p_key]				= {p_value, new_index};
-			m_keys.push_back(p_key);
+			slot.second = m_keys.size();
+			m_keys.push_back(&*emplaced.first);
+			m_heap_meter.add(p_key, slot.first);
 		}
 
 		auto get(const key_t& p_key) -> value_t { return m_map.at(p_key).first; }
@@ -579,7 +1014,52 @@ namespace cache_engine
 		{
 			m_map.clear();
 			m_keys.clear();
+			m_heap_meter.clear();
+		}
+
+		/**
+		 * @brief Count the heap owned by keys and values in memory_usage()
+		 * @param p_size_of Heap bytes of one entry, the same for an entry when stored and when removed; empty to stop counting
+		 */
+		auto set_heap_size_function(size_function p_size_of) -> void
+		{
+			m_heap_meter.reset(std::move(p_size_of));
+			for (const auto& entry : m_map)
+			{
+				m_heap_meter.add(entry.first, entry.second.first);
+			}
 		}
+
+		/**
+		 * @brief Get the heap bytes of the cache per component, in O(1)
+		 * @return The map nodes and buckets, the victim index and the owned heap
+		 */
+		auto memory_usage() const -> memory_report
+		{
+			memory_report report;
+			report.m_storage_nodes	   = policies::containers::node_bytes(m_map);
+			report.m_bucket_arrays	   = policies::containers::bucket_bytes(m_map);
+			report.m_eviction_metadata = policies::containers::heap_bytes(m_keys);
+			report.m_owned_heap		   = m_heap_meter.bytes();
+			return report;
+		}
+	};
+
+	/**
+	 * @brief Options for policy_based_cache::for_each and policy_based_cache::erase_if
+	 *
+	 * The storage is cut into m_threads * m_partitions_per_thread partitions
+	 * handed out to the worker threads one at a time, so a partition with
+	 * many entries does not leave the other threads idle. With more than one
+	 * thread the visitor or predicate is called concurrently and must be
+	 * thread-safe.
+	 */
+	struct scan_options
+	{
+		std::size_t m_threads				= 1;	// Worker threads, including the calling thread
+		std::size_t m_partitions_per_thread = 4;	// Partitions per worker thread
+		std::size_t m_erase_chunk			= 4096; // Keys removed by erase_if between two m_between_chunks calls
+		std::function<void()> m_between_chunks;		// Called after every removal chunk, e.g. to let other users take the lock
 	};
 
 	/**
@@ -610,27 +1090,77 @@ namespace cache_engine
 		using policy_validator = policies::traits::policy_validator<key_t, value_t, eviction_policy_type, storage_policy_type, access_policy_type, capacity_policy_type>;
 
 	  public:
-		using self_t	 = policy_based_cache<key_t, value_t, eviction_policy_t, storage_policy_t, access_policy_t, capacity_policy_t>;
-		using key_type	 = key_t;
-		using value_type = value_t;
+		using self_t		= policy_based_cache<key_t, value_t, eviction_policy_t, storage_policy_t, access_policy_t, capacity_policy_t>;
+		using key_type		= key_t;
+		using value_type	= value_t;
+		using size_function = typename detail::heap_meter<key_t, value_t>::size_function;
 
 	  private:
 		std::unique_ptr<eviction_policy_type> m_eviction_policy;
 		std::unique_ptr<storage_policy_type> m_storage_policy;
 		std::unique_ptr<access_policy_type> m_access_policy;
 		std::unique_ptr<capacity_policy_type> m_capacity_policy;
+		detail::heap_meter<key_t, value_t> m_heap_meter;
 
 	  public:
 		// Destructor
 		~policy_based_cache() {}
 
-		// Constructor
+		/**
+		 * @brief Construct a cache from its capacity policy's argument
+		 *
+		 * p_capacity goes to the capacity policy as is, e.g. a byte limit
+		 * for memory_capacity; the other policies are sized for the entry
+		 * count it translates to (see containers::entry_capacity()).
+		 *
+		 * @param p_capacity The capacity policy's constructor argument
+		 */
 		explicit policy_based_cache(std::size_t p_capacity)
-			: m_eviction_policy(std::unique_ptr<eviction_policy_type>(new eviction_policy_type())), m_storage_policy(std::unique_ptr<storage_policy_type>(new storage_policy_type())),
-			  m_access_policy(std::unique_ptr<access_policy_type>(new access_policy_type())), m_capacity_policy(std::unique_ptr<capacity_policy_type>(new capacity_policy_type(p_capacity)))
+			: m_eviction_policy(policies::containers::make_policy<eviction_policy_type>(self_t::entry_context(p_capacity))),
+			  m_storage_policy(policies::containers::make_policy<storage_policy_type>(self_t::entry_context(p_capacity))),
+			  m_access_policy(policies::containers::make_policy<access_policy_type>(self_t::entry_context(p_capacity))),
+			  m_capacity_policy(std::unique_ptr<capacity_policy_type>(new capacity_policy_type(p_capacity)))
+		{
+		}
+
+		/**
+		 * @brief Construct a cache whose policies are sized from a construction context
+		 *
+		 * Eviction, storage and access policies with a policy_context
+		 * constructor reserve their tables and vectors for the context's
+		 * capacity, so filling the cache performs no rehash or reallocation;
+		 * policies without one are default constructed. The capacity policy
+		 * is constructed from the context's capacity.
+		 *
+		 * @param p_context The construction context (capacity, expected key/value sizes, allocator)
+		 */
+		explicit policy_based_cache(const policies::containers::policy_context& p_context)
+			: m_eviction_policy(policies::containers::make_policy<eviction_policy_type>(p_context)), m_storage_policy(policies::containers::make_policy<storage_policy_type>(p_context)),
+			  m_access_policy(policies::containers::make_policy<access_policy_type>(p_context)),
+			  m_capacity_policy(std::unique_ptr<capacity_policy_type>(new capacity_policy_type(p_context.capacity())))
 		{
 		}
 
+#if defined(CACHE_ENGINE_PMR)
+		/**
+		 * @brief Construct a cache whose policy containers allocate from a memory resource
+		 *
+		 * Every policy with a context or resource constructor places all of
+		 * its internal containers on p_resource; the remaining policies are
+		 * default constructed. The resource must outlive the cache.
+		 *
+		 * @param p_capacity The maximum number of entries
+		 * @param p_resource The memory resource (e.g. cache_arena::resource())
+		 */
+		policy_based_cache(std::size_t p_capacity, policies::containers::memory_resource* p_resource)
+			: m_eviction_policy(policies::containers::make_policy<eviction_policy_type>(self_t::entry_context(p_capacity, p_resource))),
+			  m_storage_policy(policies::containers::make_policy<storage_policy_type>(self_t::entry_context(p_capacity, p_resource))),
+			  m_access_policy(policies::containers::make_policy<access_policy_type>(self_t::entry_context(p_capacity, p_resource))),
+			  m_capacity_policy(std::unique_ptr<capacity_policy_type>(new capacity_policy_type(p_capacity)))
+		{
+		}
+#endif
+
 		// Deleted copy constructor and assignment operator
 		policy_based_cache(const self_t&)		 = delete;
 		auto operator=(const self_t&) -> self_t& = delete;
@@ -638,7 +1168,7 @@ namespace cache_engine
 		// Move constructor and assignment operator
 		policy_based_cache(self_t&& p_other) noexcept
 			: m_eviction_policy(std::move(p_other.m_eviction_policy)), m_storage_policy(std::move(p_other.m_storage_policy)), m_access_policy(std::move(p_other.m_access_policy)),
-			  m_capacity_policy(std::move(p_other.m_capacity_policy))
+			  m_capacity_policy(std::move(p_other.m_capacity_policy)), m_heap_meter(std::move(p_other.m_heap_meter))
 		{
 		}
 
@@ -650,6 +1180,7 @@ namespace cache_engine
 				m_storage_policy  = std::move(p_other.m_storage_policy);
 				m_access_policy	  = std::move(p_other.m_access_policy);
 				m_capacity_policy = std::move(p_other.m_capacity_policy);
+				m_heap_meter	  = std::move(p_other.m_heap_meter);
 			}
 			return *this;
 		}
@@ -681,9 +1212,11 @@ namespace cache_engine
 			else
 			{
 				// Update existing key-value pair
+				this->forget_heap(p_key);
 				m_storage_policy->insert(p_key, p_value);
 				m_eviction_policy->on_update(p_key);
 			}
+			this->count_heap(p_key);
 		}
 
 		/**
@@ -768,6 +1301,7 @@ namespace cache_engine
 		{
 			m_storage_policy->clear();
 			m_eviction_policy->clear();
+			m_heap_meter.clear();
 		}
 
 		/**
@@ -778,6 +1312,7 @@ namespace cache_engine
 		 */
 		auto erase(const key_t& p_key) -> bool
 		{
+			this->forget_heap(p_key);
 			const bool was_erased = m_storage_policy->erase(p_key);
 
 			if (was_erased)
@@ -788,7 +1323,186 @@ namespace cache_engine
 			return was_erased;
 		}
 
+		/**
+		 * @brief Visit every entry of the cache, optionally on several threads
+		 *
+		 * Entries are visited in storage order and do not count as accesses:
+		 * neither the access nor the eviction policy is notified. The cache
+		 * must not be modified during the call.
+		 *
+		 * @param p_visitor Called with (key, value) for every entry
+		 * @param p_options Thread and partition counts
+		 * @throws Rethrows the first exception thrown by p_visitor, after all workers stopped
+		 * @throws std::logic_error if the storage policy cannot visit its entries
+		 */
+		template <typename visitor_t> auto for_each(const visitor_t& p_visitor, const scan_options& p_options = scan_options()) const -> void
+		{
+			const typename storage_policy_type::entry_visitor visitor(std::cref(p_visitor));
+			this->run_partitioned(p_options, [this, &visitor](std::size_t p_partition, std::size_t p_partition_count)
+								  { m_storage_policy->visit_partition(p_partition, p_partition_count, visitor); });
+		}
+
+		/**
+		 * @brief Remove every entry matching a predicate
+		 *
+		 * The entries are scanned in parallel, read-only, and the matching
+		 * keys collected per partition; they are then removed on the calling
+		 * thread through the same path as erase(), so the eviction policy
+		 * stays consistent. Removal runs in chunks of m_erase_chunk keys with
+		 * m_between_chunks called after each one. When that hook is set the
+		 * caller may let other users modify the cache inside it, so the
+		 * predicate is checked again before each key is removed.
+		 *
+		 * @param p_predicate Called with (key, value); returns true for entries to remove
+		 * @param p_options Thread, partition and chunk settings
+		 * @return The number of removed entries
+		 * @throws Rethrows the first exception thrown by p_predicate during the scan; nothing has been removed then
+		 * @throws std::logic_error if the storage policy cannot visit its entries
+		 */
+		template <typename predicate_t> auto erase_if(const predicate_t& p_predicate, const scan_options& p_options = scan_options()) -> std::size_t
+		{
+			std::vector<std::vector<key_t>> matches;
+			this->run_partitioned(p_options,
+								  [this, &p_predicate, &matches](std::size_t p_partition, std::size_t p_partition_count)
+								  {
+									  std::vector<key_t>& found = matches[p_partition];
+									  m_storage_policy->visit_partition(p_partition, p_partition_count,
+																		[&p_predicate, &found](const key_t& p_key, const value_t& p_value)
+																		{
+																			if (p_predicate(p_key, p_value))
+																			{
+																				found.push_back(p_key);
+																			}
+																		});
+								  },
+								  &matches);
+
+			const bool recheck		= static_cast<bool>(p_options.m_between_chunks);
+			const std::size_t chunk = (p_options.m_erase_chunk == 0) ? 1 : p_options.m_erase_chunk;
+			std::size_t erased		= 0;
+			std::size_t in_chunk	= 0;
+
+			for (const std::vector<key_t>& found : matches)
+			{
+				for (const key_t& key : found)
+				{
+					if (recheck)
+					{
+						const value_t* value = m_storage_policy->find(key);
+						if (value == nullptr || !p_predicate(key, *value))
+						{
+							continue;
+						}
+					}
+
+					erased += this->erase(key) ? 1U : 0U;
+
+					if (++in_chunk == chunk)
+					{
+						in_chunk = 0;
+						if (recheck)
+						{
+							p_options.m_between_chunks();
+						}
+					}
+				}
+			}
+
+			if (recheck && in_chunk != 0)
+			{
+				p_options.m_between_chunks();
+			}
+
+			return erased;
+		}
+
 	  private:
+		/**
+		 * @brief Run p_task(partition, partition_count) once per partition on p_options.m_threads threads
+		 *
+		 * The calling thread works as one of the workers; with a single
+		 * thread no thread is started. The first exception thrown by a task
+		 * stops the hand-out of further partitions and is rethrown once every
+		 * worker has finished.
+		 *
+		 * @param p_options Thread and partition counts
+		 * @param p_task The per-partition work
+		 * @param p_results Optional per-partition result slots, resized to the partition count
+		 */
+		template <typename task_t, typename result_t = std::vector<key_t>>
+		auto run_partitioned(const scan_options& p_options, const task_t& p_task, std::vector<result_t>* p_results = nullptr) const -> void
+		{
+			const std::size_t threads		  = (p_options.m_threads == 0) ? 1 : p_options.m_threads;
+			const std::size_t per_thread	  = (p_options.m_partitions_per_thread == 0) ? 1 : p_options.m_partitions_per_thread;
+			const std::size_t partition_count = (threads == 1) ? 1 : threads * per_thread;
+
+			if (p_results != nullptr)
+			{
+				p_results->assign(partition_count, result_t());
+			}
+
+			if (partition_count == 1)
+			{
+				p_task(0, 1);
+				return;
+			}
+
+			std::atomic<std::size_t> next_partition(0);
+			std::atomic<bool> failed(false);
+			std::exception_ptr first_error;
+			std::mutex error_mutex;
+
+			auto worker = [&]()
+			{
+				for (std::size_t partition = next_partition.fetch_add(1); partition < partition_count && !failed.load(); partition = next_partition.fetch_add(1))
+				{
+					try
+					{
+						p_task(partition, partition_count);
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(error_mutex);
+						if (!first_error)
+						{
+							first_error = std::current_exception();
+						}
+						failed.store(true);
+					}
+				}
+			};
+
+			std::vector<std::thread> helpers;
+			helpers.reserve(threads - 1);
+			try
+			{
+				for (std::size_t idx_for = 1; idx_for < threads; ++idx_for)
+				{
+					helpers.emplace_back(worker);
+				}
+			}
+			catch (...)
+			{
+				// Could not start every helper: stop the ones running before propagating
+				failed.store(true);
+				for (std::thread& helper : helpers)
+				{
+					helper.join();
+				}
+				throw;
+			}
+			worker();
+			for (std::thread& helper : helpers)
+			{
+				helper.join();
+			}
+
+			if (first_error)
+			{
+				std::rethrow_exception(first_error);
+			}
+		}
+
 		/**
 		 * @brief Evict entries if necessary before inserting a new key
 		 */
@@ -829,7 +1543,8 @@ namespace cache_engine
 				try
 				{
 					const key_t victim_key = m_eviction_policy->select_victim();
-					const bool was_erased  = m_storage_policy->erase(victim_key);
+					this->forget_heap(victim_key);
+					const bool was_erased = m_storage_policy->erase(victim_key);
 
 					if (was_erased)
 					{
@@ -849,7 +1564,98 @@ namespace cache_engine
 			}
 		}
 
+		/**
+		 * @brief Context sized for the entries a capacity policy built from p_capacity holds
+		 */
+		static auto entry_context(std::size_t p_capacity) -> policies::containers::policy_context
+		{
+			return policies::containers::make_policy_context<key_t, value_t>(policies::containers::entry_capacity<capacity_policy_type>(p_capacity));
+		}
+
+#if defined(CACHE_ENGINE_PMR)
+		static auto entry_context(std::size_t p_capacity, policies::containers::memory_resource* p_resource) -> policies::containers::policy_context
+		{
+			return policies::containers::make_policy_context<key_t, value_t>(policies::containers::entry_capacity<capacity_policy_type>(p_capacity), p_resource);
+		}
+#endif
+
+		/**
+		 * @brief Add a stored entry's owned heap to the meter
+		 *
+		 * Measures the stored copy, whose capacity may differ from the
+		 * caller's value. Costs a storage lookup only while a heap size
+		 * function is set, like forget_heap().
+		 */
+		auto count_heap(const key_t& p_key) -> void
+		{
+			if (m_heap_meter.enabled())
+			{
+				const value_t* value = m_storage_policy->find(p_key);
+				if (value != nullptr)
+				{
+					m_heap_meter.add(p_key, *value);
+				}
+			}
+		}
+
+		/**
+		 * @brief Take an entry's owned heap off the meter before it is replaced or removed
+		 */
+		auto forget_heap(const key_t& p_key) -> void
+		{
+			if (m_heap_meter.enabled())
+			{
+				const value_t* value = m_storage_policy->find(p_key);
+				if (value != nullptr)
+				{
+					m_heap_meter.remove(p_key, *value);
+				}
+			}
+		}
+
 	  public:
+		/**
+		 * @brief Count the heap owned by keys and values in memory_usage()
+		 *
+		 * The function is called for every current entry now, then for
+		 * every entry stored and every entry replaced, evicted or erased,
+		 * and must return the same size for an entry each time.
+		 *
+		 * @param p_size_of Heap bytes owned by one (key, value); empty to stop counting
+		 * @throws std::logic_error if the cache holds entries its storage policy cannot visit
+		 */
+		auto set_heap_size_function(size_function p_size_of) -> void
+		{
+			m_heap_meter.reset(std::move(p_size_of));
+			if (!m_heap_meter.enabled() || m_storage_policy->empty())
+			{
+				return;
+			}
+			detail::heap_meter<key_t, value_t>& meter = m_heap_meter;
+			m_storage_policy->visit_partition(0, 1, [&meter](const key_t& p_key, const value_t& p_value) { meter.add(p_key, p_value); });
+		}
+
+		/**
+		 * @brief Get the heap bytes of the cache per component
+		 *
+		 * O(1) for the built-in policies: every figure derives from sizes the
+		 * policies' containers already keep, and the owned heap from the
+		 * running total kept through set_heap_size_function(). The policy
+		 * objects themselves (a few hundred bytes) are not counted.
+		 *
+		 * @return The storage nodes and buckets, the eviction and access policy bookkeeping and the owned heap
+		 */
+		auto memory_usage() const -> memory_report
+		{
+			memory_report report;
+			report.m_storage_nodes	   = m_storage_policy->node_bytes();
+			report.m_bucket_arrays	   = m_storage_policy->bucket_bytes();
+			report.m_eviction_metadata = m_eviction_policy->memory_usage();
+			report.m_access_metadata   = m_access_policy->memory_usage();
+			report.m_owned_heap		   = m_heap_meter.bytes();
+			return report;
+		}
+
 		/**
 		 * @brief Get access to the eviction policy (for advanced use cases)
 		 *
@@ -0,0 +1,290 @@
+// File: inc/cache_engine/concurrent/clock_cache.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "concurrent_detail.hpp"
+
+namespace cache_engine
+{
+	namespace concurrent
+	{
+		/**
+		 * @brief Thread-safe CLOCK cache for arbitrary copyable values
+		 *
+		 * An LRU list has to be relinked on every hit, which serializes readers
+		 * on one lock. CLOCK only needs a reference bit: a hit sets it with a
+		 * single relaxed store (skipped when already set), so readers contend
+		 * only on the index shard that owns their key.
+		 *
+		 * Entries live in a fixed array of `capacity` slots. The key to slot
+		 * index is split into power-of-two shards, each an unordered_map under
+		 * its own mutex and padded to its own cache line. Inserting a new key
+		 * takes the hand lock, sweeps the hand over the slots clearing set
+		 * reference bits until it finds a free or unreferenced slot, unlinks
+		 * that slot's key from its shard and reuses the slot.
+		 *
+		 * Lock order is hand, then shard. Only the thread holding the hand lock
+		 * ever holds two shard locks, so readers and updaters cannot deadlock.
+		 *
+		 * @tparam key_t Key type (must be hashable)
+		 * @tparam value_t Value type (must be copyable)
+		 * @tparam hash_t Hash functor for key_t
+		 */
+		template <typename key_t, typename value_t, typename hash_t = std::hash<key_t>> class clock_cache
+		{
+		  public:
+			using self_t = clock_cache<key_t, value_t, hash_t>;
+
+			static constexpr std::size_t default_shard_count = 64;
+
+		  private:
+			struct slot
+			{
+				std::atomic<std::uint8_t> m_referenced;
+				std::atomic<std::uint8_t> m_occupied;
+				key_t m_key;
+				value_t m_value;
+
+				slot() : m_referenced(0), m_occupied(0), m_key(), m_value() {}
+			};
+
+			struct shard
+			{
+				std::mutex m_mutex;
+				std::unordered_map<key_t, std::size_t, hash_t> m_index;
+				char m_padding[detail::cache_line_bytes];
+			};
+
+			std::size_t m_capacity;
+			std::size_t m_shard_mask;
+			std::unique_ptr<slot[]> m_slots;
+			std::unique_ptr<shard[]> m_shards;
+			std::mutex m_hand_mutex;
+			std::size_t m_hand;
+			std::atomic<std::size_t> m_size;
+			hash_t m_hasher;
+
+		  public:
+			// Constructor
+			explicit clock_cache(std::size_t p_capacity, std::size_t p_shard_count = default_shard_count, const hash_t& p_hasher = hash_t())
+				: m_capacity(p_capacity), m_shard_mask(0), m_hand(0), m_size(0), m_hasher(p_hasher)
+			{
+				if (p_capacity == 0)
+				{
+					throw std::invalid_argument("Capacity must be greater than zero");
+				}
+				if (p_shard_count == 0)
+				{
+					throw std::invalid_argument("Shard count must be greater than zero");
+				}
+
+				const std::size_t shard_count = detail::next_power_of_two(p_shard_count);
+				m_shard_mask				  = shard_count - 1;
+
+				m_slots.reset(new slot[p_capacity]);
+				m_shards.reset(new shard[shard_count]);
+
+				const std::size_t per_shard = p_capacity / shard_count + 1;
+				for (std::size_t idx_for = 0; idx_for < shard_count; ++idx_for)
+				{
+					m_shards[idx_for].m_index.reserve(per_shard);
+				}
+			}
+
+			// Destructor
+			~clock_cache() = default;
+
+			// Deleted copy/move: shard mutexes are not movable
+			clock_cache(const self_t&)				 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+			clock_cache(self_t&&)					 = delete;
+			auto operator=(self_t&&) -> self_t&		 = delete;
+
+		  public:
+			/**
+			 * @brief Look up a key and mark it referenced
+			 * @param p_key The key to look up
+			 * @param p_value Receives a copy of the value on a hit
+			 * @return true on a hit
+			 */
+			auto find(const key_t& p_key, value_t& p_value) -> bool
+			{
+				shard& owner = this->shard_for(p_key);
+				std::lock_guard<std::mutex> lock(owner.m_mutex);
+
+				auto index_iter = owner.m_index.find(p_key);
+				if (index_iter == owner.m_index.end())
+				{
+					return false;
+				}
+
+				slot& target = m_slots[index_iter->second];
+				p_value		 = target.m_value;
+				// A set bit is the common case on a hot key; do not dirty the line again
+				if (target.m_referenced.load(std::memory_order_relaxed) == 0)
+				{
+					target.m_referenced.store(1, std::memory_order_relaxed);
+				}
+				return true;
+			}
+
+			/**
+			 * @brief Get a copy of a value
+			 * @param p_key The key to look up
+			 * @return The value
+			 * @throws std::out_of_range if the key is not cached
+			 */
+			auto get(const key_t& p_key) -> value_t
+			{
+				value_t value = value_t();
+				if (!this->find(p_key, value))
+				{
+					throw std::out_of_range("Key not found in cache");
+				}
+				return value;
+			}
+
+			/**
+			 * @brief Check for a key without touching its reference bit
+			 * @param p_key The key
+			 * @return true if cached
+			 */
+			auto contains(const key_t& p_key) const -> bool
+			{
+				shard& owner = this->shard_for(p_key);
+				std::lock_guard<std::mutex> lock(owner.m_mutex);
+				return owner.m_index.find(p_key) != owner.m_index.end();
+			}
+
+			/**
+			 * @brief Insert or update a value; a new key may evict one entry
+			 * @param p_key The key
+			 * @param p_value The value
+			 */
+			auto put(const key_t& p_key, const value_t& p_value) -> void
+			{
+				shard& owner = this->shard_for(p_key);
+				if (this->try_update(owner, p_key, p_value))
+				{
+					return;
+				}
+
+				std::lock_guard<std::mutex> hand_lock(m_hand_mutex);
+				// Another inserter may have added the key while the hand lock was contended
+				if (this->try_update(owner, p_key, p_value))
+				{
+					return;
+				}
+
+				const std::size_t slot_index = this->advance_hand();
+				slot& target				 = m_slots[slot_index];
+
+				std::lock_guard<std::mutex> owner_lock(owner.m_mutex);
+				target.m_key   = p_key;
+				target.m_value = p_value;
+				target.m_referenced.store(0, std::memory_order_relaxed);
+				target.m_occupied.store(1, std::memory_order_relaxed);
+				owner.m_index.emplace(p_key, slot_index);
+				m_size.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Remove a key
+			 * @param p_key The key
+			 * @return true if the key was present
+			 */
+			auto erase(const key_t& p_key) -> bool
+			{
+				shard& owner = this->shard_for(p_key);
+				std::lock_guard<std::mutex> lock(owner.m_mutex);
+
+				auto index_iter = owner.m_index.find(p_key);
+				if (index_iter == owner.m_index.end())
+				{
+					return false;
+				}
+
+				slot& target = m_slots[index_iter->second];
+				owner.m_index.erase(index_iter);
+				target.m_referenced.store(0, std::memory_order_relaxed);
+				target.m_occupied.store(0, std::memory_order_relaxed);
+				m_size.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			/**
+			 * @brief Get the number of cached entries (may lag concurrent writers)
+			 * @return The entry count
+			 */
+			auto size() const -> std::size_t { return m_size.load(std::memory_order_relaxed); }
+
+			auto capacity() const -> std::size_t { return m_capacity; }
+
+			auto empty() const -> bool { return this->size() == 0; }
+
+		  private:
+			auto shard_for(const key_t& p_key) const -> shard& { return m_shards[detail::mix_hash(static_cast<std::uint64_t>(m_hasher(p_key))) & m_shard_mask]; }
+
+			auto try_update(shard& p_owner, const key_t& p_key, const value_t& p_value) -> bool
+			{
+				std::lock_guard<std::mutex> lock(p_owner.m_mutex);
+				auto index_iter = p_owner.m_index.find(p_key);
+				if (index_iter == p_owner.m_index.end())
+				{
+					return false;
+				}
+
+				slot& target   = m_slots[index_iter->second];
+				target.m_value = p_value;
+				target.m_referenced.store(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			/**
+			 * @brief Sweep to a free or unreferenced slot and detach its key; caller holds the hand lock
+			 * @return The index of a slot that no shard refers to
+			 */
+			auto advance_hand() -> std::size_t
+			{
+				for (;;)
+				{
+					const std::size_t slot_index = m_hand;
+					m_hand						 = (m_hand + 1 == m_capacity) ? 0 : m_hand + 1;
+					slot& candidate				 = m_slots[slot_index];
+
+					if (candidate.m_occupied.load(std::memory_order_relaxed) == 0)
+					{
+						return slot_index;
+					}
+					if (candidate.m_referenced.load(std::memory_order_relaxed) != 0)
+					{
+						candidate.m_referenced.store(0, std::memory_order_relaxed);
+						continue;
+					}
+
+					// Keys are only written under the hand lock, so reading it here is safe
+					shard& victim_shard = this->shard_for(candidate.m_key);
+					std::lock_guard<std::mutex> victim_lock(victim_shard.m_mutex);
+					auto index_iter = victim_shard.m_index.find(candidate.m_key);
+					if (index_iter != victim_shard.m_index.end() && index_iter->second == slot_index)
+					{
+						victim_shard.m_index.erase(index_iter);
+						candidate.m_occupied.store(0, std::memory_order_relaxed);
+						m_size.fetch_sub(1, std::memory_order_relaxed);
+					}
+					return slot_index;
+				}
+			}
+		};
+	} // namespace concurrent
+} // namespace cache_engine
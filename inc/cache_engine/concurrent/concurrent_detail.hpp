@@ -0,0 +1,43 @@
+// File: inc/cache_engine/concurrent/concurrent_detail.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cache_engine
+{
+	namespace concurrent
+	{
+		namespace detail
+		{
+			/**
+			 * @brief Finalizer of MurmurHash3; spreads identity hashes (std::hash<int>) over sets and shards
+			 */
+			inline auto mix_hash(std::uint64_t p_hash) -> std::uint64_t
+			{
+				p_hash ^= p_hash >> 33U;
+				p_hash *= 0xff51afd7ed558ccdULL;
+				p_hash ^= p_hash >> 33U;
+				p_hash *= 0xc4ceb9fe1a85ec53ULL;
+				p_hash ^= p_hash >> 33U;
+				return p_hash;
+			}
+
+			inline auto next_power_of_two(std::size_t p_value) -> std::size_t
+			{
+				std::size_t result = 1;
+				while (result < p_value)
+				{
+					result <<= 1U;
+				}
+				return result;
+			}
+
+			/**
+			 * @brief Assumed destructive interference size, used to pad per-shard state
+			 */
+			constexpr std::size_t cache_line_bytes = 64;
+		} // namespace detail
+	} // namespace concurrent
+} // namespace cache_engine
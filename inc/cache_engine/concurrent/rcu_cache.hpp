@@ -0,0 +1,495 @@
+// File: inc/cache_engine/concurrent/rcu_cache.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "concurrent_detail.hpp"
+
+namespace cache_engine
+{
+	namespace concurrent
+	{
+		namespace detail
+		{
+			/**
+			 * @brief Immutable open-addressing table built once per published version
+			 *
+			 * Entries are stored densely; the index is a power-of-two array of
+			 * entry positions + 1 (0 = empty) at a load factor of at most 1/2,
+			 * probed linearly from the mixed hash.
+			 */
+			template <typename key_t, typename value_t, typename hash_t> class frozen_table
+			{
+			  public:
+				using entry_t = std::pair<key_t, value_t>;
+
+			  private:
+				std::vector<entry_t> m_entries;
+				std::vector<std::uint32_t> m_index;
+				std::size_t m_mask;
+				std::uint64_t m_version;
+				hash_t m_hasher;
+
+			  public:
+				// Constructor
+				frozen_table(std::vector<entry_t>&& p_entries, std::uint64_t p_version, const hash_t& p_hasher)
+					: m_entries(std::move(p_entries)), m_mask(0), m_version(p_version), m_hasher(p_hasher)
+				{
+					if (m_entries.size() >= 0x7FFFFFFFU)
+					{
+						throw std::length_error("rcu_cache tables are limited to 2^31 entries");
+					}
+
+					const std::size_t slots = next_power_of_two(m_entries.size() * 2U + 2U);
+					m_mask					= slots - 1;
+					m_index.assign(slots, 0);
+					for (std::size_t idx_for = 0; idx_for < m_entries.size(); ++idx_for)
+					{
+						std::size_t position = this->home(m_entries[idx_for].first);
+						while (m_index[position] != 0)
+						{
+							position = (position + 1) & m_mask;
+						}
+						m_index[position] = static_cast<std::uint32_t>(idx_for + 1);
+					}
+				}
+
+				auto find(const key_t& p_key) const -> const value_t*
+				{
+					for (std::size_t position = this->home(p_key);; position = (position + 1) & m_mask)
+					{
+						const std::uint32_t entry = m_index[position];
+						if (entry == 0)
+						{
+							return nullptr;
+						}
+						if (m_entries[entry - 1].first == p_key)
+						{
+							return &m_entries[entry - 1].second;
+						}
+					}
+				}
+
+				auto entries() const -> const std::vector<entry_t>& { return m_entries; }
+
+				auto size() const -> std::size_t { return m_entries.size(); }
+
+				auto version() const -> std::uint64_t { return m_version; }
+
+			  private:
+				auto home(const key_t& p_key) const -> std::size_t { return static_cast<std::size_t>(mix_hash(static_cast<std::uint64_t>(m_hasher(p_key)))) & m_mask; }
+			};
+		} // namespace detail
+
+		/**
+		 * @brief Read-mostly cache: readers see an immutable table through one atomic pointer
+		 *
+		 * Meant for configuration and routing data, read millions of times per
+		 * second and written a few times per minute. A reader loads the
+		 * published table pointer and probes it; it takes no lock, never
+		 * retries and never writes to memory another reader or the writer
+		 * writes. Its only store is the epoch it announces in its own padded
+		 * slot, so reads scale with cores instead of bouncing a lock line.
+		 *
+		 * Writers stage puts and erases, then publish() builds a new compact
+		 * table from the current version plus the batch and swaps it in; each
+		 * publish copies the whole table, so batch writes when they are
+		 * frequent. A replaced table is retired with the epoch it was
+		 * published under and freed once no reader slot still announces an
+		 * epoch at or before it (epoch-based grace period).
+		 *
+		 * Each reading thread needs its own reader handle from make_reader();
+		 * a handle is not shared between threads at the same time.
+		 *
+		 * @tparam key_t Key type (hashable, equality comparable, copyable)
+		 * @tparam value_t Value type (copyable)
+		 * @tparam hash_t Hash functor for key_t
+		 */
+		template <typename key_t, typename value_t, typename hash_t = std::hash<key_t>> class rcu_cache
+		{
+		  public:
+			using self_t  = rcu_cache<key_t, value_t, hash_t>;
+			using table_t = detail::frozen_table<key_t, value_t, hash_t>;
+
+			static constexpr std::size_t default_max_readers = 128;
+
+		  private:
+			static constexpr std::uint64_t idle_epoch = 0;
+
+			struct reader_slot
+			{
+				std::atomic<std::uint64_t> m_epoch;
+				std::atomic<std::uint8_t> m_claimed;
+				char m_padding[detail::cache_line_bytes];
+
+				reader_slot() : m_epoch(idle_epoch), m_claimed(0) {}
+			};
+
+			struct staged_change
+			{
+				key_t m_key;
+				value_t m_value;
+				bool m_erase;
+			};
+
+			struct retired_table
+			{
+				const table_t* m_table;
+				std::uint64_t m_epoch;
+			};
+
+			std::atomic<const table_t*> m_table;
+			std::atomic<std::uint64_t> m_epoch;
+			std::size_t m_max_readers;
+			std::unique_ptr<reader_slot[]> m_slots;
+			std::mutex m_writer_mutex;
+			std::vector<staged_change> m_staged;
+			std::vector<retired_table> m_retired;
+			hash_t m_hasher;
+
+		  public:
+			/**
+			 * @brief A pinned table version; lookups through it stay valid until it is destroyed
+			 */
+			class snapshot
+			{
+			  private:
+				reader_slot* m_slot;
+				const table_t* m_table;
+
+			  public:
+				// Constructor
+				snapshot(reader_slot* p_slot, const table_t* p_table) : m_slot(p_slot), m_table(p_table) {}
+
+				// Destructor
+				~snapshot()
+				{
+					if (m_slot != nullptr)
+					{
+						m_slot->m_epoch.store(idle_epoch, std::memory_order_release);
+					}
+				}
+
+				snapshot(const snapshot&)					 = delete;
+				auto operator=(const snapshot&) -> snapshot& = delete;
+
+				snapshot(snapshot&& p_other) noexcept : m_slot(p_other.m_slot), m_table(p_other.m_table) { p_other.m_slot = nullptr; }
+
+				auto operator=(snapshot&&) -> snapshot& = delete;
+
+				/**
+				 * @brief Find a value in this version
+				 * @param p_key The key
+				 * @return Pointer to the value, or nullptr; valid while the snapshot lives
+				 */
+				auto find(const key_t& p_key) const -> const value_t* { return m_table->find(p_key); }
+
+				auto size() const -> std::size_t { return m_table->size(); }
+
+				auto version() const -> std::uint64_t { return m_table->version(); }
+			};
+
+			/**
+			 * @brief Per-thread read handle owning one epoch slot
+			 */
+			class reader
+			{
+			  private:
+				self_t* m_owner;
+				reader_slot* m_slot;
+
+			  public:
+				// Constructor
+				reader(self_t* p_owner, reader_slot* p_slot) : m_owner(p_owner), m_slot(p_slot) {}
+
+				// Destructor
+				~reader()
+				{
+					if (m_slot != nullptr)
+					{
+						m_slot->m_epoch.store(idle_epoch, std::memory_order_release);
+						m_slot->m_claimed.store(0, std::memory_order_release);
+					}
+				}
+
+				reader(const reader&)					 = delete;
+				auto operator=(const reader&) -> reader& = delete;
+
+				reader(reader&& p_other) noexcept : m_owner(p_other.m_owner), m_slot(p_other.m_slot) { p_other.m_slot = nullptr; }
+
+				auto operator=(reader&&) -> reader& = delete;
+
+				/**
+				 * @brief Pin the current version for several lookups; at most one pin per reader at a time
+				 * @return The pinned snapshot
+				 */
+				auto pin() const -> snapshot
+				{
+					// Announce the epoch before loading the table: the writer either sees it or we see the new table
+					m_slot->m_epoch.store(m_owner->m_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					return snapshot(m_slot, m_owner->m_table.load(std::memory_order_acquire));
+				}
+
+				/**
+				 * @brief Copy a value out of the current version
+				 * @param p_key The key
+				 * @param p_value Receives the value on a hit
+				 * @return true on a hit
+				 */
+				auto find(const key_t& p_key, value_t& p_value) const -> bool
+				{
+					const snapshot pinned  = this->pin();
+					const value_t* p_found = pinned.find(p_key);
+					if (p_found == nullptr)
+					{
+						return false;
+					}
+					p_value = *p_found;
+					return true;
+				}
+
+				/**
+				 * @brief Get a copy of a value
+				 * @param p_key The key
+				 * @return The value
+				 * @throws std::out_of_range if the key is not present
+				 */
+				auto get(const key_t& p_key) const -> value_t
+				{
+					value_t value = value_t();
+					if (!this->find(p_key, value))
+					{
+						throw std::out_of_range("Key not found in cache");
+					}
+					return value;
+				}
+
+				auto contains(const key_t& p_key) const -> bool { return this->pin().find(p_key) != nullptr; }
+			};
+
+			// Constructor
+			explicit rcu_cache(std::size_t p_max_readers = default_max_readers, const hash_t& p_hasher = hash_t())
+				: m_table(nullptr), m_epoch(1), m_max_readers(p_max_readers), m_hasher(p_hasher)
+			{
+				if (p_max_readers == 0)
+				{
+					throw std::invalid_argument("Reader count must be greater than zero");
+				}
+				m_slots.reset(new reader_slot[p_max_readers]);
+				m_table.store(new table_t(std::vector<typename table_t::entry_t>(), 0, m_hasher), std::memory_order_release);
+			}
+
+			// Destructor: every reader handle must already be gone
+			~rcu_cache()
+			{
+				for (const auto& retired : m_retired)
+				{
+					delete retired.m_table;
+				}
+				delete m_table.load(std::memory_order_acquire);
+			}
+
+			// Deleted copy/move: reader handles point into this object
+			rcu_cache(const self_t&)				 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+			rcu_cache(self_t&&)						 = delete;
+			auto operator=(self_t&&) -> self_t&		 = delete;
+
+		  public:
+			/**
+			 * @brief Claim a reader slot for the calling thread
+			 * @return The reader handle; it releases the slot when destroyed
+			 * @throws std::runtime_error if every slot is claimed
+			 */
+			auto make_reader() -> reader
+			{
+				for (std::size_t idx_for = 0; idx_for < m_max_readers; ++idx_for)
+				{
+					std::uint8_t expected = 0;
+					if (m_slots[idx_for].m_claimed.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
+					{
+						return reader(this, &m_slots[idx_for]);
+					}
+				}
+				throw std::runtime_error("All rcu_cache reader slots are in use");
+			}
+
+			/**
+			 * @brief Stage an insert or update for the next publish()
+			 * @param p_key The key
+			 * @param p_value The value
+			 */
+			auto stage_put(const key_t& p_key, const value_t& p_value) -> void
+			{
+				std::lock_guard<std::mutex> lock(m_writer_mutex);
+				m_staged.push_back(staged_change{p_key, p_value, false});
+			}
+
+			/**
+			 * @brief Stage a removal for the next publish()
+			 * @param p_key The key
+			 */
+			auto stage_erase(const key_t& p_key) -> void
+			{
+				std::lock_guard<std::mutex> lock(m_writer_mutex);
+				m_staged.push_back(staged_change{p_key, value_t(), true});
+			}
+
+			/**
+			 * @brief Build a table from the current version plus every staged change and publish it
+			 *
+			 * Later staged changes to the same key win. The replaced table is
+			 * retired, and retired tables past their grace period are freed.
+			 *
+			 * @return The published version number
+			 */
+			auto publish() -> std::uint64_t
+			{
+				std::lock_guard<std::mutex> lock(m_writer_mutex);
+
+				const table_t* p_current	= m_table.load(std::memory_order_relaxed);
+				const std::uint64_t version = p_current->version() + 1;
+
+				std::unordered_map<key_t, std::size_t, hash_t> last_change(m_staged.size() * 2U + 1U, m_hasher);
+				for (std::size_t idx_for = 0; idx_for < m_staged.size(); ++idx_for)
+				{
+					last_change[m_staged[idx_for].m_key] = idx_for;
+				}
+
+				std::vector<typename table_t::entry_t> entries;
+				entries.reserve(p_current->size() + m_staged.size());
+				for (const auto& entry : p_current->entries())
+				{
+					if (last_change.find(entry.first) == last_change.end())
+					{
+						entries.push_back(entry);
+					}
+				}
+				for (const auto& change : last_change)
+				{
+					const staged_change& staged = m_staged[change.second];
+					if (!staged.m_erase)
+					{
+						entries.emplace_back(staged.m_key, staged.m_value);
+					}
+				}
+				m_staged.clear();
+
+				const table_t* p_next = new table_t(std::move(entries), version, m_hasher);
+				m_table.exchange(p_next, std::memory_order_seq_cst);
+				// Readers that could still see p_current announced an epoch <= retired_epoch
+				const std::uint64_t retired_epoch = m_epoch.fetch_add(1, std::memory_order_seq_cst);
+				m_retired.push_back(retired_table{p_current, retired_epoch});
+
+				this->reclaim();
+				return version;
+			}
+
+			/**
+			 * @brief Stage and publish a single insert or update
+			 */
+			auto put(const key_t& p_key, const value_t& p_value) -> void
+			{
+				this->stage_put(p_key, p_value);
+				this->publish();
+			}
+
+			/**
+			 * @brief Stage and publish a single removal
+			 */
+			auto erase(const key_t& p_key) -> void
+			{
+				this->stage_erase(p_key);
+				this->publish();
+			}
+
+			/**
+			 * @brief Block until every retired table is freed; no reader may be pinned by the caller
+			 */
+			auto synchronize() -> void
+			{
+				std::lock_guard<std::mutex> lock(m_writer_mutex);
+				while (this->reclaim() != 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			/**
+			 * @brief Number of entries in the published version
+			 */
+			auto size() const -> std::size_t { return m_table.load(std::memory_order_acquire)->size(); }
+
+			auto empty() const -> bool { return this->size() == 0; }
+
+			/**
+			 * @brief Version number of the published table (0 before the first publish)
+			 */
+			auto version() const -> std::uint64_t { return m_table.load(std::memory_order_acquire)->version(); }
+
+			/**
+			 * @brief Number of staged changes not yet published
+			 */
+			auto pending_changes() -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_writer_mutex);
+				return m_staged.size();
+			}
+
+			/**
+			 * @brief Number of replaced tables still inside their grace period
+			 */
+			auto retired_tables() -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_writer_mutex);
+				return m_retired.size();
+			}
+
+		  private:
+			/**
+			 * @brief Free retired tables whose grace period has ended; caller holds the writer mutex
+			 * @return Number of tables still waiting for a reader
+			 */
+			auto reclaim() -> std::size_t
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				std::uint64_t oldest_active = UINT64_MAX;
+				for (std::size_t idx_for = 0; idx_for < m_max_readers; ++idx_for)
+				{
+					const std::uint64_t announced = m_slots[idx_for].m_epoch.load(std::memory_order_acquire);
+					if (announced != idle_epoch && announced < oldest_active)
+					{
+						oldest_active = announced;
+					}
+				}
+
+				std::size_t kept = 0;
+				for (std::size_t idx_for = 0; idx_for < m_retired.size(); ++idx_for)
+				{
+					if (m_retired[idx_for].m_epoch < oldest_active)
+					{
+						delete m_retired[idx_for].m_table;
+					}
+					else
+					{
+						m_retired[kept++] = m_retired[idx_for];
+					}
+				}
+				m_retired.resize(kept);
+				return kept;
+			}
+		};
+	} // namespace concurrent
+} // namespace cache_engine
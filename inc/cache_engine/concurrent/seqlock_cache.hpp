@@ -0,0 +1,368 @@
+// File: inc/cache_engine/concurrent/seqlock_cache.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+
+#include "concurrent_detail.hpp"
+
+namespace cache_engine
+{
+	namespace concurrent
+	{
+		namespace detail
+		{
+			/**
+			 * @brief Number of 64-bit words needed to hold an object of type value_t
+			 */
+			template <typename value_t> struct word_count
+			{
+				static constexpr std::size_t value = (sizeof(value_t) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+			};
+		} // namespace detail
+
+		/**
+		 * @brief Read-mostly concurrent cache for small trivially copyable values
+		 *
+		 * Every slot is guarded by a sequence counter instead of a lock. Readers
+		 * never write shared memory on the hot path: they load the sequence, copy
+		 * the key and value words, and retry if the sequence was odd or changed
+		 * meanwhile. Writers serialize per set on a striped mutex, bump the
+		 * sequence to odd, store the words, then publish the even sequence.
+		 *
+		 * The index is set-associative open addressing: a key hashes to one set
+		 * of `ways` adjacent slots and is probed linearly within it, so a lookup
+		 * touches at most two cache lines for the default geometry. When a set
+		 * is full the victim is chosen by CLOCK second chance within the set; a
+		 * hit only sets the slot's reference bit (relaxed, and only when clear)
+		 * so that the shared line stays clean under a read-heavy load.
+		 *
+		 * Key and value are stored as relaxed atomic words so that the racy copy
+		 * a reader may observe is well defined; a torn copy is always discarded
+		 * by the sequence check.
+		 *
+		 * @tparam key_t Key type (trivially copyable, equality comparable)
+		 * @tparam value_t Value type (trivially copyable, at most 64 bytes)
+		 * @tparam hash_t Hash functor for key_t
+		 * @tparam ways Slots per set (power of two)
+		 */
+		template <typename key_t, typename value_t, typename hash_t = std::hash<key_t>, std::size_t ways = 8> class seqlock_cache
+		{
+		  public:
+			using self_t = seqlock_cache<key_t, value_t, hash_t, ways>;
+
+			static constexpr std::size_t max_value_bytes  = 64;
+			static constexpr std::size_t max_lock_stripes = 1024;
+
+			static_assert(std::is_trivially_copyable<key_t>::value, "seqlock_cache keys must be trivially copyable");
+			static_assert(std::is_trivially_copyable<value_t>::value, "seqlock_cache values must be trivially copyable");
+			static_assert(std::is_default_constructible<key_t>::value && std::is_default_constructible<value_t>::value, "seqlock_cache keys and values must be default constructible");
+			static_assert(sizeof(value_t) <= max_value_bytes, "seqlock_cache values are limited to 64 bytes; use a locked cache for larger values");
+			static_assert(ways != 0 && (ways & (ways - 1)) == 0, "seqlock_cache ways must be a power of two");
+			static_assert(ways <= 256, "seqlock_cache keeps its per-set CLOCK hand in one byte");
+
+		  private:
+			static constexpr std::size_t key_words	 = detail::word_count<key_t>::value;
+			static constexpr std::size_t value_words = detail::word_count<value_t>::value;
+
+			struct slot
+			{
+				std::atomic<std::uint32_t> m_sequence;
+				std::atomic<std::uint8_t> m_occupied;
+				mutable std::atomic<std::uint8_t> m_referenced;
+				std::atomic<std::uint64_t> m_hash;
+				std::atomic<std::uint64_t> m_key[key_words];
+				std::atomic<std::uint64_t> m_value[value_words];
+			};
+
+			std::size_t m_set_count;
+			std::size_t m_set_mask;
+			std::size_t m_stripe_mask;
+			std::unique_ptr<slot[]> m_slots;
+			std::unique_ptr<std::uint8_t[]> m_hands;
+			std::unique_ptr<std::mutex[]> m_stripes;
+			std::atomic<std::size_t> m_size;
+			hash_t m_hasher;
+
+		  public:
+			// Constructor
+			explicit seqlock_cache(std::size_t p_capacity, const hash_t& p_hasher = hash_t()) : m_set_count(0), m_set_mask(0), m_stripe_mask(0), m_size(0), m_hasher(p_hasher)
+			{
+				if (p_capacity == 0)
+				{
+					throw std::invalid_argument("Capacity must be greater than zero");
+				}
+
+				m_set_count = detail::next_power_of_two((p_capacity + ways - 1) / ways);
+				m_set_mask	= m_set_count - 1;
+
+				const std::size_t stripe_count = (m_set_count < max_lock_stripes) ? m_set_count : max_lock_stripes;
+				m_stripe_mask				   = stripe_count - 1;
+
+				m_slots.reset(new slot[m_set_count * ways]);
+				m_hands.reset(new std::uint8_t[m_set_count]());
+				m_stripes.reset(new std::mutex[stripe_count]);
+
+				for (std::size_t idx_for = 0; idx_for < m_set_count * ways; ++idx_for)
+				{
+					slot& target = m_slots[idx_for];
+					target.m_sequence.store(0, std::memory_order_relaxed);
+					target.m_occupied.store(0, std::memory_order_relaxed);
+					target.m_referenced.store(0, std::memory_order_relaxed);
+					target.m_hash.store(0, std::memory_order_relaxed);
+					for (std::size_t idx_word = 0; idx_word < key_words; ++idx_word)
+					{
+						target.m_key[idx_word].store(0, std::memory_order_relaxed);
+					}
+					for (std::size_t idx_word = 0; idx_word < value_words; ++idx_word)
+					{
+						target.m_value[idx_word].store(0, std::memory_order_relaxed);
+					}
+				}
+			}
+
+			// Destructor
+			~seqlock_cache() = default;
+
+			// Deleted copy/move: concurrent readers hold references into the slot array
+			seqlock_cache(const self_t&)			 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+			seqlock_cache(self_t&&)					 = delete;
+			auto operator=(self_t&&) -> self_t&		 = delete;
+
+		  public:
+			/**
+			 * @brief Lock-free lookup
+			 * @param p_key The key to look up
+			 * @param p_value Receives a consistent copy of the value on a hit
+			 * @return true on a hit
+			 */
+			auto find(const key_t& p_key, value_t& p_value) const -> bool
+			{
+				const std::uint64_t hash = this->hash_of(p_key);
+				const slot* p_set		 = &m_slots[(hash & m_set_mask) * ways];
+
+				for (std::size_t idx_for = 0; idx_for < ways; ++idx_for)
+				{
+					const slot& target = p_set[idx_for];
+					std::uint64_t value_buffer[value_words];
+					bool matched = false;
+
+					for (;;)
+					{
+						const std::uint32_t sequence_before = target.m_sequence.load(std::memory_order_acquire);
+						if ((sequence_before & 1U) != 0)
+						{
+							continue;
+						}
+
+						matched = target.m_occupied.load(std::memory_order_relaxed) != 0 && target.m_hash.load(std::memory_order_relaxed) == hash && this->key_equals(target, p_key);
+						if (matched)
+						{
+							for (std::size_t idx_word = 0; idx_word < value_words; ++idx_word)
+							{
+								value_buffer[idx_word] = target.m_value[idx_word].load(std::memory_order_relaxed);
+							}
+						}
+
+						std::atomic_thread_fence(std::memory_order_acquire);
+						if (target.m_sequence.load(std::memory_order_relaxed) == sequence_before)
+						{
+							break;
+						}
+					}
+
+					if (matched)
+					{
+						std::memcpy(&p_value, value_buffer, sizeof(value_t));
+						// Only write the shared line when the bit is actually clear
+						if (target.m_referenced.load(std::memory_order_relaxed) == 0)
+						{
+							target.m_referenced.store(1, std::memory_order_relaxed);
+						}
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/**
+			 * @brief Get a copy of a value
+			 * @param p_key The key to look up
+			 * @return The value
+			 * @throws std::out_of_range if the key is not cached
+			 */
+			auto get(const key_t& p_key) const -> value_t
+			{
+				value_t value = value_t();
+				if (!this->find(p_key, value))
+				{
+					throw std::out_of_range("Key not found in cache");
+				}
+				return value;
+			}
+
+			auto contains(const key_t& p_key) const -> bool
+			{
+				value_t value = value_t();
+				return this->find(p_key, value);
+			}
+
+			/**
+			 * @brief Insert or update a value, evicting within the key's set when it is full
+			 * @param p_key The key
+			 * @param p_value The value
+			 */
+			auto put(const key_t& p_key, const value_t& p_value) -> void
+			{
+				const std::uint64_t hash	= this->hash_of(p_key);
+				const std::size_t set_index = hash & m_set_mask;
+				slot* p_set					= &m_slots[set_index * ways];
+
+				std::lock_guard<std::mutex> lock(m_stripes[set_index & m_stripe_mask]);
+
+				slot* p_free = nullptr;
+				for (std::size_t idx_for = 0; idx_for < ways; ++idx_for)
+				{
+					slot& target = p_set[idx_for];
+					if (target.m_occupied.load(std::memory_order_relaxed) == 0)
+					{
+						p_free = (p_free == nullptr) ? &target : p_free;
+						continue;
+					}
+					if (target.m_hash.load(std::memory_order_relaxed) == hash && this->key_equals(target, p_key))
+					{
+						this->write_slot(target, hash, p_key, p_value);
+						return;
+					}
+				}
+
+				if (p_free != nullptr)
+				{
+					this->write_slot(*p_free, hash, p_key, p_value);
+					m_size.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				this->write_slot(this->clock_victim(set_index), hash, p_key, p_value);
+			}
+
+			/**
+			 * @brief Remove a key
+			 * @param p_key The key
+			 * @return true if the key was present
+			 */
+			auto erase(const key_t& p_key) -> bool
+			{
+				const std::uint64_t hash	= this->hash_of(p_key);
+				const std::size_t set_index = hash & m_set_mask;
+				slot* p_set					= &m_slots[set_index * ways];
+
+				std::lock_guard<std::mutex> lock(m_stripes[set_index & m_stripe_mask]);
+
+				for (std::size_t idx_for = 0; idx_for < ways; ++idx_for)
+				{
+					slot& target = p_set[idx_for];
+					if (target.m_occupied.load(std::memory_order_relaxed) != 0 && target.m_hash.load(std::memory_order_relaxed) == hash && this->key_equals(target, p_key))
+					{
+						const std::uint32_t sequence = target.m_sequence.load(std::memory_order_relaxed);
+						target.m_sequence.store(sequence + 1, std::memory_order_relaxed);
+						std::atomic_thread_fence(std::memory_order_release);
+						target.m_occupied.store(0, std::memory_order_relaxed);
+						target.m_referenced.store(0, std::memory_order_relaxed);
+						target.m_sequence.store(sequence + 2, std::memory_order_release);
+						m_size.fetch_sub(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/**
+			 * @brief Get the number of cached entries (may lag concurrent writers)
+			 * @return The entry count
+			 */
+			auto size() const -> std::size_t { return m_size.load(std::memory_order_relaxed); }
+
+			/**
+			 * @brief Get the number of slots; rounded up to a whole number of power-of-two sets
+			 * @return The slot count
+			 */
+			auto capacity() const -> std::size_t { return m_set_count * ways; }
+
+			auto empty() const -> bool { return this->size() == 0; }
+
+		  private:
+			auto hash_of(const key_t& p_key) const -> std::uint64_t { return detail::mix_hash(static_cast<std::uint64_t>(m_hasher(p_key))); }
+
+			static auto key_equals(const slot& p_slot, const key_t& p_key) -> bool
+			{
+				std::uint64_t key_buffer[key_words];
+				for (std::size_t idx_word = 0; idx_word < key_words; ++idx_word)
+				{
+					key_buffer[idx_word] = p_slot.m_key[idx_word].load(std::memory_order_relaxed);
+				}
+
+				key_t stored = key_t();
+				std::memcpy(&stored, key_buffer, sizeof(key_t));
+				return stored == p_key;
+			}
+
+			/**
+			 * @brief Publish key and value into a slot; caller holds the set's stripe
+			 */
+			static auto write_slot(slot& p_slot, std::uint64_t p_hash, const key_t& p_key, const value_t& p_value) -> void
+			{
+				std::uint64_t key_buffer[key_words]		= {};
+				std::uint64_t value_buffer[value_words] = {};
+				std::memcpy(key_buffer, &p_key, sizeof(key_t));
+				std::memcpy(value_buffer, &p_value, sizeof(value_t));
+
+				const std::uint32_t sequence = p_slot.m_sequence.load(std::memory_order_relaxed);
+				p_slot.m_sequence.store(sequence + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+
+				p_slot.m_hash.store(p_hash, std::memory_order_relaxed);
+				for (std::size_t idx_word = 0; idx_word < key_words; ++idx_word)
+				{
+					p_slot.m_key[idx_word].store(key_buffer[idx_word], std::memory_order_relaxed);
+				}
+				for (std::size_t idx_word = 0; idx_word < value_words; ++idx_word)
+				{
+					p_slot.m_value[idx_word].store(value_buffer[idx_word], std::memory_order_relaxed);
+				}
+				p_slot.m_occupied.store(1, std::memory_order_relaxed);
+
+				p_slot.m_sequence.store(sequence + 2, std::memory_order_release);
+			}
+
+			/**
+			 * @brief CLOCK second chance over one full set; caller holds the set's stripe
+			 */
+			auto clock_victim(std::size_t p_set_index) -> slot&
+			{
+				slot* p_set		   = &m_slots[p_set_index * ways];
+				std::uint8_t& hand = m_hands[p_set_index];
+
+				for (;;)
+				{
+					slot& candidate = p_set[hand];
+					hand			= static_cast<std::uint8_t>((hand + 1U) & (ways - 1U));
+					if (candidate.m_referenced.load(std::memory_order_relaxed) == 0)
+					{
+						return candidate;
+					}
+					candidate.m_referenced.store(0, std::memory_order_relaxed);
+				}
+			}
+		};
+	} // namespace concurrent
+} // namespace cache_engine
@@ -0,0 +1,431 @@
+// File: inc/cache_engine/concurrent/sharded_lru_cache.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "concurrent_detail.hpp"
+
+namespace cache_engine
+{
+	namespace concurrent
+	{
+		/**
+		 * @brief How a sharded_lru_cache picks the entry to evict
+		 */
+		enum class shard_eviction : std::uint8_t
+		{
+			independent, // Each shard holds an equal share of the capacity and evicts its own LRU entry
+			global		 // The victim is the oldest LRU entry among sampled shards; shares float
+		};
+
+		/**
+		 * @brief Thread-safe LRU cache split into shards, with an optional approximate global LRU
+		 *
+		 * Each shard is an LRU list and index under its own mutex, padded to
+		 * its own cache line. With independent eviction every shard owns
+		 * capacity / shards entries, so under skewed traffic a hot shard evicts
+		 * entries much newer than the cold entries other shards keep.
+		 *
+		 * Global eviction approximates one LRU over the whole cache. Entries
+		 * carry a stamp from a coarse shared clock that each shard ticks once
+		 * every ops_per_tick of its operations, so the clock's cache line is
+		 * written rarely. Within a shard stamps never decrease from the LRU end
+		 * to the MRU end, and every shard publishes the stamp of its LRU entry
+		 * in an atomic. A new key that would exceed the capacity evicts the LRU
+		 * entry of whichever of `sample_size` shards publishes the oldest stamp,
+		 * starting from a shard picked by the key's hash. The inserting shard
+		 * thereby borrows a unit of capacity from the victim shard, which takes
+		 * it back as soon as its own entries are newer than the borrower's.
+		 *
+		 * A thread holds at most one shard lock at a time: the victim shard is
+		 * locked only after the inserting shard's lock is released.
+		 *
+		 * @tparam key_t Key type (must be hashable)
+		 * @tparam value_t Value type (must be copyable)
+		 * @tparam hash_t Hash functor for key_t
+		 */
+		template <typename key_t, typename value_t, typename hash_t = std::hash<key_t>> class sharded_lru_cache
+		{
+		  public:
+			using self_t = sharded_lru_cache<key_t, value_t, hash_t>;
+
+			static constexpr std::size_t default_shard_count = 16;
+			static constexpr std::size_t default_sample_size = 4;
+			// Operations of one shard between two ticks of the shared clock
+			static constexpr std::uint32_t ops_per_tick = 16;
+
+		  private:
+			static constexpr std::uint64_t empty_stamp = std::numeric_limits<std::uint64_t>::max();
+
+			struct entry
+			{
+				key_t m_key;
+				value_t m_value;
+				std::uint64_t m_stamp;
+			};
+
+			using order_t = std::list<entry>;
+
+			struct shard
+			{
+				std::mutex m_mutex;
+				order_t m_order; // Front is the most recently used entry
+				std::unordered_map<key_t, typename order_t::iterator, hash_t> m_index;
+				std::size_t m_limit;
+				std::uint32_t m_ops;
+				std::atomic<std::uint64_t> m_oldest; // Stamp of the back entry, empty_stamp when empty
+				char m_padding[detail::cache_line_bytes];
+
+				shard() : m_limit(0), m_ops(0), m_oldest(empty_stamp) {}
+			};
+
+			std::size_t m_capacity;
+			std::size_t m_shard_mask;
+			std::size_t m_sample_size;
+			shard_eviction m_mode;
+			std::unique_ptr<shard[]> m_shards;
+			std::atomic<std::uint64_t> m_clock;
+			std::atomic<std::size_t> m_size;
+			std::atomic<std::uint64_t> m_cross_shard_evictions;
+			hash_t m_hasher;
+
+		  public:
+			/**
+			 * @brief Construct an empty cache
+			 * @param p_capacity Maximum number of entries across all shards
+			 * @param p_mode Eviction mode
+			 * @param p_shard_count Number of shards, rounded up to a power of two
+			 * @param p_sample_size Shards compared per global eviction, capped at the shard count
+			 * @param p_hasher Hash functor
+			 * @throws std::invalid_argument if the capacity, shard count or sample size is zero,
+			 *         or independent shards would get no capacity
+			 */
+			explicit sharded_lru_cache(std::size_t p_capacity, shard_eviction p_mode = shard_eviction::global, std::size_t p_shard_count = default_shard_count,
+									   std::size_t p_sample_size = default_sample_size, const hash_t& p_hasher = hash_t())
+				: m_capacity(p_capacity), m_shard_mask(0), m_sample_size(p_sample_size), m_mode(p_mode), m_clock(0), m_size(0), m_cross_shard_evictions(0),
+				  m_hasher(p_hasher)
+			{
+				if (p_capacity == 0)
+				{
+					throw std::invalid_argument("Capacity must be greater than zero");
+				}
+				if (p_shard_count == 0)
+				{
+					throw std::invalid_argument("Shard count must be greater than zero");
+				}
+				if (p_sample_size == 0)
+				{
+					throw std::invalid_argument("Sample size must be greater than zero");
+				}
+
+				const std::size_t shard_count = detail::next_power_of_two(p_shard_count);
+				if (p_mode == shard_eviction::independent && p_capacity < shard_count)
+				{
+					throw std::invalid_argument("Independent shards need a capacity of at least one entry per shard");
+				}
+				m_shard_mask  = shard_count - 1;
+				m_sample_size = p_sample_size < shard_count ? p_sample_size : shard_count;
+
+				m_shards.reset(new shard[shard_count]);
+				for (std::size_t idx_for = 0; idx_for < shard_count; ++idx_for)
+				{
+					shard& target  = m_shards[idx_for];
+					target.m_limit = p_capacity / shard_count + (idx_for < p_capacity % shard_count ? 1U : 0U);
+					target.m_index.reserve(target.m_limit);
+				}
+			}
+
+			// Destructor
+			~sharded_lru_cache() = default;
+
+			// Deleted copy/move: shard mutexes are not movable
+			sharded_lru_cache(const self_t&)		 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+			sharded_lru_cache(self_t&&)				 = delete;
+			auto operator=(self_t&&) -> self_t&		 = delete;
+
+		  public:
+			/**
+			 * @brief Look up a key and make it the most recently used entry of its shard
+			 * @param p_key The key to look up
+			 * @param p_value Receives a copy of the value on a hit
+			 * @return true on a hit
+			 */
+			auto find(const key_t& p_key, value_t& p_value) -> bool
+			{
+				shard& owner = this->shard_for(p_key);
+				std::lock_guard<std::mutex> lock(owner.m_mutex);
+
+				auto index_iter = owner.m_index.find(p_key);
+				if (index_iter == owner.m_index.end())
+				{
+					return false;
+				}
+
+				this->touch(owner, index_iter->second);
+				p_value = index_iter->second->m_value;
+				return true;
+			}
+
+			/**
+			 * @brief Get a copy of a value
+			 * @param p_key The key to look up
+			 * @return The value
+			 * @throws std::out_of_range if the key is not cached
+			 */
+			auto get(const key_t& p_key) -> value_t
+			{
+				value_t value = value_t();
+				if (!this->find(p_key, value))
+				{
+					throw std::out_of_range("Key not found in cache");
+				}
+				return value;
+			}
+
+			/**
+			 * @brief Check for a key without changing its recency
+			 * @param p_key The key
+			 * @return true if cached
+			 */
+			auto contains(const key_t& p_key) const -> bool
+			{
+				shard& owner = this->shard_for(p_key);
+				std::lock_guard<std::mutex> lock(owner.m_mutex);
+				return owner.m_index.find(p_key) != owner.m_index.end();
+			}
+
+			/**
+			 * @brief Insert or update a value; a new key may evict one entry
+			 * @param p_key The key
+			 * @param p_value The value
+			 */
+			auto put(const key_t& p_key, const value_t& p_value) -> void
+			{
+				const std::uint64_t hash = detail::mix_hash(static_cast<std::uint64_t>(m_hasher(p_key)));
+				shard& owner			 = m_shards[hash & m_shard_mask];
+
+				if (m_mode == shard_eviction::independent)
+				{
+					std::lock_guard<std::mutex> lock(owner.m_mutex);
+					if (this->update_locked(owner, p_key, p_value))
+					{
+						return;
+					}
+					if (owner.m_order.size() >= owner.m_limit)
+					{
+						this->pop_oldest(owner);
+						m_size.fetch_sub(1, std::memory_order_relaxed);
+					}
+					this->insert_locked(owner, p_key, p_value);
+					m_size.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				// Insert first so an eviction only ever makes room for a key known to be new
+				bool sole_entry = false;
+				{
+					std::lock_guard<std::mutex> lock(owner.m_mutex);
+					if (this->update_locked(owner, p_key, p_value))
+					{
+						return;
+					}
+					this->insert_locked(owner, p_key, p_value);
+					sole_entry = owner.m_order.size() == 1;
+				}
+
+				// Concurrent inserters each see their own count, so each makes its own room
+				if (m_size.fetch_add(1, std::memory_order_relaxed) >= m_capacity)
+				{
+					this->evict_sampled(static_cast<std::size_t>(hash >> 32U), owner, sole_entry);
+				}
+			}
+
+			/**
+			 * @brief Remove a key
+			 * @param p_key The key
+			 * @return true if the key was present
+			 */
+			auto erase(const key_t& p_key) -> bool
+			{
+				shard& owner = this->shard_for(p_key);
+				std::lock_guard<std::mutex> lock(owner.m_mutex);
+
+				auto index_iter = owner.m_index.find(p_key);
+				if (index_iter == owner.m_index.end())
+				{
+					return false;
+				}
+
+				owner.m_order.erase(index_iter->second);
+				owner.m_index.erase(index_iter);
+				this->publish_oldest(owner);
+				m_size.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			/**
+			 * @brief Get the number of cached entries (may lag concurrent writers)
+			 * @return The entry count
+			 */
+			auto size() const -> std::size_t { return m_size.load(std::memory_order_relaxed); }
+
+			auto capacity() const -> std::size_t { return m_capacity; }
+
+			auto empty() const -> bool { return this->size() == 0; }
+
+			auto mode() const -> shard_eviction { return m_mode; }
+
+			auto shard_count() const -> std::size_t { return m_shard_mask + 1; }
+
+			/**
+			 * @brief Index of the shard that holds p_key
+			 */
+			auto shard_index(const key_t& p_key) const -> std::size_t { return detail::mix_hash(static_cast<std::uint64_t>(m_hasher(p_key))) & m_shard_mask; }
+
+			/**
+			 * @brief Entries currently held by one shard
+			 * @param p_shard Shard index, below shard_count()
+			 */
+			auto shard_size(std::size_t p_shard) const -> std::size_t
+			{
+				shard& target = m_shards[p_shard & m_shard_mask];
+				std::lock_guard<std::mutex> lock(target.m_mutex);
+				return target.m_order.size();
+			}
+
+			/**
+			 * @brief Global evictions whose victim was in another shard than the inserted key
+			 */
+			auto cross_shard_evictions() const -> std::uint64_t { return m_cross_shard_evictions.load(std::memory_order_relaxed); }
+
+		  private:
+			auto shard_for(const key_t& p_key) const -> shard& { return m_shards[this->shard_index(p_key)]; }
+
+			/**
+			 * @brief Current coarse time; the caller holds p_owner's lock
+			 */
+			auto stamp(shard& p_owner) -> std::uint64_t
+			{
+				if (++p_owner.m_ops == ops_per_tick)
+				{
+					p_owner.m_ops = 0;
+					return m_clock.fetch_add(1, std::memory_order_relaxed) + 1;
+				}
+				return m_clock.load(std::memory_order_relaxed);
+			}
+
+			auto publish_oldest(shard& p_owner) -> void
+			{
+				p_owner.m_oldest.store(p_owner.m_order.empty() ? empty_stamp : p_owner.m_order.back().m_stamp, std::memory_order_relaxed);
+			}
+
+			auto touch(shard& p_owner, typename order_t::iterator p_entry) -> void
+			{
+				p_entry->m_stamp = this->stamp(p_owner);
+				if (p_entry != p_owner.m_order.begin())
+				{
+					p_owner.m_order.splice(p_owner.m_order.begin(), p_owner.m_order, p_entry);
+				}
+				this->publish_oldest(p_owner);
+			}
+
+			auto update_locked(shard& p_owner, const key_t& p_key, const value_t& p_value) -> bool
+			{
+				auto index_iter = p_owner.m_index.find(p_key);
+				if (index_iter == p_owner.m_index.end())
+				{
+					return false;
+				}
+				index_iter->second->m_value = p_value;
+				this->touch(p_owner, index_iter->second);
+				return true;
+			}
+
+			auto insert_locked(shard& p_owner, const key_t& p_key, const value_t& p_value) -> void
+			{
+				p_owner.m_order.push_front(entry{p_key, p_value, this->stamp(p_owner)});
+				p_owner.m_index.emplace(p_key, p_owner.m_order.begin());
+				this->publish_oldest(p_owner);
+			}
+
+			auto pop_oldest(shard& p_owner) -> void
+			{
+				p_owner.m_index.erase(p_owner.m_order.back().m_key);
+				p_owner.m_order.pop_back();
+				this->publish_oldest(p_owner);
+			}
+
+			/**
+			 * @brief Evict the LRU entry of the sampled shard with the oldest stamp
+			 *
+			 * Published stamps are read without locks; a victim shard that
+			 * emptied before its lock was taken moves the sample on. When no
+			 * other shard holds an entry (concurrent erasers or evictors emptied
+			 * them) the cache briefly holds one entry too many.
+			 *
+			 * @param p_start First sampled shard, taken from the inserted key's hash
+			 * @param p_owner Shard of the inserted key, for the cross-shard counter
+			 * @param p_skip_owner True when the inserted key is the owner's only entry, so it is not its own victim
+			 */
+			auto evict_sampled(std::size_t p_start, const shard& p_owner, bool p_skip_owner) -> void
+			{
+				const shard* skip			  = p_skip_owner ? &p_owner : nullptr;
+				const std::size_t shard_count = m_shard_mask + 1;
+				for (std::size_t idx_round = 0; idx_round < shard_count; ++idx_round)
+				{
+					shard* victim = this->oldest_of(p_start, m_sample_size, skip);
+					if (victim == nullptr)
+					{
+						victim = this->oldest_of(0, shard_count, skip);
+					}
+					if (victim == nullptr)
+					{
+						return;
+					}
+
+					std::lock_guard<std::mutex> lock(victim->m_mutex);
+					if (!victim->m_order.empty())
+					{
+						this->pop_oldest(*victim);
+						m_size.fetch_sub(1, std::memory_order_relaxed);
+						if (victim != &p_owner)
+						{
+							m_cross_shard_evictions.fetch_add(1, std::memory_order_relaxed);
+						}
+						return;
+					}
+					p_start += m_sample_size;
+				}
+			}
+
+			auto oldest_of(std::size_t p_start, std::size_t p_count, const shard* p_skip) const -> shard*
+			{
+				shard* oldest			   = nullptr;
+				std::uint64_t oldest_stamp = empty_stamp;
+				for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+				{
+					shard& candidate					= m_shards[(p_start + idx_for) & m_shard_mask];
+					const std::uint64_t candidate_stamp = candidate.m_oldest.load(std::memory_order_relaxed);
+					if (&candidate != p_skip && candidate_stamp < oldest_stamp)
+					{
+						oldest		 = &candidate;
+						oldest_stamp = candidate_stamp;
+					}
+				}
+				return oldest;
+			}
+		};
+	} // namespace concurrent
+} // namespace cache_engine
@@ -0,0 +1,58 @@
+// File: inc/cache_engine/durable/codec.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace cache_engine
+{
+	namespace durable
+	{
+		/**
+		 * @brief Byte encoding of keys and values in log records and checkpoint segments
+		 *
+		 * encode() appends the bytes of a value to a buffer; decode() rebuilds
+		 * the value from exactly the bytes encode() produced and returns false
+		 * when they cannot be decoded. Trivially copyable types and std::string
+		 * are provided; specialize codec for other types.
+		 *
+		 * @tparam value_t The encoded type
+		 */
+		template <typename value_t, typename enable_t = void> struct codec;
+
+		/**
+		 * @brief Object representation of trivially copyable types, in native byte order
+		 */
+		template <typename value_t> struct codec<value_t, typename std::enable_if<std::is_trivially_copyable<value_t>::value>::type>
+		{
+			static auto encode(const value_t& p_value, std::string& p_out) -> void { p_out.append(reinterpret_cast<const char*>(&p_value), sizeof(value_t)); }
+
+			static auto decode(const char* p_data, std::size_t p_bytes, value_t& p_value) -> bool
+			{
+				if (p_bytes != sizeof(value_t))
+				{
+					return false;
+				}
+				std::memcpy(&p_value, p_data, sizeof(value_t));
+				return true;
+			}
+		};
+
+		/**
+		 * @brief Raw characters of a string; the length comes from the record framing
+		 */
+		template <> struct codec<std::string>
+		{
+			static auto encode(const std::string& p_value, std::string& p_out) -> void { p_out.append(p_value); }
+
+			static auto decode(const char* p_data, std::size_t p_bytes, std::string& p_value) -> bool
+			{
+				p_value.assign(p_data, p_bytes);
+				return true;
+			}
+		};
+	} // namespace durable
+} // namespace cache_engine
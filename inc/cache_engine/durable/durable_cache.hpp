@@ -0,0 +1,717 @@
+// File: inc/cache_engine/durable/durable_cache.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "durable_detail.hpp"
+#include "write_ahead_log.hpp"
+
+namespace cache_engine
+{
+	namespace durable
+	{
+		namespace detail
+		{
+			constexpr char segment_magic[8] = {'C', 'E', 'C', 'K', 'P', 'T', '0', '1'};
+			// Header: magic, u64 sequence, u64 covered lsn, u64 record count, u8 base flag
+			constexpr std::size_t segment_header_bytes = 8 + 8 + 8 + 8 + 1;
+
+			/**
+			 * @brief Header of a checkpoint segment
+			 *
+			 * A segment holds the state, at LSN m_lsn or later, of every key
+			 * dirtied since the previous segment: a put record with its value or
+			 * an erase record. A base segment holds the whole cache and ends the
+			 * chain: older segments are ignored by recovery.
+			 */
+			struct segment_header
+			{
+				std::uint64_t m_sequence = 0;
+				std::uint64_t m_lsn		 = 0;
+				std::uint64_t m_records	 = 0;
+				bool m_base				 = false;
+			};
+
+			/**
+			 * @brief Reading and writing segment headers
+			 */
+			struct segment_format
+			{
+				static auto encode(const segment_header& p_header, std::string& p_out) -> void
+				{
+					p_out.append(segment_magic, sizeof(segment_magic));
+					put_int<std::uint64_t>(p_out, p_header.m_sequence);
+					put_int<std::uint64_t>(p_out, p_header.m_lsn);
+					put_int<std::uint64_t>(p_out, p_header.m_records);
+					put_int<std::uint8_t>(p_out, p_header.m_base ? 1U : 0U);
+				}
+
+				static auto decode(const std::string& p_contents, segment_header& p_header) -> bool
+				{
+					if (p_contents.size() < segment_header_bytes || std::memcmp(p_contents.data(), segment_magic, sizeof(segment_magic)) != 0)
+					{
+						return false;
+					}
+					p_header.m_sequence = get_int<std::uint64_t>(p_contents.data() + 8);
+					p_header.m_lsn		= get_int<std::uint64_t>(p_contents.data() + 16);
+					p_header.m_records	= get_int<std::uint64_t>(p_contents.data() + 24);
+					p_header.m_base		= get_int<std::uint8_t>(p_contents.data() + 32) != 0;
+					return true;
+				}
+			};
+
+			/**
+			 * @brief Decode the records of p_buffer from p_first_byte on, on up to p_threads threads
+			 *
+			 * Framing is walked serially (a length hop per record); checksums and
+			 * codecs run in parallel over contiguous record ranges. The result
+			 * stops before the first record that fails to decode.
+			 *
+			 * @param p_valid_end Receives the offset just past the last decoded record
+			 */
+			template <typename key_t, typename value_t>
+			auto decode_records(const std::string& p_buffer, std::size_t p_first_byte, std::size_t p_threads, std::size_t& p_valid_end) -> std::vector<decoded_record<key_t, value_t>>
+			{
+				const std::vector<std::size_t> offsets = record_format::frame_offsets(p_buffer, p_first_byte, p_valid_end);
+				std::vector<decoded_record<key_t, value_t>> records(offsets.size());
+				std::atomic<std::size_t> first_bad(offsets.size());
+
+				auto decode_range = [&](std::size_t p_begin, std::size_t p_end)
+				{
+					for (std::size_t idx_for = p_begin; idx_for < p_end; ++idx_for)
+					{
+						if (!decode_record(p_buffer, offsets[idx_for], records[idx_for]))
+						{
+							std::size_t current = first_bad.load();
+							while (idx_for < current && !first_bad.compare_exchange_weak(current, idx_for))
+							{
+							}
+							return;
+						}
+					}
+				};
+
+				const std::size_t threads = std::max<std::size_t>(1, std::min(p_threads, offsets.size() / 4096 + 1));
+				std::vector<std::thread> helpers;
+				for (std::size_t idx_for = 1; idx_for < threads; ++idx_for)
+				{
+					helpers.emplace_back(decode_range, offsets.size() * idx_for / threads, offsets.size() * (idx_for + 1) / threads);
+				}
+				decode_range(0, offsets.size() / threads);
+				for (std::thread& helper : helpers)
+				{
+					helper.join();
+				}
+
+				if (first_bad.load() < offsets.size())
+				{
+					p_valid_end = offsets[first_bad.load()];
+					records.resize(first_bad.load());
+				}
+				return records;
+			}
+
+			/**
+			 * @brief Read a value without touching recency: storage_policy().find() when the cache has one
+			 */
+			template <typename cache_t, typename key_t, typename value_t>
+			auto peek(cache_t& p_cache, const key_t& p_key, value_t& p_value, int) -> decltype(p_cache.storage_policy().find(p_key), bool())
+			{
+				const value_t* value = p_cache.storage_policy().find(p_key);
+				if (value == nullptr)
+				{
+					return false;
+				}
+				p_value = *value;
+				return true;
+			}
+
+			template <typename cache_t, typename key_t, typename value_t> auto peek(cache_t& p_cache, const key_t& p_key, value_t& p_value, long) -> bool
+			{
+				if (!p_cache.contains(p_key))
+				{
+					return false;
+				}
+				p_value = p_cache.get(p_key);
+				return true;
+			}
+
+			template <typename cache_t, typename key_t> auto erase_key(cache_t& p_cache, const key_t& p_key, int) -> decltype(p_cache.erase(p_key), bool())
+			{
+				return p_cache.erase(p_key);
+			}
+
+			template <typename cache_t, typename key_t> auto erase_key(cache_t&, const key_t&, long) -> bool
+			{
+				throw std::logic_error("durable_cache: the wrapped cache has no erase()");
+			}
+		} // namespace detail
+
+		/**
+		 * @brief Settings of durable_cache
+		 */
+		struct durability_options
+		{
+			log_options m_log;
+			std::chrono::milliseconds m_checkpoint_interval = std::chrono::milliseconds(1000); // Zero disables the background checkpointer
+			std::size_t m_max_chain							= 16;								// Segments after which the chain is merged into one base segment
+			std::size_t m_recovery_threads					= 4;								// Threads decoding segments and the log tail on open
+			bool m_wait_for_durability						= false;							// put/erase return only once their record is synced
+		};
+
+		/**
+		 * @brief What durable_cache found on open
+		 */
+		struct recovery_info
+		{
+			std::size_t m_segments		   = 0;
+			std::size_t m_segment_records  = 0;
+			std::size_t m_log_records	   = 0;
+			std::uint64_t m_checkpoint_lsn = 0;
+			std::uint64_t m_last_lsn	   = 0;
+			bool m_torn_tail			   = false; // The log ended in a partial or corrupt record, dropped as not durable
+			double m_seconds			   = 0.0;
+		};
+
+		/**
+		 * @brief Counters of a durable_cache
+		 */
+		struct durability_stats
+		{
+			log_stats m_log;
+			std::uint64_t m_checkpoints		   = 0;
+			std::uint64_t m_checkpoint_records = 0;
+			std::uint64_t m_merges			   = 0;
+			std::size_t m_chain_length		   = 0;
+			std::size_t m_log_files			   = 0;
+		};
+
+		/**
+		 * @brief Crash-recoverable wrapper around a cache
+		 *
+		 * Every put and erase is applied to the wrapped cache and appended to a
+		 * write_ahead_log under one mutex, so log order is apply order. The log
+		 * is written by group commit; by default callers do not wait for the
+		 * sync and a crash loses at most the last flush interval, with
+		 * m_wait_for_durability each mutation returns once its batch is synced.
+		 *
+		 * A background checkpointer periodically writes an incremental segment
+		 * holding only the keys dirtied since the previous one, read from the
+		 * cache at checkpoint time (an evicted key is written as an erase),
+		 * then drops the log files the segment covers. Once the chain grows
+		 * beyond m_max_chain the segments are merged into one base segment.
+		 *
+		 * Opening loads the chain from its last base segment and replays the
+		 * log records newer than the last segment, decoding segments and log
+		 * files on m_recovery_threads threads and applying them in LSN order.
+		 * Segment records carry no recency, so after a checkpoint the
+		 * recovered eviction order is not the one before the restart.
+		 * Evictions themselves are not logged.
+		 *
+		 * The wrapper is thread-safe; all operations serialize on its mutex.
+		 *
+		 * @tparam key_t The key type, encoded with codec<key_t>
+		 * @tparam value_t The value type, encoded with codec<value_t>
+		 * @tparam cache_t The wrapped cache, e.g. cache<> or policy_based_cache<>
+		 * @tparam hash_t Hash for the dirty key set
+		 */
+		template <typename key_t, typename value_t, typename cache_t, typename hash_t = std::hash<key_t>> class durable_cache
+		{
+		  public:
+			using self_t	 = durable_cache<key_t, value_t, cache_t, hash_t>;
+			using key_type	 = key_t;
+			using value_type = value_t;
+
+		  private:
+			using record_t = detail::decoded_record<key_t, value_t>;
+
+			std::string m_directory;
+			durability_options m_options;
+			cache_t m_cache;
+			std::unordered_set<key_t, hash_t> m_dirty;
+			mutable std::mutex m_mutex;
+
+			std::unique_ptr<write_ahead_log> m_log;
+			recovery_info m_recovery;
+
+			std::mutex m_checkpoint_mutex;
+			std::deque<std::pair<std::uint64_t, std::string>> m_chain;
+			std::uint64_t m_next_sequence;
+			std::uint64_t m_checkpoints;
+			std::uint64_t m_checkpoint_records;
+			std::uint64_t m_merges;
+
+			std::mutex m_checkpointer_mutex;
+			std::condition_variable m_checkpointer_cv;
+			bool m_stop;
+			std::exception_ptr m_background_error;
+			std::thread m_checkpointer;
+
+		  public:
+			/**
+			 * @brief Open p_directory, recover its contents into p_cache and start logging
+			 *
+			 * @param p_directory Directory of the log and checkpoint files, created if missing
+			 * @param p_cache The cache to wrap, usually empty, moved in
+			 * @param p_options Log and checkpoint settings
+			 * @throws std::runtime_error on I/O failure or a corrupt checkpoint segment
+			 */
+			durable_cache(const std::string& p_directory, cache_t&& p_cache, const durability_options& p_options = durability_options())
+				: m_directory(p_directory), m_options(p_options), m_cache(std::move(p_cache)), m_next_sequence(1), m_checkpoints(0), m_checkpoint_records(0), m_merges(0),
+				  m_stop(false)
+			{
+				detail::file_io::make_directory(m_directory);
+				const std::deque<std::pair<std::uint64_t, std::string>> log_files = this->recover();
+				m_log.reset(new write_ahead_log(m_directory, m_recovery.m_last_lsn + 1, m_options.m_log, log_files));
+
+				if (m_options.m_checkpoint_interval.count() > 0)
+				{
+					m_checkpointer = std::thread([this]() { this->checkpoint_loop(); });
+				}
+			}
+
+			// Destructor: stops the checkpointer and syncs the log; no final checkpoint is taken
+			~durable_cache()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_checkpointer_mutex);
+					m_stop = true;
+				}
+				m_checkpointer_cv.notify_all();
+				if (m_checkpointer.joinable())
+				{
+					m_checkpointer.join();
+				}
+			}
+
+			// Deleted copy constructor and assignment operator
+			durable_cache(const self_t&)			 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			/**
+			 * @brief Store a value and log it
+			 *
+			 * @throws std::runtime_error if the log can no longer be written
+			 */
+			auto put(const key_t& p_key, const value_t& p_value) -> void
+			{
+				std::uint64_t lsn = 0;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					lsn = m_log->append_put(p_key, p_value);
+					m_cache.put(p_key, p_value);
+					m_dirty.insert(p_key);
+				}
+				if (m_options.m_wait_for_durability)
+				{
+					m_log->wait_durable(lsn);
+				}
+			}
+
+			/**
+			 * @brief Remove a key and log the removal; needs a wrapped cache with erase()
+			 *
+			 * @return true if the key was cached
+			 */
+			auto erase(const key_t& p_key) -> bool
+			{
+				std::uint64_t lsn = 0;
+				bool erased		  = false;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					lsn	   = m_log->template append_erase<key_t, value_t>(p_key);
+					erased = detail::erase_key(m_cache, p_key, 0);
+					m_dirty.insert(p_key);
+				}
+				if (m_options.m_wait_for_durability)
+				{
+					m_log->wait_durable(lsn);
+				}
+				return erased;
+			}
+
+			/**
+			 * @brief Look up a key; reads are not logged
+			 *
+			 * @throws std::out_of_range if the key is not cached
+			 */
+			auto get(const key_t& p_key) -> value_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_cache.get(p_key);
+			}
+
+			auto contains(const key_t& p_key) const -> bool
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_cache.contains(p_key);
+			}
+
+			auto size() const -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_cache.size();
+			}
+
+			/**
+			 * @brief Block until every mutation so far is durable in the log
+			 */
+			auto sync() -> void { m_log->flush(); }
+
+			/**
+			 * @brief Write an incremental checkpoint segment now
+			 *
+			 * The background checkpointer calls this on its interval; an error
+			 * it hit is rethrown by the next explicit call.
+			 *
+			 * @return The number of records in the new segment, 0 when nothing was dirty
+			 */
+			auto checkpoint() -> std::size_t
+			{
+				this->rethrow_background_error();
+				return this->write_checkpoint();
+			}
+
+			auto recovery() const -> const recovery_info& { return m_recovery; }
+
+			auto stats() -> durability_stats
+			{
+				durability_stats stats;
+				stats.m_log		  = m_log->stats();
+				stats.m_log_files = m_log->file_count();
+				std::lock_guard<std::mutex> lock(m_checkpoint_mutex);
+				stats.m_checkpoints		   = m_checkpoints;
+				stats.m_checkpoint_records = m_checkpoint_records;
+				stats.m_merges			   = m_merges;
+				stats.m_chain_length	   = m_chain.size();
+				return stats;
+			}
+
+			/**
+			 * @brief Run p_action on the wrapped cache under the wrapper's lock
+			 *
+			 * Mutations made this way bypass the log and are lost on a crash.
+			 */
+			template <typename action_t> auto with_cache(const action_t& p_action) -> void
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				p_action(m_cache);
+			}
+
+		  private:
+			/**
+			 * @brief Load the checkpoint chain and replay the log tail; returns the log files found
+			 */
+			auto recover() -> std::deque<std::pair<std::uint64_t, std::string>>
+			{
+				const auto start = std::chrono::steady_clock::now();
+
+				// Chain: the last base segment and everything after it
+				const std::vector<std::pair<std::uint64_t, std::string>> segments = detail::file_io::list_numbered(m_directory, "ckpt-", ".seg");
+				std::vector<std::string> contents(segments.size());
+				std::vector<detail::segment_header> headers(segments.size());
+				std::size_t chain_start = 0;
+				for (std::size_t idx_for = 0; idx_for < segments.size(); ++idx_for)
+				{
+					contents[idx_for] = detail::file_io::read_file(segments[idx_for].second);
+					if (!detail::segment_format::decode(contents[idx_for], headers[idx_for]))
+					{
+						throw std::runtime_error("durable_cache corrupt checkpoint segment " + segments[idx_for].second);
+					}
+					if (headers[idx_for].m_base)
+					{
+						chain_start = idx_for;
+					}
+				}
+
+				for (std::size_t idx_for = 0; idx_for < chain_start; ++idx_for)
+				{
+					std::remove(segments[idx_for].second.c_str());
+				}
+
+				for (std::size_t idx_for = chain_start; idx_for < segments.size(); ++idx_for)
+				{
+					std::size_t valid_end				= 0;
+					const std::vector<record_t> records = detail::decode_records<key_t, value_t>(contents[idx_for], detail::segment_header_bytes, m_options.m_recovery_threads, valid_end);
+					if (records.size() != headers[idx_for].m_records || valid_end != contents[idx_for].size())
+					{
+						throw std::runtime_error("durable_cache corrupt checkpoint segment " + segments[idx_for].second);
+					}
+					contents[idx_for].clear();
+					contents[idx_for].shrink_to_fit();
+					this->apply(records, 0, false);
+
+					m_chain.push_back(segments[idx_for]);
+					m_recovery.m_segment_records += records.size();
+					m_recovery.m_checkpoint_lsn = headers[idx_for].m_lsn;
+				}
+				m_recovery.m_segments = m_chain.size();
+				m_next_sequence		  = segments.empty() ? 1 : segments.back().first + 1;
+
+				// Log tail: records newer than the last checkpoint, in file order, up to the first torn record
+				const std::vector<std::pair<std::uint64_t, std::string>> logs = detail::file_io::list_numbered(m_directory, "wal-", ".log");
+				std::deque<std::pair<std::uint64_t, std::string>> kept;
+				m_recovery.m_last_lsn = m_recovery.m_checkpoint_lsn;
+
+				for (std::size_t idx_for = 0; idx_for < logs.size(); ++idx_for)
+				{
+					if (m_recovery.m_torn_tail)
+					{
+						// Records after a torn one were never acknowledged as durable
+						std::remove(logs[idx_for].second.c_str());
+						continue;
+					}
+
+					const std::string buffer			= detail::file_io::read_file(logs[idx_for].second);
+					std::size_t valid_end				= 0;
+					const std::vector<record_t> records = detail::decode_records<key_t, value_t>(buffer, 0, m_options.m_recovery_threads, valid_end);
+					m_recovery.m_log_records += this->apply(records, m_recovery.m_checkpoint_lsn, true);
+					m_recovery.m_torn_tail = valid_end != buffer.size();
+					if (records.empty())
+					{
+						// An empty or wholly torn file covers no LSN; the new log may start a file of the same name
+						std::remove(logs[idx_for].second.c_str());
+						continue;
+					}
+					m_recovery.m_last_lsn = std::max(m_recovery.m_last_lsn, records.back().m_lsn);
+					if (m_recovery.m_torn_tail)
+					{
+						// Cut the torn record so the next open does not stop here again
+						detail::file_io::truncate_file(logs[idx_for].second, valid_end);
+					}
+					kept.push_back(logs[idx_for]);
+				}
+
+				m_recovery.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				return kept;
+			}
+
+			/**
+			 * @brief Apply records newer than p_after_lsn to the cache; replayed keys become dirty
+			 */
+			auto apply(const std::vector<record_t>& p_records, std::uint64_t p_after_lsn, bool p_mark_dirty) -> std::size_t
+			{
+				std::size_t applied = 0;
+				for (const record_t& record : p_records)
+				{
+					if (record.m_lsn <= p_after_lsn)
+					{
+						continue;
+					}
+					if (record.m_op == detail::record_op::put)
+					{
+						m_cache.put(record.m_key, record.m_value);
+					}
+					else
+					{
+						detail::erase_key(m_cache, record.m_key, 0);
+					}
+					if (p_mark_dirty)
+					{
+						// The next checkpoint must cover them before their log files go
+						m_dirty.insert(record.m_key);
+					}
+					++applied;
+				}
+				return applied;
+			}
+
+			auto write_checkpoint() -> std::size_t
+			{
+				std::lock_guard<std::mutex> checkpoint_lock(m_checkpoint_mutex);
+
+				std::vector<key_t> keys;
+				std::uint64_t lsn = 0;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (m_dirty.empty())
+					{
+						return 0;
+					}
+					keys.assign(m_dirty.begin(), m_dirty.end());
+					m_dirty.clear();
+					lsn = m_log->last_lsn();
+				}
+
+				// Values are read in chunks so writers are not held off for the whole set;
+				// a value newer than lsn is fine, replaying the log tail reapplies the same change
+				std::string contents;
+				detail::segment_header header;
+				header.m_sequence = m_next_sequence;
+				header.m_lsn	  = lsn;
+				header.m_records  = keys.size();
+				detail::segment_format::encode(header, contents);
+
+				const std::size_t chunk = 4096;
+				value_t value;
+				for (std::size_t first = 0; first < keys.size(); first += chunk)
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					for (std::size_t idx_for = first; idx_for < std::min(keys.size(), first + chunk); ++idx_for)
+					{
+						if (detail::peek(m_cache, keys[idx_for], value, 0))
+						{
+							detail::append_record(contents, lsn, detail::record_op::put, keys[idx_for], &value);
+						}
+						else
+						{
+							detail::append_record<key_t, value_t>(contents, lsn, detail::record_op::erase, keys[idx_for], nullptr);
+						}
+					}
+				}
+
+				try
+				{
+					const std::string path = detail::file_io::join_path(m_directory, detail::file_io::numbered_name("ckpt-", header.m_sequence, ".seg"));
+					detail::file_io::write_file_atomically(m_directory, path, contents);
+					m_chain.emplace_back(header.m_sequence, path);
+				}
+				catch (...)
+				{
+					// Nothing was covered: the keys stay dirty for the next attempt
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_dirty.insert(keys.begin(), keys.end());
+					throw;
+				}
+
+				++m_next_sequence;
+				++m_checkpoints;
+				m_checkpoint_records += keys.size();
+
+				// The segment is durable, so log records up to lsn are no longer needed
+				m_log->remove_files_through(lsn);
+
+				if (m_chain.size() > m_options.m_max_chain)
+				{
+					this->merge_chain();
+				}
+				return keys.size();
+			}
+
+			/**
+			 * @brief Replace the chain by one base segment with the last state of every key
+			 *
+			 * The base segment takes the newest sequence number, so a crash
+			 * between the rename and the removal of the older segments leaves a
+			 * chain recovery still reads correctly.
+			 */
+			auto merge_chain() -> void
+			{
+				std::unordered_map<key_t, std::size_t, hash_t> latest;
+				std::vector<record_t> merged;
+				std::uint64_t lsn = 0;
+
+				for (const auto& segment : m_chain)
+				{
+					const std::string contents = detail::file_io::read_file(segment.second);
+					detail::segment_header header;
+					if (!detail::segment_format::decode(contents, header))
+					{
+						throw std::runtime_error("durable_cache corrupt checkpoint segment " + segment.second);
+					}
+					lsn = header.m_lsn;
+
+					std::size_t valid_end		  = 0;
+					std::vector<record_t> records = detail::decode_records<key_t, value_t>(contents, detail::segment_header_bytes, m_options.m_recovery_threads, valid_end);
+					for (record_t& record : records)
+					{
+						const auto found = latest.find(record.m_key);
+						if (found == latest.end())
+						{
+							latest.emplace(record.m_key, merged.size());
+							merged.push_back(std::move(record));
+						}
+						else
+						{
+							merged[found->second] = std::move(record);
+						}
+					}
+				}
+
+				// A base segment has nothing below it to erase
+				std::string contents;
+				detail::segment_header header;
+				header.m_sequence = m_chain.back().first;
+				header.m_lsn	  = lsn;
+				header.m_base	  = true;
+				for (const record_t& record : merged)
+				{
+					header.m_records += (record.m_op == detail::record_op::put) ? 1U : 0U;
+				}
+				detail::segment_format::encode(header, contents);
+				for (const record_t& record : merged)
+				{
+					if (record.m_op == detail::record_op::put)
+					{
+						detail::append_record(contents, lsn, detail::record_op::put, record.m_key, &record.m_value);
+					}
+				}
+
+				detail::file_io::write_file_atomically(m_directory, m_chain.back().second, contents);
+				while (m_chain.size() > 1)
+				{
+					std::remove(m_chain.front().second.c_str());
+					m_chain.pop_front();
+				}
+				detail::file_io::sync_directory(m_directory);
+				++m_merges;
+			}
+
+			auto checkpoint_loop() -> void
+			{
+				std::unique_lock<std::mutex> lock(m_checkpointer_mutex);
+				while (!m_stop)
+				{
+					m_checkpointer_cv.wait_for(lock, m_options.m_checkpoint_interval, [this]() { return m_stop; });
+					if (m_stop)
+					{
+						break;
+					}
+					lock.unlock();
+					try
+					{
+						this->write_checkpoint();
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> error_lock(m_checkpointer_mutex);
+						m_background_error = std::current_exception();
+					}
+					lock.lock();
+				}
+			}
+
+			auto rethrow_background_error() -> void
+			{
+				std::exception_ptr error;
+				{
+					std::lock_guard<std::mutex> lock(m_checkpointer_mutex);
+					std::swap(error, m_background_error);
+				}
+				if (error)
+				{
+					std::rethrow_exception(error);
+				}
+			}
+		};
+	} // namespace durable
+} // namespace cache_engine
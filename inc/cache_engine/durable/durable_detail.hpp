@@ -0,0 +1,421 @@
+// File: inc/cache_engine/durable/durable_detail.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "codec.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "cache_engine/durable needs POSIX file APIs (write, fdatasync, rename)"
+#endif
+
+namespace cache_engine
+{
+	namespace durable
+	{
+		namespace detail
+		{
+			/**
+			 * @brief Kind of a log or checkpoint record
+			 */
+			enum class record_op : std::uint8_t
+			{
+				put	  = 1,
+				erase = 2
+			};
+
+			// Framing: u32 payload bytes, u32 CRC-32 of the payload
+			constexpr std::size_t frame_bytes = 8;
+			// Payload head: u64 lsn, u8 op, u32 key bytes; key and value bytes follow
+			constexpr std::size_t payload_head_bytes = 13;
+
+			template <typename int_t> auto put_int(std::string& p_out, int_t p_value) -> void { p_out.append(reinterpret_cast<const char*>(&p_value), sizeof(int_t)); }
+
+			template <typename int_t> auto get_int(const char* p_data) -> int_t
+			{
+				int_t value;
+				std::memcpy(&value, p_data, sizeof(int_t));
+				return value;
+			}
+
+			/**
+			 * @brief Checksums and framing of log and segment records
+			 */
+			struct record_format
+			{
+				static auto make_crc32_table() -> std::array<std::uint32_t, 256>
+				{
+					std::array<std::uint32_t, 256> table;
+					for (std::uint32_t idx_for = 0; idx_for < 256; ++idx_for)
+					{
+						std::uint32_t crc = idx_for;
+						for (int idx_bit = 0; idx_bit < 8; ++idx_bit)
+						{
+							crc = (crc & 1U) ? (crc >> 1U) ^ 0xEDB88320U : (crc >> 1U);
+						}
+						table[idx_for] = crc;
+					}
+					return table;
+				}
+
+				/**
+				 * @brief CRC-32 (IEEE) of p_bytes bytes
+				 */
+				static auto crc32(const char* p_data, std::size_t p_bytes) -> std::uint32_t
+				{
+					static const std::array<std::uint32_t, 256> table = make_crc32_table();
+
+					std::uint32_t crc = 0xFFFFFFFFU;
+					for (std::size_t idx_for = 0; idx_for < p_bytes; ++idx_for)
+					{
+						crc = table[(crc ^ static_cast<unsigned char>(p_data[idx_for])) & 0xFFU] ^ (crc >> 8U);
+					}
+					return crc ^ 0xFFFFFFFFU;
+				}
+
+				/**
+				 * @brief Offsets of the complete records in p_buffer from p_start on
+				 *
+				 * Stops at the first record that does not fit in the buffer, which
+				 * is where a write torn by a crash ends.
+				 *
+				 * @param p_end Receives the offset just past the last complete record
+				 */
+				static auto frame_offsets(const std::string& p_buffer, std::size_t p_start, std::size_t& p_end) -> std::vector<std::size_t>
+				{
+					std::vector<std::size_t> offsets;
+					std::size_t offset = p_start;
+					while (offset + frame_bytes <= p_buffer.size())
+					{
+						const std::size_t payload_bytes = get_int<std::uint32_t>(p_buffer.data() + offset);
+						if (payload_bytes < payload_head_bytes || offset + frame_bytes + payload_bytes > p_buffer.size())
+						{
+							break;
+						}
+						offsets.push_back(offset);
+						offset += frame_bytes + payload_bytes;
+					}
+					p_end = offset;
+					return offsets;
+				}
+			};
+
+			/**
+			 * @brief Append one framed record; p_value is ignored for erase records
+			 */
+			template <typename key_t, typename value_t>
+			auto append_record(std::string& p_out, std::uint64_t p_lsn, record_op p_op, const key_t& p_key, const value_t* p_value) -> void
+			{
+				const std::size_t frame = p_out.size();
+				p_out.append(frame_bytes, '\0');
+				put_int<std::uint64_t>(p_out, p_lsn);
+				put_int<std::uint8_t>(p_out, static_cast<std::uint8_t>(p_op));
+				const std::size_t key_length = p_out.size();
+				put_int<std::uint32_t>(p_out, 0);
+
+				const std::size_t key_start = p_out.size();
+				codec<key_t>::encode(p_key, p_out);
+				const std::uint32_t key_bytes = static_cast<std::uint32_t>(p_out.size() - key_start);
+				std::memcpy(&p_out[key_length], &key_bytes, sizeof(key_bytes));
+
+				if (p_op == record_op::put)
+				{
+					codec<value_t>::encode(*p_value, p_out);
+				}
+
+				const std::size_t payload		  = frame + frame_bytes;
+				const std::uint32_t payload_bytes = static_cast<std::uint32_t>(p_out.size() - payload);
+				const std::uint32_t checksum	  = record_format::crc32(p_out.data() + payload, payload_bytes);
+				std::memcpy(&p_out[frame], &payload_bytes, sizeof(payload_bytes));
+				std::memcpy(&p_out[frame + 4], &checksum, sizeof(checksum));
+			}
+
+			/**
+			 * @brief A decoded record
+			 */
+			template <typename key_t, typename value_t> struct decoded_record
+			{
+				std::uint64_t m_lsn = 0;
+				record_op m_op		= record_op::put;
+				key_t m_key;
+				value_t m_value;
+			};
+
+			/**
+			 * @brief Verify and decode the record at p_offset; false on a checksum or codec failure
+			 */
+			template <typename key_t, typename value_t> auto decode_record(const std::string& p_buffer, std::size_t p_offset, decoded_record<key_t, value_t>& p_record) -> bool
+			{
+				const char* frame				  = p_buffer.data() + p_offset;
+				const std::uint32_t payload_bytes = get_int<std::uint32_t>(frame);
+				const char* payload				  = frame + frame_bytes;
+
+				if (record_format::crc32(payload, payload_bytes) != get_int<std::uint32_t>(frame + 4))
+				{
+					return false;
+				}
+
+				const std::uint8_t op		  = get_int<std::uint8_t>(payload + 8);
+				const std::uint32_t key_bytes = get_int<std::uint32_t>(payload + 9);
+				if ((op != static_cast<std::uint8_t>(record_op::put) && op != static_cast<std::uint8_t>(record_op::erase)) || payload_head_bytes + key_bytes > payload_bytes)
+				{
+					return false;
+				}
+
+				p_record.m_lsn = get_int<std::uint64_t>(payload);
+				p_record.m_op  = static_cast<record_op>(op);
+				if (!codec<key_t>::decode(payload + payload_head_bytes, key_bytes, p_record.m_key))
+				{
+					return false;
+				}
+				if (p_record.m_op == record_op::put)
+				{
+					const char* value = payload + payload_head_bytes + key_bytes;
+					return codec<value_t>::decode(value, payload_bytes - payload_head_bytes - key_bytes, p_record.m_value);
+				}
+				return true;
+			}
+
+			/**
+			 * @brief std::runtime_error carrying errno's text
+			 */
+			struct io_error
+			{
+				static auto make(const std::string& p_what, const std::string& p_path) -> std::runtime_error
+				{
+					return std::runtime_error(p_what + " " + p_path + ": " + std::strerror(errno));
+				}
+			};
+
+			/**
+			 * @brief Append-only file written with write() and synced with fdatasync()
+			 */
+			class append_file
+			{
+			  private:
+				int m_descriptor;
+				std::string m_path;
+				std::size_t m_bytes;
+
+			  public:
+				// Constructor
+				append_file() : m_descriptor(-1), m_bytes(0) {}
+
+				// Destructor
+				~append_file() { this->close(); }
+
+				// Deleted copy constructor and assignment operator
+				append_file(const append_file&)					   = delete;
+				auto operator=(const append_file&) -> append_file& = delete;
+
+				/**
+				 * @brief Create p_path, or truncate it unless p_exclusive, where an existing file is an error
+				 */
+				auto open(const std::string& p_path, bool p_exclusive = false) -> void
+				{
+					this->close();
+					m_descriptor = ::open(p_path.c_str(), O_WRONLY | O_CREAT | (p_exclusive ? O_EXCL : O_TRUNC) | O_CLOEXEC, 0644);
+					if (m_descriptor < 0)
+					{
+						throw io_error::make("cannot create", p_path);
+					}
+					m_path	= p_path;
+					m_bytes = 0;
+				}
+
+				auto is_open() const -> bool { return m_descriptor >= 0; }
+
+				auto bytes() const -> std::size_t { return m_bytes; }
+
+				auto write(const char* p_data, std::size_t p_bytes) -> void
+				{
+					while (p_bytes > 0)
+					{
+						const ssize_t written = ::write(m_descriptor, p_data, p_bytes);
+						if (written < 0 && errno == EINTR)
+						{
+							continue;
+						}
+						if (written <= 0)
+						{
+							throw io_error::make("cannot write", m_path);
+						}
+						p_data += written;
+						p_bytes -= static_cast<std::size_t>(written);
+						m_bytes += static_cast<std::size_t>(written);
+					}
+				}
+
+				auto sync() -> void
+				{
+#if defined(__APPLE__)
+					const int result = ::fsync(m_descriptor);
+#else
+					const int result = ::fdatasync(m_descriptor);
+#endif
+					if (result != 0)
+					{
+						throw io_error::make("cannot sync", m_path);
+					}
+				}
+
+				auto close() -> void
+				{
+					if (m_descriptor >= 0)
+					{
+						::close(m_descriptor);
+						m_descriptor = -1;
+					}
+				}
+			};
+
+			/**
+			 * @brief Naming, listing and whole-file operations in the log directory
+			 */
+			struct file_io
+			{
+				/**
+				 * @brief "<prefix><16 hex digits><suffix>"
+				 */
+				static auto numbered_name(const char* p_prefix, std::uint64_t p_number, const char* p_suffix) -> std::string
+				{
+					char digits[17];
+					std::snprintf(digits, sizeof(digits), "%016llx", static_cast<unsigned long long>(p_number));
+					return std::string(p_prefix) + digits + p_suffix;
+				}
+
+				static auto join_path(const std::string& p_directory, const std::string& p_name) -> std::string { return p_directory + "/" + p_name; }
+
+				/**
+				 * @brief Files "<prefix><16 hex digits><suffix>" in p_directory, sorted by number
+				 */
+				static auto list_numbered(const std::string& p_directory, const std::string& p_prefix, const std::string& p_suffix) -> std::vector<std::pair<std::uint64_t, std::string>>
+				{
+					std::vector<std::pair<std::uint64_t, std::string>> files;
+					DIR* directory = ::opendir(p_directory.c_str());
+					if (directory == nullptr)
+					{
+						throw io_error::make("cannot list", p_directory);
+					}
+					for (dirent* entry = ::readdir(directory); entry != nullptr; entry = ::readdir(directory))
+					{
+						const std::string name(entry->d_name);
+						if (name.size() == p_prefix.size() + 16 + p_suffix.size() && name.compare(0, p_prefix.size(), p_prefix) == 0 &&
+							name.compare(name.size() - p_suffix.size(), p_suffix.size(), p_suffix) == 0)
+						{
+							const std::string digits   = name.substr(p_prefix.size(), 16);
+							char* end				   = nullptr;
+							const std::uint64_t number = std::strtoull(digits.c_str(), &end, 16);
+							if (end == digits.c_str() + 16)
+							{
+								files.emplace_back(number, join_path(p_directory, name));
+							}
+						}
+					}
+					::closedir(directory);
+					std::sort(files.begin(), files.end());
+					return files;
+				}
+
+				static auto make_directory(const std::string& p_directory) -> void
+				{
+					if (::mkdir(p_directory.c_str(), 0755) != 0 && errno != EEXIST)
+					{
+						throw io_error::make("cannot create directory", p_directory);
+					}
+				}
+
+				/**
+				 * @brief Make renames and unlinks in p_directory durable
+				 */
+				static auto sync_directory(const std::string& p_directory) -> void
+				{
+					const int descriptor = ::open(p_directory.c_str(), O_RDONLY | O_CLOEXEC);
+					if (descriptor >= 0)
+					{
+						::fsync(descriptor);
+						::close(descriptor);
+					}
+				}
+
+				static auto read_file(const std::string& p_path) -> std::string
+				{
+					const int descriptor = ::open(p_path.c_str(), O_RDONLY | O_CLOEXEC);
+					if (descriptor < 0)
+					{
+						throw io_error::make("cannot open", p_path);
+					}
+					std::string contents;
+					char chunk[1 << 16];
+					for (;;)
+					{
+						const ssize_t got = ::read(descriptor, chunk, sizeof(chunk));
+						if (got < 0 && errno == EINTR)
+						{
+							continue;
+						}
+						if (got < 0)
+						{
+							::close(descriptor);
+							throw io_error::make("cannot read", p_path);
+						}
+						if (got == 0)
+						{
+							break;
+						}
+						contents.append(chunk, static_cast<std::size_t>(got));
+					}
+					::close(descriptor);
+					return contents;
+				}
+
+				/**
+				 * @brief Write p_contents to p_path through a synced temporary file and a rename
+				 */
+				static auto write_file_atomically(const std::string& p_directory, const std::string& p_path, const std::string& p_contents) -> void
+				{
+					const std::string temporary = p_path + ".tmp";
+					{
+						append_file file;
+						file.open(temporary);
+						file.write(p_contents.data(), p_contents.size());
+						file.sync();
+					}
+					if (::rename(temporary.c_str(), p_path.c_str()) != 0)
+					{
+						throw io_error::make("cannot rename", temporary);
+					}
+					sync_directory(p_directory);
+				}
+
+				/**
+				 * @brief Cut p_path to p_bytes, dropping a torn tail
+				 */
+				static auto truncate_file(const std::string& p_path, std::size_t p_bytes) -> void
+				{
+					if (::truncate(p_path.c_str(), static_cast<off_t>(p_bytes)) != 0)
+					{
+						throw io_error::make("cannot truncate", p_path);
+					}
+				}
+			};
+		} // namespace detail
+	} // namespace durable
+} // namespace cache_engine
@@ -0,0 +1,316 @@
+// File: inc/cache_engine/durable/write_ahead_log.hpp
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "durable_detail.hpp"
+
+namespace cache_engine
+{
+	namespace durable
+	{
+		/**
+		 * @brief Group commit settings of write_ahead_log
+		 */
+		struct log_options
+		{
+			std::chrono::microseconds m_flush_interval = std::chrono::microseconds(2000); // Longest time a record waits before its batch is written
+			std::size_t m_flush_bytes				   = std::size_t(1) << 20;			  // Pending bytes that start a batch before the interval ends
+			std::size_t m_max_pending_bytes			   = std::size_t(64) << 20;			  // Appenders block while this much is waiting to be written
+			std::size_t m_file_bytes				   = std::size_t(64) << 20;			  // A new log file is started once the current one is this large
+			bool m_sync								   = true;							  // fdatasync every batch; off leaves durability to the page cache
+		};
+
+		/**
+		 * @brief Counters of a write_ahead_log
+		 */
+		struct log_stats
+		{
+			std::uint64_t m_records = 0;
+			std::uint64_t m_batches = 0;
+			std::uint64_t m_syncs	= 0;
+			std::uint64_t m_bytes	= 0;
+		};
+
+		/**
+		 * @brief Append-only log of cache mutations with group commit
+		 *
+		 * append() frames a record into an in-memory buffer under a short lock
+		 * and returns its log sequence number (LSN); it never touches the file.
+		 * A flusher thread swaps the buffer out once m_flush_bytes are pending,
+		 * the interval elapses or a caller waits, writes the whole batch with
+		 * one write() and makes it durable with one fdatasync(). Concurrent
+		 * callers of wait_durable() share that sync.
+		 *
+		 * Records go to files "wal-<first lsn>.log" in the directory; a new file
+		 * is started at a batch boundary once the current one exceeds
+		 * m_file_bytes, so files wholly covered by a checkpoint can be removed.
+		 */
+		class write_ahead_log
+		{
+		  private:
+			std::string m_directory;
+			log_options m_options;
+
+			mutable std::mutex m_mutex;
+			std::condition_variable m_flush_cv;
+			std::condition_variable m_durable_cv;
+			std::condition_variable m_space_cv;
+			std::string m_pending;
+			std::uint64_t m_pending_first_lsn;
+			std::uint64_t m_next_lsn;
+			std::uint64_t m_durable_lsn;
+			std::size_t m_waiters;
+			bool m_stop;
+			std::exception_ptr m_error;
+			log_stats m_stats;
+			std::deque<std::pair<std::uint64_t, std::string>> m_files;
+
+			std::thread m_flusher;
+
+		  public:
+			/**
+			 * @brief Start a log whose first record gets p_first_lsn
+			 *
+			 * @param p_directory Existing directory for the log files
+			 * @param p_first_lsn LSN of the first appended record, above every LSN already on disk
+			 * @param p_options Group commit settings
+			 * @param p_existing Log files already in the directory, as (first lsn, path), oldest first
+			 */
+			write_ahead_log(const std::string& p_directory, std::uint64_t p_first_lsn, const log_options& p_options,
+							const std::deque<std::pair<std::uint64_t, std::string>>& p_existing = std::deque<std::pair<std::uint64_t, std::string>>())
+				: m_directory(p_directory), m_options(p_options), m_pending_first_lsn(p_first_lsn), m_next_lsn(p_first_lsn), m_durable_lsn(p_first_lsn - 1), m_waiters(0),
+				  m_stop(false), m_files(p_existing)
+			{
+				m_flusher = std::thread([this]() { this->flush_loop(); });
+			}
+
+			// Destructor: writes and syncs everything appended so far
+			~write_ahead_log()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_stop = true;
+				}
+				m_flush_cv.notify_all();
+				m_flusher.join();
+			}
+
+			// Deleted copy constructor and assignment operator
+			write_ahead_log(const write_ahead_log&)					   = delete;
+			auto operator=(const write_ahead_log&) -> write_ahead_log& = delete;
+
+			/**
+			 * @brief Append a put record
+			 *
+			 * @return The record's LSN
+			 * @throws std::runtime_error if a previous batch failed to write
+			 */
+			template <typename key_t, typename value_t> auto append_put(const key_t& p_key, const value_t& p_value) -> std::uint64_t
+			{
+				return this->append<key_t, value_t>(detail::record_op::put, p_key, &p_value);
+			}
+
+			/**
+			 * @brief Append an erase record
+			 *
+			 * @return The record's LSN
+			 */
+			template <typename key_t, typename value_t> auto append_erase(const key_t& p_key) -> std::uint64_t
+			{
+				return this->append<key_t, value_t>(detail::record_op::erase, p_key, nullptr);
+			}
+
+			/**
+			 * @brief Block until every record up to p_lsn is durable
+			 *
+			 * @throws std::runtime_error if the batch holding p_lsn failed to write
+			 */
+			auto wait_durable(std::uint64_t p_lsn) -> void
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				if (m_durable_lsn >= p_lsn)
+				{
+					return;
+				}
+				++m_waiters;
+				m_flush_cv.notify_one();
+				m_durable_cv.wait(lock, [this, p_lsn]() { return m_durable_lsn >= p_lsn || m_error; });
+				--m_waiters;
+				this->throw_if_failed();
+			}
+
+			/**
+			 * @brief Block until everything appended so far is durable
+			 */
+			auto flush() -> void { this->wait_durable(this->last_lsn()); }
+
+			auto last_lsn() const -> std::uint64_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_next_lsn - 1;
+			}
+
+			auto durable_lsn() const -> std::uint64_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_durable_lsn;
+			}
+
+			auto stats() const -> log_stats
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_stats;
+			}
+
+			/**
+			 * @brief Delete log files whose records all have an LSN up to p_lsn
+			 *
+			 * The file being appended to is always kept.
+			 *
+			 * @return The number of removed files
+			 */
+			auto remove_files_through(std::uint64_t p_lsn) -> std::size_t
+			{
+				std::deque<std::pair<std::uint64_t, std::string>> obsolete;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					// File i holds LSNs [first_i, first_{i+1}); the last file is still open
+					while (m_files.size() > 1 && m_files[1].first - 1 <= p_lsn)
+					{
+						obsolete.push_back(m_files.front());
+						m_files.pop_front();
+					}
+				}
+				for (const auto& file : obsolete)
+				{
+					std::remove(file.second.c_str());
+				}
+				if (!obsolete.empty())
+				{
+					detail::file_io::sync_directory(m_directory);
+				}
+				return obsolete.size();
+			}
+
+			auto file_count() const -> std::size_t
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_files.size();
+			}
+
+		  private:
+			template <typename key_t, typename value_t> auto append(detail::record_op p_op, const key_t& p_key, const value_t* p_value) -> std::uint64_t
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				this->throw_if_failed();
+				if (m_pending.size() >= m_options.m_max_pending_bytes)
+				{
+					m_flush_cv.notify_one();
+					m_space_cv.wait(lock, [this]() { return m_pending.size() < m_options.m_max_pending_bytes || m_error; });
+					this->throw_if_failed();
+				}
+
+				const std::uint64_t lsn = m_next_lsn++;
+				if (m_pending.empty())
+				{
+					m_pending_first_lsn = lsn;
+				}
+				detail::append_record(m_pending, lsn, p_op, p_key, p_value);
+				++m_stats.m_records;
+
+				if (m_pending.size() >= m_options.m_flush_bytes)
+				{
+					m_flush_cv.notify_one();
+				}
+				return lsn;
+			}
+
+			auto throw_if_failed() const -> void
+			{
+				if (m_error)
+				{
+					std::rethrow_exception(m_error);
+				}
+			}
+
+			auto flush_loop() -> void
+			{
+				detail::append_file file;
+				std::string writing;
+				std::unique_lock<std::mutex> lock(m_mutex);
+
+				for (;;)
+				{
+					// A waiter only counts while something is pending, or the predicate would hold the lock forever
+					m_flush_cv.wait_for(lock, m_options.m_flush_interval,
+										[this]() {
+											return m_stop || (!m_error && !m_pending.empty() && (m_waiters > 0 || m_pending.size() >= m_options.m_flush_bytes));
+										});
+					if (m_pending.empty() || m_error)
+					{
+						if (m_stop)
+						{
+							break;
+						}
+						continue;
+					}
+
+					writing.swap(m_pending);
+					const std::uint64_t batch_first = m_pending_first_lsn;
+					const std::uint64_t batch_last	= m_next_lsn - 1;
+					m_space_cv.notify_all();
+					lock.unlock();
+
+					try
+					{
+						if (!file.is_open() || file.bytes() >= m_options.m_file_bytes)
+						{
+							const std::string path = detail::file_io::join_path(m_directory, detail::file_io::numbered_name("wal-", batch_first, ".log"));
+							// Never truncate: an existing file of that name holds acknowledged records
+							file.open(path, true);
+							detail::file_io::sync_directory(m_directory);
+							std::lock_guard<std::mutex> files_lock(m_mutex);
+							if (m_files.empty() || m_files.back().second != path)
+							{
+								m_files.emplace_back(batch_first, path);
+							}
+						}
+						file.write(writing.data(), writing.size());
+						if (m_options.m_sync)
+						{
+							file.sync();
+						}
+					}
+					catch (...)
+					{
+						lock.lock();
+						m_error = std::current_exception();
+						m_durable_cv.notify_all();
+						m_space_cv.notify_all();
+						continue;
+					}
+
+					lock.lock();
+					m_stats.m_bytes += writing.size();
+					++m_stats.m_batches;
+					m_stats.m_syncs += m_options.m_sync ? 1U : 0U;
+					m_durable_lsn = batch_last;
+					writing.clear();
+					m_durable_cv.notify_all();
+				}
+			}
+		};
+	} // namespace durable
+} // namespace cache_engine
@@ -0,0 +1,776 @@
+// File: inc/cache_engine/immutable/mph_table.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CACHE_ENGINE_HAS_MMAP 1
+#else
+#define CACHE_ENGINE_HAS_MMAP 0
+#endif
+
+namespace cache_engine
+{
+	namespace immutable
+	{
+		namespace detail
+		{
+			constexpr char file_magic[8]			= {'C', 'E', 'M', 'P', 'H', 'T', '0', '1'};
+			constexpr std::uint32_t file_version	= 1;
+			constexpr std::uint32_t byte_order_mark = 0x01020304U;
+			constexpr std::uint32_t flag_has_keys	= 1U;
+			constexpr std::size_t max_levels		= 32;
+			constexpr std::size_t block_bits		= 512;
+			constexpr std::size_t block_words		= block_bits / 64;
+			constexpr std::size_t section_alignment = 64;
+
+			/**
+			 * @brief On-disk header, followed by 64-byte aligned sections
+			 *
+			 * Levels are bit vectors stored back to back, each a multiple of
+			 * block_bits long. ranks[b] is the number of set bits before block
+			 * b. Slots 0..ranked-1 belong to keys placed by the levels, the
+			 * remaining ones to the sorted fallback keys, in order.
+			 */
+			struct file_header
+			{
+				char m_magic[8];
+				std::uint32_t m_version;
+				std::uint32_t m_byte_order;
+				std::uint32_t m_flags;
+				std::uint32_t m_key_bytes;
+				std::uint32_t m_value_bytes;
+				std::uint32_t m_level_count;
+				std::uint64_t m_entry_count;
+				std::uint64_t m_fallback_count;
+				std::uint64_t m_seed;
+				std::uint64_t m_level_bits[max_levels];
+				std::uint64_t m_bits_offset;
+				std::uint64_t m_ranks_offset;
+				std::uint64_t m_fingerprints_offset;
+				std::uint64_t m_keys_offset;
+				std::uint64_t m_values_offset;
+				std::uint64_t m_fallback_offset;
+				std::uint64_t m_file_bytes;
+			};
+
+			/**
+			 * @brief 64-bit finalizer (MurmurHash3 fmix64)
+			 */
+			inline auto mix64(std::uint64_t p_value) -> std::uint64_t
+			{
+				p_value ^= p_value >> 33U;
+				p_value *= 0xFF51AFD7ED558CCDULL;
+				p_value ^= p_value >> 33U;
+				p_value *= 0xC4CEB9FE1A85EC53ULL;
+				p_value ^= p_value >> 33U;
+				return p_value;
+			}
+
+			/**
+			 * @brief Seeded hash of an object representation
+			 *
+			 * Stable across processes and builds, unlike std::hash, so a file
+			 * built on one machine is queried with the same positions elsewhere.
+			 */
+			template <typename key_t> auto hash_key(const key_t& p_key, std::uint64_t p_seed) -> std::uint64_t
+			{
+				const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&p_key);
+				std::uint64_t hash		   = p_seed ^ (sizeof(key_t) * 0x9E3779B97F4A7C15ULL);
+				std::size_t offset		   = 0;
+
+				for (; offset + 8 <= sizeof(key_t); offset += 8)
+				{
+					std::uint64_t word = 0;
+					std::memcpy(&word, bytes + offset, 8);
+					hash = mix64(hash ^ word) + 0x9E3779B97F4A7C15ULL;
+				}
+				if (offset < sizeof(key_t))
+				{
+					std::uint64_t word = 0;
+					std::memcpy(&word, bytes + offset, sizeof(key_t) - offset);
+					hash = mix64(hash ^ word ^ 0xA0761D6478BD642FULL);
+				}
+				return mix64(hash);
+			}
+
+			/**
+			 * @brief Bit position of a hashed key in a level of p_bits bits
+			 */
+			inline auto level_position(std::uint64_t p_hash, std::size_t p_level, std::uint64_t p_bits) -> std::uint64_t
+			{
+				return mix64(p_hash + (static_cast<std::uint64_t>(p_level) + 1U) * 0x9E3779B97F4A7C15ULL) % p_bits;
+			}
+
+			/**
+			 * @brief 16-bit fingerprint, independent of the level positions
+			 */
+			inline auto fingerprint(std::uint64_t p_hash) -> std::uint16_t { return static_cast<std::uint16_t>(mix64(p_hash ^ 0xD6E8FEB86659FD93ULL) >> 48U); }
+
+			inline auto popcount(std::uint64_t p_word) -> std::uint32_t
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return static_cast<std::uint32_t>(__builtin_popcountll(p_word));
+#else
+				p_word = p_word - ((p_word >> 1U) & 0x5555555555555555ULL);
+				p_word = (p_word & 0x3333333333333333ULL) + ((p_word >> 2U) & 0x3333333333333333ULL);
+				p_word = (p_word + (p_word >> 4U)) & 0x0F0F0F0F0F0F0F0FULL;
+				return static_cast<std::uint32_t>((p_word * 0x0101010101010101ULL) >> 56U);
+#endif
+			}
+
+			inline auto align_up(std::uint64_t p_value, std::uint64_t p_alignment) -> std::uint64_t { return (p_value + p_alignment - 1) / p_alignment * p_alignment; }
+
+			template <typename key_t> auto key_less(const key_t& p_lhs, const key_t& p_rhs) -> bool { return std::memcmp(&p_lhs, &p_rhs, sizeof(key_t)) < 0; }
+
+			template <typename key_t> auto key_equal(const key_t& p_lhs, const key_t& p_rhs) -> bool { return std::memcmp(&p_lhs, &p_rhs, sizeof(key_t)) == 0; }
+
+			/**
+			 * @brief Slot of p_hash in the level bit vectors, or -1 when no level holds it
+			 *
+			 * Shared by the builder and the mapped table so both resolve a key to
+			 * the same slot.
+			 */
+			inline auto ranked_slot(const file_header& p_header, const std::uint64_t* p_bits, const std::uint64_t* p_ranks, std::uint64_t p_hash) -> std::int64_t
+			{
+				std::uint64_t level_offset = 0;
+				for (std::size_t idx_level = 0; idx_level < p_header.m_level_count; ++idx_level)
+				{
+					const std::uint64_t bit	 = level_offset + level_position(p_hash, idx_level, p_header.m_level_bits[idx_level]);
+					const std::uint64_t word = bit / 64;
+
+					if ((p_bits[word] >> (bit % 64)) & 1U)
+					{
+						std::uint64_t rank = p_ranks[word / block_words];
+						for (std::uint64_t idx_word = word - word % block_words; idx_word < word; ++idx_word)
+						{
+							rank += popcount(p_bits[idx_word]);
+						}
+						rank += popcount(p_bits[word] & ((std::uint64_t(1) << (bit % 64)) - 1U));
+						return static_cast<std::int64_t>(rank);
+					}
+					level_offset += p_header.m_level_bits[idx_level];
+				}
+				return -1;
+			}
+		} // namespace detail
+
+		/**
+		 * @brief Settings for mph_builder::write
+		 */
+		struct mph_build_options
+		{
+			double m_gamma		 = 2.0;			  // Level bits per remaining key; higher builds faster and queries fewer levels
+			bool m_store_keys	 = true;		  // Store full keys; without them absent keys match a slot's fingerprint with p = 2^-16
+			std::uint64_t m_seed = 0x5DEECE66DULL; // Hash seed recorded in the file
+		};
+
+		/**
+		 * @brief What mph_builder::write produced
+		 */
+		struct mph_build_info
+		{
+			std::size_t m_entries		   = 0;
+			std::size_t m_levels		   = 0;
+			std::size_t m_fallback_entries = 0;
+			std::size_t m_file_bytes	   = 0;
+			double m_index_bits_per_key	   = 0.0; // Level bits plus rank directory, excluding fingerprints, keys and values
+		};
+
+		/**
+		 * @brief Offline builder of an immutable minimal perfect hash table file
+		 *
+		 * The index is BBHash style: every level is a bit vector of
+		 * gamma * remaining_keys bits; keys that land alone on a bit are placed
+		 * there, colliding keys move on to the next level. Keys still colliding
+		 * after the last level are stored sorted in a small fallback section.
+		 * Every slot gets a 16-bit fingerprint, optionally the full key, and the
+		 * value, in separate packed arrays.
+		 *
+		 * Keys and values are stored by their object representation, so both
+		 * must be trivially copyable and keys must not contain padding bytes.
+		 * Files are written in native byte order; mph_table rejects files of the
+		 * other order.
+		 *
+		 * @tparam key_t The key type
+		 * @tparam value_t The value type
+		 */
+		template <typename key_t, typename value_t> class mph_builder
+		{
+			static_assert(std::is_trivially_copyable<key_t>::value, "mph_builder keys must be trivially copyable");
+			static_assert(std::is_trivially_copyable<value_t>::value, "mph_builder values must be trivially copyable");
+
+		  public:
+			using self_t	 = mph_builder<key_t, value_t>;
+			using key_type	 = key_t;
+			using value_type = value_t;
+
+		  private:
+			std::vector<key_t> m_keys;
+			std::vector<value_t> m_values;
+
+		  public:
+			// Constructor
+			mph_builder() {}
+
+			// Constructor reserving room for p_expected entries
+			explicit mph_builder(std::size_t p_expected)
+			{
+				m_keys.reserve(p_expected);
+				m_values.reserve(p_expected);
+			}
+
+			// Destructor
+			~mph_builder() {}
+
+			// Deleted copy constructor and assignment operator
+			mph_builder(const self_t&)				 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			// Move constructor and assignment operator
+			mph_builder(self_t&& p_other) noexcept : m_keys(std::move(p_other.m_keys)), m_values(std::move(p_other.m_values)) {}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					m_keys	 = std::move(p_other.m_keys);
+					m_values = std::move(p_other.m_values);
+				}
+				return *this;
+			}
+
+			/**
+			 * @brief Add an entry; keys must be unique, which write() verifies
+			 */
+			auto add(const key_t& p_key, const value_t& p_value) -> void
+			{
+				m_keys.push_back(p_key);
+				m_values.push_back(p_value);
+			}
+
+			auto size() const -> std::size_t { return m_keys.size(); }
+
+			auto empty() const -> bool { return m_keys.empty(); }
+
+			/**
+			 * @brief Build the table and write it to p_path
+			 *
+			 * The file is written next to p_path and renamed over it, so
+			 * processes that still map the previous file keep a consistent view.
+			 *
+			 * @param p_path Destination file
+			 * @param p_options Build settings
+			 * @return Sizes of the written table
+			 * @throws std::invalid_argument on duplicate keys or a gamma below 1
+			 * @throws std::runtime_error when the file cannot be written
+			 */
+			auto write(const std::string& p_path, const mph_build_options& p_options = mph_build_options()) const -> mph_build_info
+			{
+				if (!(p_options.m_gamma >= 1.0))
+				{
+					throw std::invalid_argument("mph_builder gamma must be at least 1");
+				}
+
+				detail::file_header header;
+				std::memset(&header, 0, sizeof(header));
+				std::memcpy(header.m_magic, detail::file_magic, sizeof(header.m_magic));
+				header.m_version	 = detail::file_version;
+				header.m_byte_order	 = detail::byte_order_mark;
+				header.m_flags		 = p_options.m_store_keys ? detail::flag_has_keys : 0U;
+				header.m_key_bytes	 = static_cast<std::uint32_t>(sizeof(key_t));
+				header.m_value_bytes = static_cast<std::uint32_t>(sizeof(value_t));
+				header.m_entry_count = m_keys.size();
+				header.m_seed		 = p_options.m_seed;
+
+				std::vector<std::uint64_t> hashes(m_keys.size());
+				for (std::size_t idx_for = 0; idx_for < m_keys.size(); ++idx_for)
+				{
+					hashes[idx_for] = detail::hash_key(m_keys[idx_for], p_options.m_seed);
+				}
+
+				// Place keys level by level; remaining holds indices into m_keys
+				std::vector<std::uint64_t> bits;
+				std::vector<std::size_t> remaining(m_keys.size());
+				for (std::size_t idx_for = 0; idx_for < remaining.size(); ++idx_for)
+				{
+					remaining[idx_for] = idx_for;
+				}
+
+				std::size_t level_count = 0;
+				for (; level_count < detail::max_levels && !remaining.empty(); ++level_count)
+				{
+					const std::uint64_t wanted	   = static_cast<std::uint64_t>(std::ceil(static_cast<double>(remaining.size()) * p_options.m_gamma));
+					const std::uint64_t level_bits = detail::align_up(std::max<std::uint64_t>(wanted, 1), detail::block_bits);
+					const std::size_t words		   = static_cast<std::size_t>(level_bits / 64);
+					std::vector<std::uint64_t> used(words, 0);
+					std::vector<std::uint64_t> collided(words, 0);
+
+					for (const std::size_t index : remaining)
+					{
+						const std::uint64_t bit	 = detail::level_position(hashes[index], level_count, level_bits);
+						const std::uint64_t mask = std::uint64_t(1) << (bit % 64);
+						if (used[bit / 64] & mask)
+						{
+							collided[bit / 64] |= mask;
+						}
+						used[bit / 64] |= mask;
+					}
+
+					std::vector<std::size_t> next;
+					for (const std::size_t index : remaining)
+					{
+						const std::uint64_t bit = detail::level_position(hashes[index], level_count, level_bits);
+						if ((collided[bit / 64] >> (bit % 64)) & 1U)
+						{
+							next.push_back(index);
+						}
+					}
+					for (std::size_t idx_word = 0; idx_word < words; ++idx_word)
+					{
+						bits.push_back(used[idx_word] & ~collided[idx_word]);
+					}
+
+					header.m_level_bits[level_count] = level_bits;
+					remaining.swap(next);
+				}
+				header.m_level_count = static_cast<std::uint32_t>(level_count);
+
+				// Equal keys collide on every level, so duplicates always end up here
+				std::sort(remaining.begin(), remaining.end(), [this](std::size_t p_lhs, std::size_t p_rhs) { return detail::key_less(m_keys[p_lhs], m_keys[p_rhs]); });
+				for (std::size_t idx_for = 1; idx_for < remaining.size(); ++idx_for)
+				{
+					if (detail::key_equal(m_keys[remaining[idx_for - 1]], m_keys[remaining[idx_for]]))
+					{
+						throw std::invalid_argument("mph_builder found a duplicate key");
+					}
+				}
+				header.m_fallback_count = remaining.size();
+
+				std::vector<std::uint64_t> ranks(bits.size() / detail::block_words + 1, 0);
+				std::uint64_t ranked = 0;
+				for (std::size_t idx_block = 0; idx_block < bits.size() / detail::block_words; ++idx_block)
+				{
+					ranks[idx_block] = ranked;
+					for (std::size_t idx_word = 0; idx_word < detail::block_words; ++idx_word)
+					{
+						ranked += detail::popcount(bits[idx_block * detail::block_words + idx_word]);
+					}
+				}
+				ranks.back() = ranked;
+
+				// Lay out the slot arrays
+				const std::size_t count = m_keys.size();
+				std::vector<std::uint16_t> fingerprints(count, 0);
+				std::vector<key_t> keys(p_options.m_store_keys ? count : 0);
+				std::vector<value_t> values(count);
+				std::vector<key_t> fallback_keys;
+				fallback_keys.reserve(remaining.size());
+
+				for (std::size_t idx_for = 0; idx_for < remaining.size(); ++idx_for)
+				{
+					fallback_keys.push_back(m_keys[remaining[idx_for]]);
+				}
+
+				std::vector<bool> is_fallback(count, false);
+				for (std::size_t idx_for = 0; idx_for < remaining.size(); ++idx_for)
+				{
+					is_fallback[remaining[idx_for]] = true;
+				}
+
+				for (std::size_t idx_for = 0; idx_for < count; ++idx_for)
+				{
+					std::size_t slot = 0;
+					if (is_fallback[idx_for])
+					{
+						const auto iter = std::lower_bound(fallback_keys.begin(), fallback_keys.end(), m_keys[idx_for], detail::key_less<key_t>);
+						slot			= static_cast<std::size_t>(ranked) + static_cast<std::size_t>(iter - fallback_keys.begin());
+					}
+					else
+					{
+						slot = static_cast<std::size_t>(detail::ranked_slot(header, bits.data(), ranks.data(), hashes[idx_for]));
+					}
+
+					fingerprints[slot] = detail::fingerprint(hashes[idx_for]);
+					values[slot]	   = m_values[idx_for];
+					if (p_options.m_store_keys)
+					{
+						keys[slot] = m_keys[idx_for];
+					}
+				}
+
+				std::uint64_t offset		 = detail::align_up(sizeof(header), detail::section_alignment);
+				header.m_bits_offset		 = offset;
+				offset						 = detail::align_up(offset + bits.size() * sizeof(std::uint64_t), detail::section_alignment);
+				header.m_ranks_offset		 = offset;
+				offset						 = detail::align_up(offset + ranks.size() * sizeof(std::uint64_t), detail::section_alignment);
+				header.m_fingerprints_offset = offset;
+				offset						 = detail::align_up(offset + fingerprints.size() * sizeof(std::uint16_t), detail::section_alignment);
+				header.m_keys_offset		 = offset;
+				offset						 = detail::align_up(offset + keys.size() * sizeof(key_t), detail::section_alignment);
+				header.m_values_offset		 = offset;
+				offset						 = detail::align_up(offset + values.size() * sizeof(value_t), detail::section_alignment);
+				header.m_fallback_offset	 = offset;
+				offset						 = detail::align_up(offset + fallback_keys.size() * sizeof(key_t), detail::section_alignment);
+				header.m_file_bytes			 = offset;
+
+				const std::string temporary = p_path + ".tmp";
+				{
+					std::ofstream out(temporary.c_str(), std::ios::binary | std::ios::trunc);
+					if (!out)
+					{
+						throw std::runtime_error("mph_builder cannot create " + temporary);
+					}
+
+					write_section(out, &header, sizeof(header), header.m_bits_offset);
+					write_section(out, bits.data(), bits.size() * sizeof(std::uint64_t), header.m_ranks_offset);
+					write_section(out, ranks.data(), ranks.size() * sizeof(std::uint64_t), header.m_fingerprints_offset);
+					write_section(out, fingerprints.data(), fingerprints.size() * sizeof(std::uint16_t), header.m_keys_offset);
+					write_section(out, keys.data(), keys.size() * sizeof(key_t), header.m_values_offset);
+					write_section(out, values.data(), values.size() * sizeof(value_t), header.m_fallback_offset);
+					write_section(out, fallback_keys.data(), fallback_keys.size() * sizeof(key_t), header.m_file_bytes);
+
+					out.flush();
+					if (!out)
+					{
+						std::remove(temporary.c_str());
+						throw std::runtime_error("mph_builder failed writing " + temporary);
+					}
+				}
+				if (std::rename(temporary.c_str(), p_path.c_str()) != 0)
+				{
+					std::remove(temporary.c_str());
+					throw std::runtime_error("mph_builder cannot rename " + temporary + " to " + p_path);
+				}
+
+				mph_build_info info;
+				info.m_entries			  = count;
+				info.m_levels			  = level_count;
+				info.m_fallback_entries	  = remaining.size();
+				info.m_file_bytes		  = static_cast<std::size_t>(header.m_file_bytes);
+				info.m_index_bits_per_key = (count == 0) ? 0.0 : static_cast<double>((bits.size() + ranks.size()) * 64) / static_cast<double>(count);
+				return info;
+			}
+
+		  private:
+			/**
+			 * @brief Write p_bytes of p_data, then zero padding up to file offset p_end
+			 */
+			static auto write_section(std::ofstream& p_out, const void* p_data, std::size_t p_bytes, std::uint64_t p_end) -> void
+			{
+				static const char padding[detail::section_alignment] = {};
+
+				if (p_bytes != 0)
+				{
+					p_out.write(static_cast<const char*>(p_data), static_cast<std::streamsize>(p_bytes));
+				}
+				const std::uint64_t position = static_cast<std::uint64_t>(p_out.tellp());
+				if (position < p_end)
+				{
+					p_out.write(padding, static_cast<std::streamsize>(p_end - position));
+				}
+			}
+		};
+
+		/**
+		 * @brief How mph_table maps its file
+		 */
+		enum class mph_open_mode
+		{
+			lazy,	 // Pages are faulted in by lookups; opening costs only the header check
+			prefault // Ask the kernel to read the whole file ahead; first lookups avoid page faults
+		};
+
+		/**
+		 * @brief Read-only table served straight from an mph_builder file
+		 *
+		 * The file is mapped shared and read-only: opening validates the header
+		 * and does no parsing or allocation, and processes mapping the same
+		 * file share its page cache pages. A lookup hashes the key once, reads
+		 * one bit per level until a set bit is found (on average about 1.6
+		 * levels at gamma 2), then the fingerprint and, when the file stores
+		 * them, the key of that slot; the value is read only on a match.
+		 *
+		 * Lookups are const and safe from any number of threads.
+		 *
+		 * @tparam key_t The key type the file was built with
+		 * @tparam value_t The value type the file was built with
+		 */
+		template <typename key_t, typename value_t> class mph_table
+		{
+			static_assert(std::is_trivially_copyable<key_t>::value, "mph_table keys must be trivially copyable");
+			static_assert(std::is_trivially_copyable<value_t>::value, "mph_table values must be trivially copyable");
+
+		  public:
+			using self_t	 = mph_table<key_t, value_t>;
+			using key_type	 = key_t;
+			using value_type = value_t;
+
+		  private:
+			const unsigned char* m_base;
+			std::size_t m_bytes;
+			const detail::file_header* m_header;
+			const std::uint64_t* m_bits;
+			const std::uint64_t* m_ranks;
+			const std::uint16_t* m_fingerprints;
+			const unsigned char* m_keys;
+			const unsigned char* m_values;
+			const unsigned char* m_fallback;
+			std::uint64_t m_ranked;
+
+		  public:
+			/**
+			 * @brief Map p_path
+			 *
+			 * @param p_path A file written by mph_builder<key_t, value_t>
+			 * @param p_mode Lazy or prefaulted mapping
+			 * @throws std::runtime_error when the file cannot be mapped or was built for other types, version or byte order
+			 */
+			explicit mph_table(const std::string& p_path, mph_open_mode p_mode = mph_open_mode::lazy)
+				: m_base(nullptr), m_bytes(0), m_header(nullptr), m_bits(nullptr), m_ranks(nullptr), m_fingerprints(nullptr), m_keys(nullptr), m_values(nullptr), m_fallback(nullptr),
+				  m_ranked(0)
+			{
+#if CACHE_ENGINE_HAS_MMAP
+				const int descriptor = ::open(p_path.c_str(), O_RDONLY | O_CLOEXEC);
+				if (descriptor < 0)
+				{
+					throw std::runtime_error("mph_table cannot open " + p_path);
+				}
+
+				struct stat status;
+				if (::fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(detail::file_header))
+				{
+					::close(descriptor);
+					throw std::runtime_error("mph_table file too small: " + p_path);
+				}
+
+				m_bytes		  = static_cast<std::size_t>(status.st_size);
+				void* mapping = ::mmap(nullptr, m_bytes, PROT_READ, MAP_SHARED, descriptor, 0);
+				::close(descriptor);
+				if (mapping == MAP_FAILED)
+				{
+					throw std::runtime_error("mph_table cannot map " + p_path);
+				}
+				m_base = static_cast<const unsigned char*>(mapping);
+				::madvise(mapping, m_bytes, (p_mode == mph_open_mode::prefault) ? MADV_WILLNEED : MADV_RANDOM);
+
+				try
+				{
+					this->attach(p_path);
+				}
+				catch (...)
+				{
+					this->unmap();
+					throw;
+				}
+#else
+				(void)p_mode;
+				throw std::runtime_error("mph_table needs mmap, which this platform does not provide: " + p_path);
+#endif
+			}
+
+			// Destructor
+			~mph_table() { this->unmap(); }
+
+			// Deleted copy constructor and assignment operator
+			mph_table(const self_t&)				 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			// Move constructor and assignment operator
+			mph_table(self_t&& p_other) noexcept
+				: m_base(p_other.m_base), m_bytes(p_other.m_bytes), m_header(p_other.m_header), m_bits(p_other.m_bits), m_ranks(p_other.m_ranks), m_fingerprints(p_other.m_fingerprints),
+				  m_keys(p_other.m_keys), m_values(p_other.m_values), m_fallback(p_other.m_fallback), m_ranked(p_other.m_ranked)
+			{
+				p_other.m_base	= nullptr;
+				p_other.m_bytes = 0;
+			}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					this->unmap();
+					m_base			= p_other.m_base;
+					m_bytes			= p_other.m_bytes;
+					m_header		= p_other.m_header;
+					m_bits			= p_other.m_bits;
+					m_ranks			= p_other.m_ranks;
+					m_fingerprints	= p_other.m_fingerprints;
+					m_keys			= p_other.m_keys;
+					m_values		= p_other.m_values;
+					m_fallback		= p_other.m_fallback;
+					m_ranked		= p_other.m_ranked;
+					p_other.m_base	= nullptr;
+					p_other.m_bytes = 0;
+				}
+				return *this;
+			}
+
+			/**
+			 * @brief Look up a key
+			 *
+			 * @param p_key The key
+			 * @param p_value Receives the value on a hit
+			 * @return true if the key is in the table
+			 */
+			auto find(const key_t& p_key, value_t& p_value) const -> bool
+			{
+				const std::int64_t slot = this->slot_of(p_key);
+				if (slot < 0)
+				{
+					return false;
+				}
+				std::memcpy(&p_value, m_values + static_cast<std::size_t>(slot) * sizeof(value_t), sizeof(value_t));
+				return true;
+			}
+
+			auto contains(const key_t& p_key) const -> bool { return this->slot_of(p_key) >= 0; }
+
+			/**
+			 * @brief Look up a key
+			 *
+			 * @throws std::out_of_range if the key is not in the table
+			 */
+			auto get(const key_t& p_key) const -> value_t
+			{
+				value_t value;
+				if (!this->find(p_key, value))
+				{
+					throw std::out_of_range("Key not found in mph_table");
+				}
+				return value;
+			}
+
+			auto size() const -> std::size_t { return static_cast<std::size_t>(m_header->m_entry_count); }
+
+			auto empty() const -> bool { return m_header->m_entry_count == 0; }
+
+			/**
+			 * @brief Whether lookups compare full keys; without them absent keys are rejected by fingerprint only
+			 */
+			auto has_keys() const -> bool { return (m_header->m_flags & detail::flag_has_keys) != 0; }
+
+			auto mapped_bytes() const -> std::size_t { return m_bytes; }
+
+		  private:
+			auto slot_of(const key_t& p_key) const -> std::int64_t
+			{
+				const std::uint64_t hash = detail::hash_key(p_key, m_header->m_seed);
+				std::int64_t slot		 = detail::ranked_slot(*m_header, m_bits, m_ranks, hash);
+
+				if (slot < 0)
+				{
+					slot = this->fallback_slot(p_key);
+					if (slot < 0)
+					{
+						return -1;
+					}
+				}
+				if (m_fingerprints[slot] != detail::fingerprint(hash))
+				{
+					return -1;
+				}
+				if (m_keys != nullptr && std::memcmp(m_keys + static_cast<std::size_t>(slot) * sizeof(key_t), &p_key, sizeof(key_t)) != 0)
+				{
+					return -1;
+				}
+				return slot;
+			}
+
+			auto fallback_slot(const key_t& p_key) const -> std::int64_t
+			{
+				std::size_t low	 = 0;
+				std::size_t high = static_cast<std::size_t>(m_header->m_fallback_count);
+				while (low < high)
+				{
+					const std::size_t middle = low + (high - low) / 2;
+					const int order			 = std::memcmp(m_fallback + middle * sizeof(key_t), &p_key, sizeof(key_t));
+					if (order == 0)
+					{
+						return static_cast<std::int64_t>(m_ranked + middle);
+					}
+					if (order < 0)
+					{
+						low = middle + 1;
+					}
+					else
+					{
+						high = middle;
+					}
+				}
+				return -1;
+			}
+
+			/**
+			 * @brief Validate the mapped header and point the sections into the mapping
+			 */
+			auto attach(const std::string& p_path) -> void
+			{
+				m_header						  = reinterpret_cast<const detail::file_header*>(m_base);
+				const detail::file_header& header = *m_header;
+
+				if (std::memcmp(header.m_magic, detail::file_magic, sizeof(header.m_magic)) != 0 || header.m_version != detail::file_version)
+				{
+					throw std::runtime_error("mph_table unknown file format: " + p_path);
+				}
+				if (header.m_byte_order != detail::byte_order_mark)
+				{
+					throw std::runtime_error("mph_table file has foreign byte order: " + p_path);
+				}
+				if (header.m_key_bytes != sizeof(key_t) || header.m_value_bytes != sizeof(value_t))
+				{
+					throw std::runtime_error("mph_table file was built for other key or value types: " + p_path);
+				}
+				const bool ordered = header.m_bits_offset >= sizeof(detail::file_header) && header.m_bits_offset <= header.m_ranks_offset &&
+									 header.m_ranks_offset <= header.m_fingerprints_offset && header.m_fingerprints_offset <= header.m_keys_offset &&
+									 header.m_keys_offset <= header.m_values_offset && header.m_values_offset <= header.m_fallback_offset && header.m_fallback_offset <= m_bytes;
+				if (header.m_file_bytes != m_bytes || header.m_level_count > detail::max_levels || !ordered)
+				{
+					throw std::runtime_error("mph_table file is truncated or corrupt: " + p_path);
+				}
+
+				std::uint64_t level_words = 0;
+				for (std::size_t idx_level = 0; idx_level < header.m_level_count; ++idx_level)
+				{
+					level_words += header.m_level_bits[idx_level] / 64;
+				}
+
+				m_bits		   = reinterpret_cast<const std::uint64_t*>(m_base + header.m_bits_offset);
+				m_ranks		   = reinterpret_cast<const std::uint64_t*>(m_base + header.m_ranks_offset);
+				m_fingerprints = reinterpret_cast<const std::uint16_t*>(m_base + header.m_fingerprints_offset);
+				m_keys		   = this->has_keys() ? m_base + header.m_keys_offset : nullptr;
+				m_values	   = m_base + header.m_values_offset;
+				m_fallback	   = m_base + header.m_fallback_offset;
+				m_ranked	   = m_ranks[level_words / detail::block_words];
+			}
+
+			auto unmap() -> void
+			{
+#if CACHE_ENGINE_HAS_MMAP
+				if (m_base != nullptr)
+				{
+					::munmap(const_cast<unsigned char*>(m_base), m_bytes);
+				}
+#endif
+				m_base	= nullptr;
+				m_bytes = 0;
+			}
+		};
+	} // namespace immutable
+} // namespace cache_engine
@@ -0,0 +1,150 @@
+// File: inc/cache_engine/immutable/tiered_cache.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace cache_engine
+{
+	namespace immutable
+	{
+		/**
+		 * @brief A mutable cache in front of a read-only lower tier
+		 *
+		 * Lookups try the upper cache first, then the lower tier (typically an
+		 * mph_table); lower hits are optionally promoted into the upper cache so
+		 * hot entries are served without touching the mapping. Writes only go
+		 * to the upper cache and shadow the lower value while they stay
+		 * resident; once the upper cache evicts them the lower value is visible
+		 * again. The lower tier is shared, so many tiered caches, one per
+		 * thread or per process, can sit on the same mapping.
+		 *
+		 * @tparam upper_t A cache with put/get/contains/size, e.g. cache<> or policy_based_cache<>
+		 * @tparam lower_t A read-only table with find(key, value&) const
+		 */
+		template <typename upper_t, typename lower_t> class tiered_cache
+		{
+		  public:
+			using self_t	 = tiered_cache<upper_t, lower_t>;
+			using key_type	 = typename lower_t::key_type;
+			using value_type = typename lower_t::value_type;
+
+		  private:
+			upper_t m_upper;
+			std::shared_ptr<const lower_t> m_lower;
+			bool m_promote;
+			std::size_t m_upper_hits;
+			std::size_t m_lower_hits;
+			std::size_t m_misses;
+
+		  public:
+			/**
+			 * @brief Put p_upper in front of p_lower
+			 *
+			 * @param p_upper The mutable cache, moved in
+			 * @param p_lower The read-only tier
+			 * @param p_promote Copy lower hits into the upper cache
+			 * @throws std::invalid_argument if p_lower is null
+			 */
+			tiered_cache(upper_t&& p_upper, std::shared_ptr<const lower_t> p_lower, bool p_promote = true)
+				: m_upper(std::move(p_upper)), m_lower(std::move(p_lower)), m_promote(p_promote), m_upper_hits(0), m_lower_hits(0), m_misses(0)
+			{
+				if (!m_lower)
+				{
+					throw std::invalid_argument("tiered_cache needs a lower tier");
+				}
+			}
+
+			// Destructor
+			~tiered_cache() {}
+
+			// Deleted copy constructor and assignment operator
+			tiered_cache(const self_t&)				  = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			// Move constructor and assignment operator
+			tiered_cache(self_t&& p_other) noexcept
+				: m_upper(std::move(p_other.m_upper)), m_lower(std::move(p_other.m_lower)), m_promote(p_other.m_promote), m_upper_hits(p_other.m_upper_hits),
+				  m_lower_hits(p_other.m_lower_hits), m_misses(p_other.m_misses)
+			{
+			}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					m_upper		 = std::move(p_other.m_upper);
+					m_lower		 = std::move(p_other.m_lower);
+					m_promote	 = p_other.m_promote;
+					m_upper_hits = p_other.m_upper_hits;
+					m_lower_hits = p_other.m_lower_hits;
+					m_misses	 = p_other.m_misses;
+				}
+				return *this;
+			}
+
+			/**
+			 * @brief Look up a key in the upper cache, then in the lower tier
+			 *
+			 * @return true if either tier holds the key
+			 */
+			auto find(const key_type& p_key, value_type& p_value) -> bool
+			{
+				if (m_upper.contains(p_key))
+				{
+					++m_upper_hits;
+					p_value = m_upper.get(p_key);
+					return true;
+				}
+				if (m_lower->find(p_key, p_value))
+				{
+					++m_lower_hits;
+					if (m_promote)
+					{
+						m_upper.put(p_key, p_value);
+					}
+					return true;
+				}
+				++m_misses;
+				return false;
+			}
+
+			/**
+			 * @brief Look up a key
+			 *
+			 * @throws std::out_of_range if neither tier holds the key
+			 */
+			auto get(const key_type& p_key) -> value_type
+			{
+				value_type value;
+				if (!this->find(p_key, value))
+				{
+					throw std::out_of_range("Key not found in either tier");
+				}
+				return value;
+			}
+
+			auto contains(const key_type& p_key) const -> bool { return m_upper.contains(p_key) || m_lower->contains(p_key); }
+
+			/**
+			 * @brief Store a value in the upper cache; it shadows the lower value while resident
+			 */
+			auto put(const key_type& p_key, const value_type& p_value) -> void { m_upper.put(p_key, p_value); }
+
+			auto upper() -> upper_t& { return m_upper; }
+
+			auto upper() const -> const upper_t& { return m_upper; }
+
+			auto lower() const -> const lower_t& { return *m_lower; }
+
+			auto upper_hits() const -> std::size_t { return m_upper_hits; }
+
+			auto lower_hits() const -> std::size_t { return m_lower_hits; }
+
+			auto misses() const -> std::size_t { return m_misses; }
+		};
+	} // namespace immutable
+} // namespace cache_engine
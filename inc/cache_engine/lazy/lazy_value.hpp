@@ -0,0 +1,330 @@
+// File: inc/cache_engine/lazy/lazy_value.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../durable/codec.hpp"
+#include "../policies/policy_interfaces.hpp"
+
+namespace cache_engine
+{
+	namespace lazy
+	{
+		/**
+		 * @brief Running total of the bytes charged by the lazy values of one cache
+		 *
+		 * A value charges its serialized size when created, swaps that for its
+		 * decoded size when decoded and gives its charge back when the last
+		 * copy is destroyed. Thread-safe.
+		 */
+		class byte_ledger
+		{
+		  private:
+			std::atomic<std::size_t> m_bytes;
+
+		  public:
+			// Constructor
+			byte_ledger() : m_bytes(0) {}
+
+			// Deleted copy constructor and assignment operator
+			byte_ledger(const byte_ledger&)					   = delete;
+			auto operator=(const byte_ledger&) -> byte_ledger& = delete;
+
+			auto charge(std::size_t p_bytes) -> void { m_bytes.fetch_add(p_bytes, std::memory_order_relaxed); }
+
+			auto release(std::size_t p_bytes) -> void { m_bytes.fetch_sub(p_bytes, std::memory_order_relaxed); }
+
+			auto bytes() const -> std::size_t { return m_bytes.load(std::memory_order_relaxed); }
+		};
+
+		/**
+		 * @brief Default decoder: durable::codec<value_t>
+		 */
+		template <typename value_t> struct codec_decoder
+		{
+			auto operator()(const char* p_data, std::size_t p_bytes, value_t& p_value) const -> bool { return durable::codec<value_t>::decode(p_data, p_bytes, p_value); }
+		};
+
+		/**
+		 * @brief Default size of a decoded value: its object representation
+		 *
+		 * Specialize (or pass another sizer) for types that own heap memory.
+		 */
+		template <typename value_t> struct decoded_size
+		{
+			auto operator()(const value_t&) const -> std::size_t { return sizeof(value_t); }
+		};
+
+		/**
+		 * @brief Object plus heap capacity of a string
+		 */
+		template <> struct decoded_size<std::string>
+		{
+			auto operator()(const std::string& p_value) const -> std::size_t { return sizeof(std::string) + p_value.capacity(); }
+		};
+
+		namespace detail
+		{
+			/**
+			 * @brief Striped locks taken only while a value is decoded for the first time
+			 */
+			struct decode_locks
+			{
+				static constexpr std::size_t stripe_count = 64;
+
+				static auto for_state(const void* p_state) -> std::mutex&
+				{
+					static std::mutex locks[stripe_count];
+					return locks[(reinterpret_cast<std::uintptr_t>(p_state) >> 6U) % stripe_count];
+				}
+			};
+		} // namespace detail
+
+		/**
+		 * @brief Cache value kept serialized until it is first read
+		 *
+		 * Bulk-loaded caches often evict most entries before anyone reads
+		 * them, so decoding every value on put() is mostly wasted. A lazy_value
+		 * holds the serialized bytes; get() decodes them once into the live
+		 * object, keeps that and drops the bytes. Copies share one state, so
+		 * the copy a cache returns from get() decodes for the copy it stores.
+		 *
+		 * The first get() decodes under one of a few striped mutexes; later
+		 * calls only load an atomic flag, so concurrent readers of a shared
+		 * cache are safe. With a byte_ledger, the value's charge switches from
+		 * the serialized to the decoded size on decoding; see
+		 * ledger_capacity_policy.
+		 *
+		 * @tparam value_t Decoded type (must be default constructible)
+		 * @tparam decoder_t Functor (const char*, size_t, value_t&) -> bool
+		 * @tparam sizer_t Functor (const value_t&) -> size_t, the decoded charge
+		 */
+		template <typename value_t, typename decoder_t = codec_decoder<value_t>, typename sizer_t = decoded_size<value_t>> class lazy_value
+		{
+		  public:
+			using self_t = lazy_value<value_t, decoder_t, sizer_t>;
+
+		  private:
+			struct state
+			{
+				std::string m_bytes;
+				std::unique_ptr<value_t> m_value;
+				std::atomic<bool> m_decoded;
+				std::atomic<std::size_t> m_charged;
+				std::shared_ptr<byte_ledger> m_ledger;
+
+				state(std::string&& p_bytes, std::shared_ptr<byte_ledger>&& p_ledger)
+					: m_bytes(std::move(p_bytes)), m_value(), m_decoded(false), m_charged(m_bytes.size()), m_ledger(std::move(p_ledger))
+				{
+					if (m_ledger)
+					{
+						m_ledger->charge(m_charged.load(std::memory_order_relaxed));
+					}
+				}
+
+				~state()
+				{
+					if (m_ledger)
+					{
+						m_ledger->release(m_charged.load(std::memory_order_relaxed));
+					}
+				}
+
+				state(const state&)					   = delete;
+				auto operator=(const state&) -> state& = delete;
+			};
+
+			std::shared_ptr<state> m_state;
+
+		  public:
+			// Constructor: an empty value, as default-constructed by caches
+			lazy_value() : m_state() {}
+
+			/**
+			 * @brief Wrap serialized bytes, charging their size to p_ledger
+			 * @param p_bytes The serialized form decoder_t accepts
+			 * @param p_ledger Ledger of the cache the value goes into, or null
+			 */
+			explicit lazy_value(std::string p_bytes, std::shared_ptr<byte_ledger> p_ledger = std::shared_ptr<byte_ledger>())
+				: m_state(std::make_shared<state>(std::move(p_bytes), std::move(p_ledger)))
+			{
+			}
+
+			/**
+			 * @brief Wrap an already decoded value, charging its decoded size
+			 */
+			static auto from_value(value_t p_value, std::shared_ptr<byte_ledger> p_ledger = std::shared_ptr<byte_ledger>()) -> self_t
+			{
+				self_t result;
+				result.m_state			= std::make_shared<state>(std::string(), std::move(p_ledger));
+				result.m_state->m_value.reset(new value_t(std::move(p_value)));
+				result.m_state->m_decoded.store(true, std::memory_order_release);
+				result.recharge(sizer_t()(*result.m_state->m_value));
+				return result;
+			}
+
+			/**
+			 * @brief The decoded value, decoding it on the first call
+			 * @throws std::logic_error if the value is empty
+			 * @throws std::runtime_error if decoder_t rejects the bytes
+			 */
+			auto get() const -> const value_t&
+			{
+				if (!m_state)
+				{
+					throw std::logic_error("Empty lazy value");
+				}
+				if (!m_state->m_decoded.load(std::memory_order_acquire))
+				{
+					this->decode();
+				}
+				return *m_state->m_value;
+			}
+
+			auto empty() const -> bool { return !m_state; }
+
+			auto is_decoded() const -> bool { return m_state && m_state->m_decoded.load(std::memory_order_acquire); }
+
+			/**
+			 * @brief Bytes charged for this value: serialized size until decoded, decoded size after
+			 */
+			auto charged_bytes() const -> std::size_t { return m_state ? m_state->m_charged.load(std::memory_order_relaxed) : 0; }
+
+		  private:
+			auto decode() const -> void
+			{
+				std::lock_guard<std::mutex> lock(detail::decode_locks::for_state(m_state.get()));
+				if (m_state->m_decoded.load(std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				std::unique_ptr<value_t> decoded(new value_t());
+				if (!decoder_t()(m_state->m_bytes.data(), m_state->m_bytes.size(), *decoded))
+				{
+					throw std::runtime_error("Lazy value bytes could not be decoded");
+				}
+				m_state->m_value = std::move(decoded);
+				std::string().swap(m_state->m_bytes);
+				this->recharge(sizer_t()(*m_state->m_value));
+				m_state->m_decoded.store(true, std::memory_order_release);
+			}
+
+			auto recharge(std::size_t p_bytes) const -> void
+			{
+				const std::size_t previous = m_state->m_charged.exchange(p_bytes, std::memory_order_relaxed);
+				if (m_state->m_ledger)
+				{
+					m_state->m_ledger->charge(p_bytes);
+					m_state->m_ledger->release(previous);
+				}
+			}
+		};
+
+		/**
+		 * @brief Capacity policy that bounds both the entry count and the bytes charged to a byte_ledger
+		 *
+		 * The cache's capacity argument is the entry limit, as for
+		 * fixed_capacity; set_byte_limit() adds a byte budget (unlimited by
+		 * default). Create values with ledger() so they charge it: a value's
+		 * charge grows from serialized to decoded size when it is first read,
+		 * and the next insertion evicts entries until the total is back under
+		 * the budget, estimating the count from the average charge per entry.
+		 * Values still referenced outside the cache stay charged until released.
+		 */
+		template <typename key_t, typename value_t> class ledger_capacity_policy : public policies::capacity_policy_base<key_t, value_t>
+		{
+		  public:
+			using self_t = ledger_capacity_policy<key_t, value_t>;
+			using base_t = policies::capacity_policy_base<key_t, value_t>;
+
+		  private:
+			std::size_t m_capacity;
+			std::size_t m_byte_limit;
+			std::shared_ptr<byte_ledger> m_ledger;
+
+		  public:
+			// Constructor
+			explicit ledger_capacity_policy(std::size_t p_capacity)
+				: m_capacity(p_capacity), m_byte_limit(std::numeric_limits<std::size_t>::max()), m_ledger(std::make_shared<byte_ledger>())
+			{
+			}
+
+			// Destructor
+			~ledger_capacity_policy() override = default;
+
+			// Deleted copy constructor and assignment operator
+			ledger_capacity_policy(const self_t&)	 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			// Move constructor and assignment operator
+			ledger_capacity_policy(self_t&& p_other) noexcept
+				: m_capacity(p_other.m_capacity), m_byte_limit(p_other.m_byte_limit), m_ledger(std::move(p_other.m_ledger))
+			{
+			}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					m_capacity	 = p_other.m_capacity;
+					m_byte_limit = p_other.m_byte_limit;
+					m_ledger	 = std::move(p_other.m_ledger);
+				}
+				return *this;
+			}
+
+			auto capacity() const -> std::size_t override { return m_capacity; }
+
+			auto set_capacity(std::size_t p_new_capacity) -> void override { m_capacity = p_new_capacity; }
+
+			auto needs_eviction(std::size_t p_current_size) const -> bool override
+			{
+				return p_current_size >= m_capacity || (p_current_size > 0 && m_ledger->bytes() >= m_byte_limit);
+			}
+
+			auto eviction_count(std::size_t p_current_size) const -> std::size_t override
+			{
+				const std::size_t by_count = p_current_size >= m_capacity ? p_current_size - m_capacity + 1 : 0;
+				const std::size_t bytes	   = m_ledger->bytes();
+				if (p_current_size == 0 || bytes < m_byte_limit)
+				{
+					return by_count;
+				}
+				const std::size_t average  = (bytes + p_current_size - 1) / p_current_size;
+				const std::size_t by_bytes = (bytes - m_byte_limit) / average + 1;
+				const std::size_t count	   = by_bytes > by_count ? by_bytes : by_count;
+				return count < p_current_size ? count : p_current_size;
+			}
+
+			/**
+			 * @brief Set the byte budget; takes effect on the next insertion
+			 * @param p_byte_limit Bytes the charged values may total
+			 */
+			auto set_byte_limit(std::size_t p_byte_limit) -> void { m_byte_limit = p_byte_limit; }
+
+			auto byte_limit() const -> std::size_t { return m_byte_limit; }
+
+			/**
+			 * @brief The ledger values of this cache should be created with
+			 */
+			auto ledger() const -> const std::shared_ptr<byte_ledger>& { return m_ledger; }
+
+			auto charged_bytes() const -> std::size_t { return m_ledger->bytes(); }
+		};
+	} // namespace lazy
+
+	namespace policy_templates
+	{
+		template <typename key_t, typename value_t> using ledger_capacity = lazy::ledger_capacity_policy<key_t, value_t>;
+	} // namespace policy_templates
+} // namespace cache_engine
@@ -0,0 +1,301 @@
+// File: inc/cache_engine/memory/cache_arena.hpp
+
+#pragma once
+
+#if __cplusplus < 201703L
+#error "cache_arena requires C++17 <memory_resource> (link against cache_engine_pmr)"
+#endif
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace cache_engine
+{
+	namespace memory
+	{
+		/**
+		 * @brief Pass-through memory resource that accounts for every byte it hands out
+		 *
+		 * Not synchronized; intended to sit below a single-threaded cache arena.
+		 */
+		class counting_resource : public std::pmr::memory_resource
+		{
+		  private:
+			std::pmr::memory_resource* m_upstream;
+			std::size_t m_bytes_in_use;
+			std::size_t m_peak_bytes;
+			std::size_t m_allocation_count;
+
+		  public:
+			// Constructor
+			explicit counting_resource(std::pmr::memory_resource* p_upstream = std::pmr::new_delete_resource())
+				: m_upstream(p_upstream), m_bytes_in_use(0), m_peak_bytes(0), m_allocation_count(0)
+			{
+			}
+
+			// Destructor
+			~counting_resource() override = default;
+
+			// Deleted copy constructor and assignment operator
+			counting_resource(const counting_resource&)					   = delete;
+			auto operator=(const counting_resource&) -> counting_resource& = delete;
+
+		  public:
+			auto bytes_in_use() const -> std::size_t { return m_bytes_in_use; }
+
+			auto peak_bytes() const -> std::size_t { return m_peak_bytes; }
+
+			auto allocation_count() const -> std::size_t { return m_allocation_count; }
+
+		  private:
+			auto do_allocate(std::size_t p_bytes, std::size_t p_alignment) -> void* override
+			{
+				void* p_memory = m_upstream->allocate(p_bytes, p_alignment);
+				m_bytes_in_use += p_bytes;
+				m_peak_bytes = (m_bytes_in_use > m_peak_bytes) ? m_bytes_in_use : m_peak_bytes;
+				++m_allocation_count;
+				return p_memory;
+			}
+
+			auto do_deallocate(void* p_memory, std::size_t p_bytes, std::size_t p_alignment) -> void override
+			{
+				m_upstream->deallocate(p_memory, p_bytes, p_alignment);
+				m_bytes_in_use -= p_bytes;
+			}
+
+			auto do_is_equal(const std::pmr::memory_resource& p_other) const noexcept -> bool override { return this == &p_other; }
+		};
+
+		/**
+		 * @brief Unsynchronized size-class pool for small node allocations
+		 *
+		 * Requests up to max_pooled_bytes are rounded up to a multiple of 16
+		 * bytes and served from per-class intrusive free lists, refilled by
+		 * carving whole chunks obtained from the chunk resource. Freed nodes go
+		 * back on their list and are reused by the next allocation of the same
+		 * class, so steady-state insert/evict churn does not touch the upstream
+		 * resource at all. Larger requests (hash bucket arrays, vectors) are
+		 * forwarded to the large-block resource and returned to it on free.
+		 *
+		 * Compared to std::pmr::unsynchronized_pool_resource this does no
+		 * per-deallocation chunk lookup: a node's class follows from its size.
+		 */
+		class node_pool_resource : public std::pmr::memory_resource
+		{
+		  public:
+			static constexpr std::size_t granularity	  = 16;
+			static constexpr std::size_t max_pooled_bytes = 512;
+			static constexpr std::size_t class_count	  = max_pooled_bytes / granularity;
+			static constexpr std::size_t min_chunk_bytes  = 4 * 1024;
+			static constexpr std::size_t max_chunk_bytes  = 1024 * 1024;
+
+		  private:
+			struct free_node
+			{
+				free_node* m_next;
+			};
+
+			struct alignas(granularity) chunk_header
+			{
+				chunk_header* m_next;
+				std::size_t m_bytes;
+			};
+
+			std::pmr::memory_resource* m_chunk_upstream;
+			std::pmr::memory_resource* m_large_upstream;
+			free_node* m_free_lists[class_count];
+			chunk_header* m_chunks;
+			std::size_t m_next_chunk_bytes;
+			std::size_t m_pooled_bytes_in_use;
+
+		  public:
+			// Constructor
+			explicit node_pool_resource(std::pmr::memory_resource* p_chunk_upstream = std::pmr::new_delete_resource(), std::pmr::memory_resource* p_large_upstream = nullptr)
+				: m_chunk_upstream(p_chunk_upstream), m_large_upstream((p_large_upstream != nullptr) ? p_large_upstream : p_chunk_upstream), m_free_lists(), m_chunks(nullptr),
+				  m_next_chunk_bytes(min_chunk_bytes), m_pooled_bytes_in_use(0)
+			{
+			}
+
+			// Destructor
+			~node_pool_resource() override { this->release(); }
+
+			// Deleted copy constructor and assignment operator
+			node_pool_resource(const node_pool_resource&)					 = delete;
+			auto operator=(const node_pool_resource&) -> node_pool_resource& = delete;
+
+		  public:
+			/**
+			 * @brief Return every chunk to the chunk resource
+			 *
+			 * All memory handed out from the pool becomes invalid.
+			 */
+			auto release() -> void
+			{
+				while (m_chunks != nullptr)
+				{
+					chunk_header* p_next = m_chunks->m_next;
+					m_chunk_upstream->deallocate(m_chunks, m_chunks->m_bytes, alignof(chunk_header));
+					m_chunks = p_next;
+				}
+
+				for (std::size_t idx_for = 0; idx_for < class_count; ++idx_for)
+				{
+					m_free_lists[idx_for] = nullptr;
+				}
+				m_next_chunk_bytes	  = min_chunk_bytes;
+				m_pooled_bytes_in_use = 0;
+			}
+
+			/**
+			 * @brief Get the bytes currently handed out from the pooled size classes
+			 * @return The live pooled bytes (rounded to size classes)
+			 */
+			auto pooled_bytes_in_use() const -> std::size_t { return m_pooled_bytes_in_use; }
+
+		  private:
+			static auto class_index(std::size_t p_bytes) -> std::size_t { return (p_bytes == 0) ? 0 : (p_bytes - 1) / granularity; }
+
+			auto refill(std::size_t p_class) -> void
+			{
+				const std::size_t node_bytes  = (p_class + 1) * granularity;
+				const std::size_t chunk_bytes = (m_next_chunk_bytes > node_bytes * 8 + sizeof(chunk_header)) ? m_next_chunk_bytes : node_bytes * 8 + sizeof(chunk_header);
+
+				auto* p_chunk	   = static_cast<chunk_header*>(m_chunk_upstream->allocate(chunk_bytes, alignof(chunk_header)));
+				p_chunk->m_next	   = m_chunks;
+				p_chunk->m_bytes   = chunk_bytes;
+				m_chunks		   = p_chunk;
+				m_next_chunk_bytes = (m_next_chunk_bytes * 2 < max_chunk_bytes) ? m_next_chunk_bytes * 2 : max_chunk_bytes;
+
+				// Thread the chunk body onto the class free list
+				unsigned char* p_cursor		 = reinterpret_cast<unsigned char*>(p_chunk) + sizeof(chunk_header);
+				const std::size_t node_count = (chunk_bytes - sizeof(chunk_header)) / node_bytes;
+				for (std::size_t idx_for = 0; idx_for < node_count; ++idx_for)
+				{
+					auto* p_node		  = reinterpret_cast<free_node*>(p_cursor);
+					p_node->m_next		  = m_free_lists[p_class];
+					m_free_lists[p_class] = p_node;
+					p_cursor += node_bytes;
+				}
+			}
+
+			auto do_allocate(std::size_t p_bytes, std::size_t p_alignment) -> void* override
+			{
+				if (p_bytes > max_pooled_bytes || p_alignment > granularity)
+				{
+					return m_large_upstream->allocate(p_bytes, p_alignment);
+				}
+
+				const std::size_t class_idx = class_index(p_bytes);
+				if (m_free_lists[class_idx] == nullptr)
+				{
+					this->refill(class_idx);
+				}
+
+				free_node* p_node		= m_free_lists[class_idx];
+				m_free_lists[class_idx] = p_node->m_next;
+				m_pooled_bytes_in_use += (class_idx + 1) * granularity;
+				return p_node;
+			}
+
+			auto do_deallocate(void* p_memory, std::size_t p_bytes, std::size_t p_alignment) -> void override
+			{
+				if (p_bytes > max_pooled_bytes || p_alignment > granularity)
+				{
+					m_large_upstream->deallocate(p_memory, p_bytes, p_alignment);
+					return;
+				}
+
+				const std::size_t class_idx = class_index(p_bytes);
+				auto* p_node				= static_cast<free_node*>(p_memory);
+				p_node->m_next				= m_free_lists[class_idx];
+				m_free_lists[class_idx]		= p_node;
+				m_pooled_bytes_in_use -= (class_idx + 1) * granularity;
+			}
+
+			auto do_is_equal(const std::pmr::memory_resource& p_other) const noexcept -> bool override { return this == &p_other; }
+		};
+
+		/**
+		 * @brief Per-cache memory arena: a node pool over a monotonic buffer
+		 *
+		 * Node allocations (list nodes, hash nodes, map nodes) are recycled by
+		 * a node_pool_resource whose chunks are carved from a monotonic buffer.
+		 * Large blocks (hash bucket arrays) bypass the monotonic buffer so that
+		 * rehashing returns the old arrays. All memory is returned upstream in
+		 * one step by release() or the destructor, and every byte is counted,
+		 * so the footprint of a cache is attributable.
+		 *
+		 * Not thread-safe: use one arena per single-threaded cache.
+		 *
+		 * Usage:
+		 * cache_engine::memory::cache_arena arena(1 << 20);
+		 * cache_engine::policy_based_cache<...> cache(1000, arena.resource());
+		 */
+		class cache_arena
+		{
+		  public:
+			static constexpr std::size_t default_initial_bytes = 64 * 1024;
+
+		  private:
+			counting_resource m_upstream;
+			std::pmr::monotonic_buffer_resource m_monotonic;
+			node_pool_resource m_pool;
+
+		  public:
+			// Constructor
+			explicit cache_arena(std::size_t p_initial_bytes = default_initial_bytes, std::pmr::memory_resource* p_upstream = std::pmr::new_delete_resource())
+				: m_upstream(p_upstream), m_monotonic(p_initial_bytes, &m_upstream), m_pool(&m_monotonic, &m_upstream)
+			{
+			}
+
+			// Destructor
+			~cache_arena() = default;
+
+			// Deleted copy constructor and assignment operator (caches hold pointers into the arena)
+			cache_arena(const cache_arena&)					   = delete;
+			auto operator=(const cache_arena&) -> cache_arena& = delete;
+
+		  public:
+			/**
+			 * @brief Get the resource caches should allocate from
+			 * @return The node pool resource
+			 */
+			auto resource() -> std::pmr::memory_resource* { return &m_pool; }
+
+			/**
+			 * @brief Return all memory to the upstream resource
+			 *
+			 * Every cache built on this arena must have been destroyed first.
+			 */
+			auto release() -> void
+			{
+				m_pool.release();
+				m_monotonic.release();
+			}
+
+			/**
+			 * @brief Get the bytes currently obtained from the upstream resource
+			 * @return The arena footprint in bytes
+			 */
+			auto reserved_bytes() const -> std::size_t { return m_upstream.bytes_in_use(); }
+
+			/**
+			 * @brief Get the bytes of live small nodes
+			 * @return The pooled bytes in use
+			 */
+			auto node_bytes_in_use() const -> std::size_t { return m_pool.pooled_bytes_in_use(); }
+
+			/**
+			 * @brief Get the largest footprint the arena has reached
+			 * @return The peak footprint in bytes
+			 */
+			auto peak_bytes() const -> std::size_t { return m_upstream.peak_bytes(); }
+
+			/**
+			 * @brief Get the number of allocations made from the upstream resource
+			 * @return The upstream allocation count
+			 */
+			auto upstream_allocation_count() const -> std::size_t { return m_upstream.allocation_count(); }
+		};
+	} // namespace memory
+} // namespace cache_engine
@@ -0,0 +1,649 @@
+// File: inc/cache_engine/memory/slab_lru_cache.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#error "slab_lru_cache needs POSIX virtual memory APIs (mmap, madvise)"
+#endif
+
+namespace cache_engine
+{
+	namespace memory
+	{
+		/**
+		 * @brief Footprint of a slab_lru_cache
+		 */
+		struct slab_stats
+		{
+			std::size_t m_entries		  = 0;
+			std::size_t m_slot_bytes	  = 0;
+			std::size_t m_slots_per_block = 0;
+			std::size_t m_block_bytes	  = 0;
+			std::size_t m_resident_blocks = 0; // Blocks touched and not handed back to the OS
+			std::size_t m_needed_blocks	  = 0; // Blocks the entries would fill when fully packed
+			std::size_t m_reserved_bytes  = 0; // Address space reserved for the largest capacity
+			std::size_t m_released_blocks = 0; // Blocks handed back by compaction since construction
+			std::size_t m_relocated_slots = 0; // Entries moved by compaction since construction
+		};
+
+		/**
+		 * @brief Outcome of one bounded compaction step
+		 */
+		struct compaction_progress
+		{
+			std::size_t m_moved			  = 0;
+			std::size_t m_released_blocks = 0;
+			bool m_done					  = false; // Entries are packed and every block above them is released
+		};
+
+		/**
+		 * @brief Single-threaded LRU cache whose entries live in a slab that can be compacted
+		 *
+		 * Entries of a node-based cache are scattered across the heap, so after a
+		 * traffic peak or a set_capacity() shrink the freed nodes keep their pages
+		 * resident. Here every entry (key, value and its LRU links) lives in a
+		 * fixed-size slot of one anonymous mapping reserved for max_capacity
+		 * entries; pages are faulted in as slots are first used. Slots are
+		 * grouped in blocks of whole pages, and an open-addressing index maps
+		 * keys to 32-bit slot numbers.
+		 *
+		 * New entries always take the lowest free slot, so live entries drift
+		 * towards the start of the slab. compact_step() finishes the job in
+		 * bounded steps: it takes the highest resident block, moves its entries
+		 * into the lowest free slots (fixing the index bucket and the LRU
+		 * neighbours' links of each moved entry) and returns the emptied block
+		 * to the OS with madvise(MADV_DONTNEED). It stops once no free slot lies
+		 * below the highest live entry.
+		 *
+		 * Keys and values must be copy-constructible; compaction moves them when
+		 * their move cannot throw and copies them otherwise, so a throwing
+		 * relocation leaves the entry where it was. Memory they own outside the
+		 * slab (string buffers) is not compacted. Not thread-safe.
+		 *
+		 * @tparam key_t Key type (must be hashable)
+		 * @tparam value_t Value type
+		 * @tparam hash_t Hash functor for key_t
+		 */
+		template <typename key_t, typename value_t, typename hash_t = std::hash<key_t>> class slab_lru_cache
+		{
+		  public:
+			using self_t = slab_lru_cache<key_t, value_t, hash_t>;
+
+			static constexpr std::size_t default_compact_budget = 256;
+
+		  private:
+			static constexpr std::uint32_t no_slot = 0xFFFFFFFFU;
+
+			struct node
+			{
+				key_t m_key;
+				value_t m_value;
+				std::uint32_t m_prev; // Towards the most recently used entry
+				std::uint32_t m_next; // Towards the least recently used entry
+			};
+
+			static constexpr std::size_t slot_bytes = (sizeof(node) + alignof(node) - 1) / alignof(node) * alignof(node);
+
+			std::size_t m_max_capacity;
+			std::size_t m_capacity;
+			std::size_t m_size;
+			std::size_t m_slots_per_block;
+			std::size_t m_block_bytes;
+			std::size_t m_block_count;
+			std::size_t m_words_per_block;
+			unsigned char* m_base;
+			std::size_t m_reserved_bytes;
+
+			std::vector<std::uint64_t> m_used;		 // Bit per slot, block-major; bits past the block end stay set
+			std::vector<std::uint32_t> m_live;		 // Live entries per block
+			std::vector<unsigned char> m_resident;	 // Block was touched and not released since
+			std::size_t m_first_free_block;			 // Lowest block with a free slot
+			std::size_t m_top_block;				 // One past the highest resident block
+			std::size_t m_resident_blocks;
+			std::size_t m_released_blocks;
+			std::size_t m_relocated_slots;
+
+			std::vector<std::uint32_t> m_buckets; // Slot number per bucket, no_slot when empty
+			std::size_t m_bucket_mask;
+			std::uint32_t m_head; // Most recently used
+			std::uint32_t m_tail; // Least recently used
+			hash_t m_hasher;
+
+		  public:
+			/**
+			 * @brief Reserve address space for p_max_capacity entries; nothing is touched yet
+			 * @param p_max_capacity Largest capacity set_capacity() may restore
+			 * @param p_hasher Hash functor
+			 * @throws std::invalid_argument if the capacity is zero or does not fit 32-bit slot numbers
+			 * @throws std::bad_alloc if the address space cannot be reserved
+			 */
+			explicit slab_lru_cache(std::size_t p_max_capacity, const hash_t& p_hasher = hash_t())
+				: m_max_capacity(p_max_capacity), m_capacity(p_max_capacity), m_size(0), m_slots_per_block(0), m_block_bytes(0), m_block_count(0), m_words_per_block(0),
+				  m_base(nullptr), m_reserved_bytes(0), m_first_free_block(0), m_top_block(0), m_resident_blocks(0), m_released_blocks(0), m_relocated_slots(0),
+				  m_bucket_mask(0), m_head(no_slot), m_tail(no_slot), m_hasher(p_hasher)
+			{
+				if (p_max_capacity == 0)
+				{
+					throw std::invalid_argument("Capacity must be greater than zero");
+				}
+				if (p_max_capacity >= no_slot / 2)
+				{
+					throw std::invalid_argument("Capacity does not fit 32-bit slot numbers");
+				}
+
+				const long page_result = ::sysconf(_SC_PAGESIZE);
+				const std::size_t page = page_result > 0 ? static_cast<std::size_t>(page_result) : 4096;
+				m_slots_per_block	   = slot_bytes < page ? page / slot_bytes : 1;
+				m_block_bytes		   = (m_slots_per_block * slot_bytes + page - 1) / page * page;
+				m_block_count		   = (p_max_capacity + m_slots_per_block - 1) / m_slots_per_block;
+				m_words_per_block	   = (m_slots_per_block + 63) / 64;
+				m_reserved_bytes	   = m_block_count * m_block_bytes;
+
+				void* mapping = ::mmap(nullptr, m_reserved_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				if (mapping == MAP_FAILED)
+				{
+					throw std::bad_alloc();
+				}
+				m_base = static_cast<unsigned char*>(mapping);
+
+				m_used.assign(m_block_count * m_words_per_block, 0);
+				const std::size_t tail_bits = m_slots_per_block % 64;
+				if (tail_bits != 0)
+				{
+					for (std::size_t idx_for = 0; idx_for < m_block_count; ++idx_for)
+					{
+						m_used[idx_for * m_words_per_block + m_words_per_block - 1] = ~((std::uint64_t(1) << tail_bits) - 1);
+					}
+				}
+				m_live.assign(m_block_count, 0);
+				m_resident.assign(m_block_count, 0);
+
+				std::size_t bucket_count = 1;
+				while (bucket_count < p_max_capacity * 2)
+				{
+					bucket_count <<= 1U;
+				}
+				m_buckets.assign(bucket_count, std::uint32_t(no_slot));
+				m_bucket_mask = bucket_count - 1;
+			}
+
+			// Destructor
+			~slab_lru_cache()
+			{
+				this->clear();
+				::munmap(m_base, m_reserved_bytes);
+			}
+
+			// Deleted copy/move: the index and links hold slot numbers into this mapping
+			slab_lru_cache(const self_t&)			 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+			slab_lru_cache(self_t&&)				 = delete;
+			auto operator=(self_t&&) -> self_t&		 = delete;
+
+		  public:
+			/**
+			 * @brief Look up a key and make it the most recently used entry
+			 * @param p_key The key to look up
+			 * @param p_value Receives a copy of the value on a hit
+			 * @return true on a hit
+			 */
+			auto find(const key_t& p_key, value_t& p_value) -> bool
+			{
+				const std::uint32_t slot = this->slot_of(p_key);
+				if (slot == no_slot)
+				{
+					return false;
+				}
+				this->move_to_front(slot);
+				p_value = this->node_at(slot).m_value;
+				return true;
+			}
+
+			/**
+			 * @brief Get a copy of a value
+			 * @param p_key The key to look up
+			 * @return The value
+			 * @throws std::out_of_range if the key is not cached
+			 */
+			auto get(const key_t& p_key) -> value_t
+			{
+				const std::uint32_t slot = this->slot_of(p_key);
+				if (slot == no_slot)
+				{
+					throw std::out_of_range("Key not found in cache");
+				}
+				this->move_to_front(slot);
+				return this->node_at(slot).m_value;
+			}
+
+			auto contains(const key_t& p_key) const -> bool { return this->slot_of(p_key) != no_slot; }
+
+			/**
+			 * @brief Insert or update a value; a new key evicts the LRU entry when full
+			 * @param p_key The key
+			 * @param p_value The value
+			 * @throws Whatever copying p_key or p_value throws; a new key is then not
+			 *         stored, though the LRU entry may already have been evicted
+			 */
+			auto put(const key_t& p_key, const value_t& p_value) -> void
+			{
+				const std::uint32_t existing = this->slot_of(p_key);
+				if (existing != no_slot)
+				{
+					this->node_at(existing).m_value = p_value;
+					this->move_to_front(existing);
+					return;
+				}
+
+				if (m_size >= m_capacity)
+				{
+					this->remove_slot(m_tail);
+				}
+
+				const std::uint32_t slot = this->allocate_slot();
+				node* target			 = this->construct_node(slot, p_key, p_value, no_slot, m_head);
+				if (m_head != no_slot)
+				{
+					this->node_at(m_head).m_prev = slot;
+				}
+				m_head = slot;
+				if (m_tail == no_slot)
+				{
+					m_tail = slot;
+				}
+				m_buckets[this->free_bucket_for(target->m_key)] = slot;
+				++m_size;
+			}
+
+			/**
+			 * @brief Remove a key
+			 * @param p_key The key
+			 * @return true if the key was present
+			 */
+			auto erase(const key_t& p_key) -> bool
+			{
+				const std::uint32_t slot = this->slot_of(p_key);
+				if (slot == no_slot)
+				{
+					return false;
+				}
+				this->remove_slot(slot);
+				return true;
+			}
+
+			/**
+			 * @brief Remove every entry; resident blocks stay resident until compacted
+			 */
+			auto clear() -> void
+			{
+				while (m_tail != no_slot)
+				{
+					this->remove_slot(m_tail);
+				}
+			}
+
+			/**
+			 * @brief Change the capacity, evicting LRU entries down to it
+			 *
+			 * Shrinking leaves holes spread over the slab; follow it with
+			 * compact_step() calls to give the pages back.
+			 *
+			 * @param p_capacity New capacity, from 1 to max_capacity()
+			 * @throws std::invalid_argument if p_capacity is out of range
+			 */
+			auto set_capacity(std::size_t p_capacity) -> void
+			{
+				if (p_capacity == 0 || p_capacity > m_max_capacity)
+				{
+					throw std::invalid_argument("Capacity must be between one and the reserved capacity");
+				}
+				m_capacity = p_capacity;
+				while (m_size > m_capacity)
+				{
+					this->remove_slot(m_tail);
+				}
+			}
+
+			/**
+			 * @brief Move at most p_budget entries or release at most p_budget blocks
+			 *
+			 * Each step drains the highest resident block into the lowest free
+			 * slots and releases it once empty. Call repeatedly, e.g. between
+			 * requests, until m_done is set.
+			 *
+			 * @param p_budget Upper bound on moved entries plus released blocks
+			 * @return What this step did
+			 */
+			auto compact_step(std::size_t p_budget = default_compact_budget) -> compaction_progress
+			{
+				compaction_progress progress;
+				for (std::size_t idx_work = 0; idx_work < p_budget; ++idx_work)
+				{
+					if (m_top_block == 0)
+					{
+						progress.m_done = true;
+						break;
+					}
+
+					const std::size_t block = m_top_block - 1;
+					if (m_live[block] == 0)
+					{
+						this->release_block(block);
+						++progress.m_released_blocks;
+						continue;
+					}
+					if (m_first_free_block >= block)
+					{
+						progress.m_done = true;
+						break;
+					}
+
+					this->relocate(this->first_used_slot(block));
+					++progress.m_moved;
+				}
+				if (!progress.m_done && m_top_block > 0 && m_live[m_top_block - 1] != 0 && m_first_free_block >= m_top_block - 1)
+				{
+					progress.m_done = true;
+				}
+				return progress;
+			}
+
+			/**
+			 * @brief Compact in one go
+			 * @return The total of all steps
+			 */
+			auto compact() -> compaction_progress
+			{
+				compaction_progress total;
+				while (!total.m_done)
+				{
+					const compaction_progress step = this->compact_step();
+					total.m_moved += step.m_moved;
+					total.m_released_blocks += step.m_released_blocks;
+					total.m_done = step.m_done;
+				}
+				return total;
+			}
+
+			auto size() const -> std::size_t { return m_size; }
+
+			auto capacity() const -> std::size_t { return m_capacity; }
+
+			auto max_capacity() const -> std::size_t { return m_max_capacity; }
+
+			auto empty() const -> bool { return m_size == 0; }
+
+			/**
+			 * @brief Bytes of slab blocks currently resident (touched and not released)
+			 */
+			auto resident_bytes() const -> std::size_t { return m_resident_blocks * m_block_bytes; }
+
+			auto stats() const -> slab_stats
+			{
+				slab_stats stats;
+				stats.m_entries			= m_size;
+				stats.m_slot_bytes		= slot_bytes;
+				stats.m_slots_per_block = m_slots_per_block;
+				stats.m_block_bytes		= m_block_bytes;
+				stats.m_resident_blocks = m_resident_blocks;
+				stats.m_needed_blocks	= (m_size + m_slots_per_block - 1) / m_slots_per_block;
+				stats.m_reserved_bytes	= m_reserved_bytes;
+				stats.m_released_blocks = m_released_blocks;
+				stats.m_relocated_slots = m_relocated_slots;
+				return stats;
+			}
+
+		  private:
+			static auto lowest_bit(std::uint64_t p_word) -> std::size_t
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return static_cast<std::size_t>(__builtin_ctzll(p_word));
+#else
+				std::size_t bit = 0;
+				while ((p_word & 1U) == 0)
+				{
+					p_word >>= 1U;
+					++bit;
+				}
+				return bit;
+#endif
+			}
+
+			auto slot_address(std::uint32_t p_slot) const -> unsigned char*
+			{
+				return m_base + (p_slot / m_slots_per_block) * m_block_bytes + (p_slot % m_slots_per_block) * slot_bytes;
+			}
+
+			auto node_at(std::uint32_t p_slot) const -> node& { return *static_cast<node*>(static_cast<void*>(this->slot_address(p_slot))); }
+
+			auto home_bucket(const key_t& p_key) const -> std::size_t
+			{
+				std::uint64_t hash = static_cast<std::uint64_t>(m_hasher(p_key));
+				hash ^= hash >> 33U;
+				hash *= 0xff51afd7ed558ccdULL;
+				hash ^= hash >> 33U;
+				return static_cast<std::size_t>(hash) & m_bucket_mask;
+			}
+
+			auto bucket_of(const key_t& p_key) const -> std::size_t
+			{
+				std::size_t bucket = this->home_bucket(p_key);
+				while (m_buckets[bucket] != no_slot && !(this->node_at(m_buckets[bucket]).m_key == p_key))
+				{
+					bucket = (bucket + 1) & m_bucket_mask;
+				}
+				return bucket;
+			}
+
+			auto slot_of(const key_t& p_key) const -> std::uint32_t { return m_buckets[this->bucket_of(p_key)]; }
+
+			auto free_bucket_for(const key_t& p_key) const -> std::size_t
+			{
+				std::size_t bucket = this->home_bucket(p_key);
+				while (m_buckets[bucket] != no_slot)
+				{
+					bucket = (bucket + 1) & m_bucket_mask;
+				}
+				return bucket;
+			}
+
+			/**
+			 * @brief Empty a bucket by shifting later members of its probe run back (no tombstones)
+			 */
+			auto erase_bucket(std::size_t p_bucket) -> void
+			{
+				std::size_t hole = p_bucket;
+				std::size_t next = p_bucket;
+				for (;;)
+				{
+					next = (next + 1) & m_bucket_mask;
+					if (m_buckets[next] == no_slot)
+					{
+						break;
+					}
+					const std::size_t home = this->home_bucket(this->node_at(m_buckets[next]).m_key);
+					// Move the member back unless its home lies cyclically in (hole, next]
+					const bool stays = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+					if (!stays)
+					{
+						m_buckets[hole] = m_buckets[next];
+						hole			= next;
+					}
+				}
+				m_buckets[hole] = no_slot;
+			}
+
+			auto unlink(std::uint32_t p_slot) -> void
+			{
+				node& target = this->node_at(p_slot);
+				if (target.m_prev != no_slot)
+				{
+					this->node_at(target.m_prev).m_next = target.m_next;
+				}
+				else
+				{
+					m_head = target.m_next;
+				}
+				if (target.m_next != no_slot)
+				{
+					this->node_at(target.m_next).m_prev = target.m_prev;
+				}
+				else
+				{
+					m_tail = target.m_prev;
+				}
+			}
+
+			auto move_to_front(std::uint32_t p_slot) -> void
+			{
+				if (p_slot == m_head)
+				{
+					return;
+				}
+				this->unlink(p_slot);
+				node& target  = this->node_at(p_slot);
+				target.m_prev = no_slot;
+				target.m_next = m_head;
+				this->node_at(m_head).m_prev = p_slot;
+				m_head						 = p_slot;
+			}
+
+			auto remove_slot(std::uint32_t p_slot) -> void
+			{
+				node& target = this->node_at(p_slot);
+				this->erase_bucket(this->bucket_of(target.m_key));
+				this->unlink(p_slot);
+				target.~node();
+				this->free_slot(p_slot);
+				--m_size;
+			}
+
+			auto allocate_slot() -> std::uint32_t
+			{
+				const std::size_t block = m_first_free_block;
+				if (m_resident[block] == 0)
+				{
+					m_resident[block] = 1;
+					++m_resident_blocks;
+					m_top_block = (block + 1 > m_top_block) ? block + 1 : m_top_block;
+				}
+
+				std::uint64_t* words = &m_used[block * m_words_per_block];
+				std::size_t word	 = 0;
+				while (words[word] == ~std::uint64_t(0))
+				{
+					++word;
+				}
+				const std::size_t bit = lowest_bit(~words[word]);
+				words[word] |= std::uint64_t(1) << bit;
+
+				if (++m_live[block] == m_slots_per_block)
+				{
+					while (m_first_free_block < m_block_count && m_live[m_first_free_block] == m_slots_per_block)
+					{
+						++m_first_free_block;
+					}
+				}
+				return static_cast<std::uint32_t>(block * m_slots_per_block + word * 64 + bit);
+			}
+
+			auto free_slot(std::uint32_t p_slot) -> void
+			{
+				const std::size_t block = p_slot / m_slots_per_block;
+				const std::size_t index = p_slot % m_slots_per_block;
+				m_used[block * m_words_per_block + index / 64] &= ~(std::uint64_t(1) << (index % 64));
+				--m_live[block];
+				m_first_free_block = (block < m_first_free_block) ? block : m_first_free_block;
+			}
+
+			/**
+			 * @brief Build a node in a slot just taken by allocate_slot(), handing the slot back if that throws
+			 */
+			template <typename... args_t> auto construct_node(std::uint32_t p_slot, args_t&&... p_args) -> node*
+			{
+				try
+				{
+					return ::new (this->slot_address(p_slot)) node{std::forward<args_t>(p_args)...};
+				}
+				catch (...)
+				{
+					this->free_slot(p_slot);
+					throw;
+				}
+			}
+
+			auto first_used_slot(std::size_t p_block) const -> std::uint32_t
+			{
+				const std::uint64_t* words = &m_used[p_block * m_words_per_block];
+				for (std::size_t idx_word = 0;; ++idx_word)
+				{
+					// Padding bits past the block end are set, so mask them out of the last word
+					std::uint64_t live = words[idx_word];
+					if (idx_word + 1 == m_words_per_block && m_slots_per_block % 64 != 0)
+					{
+						live &= (std::uint64_t(1) << (m_slots_per_block % 64)) - 1;
+					}
+					if (live != 0)
+					{
+						return static_cast<std::uint32_t>(p_block * m_slots_per_block + idx_word * 64 + lowest_bit(live));
+					}
+				}
+			}
+
+			/**
+			 * @brief Move an entry to the lowest free slot, repointing its bucket and LRU neighbours
+			 */
+			auto relocate(std::uint32_t p_from) -> void
+			{
+				node& source			 = this->node_at(p_from);
+				const std::size_t bucket = this->bucket_of(source.m_key);
+				const std::uint32_t to	 = this->allocate_slot();
+				node* target			 = this->construct_node(to, std::move_if_noexcept(source.m_key), std::move_if_noexcept(source.m_value), source.m_prev, source.m_next);
+				source.~node();
+				this->free_slot(p_from);
+
+				if (target->m_prev != no_slot)
+				{
+					this->node_at(target->m_prev).m_next = to;
+				}
+				else
+				{
+					m_head = to;
+				}
+				if (target->m_next != no_slot)
+				{
+					this->node_at(target->m_next).m_prev = to;
+				}
+				else
+				{
+					m_tail = to;
+				}
+				m_buckets[bucket] = to;
+				++m_relocated_slots;
+			}
+
+			auto release_block(std::size_t p_block) -> void
+			{
+				::madvise(m_base + p_block * m_block_bytes, m_block_bytes, MADV_DONTNEED);
+				m_resident[p_block] = 0;
+				--m_resident_blocks;
+				++m_released_blocks;
+				while (m_top_block > 0 && m_resident[m_top_block - 1] == 0)
+				{
+					--m_top_block;
+				}
+			}
+		};
+	} // namespace memory
+} // namespace cache_engine
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "policy_containers.hpp"
 #include "policy_interfaces.hpp"
 
 namespace cache_engine
@@ -103,13 +104,24 @@ namespace cache_engine
 			using base_t = access_policy_base<key_t, value_t>;
 
 		  private:
-			std::unordered_map<key_t, std::size_t> m_access_counts;
+			containers::unordered_map<key_t, std::size_t> m_access_counts;
 			std::size_t m_threshold;
 
 		  public:
 			// Constructor with threshold
 			explicit threshold_access_policy(std::size_t p_threshold = 2) : m_threshold(p_threshold) {}
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit threshold_access_policy(containers::memory_resource* p_resource, std::size_t p_threshold = 2) : m_access_counts(p_resource), m_threshold(p_threshold) {}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit threshold_access_policy(const containers::policy_context& p_context, std::size_t p_threshold = 2) : m_access_counts(p_context.get_allocator()), m_threshold(p_threshold)
+			{
+				m_access_counts.reserve(p_context.capacity());
+			}
+
 			// Destructor
 			~threshold_access_policy() override = default;
 
@@ -146,6 +158,10 @@ namespace cache_engine
 				static_cast<void>(p_key);
 				return true;
 			}
+
+			// Counts are kept for every key ever accessed, evicted ones included
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_access_counts); }
+
 			/**
 			 * @brief Set the access threshold
 			 * @param p_threshold The new threshold value
@@ -191,7 +207,7 @@ namespace cache_engine
 		  private:
 			static constexpr std::size_t default_decay_interval = 100;
 
-			std::unordered_map<key_t, std::size_t> m_last_access_time;
+			containers::unordered_map<key_t, std::size_t> m_last_access_time;
 			std::size_t m_current_time{0};
 			std::size_t m_decay_interval;
 
@@ -199,6 +215,21 @@ namespace cache_engine
 			// Constructor with decay interval
 			explicit time_decay_access_policy(std::size_t p_decay_interval = default_decay_interval) : m_decay_interval(p_decay_interval) {}
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit time_decay_access_policy(containers::memory_resource* p_resource, std::size_t p_decay_interval = default_decay_interval)
+				: m_last_access_time(p_resource), m_decay_interval(p_decay_interval)
+			{
+			}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit time_decay_access_policy(const containers::policy_context& p_context, std::size_t p_decay_interval = default_decay_interval)
+				: m_last_access_time(p_context.get_allocator()), m_decay_interval(p_decay_interval)
+			{
+				m_last_access_time.reserve(p_context.capacity());
+			}
+
 			// Destructor
 			~time_decay_access_policy() override = default;
 
@@ -249,6 +280,9 @@ namespace cache_engine
 				static_cast<void>(p_key);
 				return true;
 			}
+
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_last_access_time); }
+
 			/**
 			 * @brief Set the decay interval
 			 * @param p_interval The new decay interval
@@ -12,6 +12,7 @@
 #include "policy_traits.hpp"
 #include "eviction_policies.hpp"
 #include "storage_policies.hpp"
+#include "inline_bytes_storage.hpp"
 #include "access_policies.hpp"
 #include "capacity_policies.hpp"
 
@@ -69,6 +70,14 @@ namespace cache_engine
 		using random_policy_set =
 			std::tuple<random_eviction_policy<key_t, value_t>, hash_storage_policy<key_t, value_t>, no_update_on_access_policy<key_t, value_t>, fixed_capacity_policy<key_t, value_t>>;
 
+		/**
+		 * @brief Sampled LFU policy set for large frequency-driven caches
+		 * Eviction: Sampled LFU (dense counters), Storage: Hash, Access: Update on access, Capacity: Fixed
+		 */
+		template <typename key_t, typename value_t>
+		using sampled_lfu_policy_set =
+			std::tuple<sampled_lfu_eviction_policy<key_t, value_t>, hash_storage_policy<key_t, value_t>, update_on_access_policy<key_t, value_t>, fixed_capacity_policy<key_t, value_t>>;
+
 		/**
 		 * @brief High-performance policy set for speed-critical applications
 		 * Eviction: LRU, Storage: Reserved Hash, Access: Update on access, Capacity: Fixed
@@ -115,18 +124,23 @@ namespace cache_engine
 	namespace policy_templates
 	{
 		// Eviction policy templates
-		template <typename key_t, typename value_t> using lru_eviction	  = policies::lru_eviction_policy<key_t, value_t>;
-		template <typename key_t, typename value_t> using mru_eviction	  = policies::mru_eviction_policy<key_t, value_t>;
-		template <typename key_t, typename value_t> using fifo_eviction	  = policies::fifo_eviction_policy<key_t, value_t>;
-		template <typename key_t, typename value_t> using lfu_eviction	  = policies::lfu_eviction_policy<key_t, value_t>;
-		template <typename key_t, typename value_t> using mfu_eviction	  = policies::mfu_eviction_policy<key_t, value_t>;
-		template <typename key_t, typename value_t> using random_eviction = policies::random_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using lru_eviction				= policies::lru_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using mru_eviction				= policies::mru_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using fifo_eviction				= policies::fifo_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using lfu_eviction				= policies::lfu_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using mfu_eviction				= policies::mfu_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using random_eviction			= policies::random_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using sampled_lfu_eviction		= policies::sampled_lfu_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using sampled_lfu16_eviction	= policies::sampled_lfu16_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using hyperbolic_eviction		= policies::hyperbolic_eviction_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using midpoint_lru_eviction		= policies::midpoint_lru_eviction_policy<key_t, value_t>;
 
 		// Storage policy templates
 		template <typename key_t, typename value_t> using hash_storage			= policies::hash_storage_policy<key_t, value_t>;
 		template <typename key_t, typename value_t> using reserved_hash_storage = policies::reserved_hash_storage_policy<key_t, value_t>;
 		template <typename key_t, typename value_t> using compact_storage		= policies::compact_storage_policy<key_t, value_t>;
 		template <typename key_t, typename value_t> using debug_storage			= policies::debug_storage_policy<key_t, value_t>;
+		template <typename key_t, typename value_t> using inline_bytes_storage	= policies::inline_bytes_storage_policy<key_t, value_t>;
 
 		// Access policy templates
 		template <typename key_t, typename value_t> using update_on_access	  = policies::update_on_access_policy<key_t, value_t>;
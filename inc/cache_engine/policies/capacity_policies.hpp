@@ -395,6 +395,13 @@ namespace cache_engine
 				return (m_item_size_estimate > 0) ? m_memory_limit / m_item_size_estimate : 0;
 			}
 
+			/**
+			 * @brief Entry count of a policy constructed with p_memory_limit and the default item size estimate
+			 *
+			 * Lets policy_based_cache size its other policies for entries, not bytes.
+			 */
+			static auto entry_capacity(std::size_t p_memory_limit) -> std::size_t { return p_memory_limit / (sizeof(key_t) + sizeof(value_t)); }
+
 			auto set_capacity(std::size_t p_new_capacity) -> void override
 			{
 				// Convert item capacity to memory limit
@@ -2,21 +2,39 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
-#include <list>
-#include <map>
-#include <queue>
+#include <iterator>
 #include <stdexcept>
-#include <unordered_map>
-#include <vector>
+#include <type_traits>
 
+#include "frequency_counters.hpp"
+#include "policy_containers.hpp"
 #include "policy_interfaces.hpp"
 
 namespace cache_engine
 {
 	namespace policies
 	{
+		namespace detail
+		{
+			/**
+			 * @brief Advance a xorshift64 state and return it
+			 *
+			 * Cheap and deterministic random numbers for the sampling policies,
+			 * without touching the std::rand state. p_state must not be 0.
+			 */
+			inline auto xorshift64(std::uint64_t& p_state) -> std::uint64_t
+			{
+				p_state ^= p_state << 13U;
+				p_state ^= p_state >> 7U;
+				p_state ^= p_state << 17U;
+				return p_state;
+			}
+		} // namespace detail
+
 		/**
 		 * @brief Least Recently Used (LRU) eviction policy
 		 *
@@ -36,13 +54,24 @@ namespace cache_engine
 			using base_t = eviction_policy_base<key_t, value_t>;
 
 		  private:
-			std::list<key_t> m_access_list;
-			std::unordered_map<key_t, typename std::list<key_t>::iterator> m_key_to_iterator;
+			containers::list<key_t> m_access_list;
+			containers::unordered_map<key_t, typename containers::list<key_t>::iterator> m_key_to_iterator;
 
 		  public:
 			// Constructor
 			lru_eviction_policy() = default;
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit lru_eviction_policy(containers::memory_resource* p_resource) : m_access_list(p_resource), m_key_to_iterator(p_resource) {}
+#endif
+
+			// Constructor sized for the cache capacity (list nodes are allocated per entry and cannot be reserved)
+			explicit lru_eviction_policy(const containers::policy_context& p_context) : m_access_list(p_context.get_allocator()), m_key_to_iterator(p_context.get_allocator())
+			{
+				m_key_to_iterator.reserve(p_context.capacity());
+			}
+
 			// Destructor
 			~lru_eviction_policy() override = default;
 
@@ -117,6 +146,8 @@ namespace cache_engine
 				m_access_list.clear();
 				m_key_to_iterator.clear();
 			}
+
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_access_list) + containers::heap_bytes(m_key_to_iterator); }
 		};
 
 		/**
@@ -138,13 +169,24 @@ namespace cache_engine
 			using base_t = eviction_policy_base<key_t, value_t>;
 
 		  private:
-			std::list<key_t> m_access_list;
-			std::unordered_map<key_t, typename std::list<key_t>::iterator> m_key_to_iterator;
+			containers::list<key_t> m_access_list;
+			containers::unordered_map<key_t, typename containers::list<key_t>::iterator> m_key_to_iterator;
 
 		  public:
 			// Constructor
 			mru_eviction_policy() = default;
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit mru_eviction_policy(containers::memory_resource* p_resource) : m_access_list(p_resource), m_key_to_iterator(p_resource) {}
+#endif
+
+			// Constructor sized for the cache capacity (list nodes are allocated per entry and cannot be reserved)
+			explicit mru_eviction_policy(const containers::policy_context& p_context) : m_access_list(p_context.get_allocator()), m_key_to_iterator(p_context.get_allocator())
+			{
+				m_key_to_iterator.reserve(p_context.capacity());
+			}
+
 			// Destructor
 			~mru_eviction_policy() override = default;
 
@@ -219,6 +261,8 @@ namespace cache_engine
 				m_access_list.clear();
 				m_key_to_iterator.clear();
 			}
+
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_access_list) + containers::heap_bytes(m_key_to_iterator); }
 		};
 
 		/**
@@ -240,13 +284,24 @@ namespace cache_engine
 			using base_t = eviction_policy_base<key_t, value_t>;
 
 		  private:
-			std::queue<key_t> m_insertion_queue;
-			std::unordered_map<key_t, bool> m_key_exists;
+			containers::queue<key_t> m_insertion_queue;
+			containers::unordered_map<key_t, bool> m_key_exists;
 
 		  public:
 			// Constructor
 			fifo_eviction_policy() = default;
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit fifo_eviction_policy(containers::memory_resource* p_resource) : m_insertion_queue(p_resource), m_key_exists(p_resource) {}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit fifo_eviction_policy(const containers::policy_context& p_context) : m_insertion_queue(p_context.get_allocator()), m_key_exists(p_context.get_allocator())
+			{
+				m_key_exists.reserve(p_context.capacity());
+			}
+
 			// Destructor
 			~fifo_eviction_policy() override = default;
 
@@ -331,10 +386,12 @@ namespace cache_engine
 
 			auto clear() -> void override
 			{
-				// Clear queue by creating new empty queue
-				m_insertion_queue = std::queue<key_t>();
+				// Clear queue by creating new empty queue (the target keeps its allocator)
+				m_insertion_queue = containers::queue<key_t>();
 				m_key_exists.clear();
 			}
+
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_insertion_queue) + containers::heap_bytes(m_key_exists); }
 		};
 
 		/**
@@ -356,14 +413,27 @@ namespace cache_engine
 			using base_t = eviction_policy_base<key_t, value_t>;
 
 		  private:
-			std::unordered_map<key_t, std::size_t> m_key_frequency;
-			std::map<std::size_t, std::list<key_t>> m_frequency_buckets;
-			std::unordered_map<key_t, typename std::list<key_t>::iterator> m_key_to_iterator;
+			containers::unordered_map<key_t, std::size_t> m_key_frequency;
+			containers::map<std::size_t, containers::list<key_t>> m_frequency_buckets;
+			containers::unordered_map<key_t, typename containers::list<key_t>::iterator> m_key_to_iterator;
 
 		  public:
 			// Constructor
 			lfu_eviction_policy() = default;
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit lfu_eviction_policy(containers::memory_resource* p_resource) : m_key_frequency(p_resource), m_frequency_buckets(p_resource), m_key_to_iterator(p_resource) {}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit lfu_eviction_policy(const containers::policy_context& p_context)
+				: m_key_frequency(p_context.get_allocator()), m_frequency_buckets(p_context.get_allocator()), m_key_to_iterator(p_context.get_allocator())
+			{
+				m_key_frequency.reserve(p_context.capacity());
+				m_key_to_iterator.reserve(p_context.capacity());
+			}
+
 			// Destructor
 			~lfu_eviction_policy() override = default;
 
@@ -465,6 +535,13 @@ namespace cache_engine
 				m_key_to_iterator.clear();
 			}
 
+			auto memory_usage() const -> std::size_t override
+			{
+				// Every tracked key sits in exactly one bucket list, so the list nodes need no walk
+				return containers::heap_bytes(m_key_frequency) + containers::heap_bytes(m_frequency_buckets) + m_key_to_iterator.size() * containers::list_node_bytes<key_t>()
+					   + containers::heap_bytes(m_key_to_iterator);
+			}
+
 		  private:
 			auto increment_frequency(const key_t& p_key) -> void
 			{
@@ -518,14 +595,27 @@ namespace cache_engine
 			using base_t = eviction_policy_base<key_t, value_t>;
 
 		  private:
-			std::unordered_map<key_t, std::size_t> m_key_frequency;
-			std::map<std::size_t, std::list<key_t>> m_frequency_buckets;
-			std::unordered_map<key_t, typename std::list<key_t>::iterator> m_key_to_iterator;
+			containers::unordered_map<key_t, std::size_t> m_key_frequency;
+			containers::map<std::size_t, containers::list<key_t>> m_frequency_buckets;
+			containers::unordered_map<key_t, typename containers::list<key_t>::iterator> m_key_to_iterator;
 
 		  public:
 			// Constructor
 			mfu_eviction_policy() = default;
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit mfu_eviction_policy(containers::memory_resource* p_resource) : m_key_frequency(p_resource), m_frequency_buckets(p_resource), m_key_to_iterator(p_resource) {}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit mfu_eviction_policy(const containers::policy_context& p_context)
+				: m_key_frequency(p_context.get_allocator()), m_frequency_buckets(p_context.get_allocator()), m_key_to_iterator(p_context.get_allocator())
+			{
+				m_key_frequency.reserve(p_context.capacity());
+				m_key_to_iterator.reserve(p_context.capacity());
+			}
+
 			// Destructor
 			~mfu_eviction_policy() override = default;
 
@@ -627,6 +717,13 @@ namespace cache_engine
 				m_key_to_iterator.clear();
 			}
 
+			auto memory_usage() const -> std::size_t override
+			{
+				// Every tracked key sits in exactly one bucket list, so the list nodes need no walk
+				return containers::heap_bytes(m_key_frequency) + containers::heap_bytes(m_frequency_buckets) + m_key_to_iterator.size() * containers::list_node_bytes<key_t>()
+					   + containers::heap_bytes(m_key_to_iterator);
+			}
+
 		  private:
 			auto increment_frequency(const key_t& p_key) -> void
 			{
@@ -680,14 +777,30 @@ namespace cache_engine
 			using base_t = eviction_policy_base<key_t, value_t>;
 
 		  private:
-			std::vector<key_t> m_keys;
-			std::unordered_map<key_t, std::size_t> m_key_to_index;
+			containers::vector<key_t> m_keys;
+			containers::unordered_map<key_t, std::size_t> m_key_to_index;
 			bool m_random_initialized;
 
 		  public:
 			// Constructor
 			random_eviction_policy() : m_random_initialized(false) { this->initialize_random(); }
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit random_eviction_policy(containers::memory_resource* p_resource) : m_keys(p_resource), m_key_to_index(p_resource), m_random_initialized(false)
+			{
+				this->initialize_random();
+			}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit random_eviction_policy(const containers::policy_context& p_context) : m_keys(p_context.get_allocator()), m_key_to_index(p_context.get_allocator()), m_random_initialized(false)
+			{
+				m_keys.reserve(p_context.capacity());
+				m_key_to_index.reserve(p_context.capacity());
+				this->initialize_random();
+			}
+
 			// Destructor
 			~random_eviction_policy() override = default;
 
@@ -772,6 +885,8 @@ namespace cache_engine
 				m_key_to_index.clear();
 			}
 
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_keys) + containers::heap_bytes(m_key_to_index); }
+
 		  private:
 			auto initialize_random() -> void
 			{
@@ -783,5 +898,853 @@ namespace cache_engine
 			}
 		};
 
+		/**
+		 * @brief Sampled LFU eviction policy over dense frequency counters
+		 *
+		 * Approximates LFU without frequency buckets. Keys live in a dense
+		 * slot array with a parallel array of small saturating counters
+		 * (see dense_frequency_counters). A victim is the least frequent key
+		 * of a randomly placed block of slots, found with vector min
+		 * instructions. Counters are periodically halved in one streaming
+		 * pass so that old popularity decays.
+		 *
+		 * Time Complexity:
+		 * - on_access: O(1), plus an amortized O(1) share of aging
+		 * - on_insert: O(1)
+		 * - select_victim: O(sample size)
+		 * - remove_key: O(1)
+		 *
+		 * @tparam counter_t std::uint8_t or std::uint16_t
+		 */
+		template <typename key_t, typename value_t, typename counter_t> class basic_sampled_lfu_eviction_policy : public eviction_policy_base<key_t, value_t>
+		{
+		  public:
+			using self_t	 = basic_sampled_lfu_eviction_policy<key_t, value_t, counter_t>;
+			using base_t	 = eviction_policy_base<key_t, value_t>;
+			using counters_t = dense_frequency_counters<counter_t>;
+
+		  private:
+			static constexpr std::size_t default_sample_size	  = 64;
+			static constexpr std::size_t default_aging_multiplier = 10;
+			static constexpr std::size_t min_aging_period		  = 1024;
+			static constexpr std::uint64_t default_seed			  = 0x9E3779B97F4A7C15ULL;
+
+			containers::vector<key_t> m_slot_keys;
+			containers::unordered_map<key_t, std::size_t> m_key_to_slot;
+			counters_t m_frequencies;
+			std::size_t m_sample_size;
+			std::size_t m_aging_multiplier;
+			std::size_t m_increments_since_aging;
+			std::size_t m_aging_count;
+			std::uint64_t m_rng_state;
+
+		  public:
+			// Constructor
+			basic_sampled_lfu_eviction_policy()
+				: m_sample_size(default_sample_size), m_aging_multiplier(default_aging_multiplier), m_increments_since_aging(0), m_aging_count(0), m_rng_state(default_seed)
+			{
+			}
+
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit basic_sampled_lfu_eviction_policy(containers::memory_resource* p_resource)
+				: m_slot_keys(p_resource), m_key_to_slot(p_resource), m_frequencies(p_resource), m_sample_size(default_sample_size), m_aging_multiplier(default_aging_multiplier),
+				  m_increments_since_aging(0), m_aging_count(0), m_rng_state(default_seed)
+			{
+			}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit basic_sampled_lfu_eviction_policy(const containers::policy_context& p_context)
+				: m_slot_keys(p_context.get_allocator()), m_key_to_slot(p_context.get_allocator()), m_frequencies(p_context.get_allocator()), m_sample_size(default_sample_size),
+				  m_aging_multiplier(default_aging_multiplier), m_increments_since_aging(0), m_aging_count(0), m_rng_state(default_seed)
+			{
+				m_slot_keys.reserve(p_context.capacity());
+				m_key_to_slot.reserve(p_context.capacity());
+				m_frequencies.reserve(p_context.capacity());
+			}
+
+			// Destructor
+			~basic_sampled_lfu_eviction_policy() override = default;
+
+			// Copy constructor and assignment operator (deleted)
+			basic_sampled_lfu_eviction_policy(const self_t&) = delete;
+			auto operator=(const self_t&) -> self_t&		 = delete;
+
+			// Move constructor and assignment operator
+			basic_sampled_lfu_eviction_policy(self_t&& p_other) noexcept
+				: m_slot_keys(std::move(p_other.m_slot_keys)), m_key_to_slot(std::move(p_other.m_key_to_slot)), m_frequencies(std::move(p_other.m_frequencies)),
+				  m_sample_size(p_other.m_sample_size), m_aging_multiplier(p_other.m_aging_multiplier), m_increments_since_aging(p_other.m_increments_since_aging),
+				  m_aging_count(p_other.m_aging_count), m_rng_state(p_other.m_rng_state)
+			{
+			}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					m_slot_keys				 = std::move(p_other.m_slot_keys);
+					m_key_to_slot			 = std::move(p_other.m_key_to_slot);
+					m_frequencies			 = std::move(p_other.m_frequencies);
+					m_sample_size			 = p_other.m_sample_size;
+					m_aging_multiplier		 = p_other.m_aging_multiplier;
+					m_increments_since_aging = p_other.m_increments_since_aging;
+					m_aging_count			 = p_other.m_aging_count;
+					m_rng_state				 = p_other.m_rng_state;
+				}
+				return *this;
+			}
+
+		  public:
+			auto on_access(const key_t& p_key) -> void override { this->increment_frequency(p_key); }
+
+			auto on_insert(const key_t& p_key) -> void override
+			{
+				// Start with frequency 1
+				m_slot_keys.push_back(p_key);
+				m_key_to_slot[p_key] = m_frequencies.push_back(1);
+			}
+
+			auto on_update(const key_t& p_key) -> void override
+			{
+				// Treat update same as access
+				this->increment_frequency(p_key);
+			}
+
+			auto select_victim() -> key_t override
+			{
+				if (m_slot_keys.empty())
+				{
+					throw std::runtime_error("Cannot select victim from empty sampled LFU policy");
+				}
+
+				// Sample a contiguous block at a random offset and take its least frequent slot
+				const std::size_t slot_count  = m_slot_keys.size();
+				const std::size_t block_size  = (m_sample_size < slot_count) ? m_sample_size : slot_count;
+				const std::size_t block_start = (slot_count > block_size) ? static_cast<std::size_t>(detail::xorshift64(m_rng_state) % (slot_count - block_size + 1)) : 0;
+
+				return m_slot_keys[m_frequencies.min_slot(block_start, block_size)];
+			}
+
+			auto remove_key(const key_t& p_key) -> void override
+			{
+				auto slot_iter = m_key_to_slot.find(p_key);
+				if (slot_iter != m_key_to_slot.end())
+				{
+					const std::size_t slot		= slot_iter->second;
+					const std::size_t last_slot = m_slot_keys.size() - 1;
+
+					if (slot != last_slot)
+					{
+						// Move the last slot into the hole to keep both arrays dense
+						m_slot_keys[slot]				 = m_slot_keys[last_slot];
+						m_key_to_slot[m_slot_keys[slot]] = slot;
+					}
+
+					m_frequencies.swap_remove(slot);
+					m_slot_keys.pop_back();
+					m_key_to_slot.erase(slot_iter);
+				}
+			}
+
+			auto empty() const -> bool override { return m_slot_keys.empty(); }
+
+			auto size() const -> std::size_t override { return m_slot_keys.size(); }
+
+			auto clear() -> void override
+			{
+				m_slot_keys.clear();
+				m_key_to_slot.clear();
+				m_frequencies.clear();
+				m_increments_since_aging = 0;
+			}
+
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_slot_keys) + containers::heap_bytes(m_key_to_slot) + m_frequencies.memory_usage(); }
+
+		  public:
+			/**
+			 * @brief Halve every frequency counter immediately
+			 */
+			auto age() -> void
+			{
+				m_frequencies.halve_all();
+				m_increments_since_aging = 0;
+				++m_aging_count;
+			}
+
+			/**
+			 * @brief Set the number of slots examined per victim selection
+			 * @param p_sample_size The block size (at least 1)
+			 */
+			auto set_sample_size(std::size_t p_sample_size) -> void { m_sample_size = (p_sample_size > 0) ? p_sample_size : 1; }
+
+			/**
+			 * @brief Get the number of slots examined per victim selection
+			 * @return The block size
+			 */
+			auto sample_size() const -> std::size_t { return m_sample_size; }
+
+			/**
+			 * @brief Set how many increments per tracked key trigger aging
+			 * @param p_multiplier Aging happens after size() * p_multiplier increments
+			 */
+			auto set_aging_multiplier(std::size_t p_multiplier) -> void { m_aging_multiplier = (p_multiplier > 0) ? p_multiplier : 1; }
+
+			/**
+			 * @brief Get the number of aging passes performed so far
+			 * @return The aging count
+			 */
+			auto aging_count() const -> std::size_t { return m_aging_count; }
+
+			/**
+			 * @brief Get the current frequency of a key
+			 * @param p_key The key to query
+			 * @return The frequency counter value (0 if the key is not tracked)
+			 */
+			auto frequency(const key_t& p_key) const -> std::size_t
+			{
+				auto slot_iter = m_key_to_slot.find(p_key);
+				return (slot_iter != m_key_to_slot.end()) ? static_cast<std::size_t>(m_frequencies[slot_iter->second]) : 0;
+			}
+
+			/**
+			 * @brief Reseed the victim sampler (mainly for testing)
+			 * @param p_seed Non-zero seed value
+			 */
+			auto set_seed(std::uint64_t p_seed) -> void { m_rng_state = (p_seed != 0) ? p_seed : default_seed; }
+
+		  private:
+			auto increment_frequency(const key_t& p_key) -> void
+			{
+				auto slot_iter = m_key_to_slot.find(p_key);
+				if (slot_iter != m_key_to_slot.end())
+				{
+					m_frequencies.increment(slot_iter->second);
+
+					// Age once the sample period (a multiple of the tracked size) has elapsed
+					const std::size_t aging_period = m_slot_keys.size() * m_aging_multiplier;
+					if (++m_increments_since_aging >= ((aging_period > min_aging_period) ? aging_period : min_aging_period))
+					{
+						this->age();
+					}
+				}
+			}
+		};
+
+		/**
+		 * @brief Sampled LFU with 8-bit counters (saturate at 255)
+		 */
+		template <typename key_t, typename value_t> using sampled_lfu_eviction_policy = basic_sampled_lfu_eviction_policy<key_t, value_t, std::uint8_t>;
+
+		/**
+		 * @brief Sampled LFU with 16-bit counters (saturate at 65535)
+		 */
+		template <typename key_t, typename value_t> using sampled_lfu16_eviction_policy = basic_sampled_lfu_eviction_policy<key_t, value_t, std::uint16_t>;
+
+		/**
+		 * @brief Hyperbolic eviction policy over a dense sampled array
+		 *
+		 * Ranks keys by hits / time in cache, so a young key with a high
+		 * request rate outranks an old key whose large count has gone stale.
+		 * Time is a logical clock advanced by every insert, access and update.
+		 * Priorities are never stored: they fall as the clock moves, so
+		 * nothing has to be re-sorted. Each slot of a dense array holds the
+		 * key, its hit count and its insert tick; a victim is the lowest
+		 * priority key among randomly chosen slots.
+		 *
+		 * Time Complexity:
+		 * - on_access: O(1)
+		 * - on_insert: O(1)
+		 * - select_victim: O(sample size)
+		 * - remove_key: O(1)
+		 */
+		template <typename key_t, typename value_t> class hyperbolic_eviction_policy : public eviction_policy_base<key_t, value_t>
+		{
+		  public:
+			using self_t = hyperbolic_eviction_policy<key_t, value_t>;
+			using base_t = eviction_policy_base<key_t, value_t>;
+
+		  private:
+			static constexpr std::size_t default_sample_size = 64;
+			static constexpr std::uint64_t default_seed		 = 0x9E3779B97F4A7C15ULL;
+
+			/**
+			 * @brief Per-key state kept inline in the dense array
+			 */
+			struct slot
+			{
+				key_t m_key;
+				std::uint64_t m_hits;
+				std::uint64_t m_inserted;
+			};
+
+			containers::vector<slot> m_slots;
+			containers::unordered_map<key_t, std::size_t> m_key_to_slot;
+			std::size_t m_sample_size;
+			std::uint64_t m_tick;
+			std::uint64_t m_rng_state;
+
+		  public:
+			// Constructor
+			hyperbolic_eviction_policy() : m_sample_size(default_sample_size), m_tick(0), m_rng_state(default_seed) {}
+
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit hyperbolic_eviction_policy(containers::memory_resource* p_resource)
+				: m_slots(p_resource), m_key_to_slot(p_resource), m_sample_size(default_sample_size), m_tick(0), m_rng_state(default_seed)
+			{
+			}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit hyperbolic_eviction_policy(const containers::policy_context& p_context)
+				: m_slots(p_context.get_allocator()), m_key_to_slot(p_context.get_allocator()), m_sample_size(default_sample_size), m_tick(0), m_rng_state(default_seed)
+			{
+				m_slots.reserve(p_context.capacity());
+				m_key_to_slot.reserve(p_context.capacity());
+			}
+
+			// Destructor
+			~hyperbolic_eviction_policy() override = default;
+
+			// Copy constructor and assignment operator (deleted)
+			hyperbolic_eviction_policy(const self_t&)	 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			// Move constructor and assignment operator
+			hyperbolic_eviction_policy(self_t&& p_other) noexcept
+				: m_slots(std::move(p_other.m_slots)), m_key_to_slot(std::move(p_other.m_key_to_slot)), m_sample_size(p_other.m_sample_size), m_tick(p_other.m_tick),
+				  m_rng_state(p_other.m_rng_state)
+			{
+			}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					m_slots		  = std::move(p_other.m_slots);
+					m_key_to_slot = std::move(p_other.m_key_to_slot);
+					m_sample_size = p_other.m_sample_size;
+					m_tick		  = p_other.m_tick;
+					m_rng_state	  = p_other.m_rng_state;
+				}
+				return *this;
+			}
+
+		  public:
+			auto on_access(const key_t& p_key) -> void override { this->record_hit(p_key); }
+
+			auto on_insert(const key_t& p_key) -> void override
+			{
+				// The insert counts as the first request
+				slot entry;
+				entry.m_key			 = p_key;
+				entry.m_hits		 = 1;
+				entry.m_inserted	 = m_tick++;
+				m_key_to_slot[p_key] = m_slots.size();
+				m_slots.push_back(entry);
+			}
+
+			auto on_update(const key_t& p_key) -> void override
+			{
+				// Treat update same as access
+				this->record_hit(p_key);
+			}
+
+			auto select_victim() -> key_t override
+			{
+				if (m_slots.empty())
+				{
+					throw std::runtime_error("Cannot select victim from empty hyperbolic policy");
+				}
+
+				// Rank every key when the array is no larger than the sample
+				const std::size_t slot_count = m_slots.size();
+				const bool rank_all			 = slot_count <= m_sample_size;
+				const std::size_t probes	 = rank_all ? slot_count : m_sample_size;
+
+				std::size_t victim = 0;
+				double victim_hits = 0.0;
+				double victim_age  = 1.0;
+				for (std::size_t idx_for = 0; idx_for < probes; ++idx_for)
+				{
+					const std::size_t candidate = rank_all ? idx_for : this->random_slot(slot_count);
+					const slot& entry			= m_slots[candidate];
+					const double hits			= static_cast<double>(entry.m_hits);
+					const double age			= static_cast<double>(this->age_of(entry));
+
+					// hits / age < victim_hits / victim_age, cross-multiplied to avoid dividing
+					if (idx_for == 0 || hits * victim_age < victim_hits * age)
+					{
+						victim		= candidate;
+						victim_hits = hits;
+						victim_age	= age;
+					}
+				}
+				return m_slots[victim].m_key;
+			}
+
+			auto remove_key(const key_t& p_key) -> void override
+			{
+				auto slot_iter = m_key_to_slot.find(p_key);
+				if (slot_iter != m_key_to_slot.end())
+				{
+					const std::size_t index		 = slot_iter->second;
+					const std::size_t last_index = m_slots.size() - 1;
+
+					if (index != last_index)
+					{
+						// Move the last slot into the hole to keep the array dense
+						m_slots[index]						= m_slots[last_index];
+						m_key_to_slot[m_slots[index].m_key] = index;
+					}
+
+					m_slots.pop_back();
+					m_key_to_slot.erase(slot_iter);
+				}
+			}
+
+			auto empty() const -> bool override { return m_slots.empty(); }
+
+			auto size() const -> std::size_t override { return m_slots.size(); }
+
+			auto clear() -> void override
+			{
+				m_slots.clear();
+				m_key_to_slot.clear();
+			}
+
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_slots) + containers::heap_bytes(m_key_to_slot); }
+
+		  public:
+			/**
+			 * @brief Set the number of slots examined per victim selection
+			 * @param p_sample_size The sample size (at least 1)
+			 */
+			auto set_sample_size(std::size_t p_sample_size) -> void { m_sample_size = (p_sample_size > 0) ? p_sample_size : 1; }
+
+			/**
+			 * @brief Get the number of slots examined per victim selection
+			 * @return The sample size
+			 */
+			auto sample_size() const -> std::size_t { return m_sample_size; }
+
+			/**
+			 * @brief Get the number of hits recorded for a key, the insert included
+			 * @param p_key The key to query
+			 * @return The hit count (0 if the key is not tracked)
+			 */
+			auto hits(const key_t& p_key) const -> std::uint64_t
+			{
+				auto slot_iter = m_key_to_slot.find(p_key);
+				return (slot_iter != m_key_to_slot.end()) ? m_slots[slot_iter->second].m_hits : 0;
+			}
+
+			/**
+			 * @brief Get the current priority of a key
+			 * @param p_key The key to query
+			 * @return Hits per tick since insertion (0 if the key is not tracked)
+			 */
+			auto priority(const key_t& p_key) const -> double
+			{
+				auto slot_iter = m_key_to_slot.find(p_key);
+				if (slot_iter == m_key_to_slot.end())
+				{
+					return 0.0;
+				}
+				const slot& entry = m_slots[slot_iter->second];
+				return static_cast<double>(entry.m_hits) / static_cast<double>(this->age_of(entry));
+			}
+
+			/**
+			 * @brief Reseed the victim sampler (mainly for testing)
+			 * @param p_seed Non-zero seed value
+			 */
+			auto set_seed(std::uint64_t p_seed) -> void { m_rng_state = (p_seed != 0) ? p_seed : default_seed; }
+
+		  private:
+			auto record_hit(const key_t& p_key) -> void
+			{
+				auto slot_iter = m_key_to_slot.find(p_key);
+				if (slot_iter != m_key_to_slot.end())
+				{
+					++m_slots[slot_iter->second].m_hits;
+				}
+				++m_tick;
+			}
+
+			auto age_of(const slot& p_slot) const -> std::uint64_t
+			{
+				// A key inserted on the current tick has been cached for one tick
+				const std::uint64_t age = m_tick - p_slot.m_inserted;
+				return (age > 0) ? age : 1;
+			}
+
+			auto random_slot(std::size_t p_slot_count) -> std::size_t
+			{
+				// Multiply-shift maps 32 random bits onto the slot range without a division
+				const std::uint64_t bits = detail::xorshift64(m_rng_state) >> 32U;
+				if (p_slot_count <= 0xFFFFFFFFULL)
+				{
+					return static_cast<std::size_t>((bits * static_cast<std::uint64_t>(p_slot_count)) >> 32U);
+				}
+				return static_cast<std::size_t>(detail::xorshift64(m_rng_state) % p_slot_count);
+			}
+		};
+
+		/**
+		 * @brief Detects runs of strictly monotonic integral keys
+		 *
+		 * Non-integral keys have no order worth tracking, so they never form a run.
+		 */
+		template <typename key_t, bool is_integral = std::is_integral<key_t>::value> struct monotonic_run_detector
+		{
+			auto observe(const key_t&, std::uintmax_t) -> std::size_t { return 0; }
+
+			auto reset() -> void {}
+		};
+
+		template <typename key_t> struct monotonic_run_detector<key_t, true>
+		{
+			key_t m_last{};
+			int m_direction		 = 0;
+			std::size_t m_length = 0;
+
+			/**
+			 * @brief Feed the next key and get the length of the run it extends
+			 * @param p_key The key
+			 * @param p_max_stride Largest gap between neighbouring keys of one run
+			 * @return Number of keys in the current run, this one included
+			 */
+			auto observe(const key_t& p_key, std::uintmax_t p_max_stride) -> std::size_t
+			{
+				// Unsigned subtraction gives the exact distance for signed keys too
+				const int direction			  = (p_key > m_last) ? 1 : ((p_key < m_last) ? -1 : 0);
+				const std::uintmax_t distance = (direction > 0) ? static_cast<std::uintmax_t>(p_key) - static_cast<std::uintmax_t>(m_last)
+																 : static_cast<std::uintmax_t>(m_last) - static_cast<std::uintmax_t>(p_key);
+
+				if (m_length > 0 && direction != 0 && distance <= p_max_stride && (m_length == 1 || direction == m_direction))
+				{
+					++m_length;
+				}
+				else
+				{
+					m_length = 1;
+				}
+				m_direction = direction;
+				m_last		= p_key;
+				return m_length;
+			}
+
+			auto reset() -> void { m_length = 0; }
+		};
+
+		/**
+		 * @brief LRU eviction policy with midpoint insertion and scan detection
+		 *
+		 * The list is split into a young and an old sublist, as in the InnoDB
+		 * buffer pool. New keys enter at the head of the old sublist, so a key
+		 * seen once is evicted before anything in the young sublist. A key in
+		 * the old sublist moves to the head of the young sublist only when it
+		 * is accessed again at least min_dwell after its insertion, which keeps
+		 * the repeated touches of a single scan pass from promoting it. When
+		 * the young sublist grows past its share, its tail drops into the old
+		 * sublist. Inserts that extend a run of monotonic integral keys go to
+		 * the tail of the old sublist instead, so a scan evicts mostly itself.
+		 *
+		 * Time Complexity:
+		 * - on_access: O(1)
+		 * - on_insert: O(1)
+		 * - select_victim: O(1)
+		 * - remove_key: O(1)
+		 *
+		 * @tparam clock_t Clock used to measure the dwell time
+		 */
+		template <typename key_t, typename value_t, typename clock_t> class basic_midpoint_lru_eviction_policy : public eviction_policy_base<key_t, value_t>
+		{
+		  public:
+			using self_t	 = basic_midpoint_lru_eviction_policy<key_t, value_t, clock_t>;
+			using base_t	 = eviction_policy_base<key_t, value_t>;
+			using duration	 = typename clock_t::duration;
+			using time_point = typename clock_t::time_point;
+
+		  private:
+			static constexpr double default_old_fraction			= 0.375;
+			static constexpr std::size_t default_scan_threshold		= 32;
+			static constexpr std::uintmax_t default_scan_max_stride = 64;
+
+			/**
+			 * @brief List node: the key, its insert time and the sublist holding it
+			 */
+			struct node
+			{
+				key_t m_key;
+				time_point m_inserted;
+				bool m_old;
+			};
+
+			using list_t	 = containers::list<node>;
+			using iterator_t = typename list_t::iterator;
+
+			list_t m_young;
+			list_t m_old;
+			containers::unordered_map<key_t, iterator_t> m_entries;
+			monotonic_run_detector<key_t> m_run_detector;
+			double m_old_fraction;
+			duration m_min_dwell;
+			std::size_t m_scan_threshold;
+			std::uintmax_t m_scan_max_stride;
+			std::size_t m_promotions;
+			std::size_t m_scan_inserts;
+
+		  public:
+			// Constructor
+			basic_midpoint_lru_eviction_policy()
+				: m_old_fraction(default_old_fraction), m_min_dwell(std::chrono::duration_cast<duration>(std::chrono::seconds(1))), m_scan_threshold(default_scan_threshold),
+				  m_scan_max_stride(default_scan_max_stride), m_promotions(0), m_scan_inserts(0)
+			{
+			}
+
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit basic_midpoint_lru_eviction_policy(containers::memory_resource* p_resource)
+				: m_young(p_resource), m_old(p_resource), m_entries(p_resource), m_old_fraction(default_old_fraction),
+				  m_min_dwell(std::chrono::duration_cast<duration>(std::chrono::seconds(1))), m_scan_threshold(default_scan_threshold), m_scan_max_stride(default_scan_max_stride),
+				  m_promotions(0), m_scan_inserts(0)
+			{
+			}
+#endif
+
+			// Constructor sized for the cache capacity (list nodes are allocated per entry and cannot be reserved)
+			explicit basic_midpoint_lru_eviction_policy(const containers::policy_context& p_context)
+				: m_young(p_context.get_allocator()), m_old(p_context.get_allocator()), m_entries(p_context.get_allocator()), m_old_fraction(default_old_fraction),
+				  m_min_dwell(std::chrono::duration_cast<duration>(std::chrono::seconds(1))), m_scan_threshold(default_scan_threshold), m_scan_max_stride(default_scan_max_stride),
+				  m_promotions(0), m_scan_inserts(0)
+			{
+				m_entries.reserve(p_context.capacity());
+			}
+
+			// Destructor
+			~basic_midpoint_lru_eviction_policy() override = default;
+
+			// Copy constructor and assignment operator (deleted)
+			basic_midpoint_lru_eviction_policy(const self_t&) = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			// Move constructor and assignment operator
+			basic_midpoint_lru_eviction_policy(self_t&& p_other) noexcept
+				: m_young(std::move(p_other.m_young)), m_old(std::move(p_other.m_old)), m_entries(std::move(p_other.m_entries)), m_run_detector(p_other.m_run_detector),
+				  m_old_fraction(p_other.m_old_fraction), m_min_dwell(p_other.m_min_dwell), m_scan_threshold(p_other.m_scan_threshold), m_scan_max_stride(p_other.m_scan_max_stride),
+				  m_promotions(p_other.m_promotions), m_scan_inserts(p_other.m_scan_inserts)
+			{
+			}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					m_young			  = std::move(p_other.m_young);
+					m_old			  = std::move(p_other.m_old);
+					m_entries		  = std::move(p_other.m_entries);
+					m_run_detector	  = p_other.m_run_detector;
+					m_old_fraction	  = p_other.m_old_fraction;
+					m_min_dwell		  = p_other.m_min_dwell;
+					m_scan_threshold  = p_other.m_scan_threshold;
+					m_scan_max_stride = p_other.m_scan_max_stride;
+					m_promotions	  = p_other.m_promotions;
+					m_scan_inserts	  = p_other.m_scan_inserts;
+				}
+				return *this;
+			}
+
+		  public:
+			auto on_access(const key_t& p_key) -> void override
+			{
+				auto iter_map = m_entries.find(p_key);
+				if (iter_map == m_entries.end())
+				{
+					return;
+				}
+
+				const iterator_t position = iter_map->second;
+				if (!position->m_old)
+				{
+					// Move to front of the young sublist
+					m_young.splice(m_young.begin(), m_young, position);
+					return;
+				}
+
+				// An old key earns promotion only once it has dwelled long enough
+				if (clock_t::now() - position->m_inserted >= m_min_dwell)
+				{
+					m_young.splice(m_young.begin(), m_old, position);
+					position->m_old = false;
+					++m_promotions;
+					this->rebalance();
+				}
+			}
+
+			auto on_insert(const key_t& p_key) -> void override
+			{
+				const bool scanning = m_scan_threshold > 0 && m_run_detector.observe(p_key, m_scan_max_stride) >= m_scan_threshold;
+
+				const node entry = {p_key, clock_t::now(), true};
+				if (scanning)
+				{
+					// Scan entries queue up right at the eviction end
+					m_old.push_back(entry);
+					m_entries[p_key] = std::prev(m_old.end());
+					++m_scan_inserts;
+				}
+				else
+				{
+					// Add at the midpoint: head of the old sublist
+					m_old.push_front(entry);
+					m_entries[p_key] = m_old.begin();
+				}
+			}
+
+			auto on_update(const key_t& p_key) -> void override
+			{
+				// Treat update same as access
+				this->on_access(p_key);
+			}
+
+			auto select_victim() -> key_t override
+			{
+				if (m_entries.empty())
+				{
+					throw std::runtime_error("Cannot select victim from empty midpoint LRU policy");
+				}
+
+				// Old sublist tail first, then the young tail once the old sublist has run dry
+				return m_old.empty() ? m_young.back().m_key : m_old.back().m_key;
+			}
+
+			auto remove_key(const key_t& p_key) -> void override
+			{
+				auto iter_map = m_entries.find(p_key);
+				if (iter_map != m_entries.end())
+				{
+					list_t& sublist = iter_map->second->m_old ? m_old : m_young;
+					sublist.erase(iter_map->second);
+					m_entries.erase(iter_map);
+				}
+			}
+
+			auto empty() const -> bool override { return m_entries.empty(); }
+
+			auto size() const -> std::size_t override { return m_entries.size(); }
+
+			auto clear() -> void override
+			{
+				m_young.clear();
+				m_old.clear();
+				m_entries.clear();
+				m_run_detector.reset();
+			}
+
+			auto memory_usage() const -> std::size_t override { return containers::heap_bytes(m_young) + containers::heap_bytes(m_old) + containers::heap_bytes(m_entries); }
+
+		  public:
+			/**
+			 * @brief Set the share of tracked keys the old sublist is allowed to keep
+			 * @param p_fraction Fraction in (0, 1); InnoDB defaults to 3/8
+			 * @throws std::invalid_argument if p_fraction is outside (0, 1)
+			 */
+			auto set_old_fraction(double p_fraction) -> void
+			{
+				if (!(p_fraction > 0.0 && p_fraction < 1.0))
+				{
+					throw std::invalid_argument("Old sublist fraction must be between 0 and 1");
+				}
+				m_old_fraction = p_fraction;
+				this->rebalance();
+			}
+
+			/**
+			 * @brief Get the share of tracked keys kept in the old sublist
+			 * @return The old sublist fraction
+			 */
+			auto old_fraction() const -> double { return m_old_fraction; }
+
+			/**
+			 * @brief Set how long a key must stay in the old sublist before an access promotes it
+			 * @param p_min_dwell Minimum time between insert and promoting access
+			 */
+			auto set_min_dwell(duration p_min_dwell) -> void { m_min_dwell = p_min_dwell; }
+
+			/**
+			 * @brief Get the minimum dwell time
+			 * @return The minimum time between insert and promoting access
+			 */
+			auto min_dwell() const -> duration { return m_min_dwell; }
+
+			/**
+			 * @brief Set the run length at which monotonic inserts count as a scan
+			 * @param p_threshold Keys in a run before tail insertion starts (0 disables detection)
+			 * @param p_max_stride Largest key gap that still continues a run
+			 */
+			auto set_scan_detection(std::size_t p_threshold, std::uintmax_t p_max_stride = default_scan_max_stride) -> void
+			{
+				m_scan_threshold  = p_threshold;
+				m_scan_max_stride = p_max_stride;
+				m_run_detector.reset();
+			}
+
+			/**
+			 * @brief Get the number of keys in the young sublist
+			 * @return The young sublist size
+			 */
+			auto young_size() const -> std::size_t { return m_young.size(); }
+
+			/**
+			 * @brief Get the number of keys in the old sublist
+			 * @return The old sublist size
+			 */
+			auto old_size() const -> std::size_t { return m_old.size(); }
+
+			/**
+			 * @brief Check whether a key currently sits in the young sublist
+			 * @param p_key The key to query
+			 * @return True if the key is tracked and young
+			 */
+			auto is_young(const key_t& p_key) const -> bool
+			{
+				auto iter_map = m_entries.find(p_key);
+				return iter_map != m_entries.end() && !iter_map->second->m_old;
+			}
+
+			/**
+			 * @brief Get the number of promotions from the old to the young sublist
+			 * @return The promotion count
+			 */
+			auto promotions() const -> std::size_t { return m_promotions; }
+
+			/**
+			 * @brief Get the number of inserts placed at the tail as part of a scan
+			 * @return The scan insert count
+			 */
+			auto scan_inserts() const -> std::size_t { return m_scan_inserts; }
+
+		  private:
+			auto rebalance() -> void
+			{
+				// Demote young tails until the young sublist is back within its share
+				const std::size_t young_limit = static_cast<std::size_t>(static_cast<double>(m_entries.size()) * (1.0 - m_old_fraction));
+				while (m_young.size() > young_limit)
+				{
+					const iterator_t tail = std::prev(m_young.end());
+					tail->m_old			  = true;
+					m_old.splice(m_old.begin(), m_young, tail);
+				}
+			}
+		};
+
+		/**
+		 * @brief Midpoint insertion LRU timed with std::chrono::steady_clock
+		 */
+		template <typename key_t, typename value_t> using midpoint_lru_eviction_policy = basic_midpoint_lru_eviction_policy<key_t, value_t, std::chrono::steady_clock>;
+
 	} // namespace policies
 } // namespace cache_engine
\ No newline at end of file
@@ -0,0 +1,393 @@
+// File: inc/cache_engine/policies/frequency_counters.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "policy_containers.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#endif
+
+namespace cache_engine
+{
+	namespace policies
+	{
+		namespace detail
+		{
+			/**
+			 * @brief Portable scalar implementation of the bulk counter operations
+			 *
+			 * Used for the tail of every vectorized pass and as the complete
+			 * implementation on targets without SSE2.
+			 */
+			template <typename counter_t> struct scalar_frequency_ops
+			{
+				static auto halve(counter_t* p_data, std::size_t p_count) -> void
+				{
+					for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+					{
+						p_data[idx_for] = static_cast<counter_t>(p_data[idx_for] >> 1U);
+					}
+				}
+
+				static auto min_value(const counter_t* p_data, std::size_t p_count) -> counter_t
+				{
+					counter_t result = std::numeric_limits<counter_t>::max();
+					for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+					{
+						result = (p_data[idx_for] < result) ? p_data[idx_for] : result;
+					}
+					return result;
+				}
+			};
+
+			/**
+			 * @brief Vectorized bulk counter operations
+			 *
+			 * Selected at compile time: AVX2 when the translation unit is built
+			 * with -mavx2, SSE2 on any x86-64 target, scalar everywhere else.
+			 */
+			template <typename counter_t> struct simd_frequency_ops;
+
+#if defined(__AVX2__)
+			template <> struct simd_frequency_ops<std::uint8_t>
+			{
+				static constexpr std::size_t lanes = 32;
+
+				static auto halve(std::uint8_t* p_data, std::size_t p_count) -> void
+				{
+					const __m256i low_bits = _mm256_set1_epi8(0x7F);
+					std::size_t idx_for	   = 0;
+					for (; idx_for + lanes <= p_count; idx_for += lanes)
+					{
+						__m256i* p_block	= reinterpret_cast<__m256i*>(p_data + idx_for);
+						const __m256i block = _mm256_loadu_si256(p_block);
+						// No 8-bit shift exists: shift 16-bit lanes and mask off the bit borrowed from the neighbour
+						_mm256_storeu_si256(p_block, _mm256_and_si256(_mm256_srli_epi16(block, 1), low_bits));
+					}
+					scalar_frequency_ops<std::uint8_t>::halve(p_data + idx_for, p_count - idx_for);
+				}
+
+				static auto min_value(const std::uint8_t* p_data, std::size_t p_count) -> std::uint8_t
+				{
+					if (p_count < lanes)
+					{
+						return scalar_frequency_ops<std::uint8_t>::min_value(p_data, p_count);
+					}
+
+					__m256i minimum		= _mm256_set1_epi8(static_cast<char>(0xFF));
+					std::size_t idx_for = 0;
+					for (; idx_for + lanes <= p_count; idx_for += lanes)
+					{
+						minimum = _mm256_min_epu8(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_data + idx_for)));
+					}
+
+					alignas(32) std::uint8_t lanes_out[lanes];
+					_mm256_store_si256(reinterpret_cast<__m256i*>(lanes_out), minimum);
+					const std::uint8_t vector_min = scalar_frequency_ops<std::uint8_t>::min_value(lanes_out, lanes);
+					const std::uint8_t tail_min	  = scalar_frequency_ops<std::uint8_t>::min_value(p_data + idx_for, p_count - idx_for);
+					return (tail_min < vector_min) ? tail_min : vector_min;
+				}
+			};
+
+			template <> struct simd_frequency_ops<std::uint16_t>
+			{
+				static constexpr std::size_t lanes = 16;
+
+				static auto halve(std::uint16_t* p_data, std::size_t p_count) -> void
+				{
+					std::size_t idx_for = 0;
+					for (; idx_for + lanes <= p_count; idx_for += lanes)
+					{
+						__m256i* p_block = reinterpret_cast<__m256i*>(p_data + idx_for);
+						_mm256_storeu_si256(p_block, _mm256_srli_epi16(_mm256_loadu_si256(p_block), 1));
+					}
+					scalar_frequency_ops<std::uint16_t>::halve(p_data + idx_for, p_count - idx_for);
+				}
+
+				static auto min_value(const std::uint16_t* p_data, std::size_t p_count) -> std::uint16_t
+				{
+					if (p_count < lanes)
+					{
+						return scalar_frequency_ops<std::uint16_t>::min_value(p_data, p_count);
+					}
+
+					__m256i minimum		= _mm256_set1_epi16(static_cast<short>(0xFFFF));
+					std::size_t idx_for = 0;
+					for (; idx_for + lanes <= p_count; idx_for += lanes)
+					{
+						minimum = _mm256_min_epu16(minimum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_data + idx_for)));
+					}
+
+					alignas(32) std::uint16_t lanes_out[lanes];
+					_mm256_store_si256(reinterpret_cast<__m256i*>(lanes_out), minimum);
+					const std::uint16_t vector_min = scalar_frequency_ops<std::uint16_t>::min_value(lanes_out, lanes);
+					const std::uint16_t tail_min   = scalar_frequency_ops<std::uint16_t>::min_value(p_data + idx_for, p_count - idx_for);
+					return (tail_min < vector_min) ? tail_min : vector_min;
+				}
+			};
+
+			constexpr const char* frequency_simd_backend = "avx2";
+#elif defined(__SSE2__) || defined(_M_X64)
+			template <> struct simd_frequency_ops<std::uint8_t>
+			{
+				static constexpr std::size_t lanes = 16;
+
+				static auto halve(std::uint8_t* p_data, std::size_t p_count) -> void
+				{
+					const __m128i low_bits = _mm_set1_epi8(0x7F);
+					std::size_t idx_for	   = 0;
+					for (; idx_for + lanes <= p_count; idx_for += lanes)
+					{
+						__m128i* p_block	= reinterpret_cast<__m128i*>(p_data + idx_for);
+						const __m128i block = _mm_loadu_si128(p_block);
+						// No 8-bit shift exists: shift 16-bit lanes and mask off the bit borrowed from the neighbour
+						_mm_storeu_si128(p_block, _mm_and_si128(_mm_srli_epi16(block, 1), low_bits));
+					}
+					scalar_frequency_ops<std::uint8_t>::halve(p_data + idx_for, p_count - idx_for);
+				}
+
+				static auto min_value(const std::uint8_t* p_data, std::size_t p_count) -> std::uint8_t
+				{
+					if (p_count < lanes)
+					{
+						return scalar_frequency_ops<std::uint8_t>::min_value(p_data, p_count);
+					}
+
+					__m128i minimum		= _mm_set1_epi8(static_cast<char>(0xFF));
+					std::size_t idx_for = 0;
+					for (; idx_for + lanes <= p_count; idx_for += lanes)
+					{
+						minimum = _mm_min_epu8(minimum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_data + idx_for)));
+					}
+
+					alignas(16) std::uint8_t lanes_out[lanes];
+					_mm_store_si128(reinterpret_cast<__m128i*>(lanes_out), minimum);
+					const std::uint8_t vector_min = scalar_frequency_ops<std::uint8_t>::min_value(lanes_out, lanes);
+					const std::uint8_t tail_min	  = scalar_frequency_ops<std::uint8_t>::min_value(p_data + idx_for, p_count - idx_for);
+					return (tail_min < vector_min) ? tail_min : vector_min;
+				}
+			};
+
+			template <> struct simd_frequency_ops<std::uint16_t>
+			{
+				static constexpr std::size_t lanes = 8;
+
+				static auto halve(std::uint16_t* p_data, std::size_t p_count) -> void
+				{
+					std::size_t idx_for = 0;
+					for (; idx_for + lanes <= p_count; idx_for += lanes)
+					{
+						__m128i* p_block = reinterpret_cast<__m128i*>(p_data + idx_for);
+						_mm_storeu_si128(p_block, _mm_srli_epi16(_mm_loadu_si128(p_block), 1));
+					}
+					scalar_frequency_ops<std::uint16_t>::halve(p_data + idx_for, p_count - idx_for);
+				}
+
+				static auto min_value(const std::uint16_t* p_data, std::size_t p_count) -> std::uint16_t
+				{
+					if (p_count < lanes)
+					{
+						return scalar_frequency_ops<std::uint16_t>::min_value(p_data, p_count);
+					}
+
+#if defined(__SSE4_1__)
+					__m128i minimum = _mm_set1_epi16(static_cast<short>(0xFFFF));
+#else
+					// SSE2 only has a signed 16-bit min: bias into signed range, compare, bias back
+					const __m128i sign_bias = _mm_set1_epi16(static_cast<short>(0x8000));
+					__m128i minimum			= _mm_set1_epi16(0x7FFF);
+#endif
+					std::size_t idx_for = 0;
+					for (; idx_for + lanes <= p_count; idx_for += lanes)
+					{
+						const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_data + idx_for));
+#if defined(__SSE4_1__)
+						minimum = _mm_min_epu16(minimum, block);
+#else
+						minimum = _mm_min_epi16(minimum, _mm_xor_si128(block, sign_bias));
+#endif
+					}
+#if !defined(__SSE4_1__)
+					minimum = _mm_xor_si128(minimum, sign_bias);
+#endif
+
+					alignas(16) std::uint16_t lanes_out[lanes];
+					_mm_store_si128(reinterpret_cast<__m128i*>(lanes_out), minimum);
+					const std::uint16_t vector_min = scalar_frequency_ops<std::uint16_t>::min_value(lanes_out, lanes);
+					const std::uint16_t tail_min   = scalar_frequency_ops<std::uint16_t>::min_value(p_data + idx_for, p_count - idx_for);
+					return (tail_min < vector_min) ? tail_min : vector_min;
+				}
+			};
+
+			constexpr const char* frequency_simd_backend = "sse2";
+#else
+			template <typename counter_t> struct simd_frequency_ops : scalar_frequency_ops<counter_t>
+			{
+			};
+
+			constexpr const char* frequency_simd_backend = "scalar";
+#endif
+		} // namespace detail
+
+		/**
+		 * @brief Dense, slot-indexed frequency counters
+		 *
+		 * Stores one small saturating counter per tracked key in a contiguous
+		 * array instead of a node-based map, so that aging (halving every
+		 * counter) is a single streaming pass and the minimum of a block of
+		 * slots can be found with vector min instructions.
+		 *
+		 * Slots are kept dense: removing a slot moves the last counter into
+		 * the hole, mirroring the swap-and-pop used by the owning policy.
+		 *
+		 * Time Complexity:
+		 * - increment: O(1)
+		 * - remove: O(1)
+		 * - halve_all: O(n), vectorized
+		 * - min_slot: O(block), vectorized
+		 *
+		 * @tparam counter_t std::uint8_t or std::uint16_t
+		 */
+		template <typename counter_t> class dense_frequency_counters
+		{
+			static_assert(std::is_same<counter_t, std::uint8_t>::value || std::is_same<counter_t, std::uint16_t>::value,
+						  "Frequency counters must be std::uint8_t or std::uint16_t");
+
+		  public:
+			using self_t						 = dense_frequency_counters<counter_t>;
+			using counter_type					 = counter_t;
+			using simd_ops_t					 = detail::simd_frequency_ops<counter_t>;
+			using scalar_ops_t					 = detail::scalar_frequency_ops<counter_t>;
+			static constexpr counter_t max_count = std::numeric_limits<counter_t>::max();
+
+		  private:
+			containers::vector<counter_t> m_counters;
+
+		  public:
+			// Constructor
+			dense_frequency_counters() = default;
+
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit dense_frequency_counters(containers::memory_resource* p_resource) : m_counters(p_resource) {}
+#endif
+
+			// Constructor with an explicit allocator (see containers::policy_context)
+			explicit dense_frequency_counters(const containers::allocator<counter_t>& p_allocator) : m_counters(p_allocator) {}
+
+			// Destructor
+			~dense_frequency_counters() = default;
+
+			// Deleted copy constructor and assignment operator
+			dense_frequency_counters(const self_t&)	 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			// Move constructor and assignment operator
+			dense_frequency_counters(self_t&& p_other) noexcept : m_counters(std::move(p_other.m_counters)) {}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					m_counters = std::move(p_other.m_counters);
+				}
+				return *this;
+			}
+
+		  public:
+			/**
+			 * @brief Append a counter for a new slot
+			 * @param p_initial The starting frequency
+			 * @return The slot index assigned to the counter
+			 */
+			auto push_back(counter_t p_initial) -> std::size_t
+			{
+				m_counters.push_back(p_initial);
+				return m_counters.size() - 1;
+			}
+
+			/**
+			 * @brief Remove a slot by moving the last counter into it
+			 * @param p_slot The slot to remove
+			 */
+			auto swap_remove(std::size_t p_slot) -> void
+			{
+				m_counters[p_slot] = m_counters.back();
+				m_counters.pop_back();
+			}
+
+			/**
+			 * @brief Saturating increment of a slot
+			 * @param p_slot The slot to increment
+			 * @return true if the counter is saturated after the call
+			 */
+			auto increment(std::size_t p_slot) -> bool
+			{
+				counter_t& counter = m_counters[p_slot];
+				if (counter < max_count)
+				{
+					++counter;
+				}
+				return counter == max_count;
+			}
+
+			/**
+			 * @brief Halve every counter in one streaming pass
+			 */
+			auto halve_all() -> void { simd_ops_t::halve(m_counters.data(), m_counters.size()); }
+
+			/**
+			 * @brief Find the slot with the smallest counter within a block
+			 *
+			 * The minimum value is found with vector min instructions; the
+			 * first slot holding it is then located with a short scan.
+			 *
+			 * @param p_begin First slot of the block
+			 * @param p_count Number of slots in the block (clamped to size())
+			 * @return The slot index of the least frequent entry in the block
+			 */
+			auto min_slot(std::size_t p_begin, std::size_t p_count) const -> std::size_t
+			{
+				const std::size_t count	  = (p_begin + p_count > m_counters.size()) ? m_counters.size() - p_begin : p_count;
+				const counter_t* p_block  = m_counters.data() + p_begin;
+				const counter_t block_min = simd_ops_t::min_value(p_block, count);
+				std::size_t offset		  = 0;
+				while (offset < count && p_block[offset] != block_min)
+				{
+					++offset;
+				}
+				return p_begin + offset;
+			}
+
+			auto operator[](std::size_t p_slot) const -> counter_t { return m_counters[p_slot]; }
+
+			auto size() const -> std::size_t { return m_counters.size(); }
+
+			auto empty() const -> bool { return m_counters.empty(); }
+
+			auto reserve(std::size_t p_capacity) -> void { m_counters.reserve(p_capacity); }
+
+			auto clear() -> void { m_counters.clear(); }
+
+			auto memory_usage() const -> std::size_t { return containers::heap_bytes(m_counters); }
+
+			/**
+			 * @brief Get the name of the instruction set used for bulk operations
+			 * @return "avx2", "sse2" or "scalar"
+			 */
+			static auto simd_backend() -> const char* { return detail::frequency_simd_backend; }
+		};
+
+	} // namespace policies
+} // namespace cache_engine
@@ -0,0 +1,604 @@
+// File: inc/cache_engine/policies/inline_bytes_storage.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "policy_containers.hpp"
+#include "policy_interfaces.hpp"
+
+namespace cache_engine
+{
+	namespace policies
+	{
+		template <typename key_t, typename value_t> class inline_bytes_storage_policy;
+
+		/**
+		 * @brief Byte-string value that keeps up to 24 bytes inside the object
+		 *
+		 * 32 bytes: 24 payload bytes, a 32-bit size and flags. Longer strings
+		 * live out of line behind a pointer. A standalone inline_bytes owns
+		 * that memory; inside inline_bytes_storage_policy it borrows a block of
+		 * the policy's value heap instead. Copies always own their bytes, so
+		 * a value copied out of a cache stays valid after the entry is gone.
+		 */
+		class inline_bytes
+		{
+		  public:
+			static constexpr std::size_t inline_capacity = 24;
+
+		  private:
+			template <typename, typename> friend class inline_bytes_storage_policy;
+
+			static constexpr std::uint32_t owned_flag	 = 1U;
+			static constexpr std::uint32_t borrowed_flag = 2U;
+
+			union payload
+			{
+				char m_inline[inline_capacity];
+				char* m_heap;
+			};
+
+			payload m_payload;
+			std::uint32_t m_size;
+			std::uint32_t m_flags;
+
+		  public:
+			// Constructor: empty
+			inline_bytes() : m_payload(), m_size(0), m_flags(0) {}
+
+			// Constructor copying p_size bytes from p_data
+			inline_bytes(const char* p_data, std::size_t p_size) : m_payload(), m_size(0), m_flags(0) { this->assign(p_data, p_size); }
+
+			// Constructor copying a string
+			explicit inline_bytes(const std::string& p_text) : m_payload(), m_size(0), m_flags(0) { this->assign(p_text.data(), p_text.size()); }
+
+			// Destructor
+			~inline_bytes() { this->reset(); }
+
+			// Copy constructor and assignment operator: the copy owns its bytes
+			inline_bytes(const inline_bytes& p_other) : m_payload(), m_size(0), m_flags(0) { this->assign(p_other.data(), p_other.size()); }
+
+			auto operator=(const inline_bytes& p_other) -> inline_bytes&
+			{
+				if (this != &p_other)
+				{
+					inline_bytes copy(p_other);
+					*this = std::move(copy);
+				}
+				return *this;
+			}
+
+			// Move constructor and assignment operator: the bytes (owned or borrowed) move along
+			inline_bytes(inline_bytes&& p_other) noexcept : m_payload(p_other.m_payload), m_size(p_other.m_size), m_flags(p_other.m_flags)
+			{
+				p_other.m_size	= 0;
+				p_other.m_flags = 0;
+			}
+
+			auto operator=(inline_bytes&& p_other) noexcept -> inline_bytes&
+			{
+				if (this != &p_other)
+				{
+					this->reset();
+					m_payload		= p_other.m_payload;
+					m_size			= p_other.m_size;
+					m_flags			= p_other.m_flags;
+					p_other.m_size	= 0;
+					p_other.m_flags = 0;
+				}
+				return *this;
+			}
+
+			auto data() const -> const char* { return (m_flags == 0) ? m_payload.m_inline : m_payload.m_heap; }
+
+			auto size() const -> std::size_t { return m_size; }
+
+			auto empty() const -> bool { return m_size == 0; }
+
+			/**
+			 * @brief Whether the bytes are stored inside the object
+			 */
+			auto is_inline() const -> bool { return m_flags == 0; }
+
+			auto str() const -> std::string { return std::string(this->data(), m_size); }
+
+			auto operator==(const inline_bytes& p_other) const -> bool { return m_size == p_other.m_size && std::memcmp(this->data(), p_other.data(), m_size) == 0; }
+
+			auto operator!=(const inline_bytes& p_other) const -> bool { return !(*this == p_other); }
+
+		  private:
+			auto assign(const char* p_data, std::size_t p_size) -> void
+			{
+				if (p_size > std::size_t(UINT32_MAX))
+				{
+					throw std::length_error("inline_bytes value too large");
+				}
+				if (p_size <= inline_capacity)
+				{
+					if (p_size != 0)
+					{
+						std::memcpy(m_payload.m_inline, p_data, p_size);
+					}
+					m_flags = 0;
+				}
+				else
+				{
+					m_payload.m_heap = new char[p_size];
+					std::memcpy(m_payload.m_heap, p_data, p_size);
+					m_flags = owned_flag;
+				}
+				m_size = static_cast<std::uint32_t>(p_size);
+			}
+
+			auto reset() -> void
+			{
+				if (m_flags == owned_flag)
+				{
+					delete[] m_payload.m_heap;
+				}
+				m_size	= 0;
+				m_flags = 0;
+			}
+
+			// A value referring to a block it does not own
+			static auto borrow(char* p_block, std::size_t p_size) -> inline_bytes
+			{
+				inline_bytes result;
+				result.m_payload.m_heap = p_block;
+				result.m_size			= static_cast<std::uint32_t>(p_size);
+				result.m_flags			= borrowed_flag;
+				return result;
+			}
+		};
+
+		namespace detail
+		{
+			/**
+			 * @brief Size-class heap for the out-of-line values of one storage
+			 *
+			 * Blocks of 32 B to 4 KiB come from power-of-two classes carved out of
+			 * 64 KiB chunks and recycled through per-class free lists; larger
+			 * blocks go to operator new. Not synchronized.
+			 */
+			class value_heap
+			{
+			  private:
+				static constexpr std::size_t min_class_shift = 5;
+				static constexpr std::size_t class_count	 = 8;
+				static constexpr std::size_t chunk_bytes	 = std::size_t(64) << 10;
+
+				char* m_free_lists[class_count];
+				std::vector<std::unique_ptr<char[]>> m_chunks;
+				char* m_chunk_cursor;
+				std::size_t m_chunk_left;
+				std::size_t m_bytes_in_use;
+				std::size_t m_large_bytes;
+
+			  public:
+				// Constructor
+				value_heap() : m_free_lists(), m_chunks(), m_chunk_cursor(nullptr), m_chunk_left(0), m_bytes_in_use(0), m_large_bytes(0) {}
+
+				// Destructor
+				~value_heap() = default;
+
+				// Deleted copy constructor and assignment operator
+				value_heap(const value_heap&)					 = delete;
+				auto operator=(const value_heap&) -> value_heap& = delete;
+
+				auto allocate(std::size_t p_bytes) -> char*
+				{
+					const std::size_t class_idx = class_index(p_bytes);
+					m_bytes_in_use += block_bytes(class_idx, p_bytes);
+					if (class_idx == class_count)
+					{
+						m_large_bytes += p_bytes;
+						return new char[p_bytes];
+					}
+
+					char* block = m_free_lists[class_idx];
+					if (block != nullptr)
+					{
+						std::memcpy(&m_free_lists[class_idx], block, sizeof(char*));
+						return block;
+					}
+
+					const std::size_t bytes = block_bytes(class_idx, p_bytes);
+					if (m_chunk_left < bytes)
+					{
+						m_chunks.emplace_back(new char[chunk_bytes]);
+						m_chunk_cursor = m_chunks.back().get();
+						m_chunk_left   = chunk_bytes;
+					}
+					block = m_chunk_cursor;
+					m_chunk_cursor += bytes;
+					m_chunk_left -= bytes;
+					return block;
+				}
+
+				auto deallocate(char* p_block, std::size_t p_bytes) -> void
+				{
+					const std::size_t class_idx = class_index(p_bytes);
+					m_bytes_in_use -= block_bytes(class_idx, p_bytes);
+					if (class_idx == class_count)
+					{
+						m_large_bytes -= p_bytes;
+						delete[] p_block;
+						return;
+					}
+					std::memcpy(p_block, &m_free_lists[class_idx], sizeof(char*));
+					m_free_lists[class_idx] = p_block;
+				}
+
+				/**
+				 * @brief Drop every chunk; all pooled blocks must have been given back or abandoned
+				 */
+				auto release() -> void
+				{
+					m_chunks.clear();
+					for (std::size_t idx_for = 0; idx_for < class_count; ++idx_for)
+					{
+						m_free_lists[idx_for] = nullptr;
+					}
+					m_chunk_cursor = nullptr;
+					m_chunk_left   = 0;
+					m_bytes_in_use = 0;
+					m_large_bytes  = 0;
+				}
+
+				/**
+				 * @brief Bytes of the live blocks, rounded to their size classes
+				 */
+				auto bytes_in_use() const -> std::size_t { return m_bytes_in_use; }
+
+				/**
+				 * @brief Bytes reserved in chunks, live or free
+				 */
+				auto chunk_bytes_reserved() const -> std::size_t { return m_chunks.size() * chunk_bytes; }
+
+				/**
+				 * @brief Bytes taken from operator new: the chunks plus the blocks too large for a size class
+				 */
+				auto reserved_bytes() const -> std::size_t { return m_chunks.size() * chunk_bytes + m_large_bytes; }
+
+			  private:
+				// Class of a block, class_count for blocks served by operator new
+				static auto class_index(std::size_t p_bytes) -> std::size_t
+				{
+					std::size_t class_idx = 0;
+					while (class_idx < class_count && (std::size_t(1) << (class_idx + min_class_shift)) < p_bytes)
+					{
+						++class_idx;
+					}
+					return class_idx;
+				}
+
+				static auto block_bytes(std::size_t p_class, std::size_t p_bytes) -> std::size_t
+				{
+					return (p_class == class_count) ? p_bytes : std::size_t(1) << (p_class + min_class_shift);
+				}
+			};
+		} // namespace detail
+
+		/**
+		 * @brief Open-addressing storage that keeps small values in the slot and large ones in a value heap
+		 *
+		 * Each slot holds the key and a 32-byte inline_bytes: values up to 24
+		 * bytes sit in the slot itself, longer ones in a block of a size-class
+		 * value heap that the slot refers to. A parallel array of one-byte
+		 * control words (empty, or seven hash bits) is scanned first, so a
+		 * probe reads control bytes and the slots whose fingerprint matches,
+		 * never the out-of-line values. Linear probing with backward-shift
+		 * deletion keeps the table free of tombstones; it doubles at 3/4 load.
+		 *
+		 * Pointers from find() stay valid until the next insert, erase or
+		 * clear. Values must not be assigned through them: a stored value
+		 * borrows its heap block, and only the policy may give it back.
+		 *
+		 * Time Complexity: insert, find, erase and contains O(1) average
+		 * Space Complexity: O(n) slots of sizeof(key_t) + 32 bytes, plus the out-of-line bytes
+		 */
+		template <typename key_t, typename value_t> class inline_bytes_storage_policy : public storage_policy_base<key_t, value_t>
+		{
+			static_assert(std::is_same<value_t, inline_bytes>::value, "inline_bytes_storage_policy stores inline_bytes values");
+
+		  public:
+			using self_t = inline_bytes_storage_policy<key_t, value_t>;
+			using base_t = storage_policy_base<key_t, value_t>;
+
+		  private:
+			static constexpr std::size_t npos		   = static_cast<std::size_t>(-1);
+			static constexpr std::size_t min_slots	   = 16;
+			static constexpr std::uint8_t occupied_bit = 0x80U;
+
+			struct slot
+			{
+				key_t m_key;
+				inline_bytes m_value;
+			};
+
+			std::vector<std::uint8_t> m_control;
+			std::vector<slot> m_slots;
+			std::size_t m_mask;
+			std::size_t m_size;
+			std::size_t m_out_of_line;
+			std::unique_ptr<detail::value_heap> m_heap;
+
+		  public:
+			// Constructor
+			inline_bytes_storage_policy() : m_control(), m_slots(), m_mask(0), m_size(0), m_out_of_line(0), m_heap(new detail::value_heap()) { this->rehash(min_slots); }
+
+			// Constructor sized for the cache capacity
+			explicit inline_bytes_storage_policy(const containers::policy_context& p_context)
+				: m_control(), m_slots(), m_mask(0), m_size(0), m_out_of_line(0), m_heap(new detail::value_heap())
+			{
+				this->rehash(slots_for(p_context.capacity()));
+			}
+
+			// Destructor
+			~inline_bytes_storage_policy() override { this->release_values(); }
+
+			// Move constructor and assignment operator
+			inline_bytes_storage_policy(self_t&& p_other) noexcept
+				: m_control(std::move(p_other.m_control)), m_slots(std::move(p_other.m_slots)), m_mask(p_other.m_mask), m_size(p_other.m_size), m_out_of_line(p_other.m_out_of_line),
+				  m_heap(std::move(p_other.m_heap))
+			{
+				p_other.m_mask		  = 0;
+				p_other.m_size		  = 0;
+				p_other.m_out_of_line = 0;
+			}
+
+			auto operator=(self_t&& p_other) noexcept -> self_t&
+			{
+				if (this != &p_other)
+				{
+					this->release_values();
+					m_control			  = std::move(p_other.m_control);
+					m_slots				  = std::move(p_other.m_slots);
+					m_mask				  = p_other.m_mask;
+					m_size				  = p_other.m_size;
+					m_out_of_line		  = p_other.m_out_of_line;
+					m_heap				  = std::move(p_other.m_heap);
+					p_other.m_mask		  = 0;
+					p_other.m_size		  = 0;
+					p_other.m_out_of_line = 0;
+				}
+				return *this;
+			}
+
+		  public:
+			auto insert(const key_t& p_key, const value_t& p_value) -> bool override
+			{
+				if ((m_size + 1) * 4 > m_slots.size() * 3)
+				{
+					this->rehash(m_slots.size() * 2);
+				}
+
+				const std::size_t hash = hash_of(p_key);
+				const std::uint8_t tag = tag_of(hash);
+				std::size_t idx		   = home_of(hash);
+				while (m_control[idx] != 0)
+				{
+					if (m_control[idx] == tag && m_slots[idx].m_key == p_key)
+					{
+						this->release_value(m_slots[idx]);
+						this->store_value(m_slots[idx], p_value);
+						return false;
+					}
+					idx = (idx + 1) & m_mask;
+				}
+
+				m_control[idx]	   = tag;
+				m_slots[idx].m_key = p_key;
+				this->store_value(m_slots[idx], p_value);
+				++m_size;
+				return true;
+			}
+
+			auto find(const key_t& p_key) -> value_t* override
+			{
+				const std::size_t idx = this->index_of(p_key);
+				return (idx != npos) ? &m_slots[idx].m_value : nullptr;
+			}
+
+			auto find(const key_t& p_key) const -> const value_t* override
+			{
+				const std::size_t idx = this->index_of(p_key);
+				return (idx != npos) ? &m_slots[idx].m_value : nullptr;
+			}
+
+			auto erase(const key_t& p_key) -> bool override
+			{
+				const std::size_t idx = this->index_of(p_key);
+				if (idx == npos)
+				{
+					return false;
+				}
+				this->release_value(m_slots[idx]);
+
+				// Backward shift: pull later entries of the run into the hole when their home allows it
+				std::size_t hole = idx;
+				std::size_t next = (hole + 1) & m_mask;
+				while (m_control[next] != 0)
+				{
+					const std::size_t home = home_of(hash_of(m_slots[next].m_key));
+					if (((next - home) & m_mask) >= ((next - hole) & m_mask))
+					{
+						m_control[hole]		  = m_control[next];
+						m_slots[hole].m_key	  = std::move(m_slots[next].m_key);
+						m_slots[hole].m_value = std::move(m_slots[next].m_value);
+						hole				  = next;
+					}
+					next = (next + 1) & m_mask;
+				}
+				m_control[hole]		= 0;
+				m_slots[hole].m_key = key_t();
+				--m_size;
+				return true;
+			}
+
+			auto contains(const key_t& p_key) const -> bool override { return this->index_of(p_key) != npos; }
+
+			auto size() const -> std::size_t override { return m_size; }
+
+			auto empty() const -> bool override { return m_size == 0; }
+
+			auto clear() -> void override
+			{
+				this->release_values();
+				for (std::size_t idx_for = 0; idx_for < m_slots.size(); ++idx_for)
+				{
+					m_control[idx_for]		 = 0;
+					m_slots[idx_for].m_key	 = key_t();
+					m_slots[idx_for].m_value = inline_bytes();
+				}
+				m_size = 0;
+			}
+
+			auto visit_partition(std::size_t p_partition, std::size_t p_partition_count, const typename base_t::entry_visitor& p_visitor) const -> void override
+			{
+				const std::size_t first = m_slots.size() * p_partition / p_partition_count;
+				const std::size_t last	= m_slots.size() * (p_partition + 1) / p_partition_count;
+				for (std::size_t idx_for = first; idx_for < last; ++idx_for)
+				{
+					if (m_control[idx_for] != 0)
+					{
+						p_visitor(m_slots[idx_for].m_key, m_slots[idx_for].m_value);
+					}
+				}
+			}
+
+			// The slot array is the node storage here, and out-of-line values live in the value heap
+			auto node_bytes() const -> std::size_t override { return m_slots.capacity() * sizeof(slot) + (m_heap ? m_heap->reserved_bytes() : 0); }
+
+			auto bucket_bytes() const -> std::size_t override { return m_control.capacity(); }
+
+		  public:
+			/**
+			 * @brief Number of slots (a power of two)
+			 */
+			auto slot_count() const -> std::size_t { return m_slots.size(); }
+
+			/**
+			 * @brief Number of values stored out of line
+			 */
+			auto out_of_line_count() const -> std::size_t { return m_out_of_line; }
+
+			/**
+			 * @brief Bytes of the live out-of-line blocks, rounded to their size classes
+			 */
+			auto heap_bytes() const -> std::size_t { return m_heap ? m_heap->bytes_in_use() : 0; }
+
+		  private:
+			static auto hash_of(const key_t& p_key) -> std::size_t
+			{
+				// std::hash of integers is the identity; spread it before taking the low bits
+				const std::uint64_t mixed = static_cast<std::uint64_t>(std::hash<key_t>()(p_key)) * 0x9E3779B97F4A7C15ULL;
+				return static_cast<std::size_t>(mixed ^ (mixed >> 29U));
+			}
+
+			static auto tag_of(std::size_t p_hash) -> std::uint8_t { return static_cast<std::uint8_t>(occupied_bit | (p_hash & 0x7FU)); }
+
+			auto home_of(std::size_t p_hash) const -> std::size_t { return (p_hash >> 7U) & m_mask; }
+
+			static auto slots_for(std::size_t p_capacity) -> std::size_t
+			{
+				std::size_t slots = min_slots;
+				while (slots * 3 < p_capacity * 4)
+				{
+					slots *= 2;
+				}
+				return slots;
+			}
+
+			auto index_of(const key_t& p_key) const -> std::size_t
+			{
+				const std::size_t hash = hash_of(p_key);
+				const std::uint8_t tag = tag_of(hash);
+				for (std::size_t idx = home_of(hash); m_control[idx] != 0; idx = (idx + 1) & m_mask)
+				{
+					if (m_control[idx] == tag && m_slots[idx].m_key == p_key)
+					{
+						return idx;
+					}
+				}
+				return npos;
+			}
+
+			auto store_value(slot& p_slot, const value_t& p_value) -> void
+			{
+				if (p_value.size() <= inline_bytes::inline_capacity)
+				{
+					p_slot.m_value = inline_bytes(p_value.data(), p_value.size());
+					return;
+				}
+				char* block = m_heap->allocate(p_value.size());
+				std::memcpy(block, p_value.data(), p_value.size());
+				p_slot.m_value = inline_bytes::borrow(block, p_value.size());
+				++m_out_of_line;
+			}
+
+			auto release_value(slot& p_slot) -> void
+			{
+				if (p_slot.m_value.m_flags == inline_bytes::borrowed_flag)
+				{
+					m_heap->deallocate(p_slot.m_value.m_payload.m_heap, p_slot.m_value.size());
+					--m_out_of_line;
+				}
+				p_slot.m_value = inline_bytes();
+			}
+
+			// Give back every out-of-line block; slots keep stale handles until reset
+			auto release_values() -> void
+			{
+				if (!m_heap)
+				{
+					return;
+				}
+				for (std::size_t idx_for = 0; idx_for < m_slots.size(); ++idx_for)
+				{
+					if (m_control[idx_for] != 0)
+					{
+						this->release_value(m_slots[idx_for]);
+					}
+				}
+				m_heap->release();
+			}
+
+			auto rehash(std::size_t p_slot_count) -> void
+			{
+				std::vector<std::uint8_t> old_control(p_slot_count, 0);
+				std::vector<slot> old_slots(p_slot_count);
+				old_control.swap(m_control);
+				old_slots.swap(m_slots);
+				m_mask = p_slot_count - 1;
+
+				// Moving a slot moves its heap handle, so no value is copied
+				for (std::size_t idx_for = 0; idx_for < old_slots.size(); ++idx_for)
+				{
+					if (old_control[idx_for] == 0)
+					{
+						continue;
+					}
+					std::size_t idx = home_of(hash_of(old_slots[idx_for].m_key));
+					while (m_control[idx] != 0)
+					{
+						idx = (idx + 1) & m_mask;
+					}
+					m_control[idx]		 = old_control[idx_for];
+					m_slots[idx].m_key	 = std::move(old_slots[idx_for].m_key);
+					m_slots[idx].m_value = std::move(old_slots[idx_for].m_value);
+				}
+			}
+		};
+	} // namespace policies
+} // namespace cache_engine
@@ -0,0 +1,362 @@
+// File: inc/cache_engine/policies/policy_containers.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <queue>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(CACHE_ENGINE_PMR)
+#if __cplusplus < 201703L
+#error "CACHE_ENGINE_PMR requires C++17 (link against cache_engine_pmr)"
+#endif
+#include <memory_resource>
+#endif
+
+namespace cache_engine
+{
+	namespace policies
+	{
+		/**
+		 * @brief Container aliases used for all policy state
+		 *
+		 * In the default C++11 build these are the plain standard containers.
+		 * With CACHE_ENGINE_PMR defined (C++17) they switch to polymorphic
+		 * allocators, and every policy that owns containers gains a constructor
+		 * taking a std::pmr::memory_resource*, so a whole cache can be placed in
+		 * a single arena (see cache_engine/memory/cache_arena.hpp).
+		 */
+		namespace containers
+		{
+#if defined(CACHE_ENGINE_PMR)
+			using memory_resource = std::pmr::memory_resource;
+
+			template <typename value_t> using allocator = std::pmr::polymorphic_allocator<value_t>;
+#else
+			template <typename value_t> using allocator = std::allocator<value_t>;
+#endif
+
+			template <typename value_t> using vector = std::vector<value_t, allocator<value_t>>;
+
+			template <typename value_t> using list = std::list<value_t, allocator<value_t>>;
+
+			template <typename value_t> using deque = std::deque<value_t, allocator<value_t>>;
+
+			template <typename value_t> using queue = std::queue<value_t, deque<value_t>>;
+
+			template <typename key_t, typename mapped_t> using map = std::map<key_t, mapped_t, std::less<key_t>, allocator<std::pair<const key_t, mapped_t>>>;
+
+			template <typename key_t, typename mapped_t>
+			using unordered_map = std::unordered_map<key_t, mapped_t, std::hash<key_t>, std::equal_to<key_t>, allocator<std::pair<const key_t, mapped_t>>>;
+
+			/**
+			 * @brief Everything a policy needs to size itself at construction
+			 *
+			 * policy_based_cache hands the same context to its eviction, storage
+			 * and access policies. Policies reserve their hash tables and vectors
+			 * for capacity() entries so that warming up to capacity performs no
+			 * rehash or reallocation, and allocate through get_allocator(). The
+			 * expected key and value sizes default to sizeof and can be raised for
+			 * types that own heap memory (strings, vectors) to size pools and arenas.
+			 */
+			class policy_context
+			{
+			  private:
+				std::size_t m_capacity;
+				std::size_t m_key_bytes;
+				std::size_t m_value_bytes;
+#if defined(CACHE_ENGINE_PMR)
+				memory_resource* m_resource = nullptr;
+#endif
+
+			  public:
+				// Constructor
+				explicit policy_context(std::size_t p_capacity, std::size_t p_key_bytes = 0, std::size_t p_value_bytes = 0)
+					: m_capacity(p_capacity), m_key_bytes(p_key_bytes), m_value_bytes(p_value_bytes)
+				{
+				}
+
+#if defined(CACHE_ENGINE_PMR)
+				// Constructor for policies allocating from a memory resource
+				policy_context(std::size_t p_capacity, memory_resource* p_resource, std::size_t p_key_bytes = 0, std::size_t p_value_bytes = 0)
+					: m_capacity(p_capacity), m_key_bytes(p_key_bytes), m_value_bytes(p_value_bytes), m_resource(p_resource)
+				{
+				}
+
+				/**
+				 * @brief Get the resource policy containers allocate from
+				 * @return The configured resource, or the default resource when none was given
+				 */
+				auto resource() const -> memory_resource* { return (m_resource != nullptr) ? m_resource : std::pmr::get_default_resource(); }
+#endif
+
+			  public:
+				/**
+				 * @brief Get the number of entries policies should be sized for
+				 * @return The expected maximum entry count
+				 */
+				auto capacity() const -> std::size_t { return m_capacity; }
+
+				auto key_bytes() const -> std::size_t { return m_key_bytes; }
+
+				auto value_bytes() const -> std::size_t { return m_value_bytes; }
+
+				/**
+				 * @brief Estimate the payload of a full cache, e.g. to size a cache_arena
+				 * @return capacity() times the expected key plus value bytes
+				 */
+				auto expected_payload_bytes() const -> std::size_t { return m_capacity * (m_key_bytes + m_value_bytes); }
+
+				/**
+				 * @brief Get an allocator for policy containers; converts to any containers::allocator<T>
+				 * @return The allocator
+				 */
+				auto get_allocator() const -> allocator<unsigned char>
+				{
+#if defined(CACHE_ENGINE_PMR)
+					return allocator<unsigned char>(this->resource());
+#else
+					return allocator<unsigned char>();
+#endif
+				}
+			};
+
+			/**
+			 * @brief Build a context sized for key_t and value_t
+			 * @param p_capacity The expected maximum entry count
+			 * @return The context
+			 */
+			template <typename key_t, typename value_t> auto make_policy_context(std::size_t p_capacity) -> policy_context
+			{
+				return policy_context(p_capacity, sizeof(key_t), sizeof(value_t));
+			}
+
+#if defined(CACHE_ENGINE_PMR)
+			template <typename key_t, typename value_t> auto make_policy_context(std::size_t p_capacity, memory_resource* p_resource) -> policy_context
+			{
+				return policy_context(p_capacity, p_resource, sizeof(key_t), sizeof(value_t));
+			}
+
+			/**
+			 * @brief Construct a policy on a memory resource when it supports one
+			 *
+			 * Policies without containers (or third-party policies without a
+			 * resource constructor) are default constructed instead.
+			 *
+			 * @param p_resource The resource the policy's containers allocate from
+			 * @return The newly constructed policy
+			 */
+			template <typename policy_t> auto make_policy(memory_resource* p_resource) -> std::unique_ptr<policy_t>
+			{
+				if constexpr (std::is_constructible<policy_t, memory_resource*>::value)
+				{
+					return std::unique_ptr<policy_t>(new policy_t(p_resource));
+				}
+				else
+				{
+					static_cast<void>(p_resource);
+					return std::unique_ptr<policy_t>(new policy_t());
+				}
+			}
+#endif
+
+			namespace detail
+			{
+				template <typename policy_t> auto make_policy_from_context(const policy_context& p_context, std::true_type) -> std::unique_ptr<policy_t>
+				{
+					return std::unique_ptr<policy_t>(new policy_t(p_context));
+				}
+
+				template <typename policy_t> auto make_policy_from_context(const policy_context& p_context, std::false_type) -> std::unique_ptr<policy_t>
+				{
+#if defined(CACHE_ENGINE_PMR)
+					return make_policy<policy_t>(p_context.resource());
+#else
+					static_cast<void>(p_context);
+					return std::unique_ptr<policy_t>(new policy_t());
+#endif
+				}
+			} // namespace detail
+
+			/**
+			 * @brief Construct a policy from a construction context when it accepts one
+			 *
+			 * Policies without a context constructor fall back to the memory
+			 * resource constructor (PMR builds) or the default constructor, so
+			 * third-party policies keep working unchanged.
+			 *
+			 * @param p_context The construction context
+			 * @return The newly constructed policy
+			 */
+			template <typename policy_t> auto make_policy(const policy_context& p_context) -> std::unique_ptr<policy_t>
+			{
+				return detail::make_policy_from_context<policy_t>(p_context, std::integral_constant<bool, std::is_constructible<policy_t, const policy_context&>::value>());
+			}
+
+			namespace detail
+			{
+				template <typename policy_t> auto entry_capacity_of(std::size_t p_argument, int) -> decltype(policy_t::entry_capacity(p_argument))
+				{
+					return policy_t::entry_capacity(p_argument);
+				}
+
+				template <typename policy_t> auto entry_capacity_of(std::size_t p_argument, long) -> std::size_t { return p_argument; }
+			} // namespace detail
+
+			/**
+			 * @brief Translate a capacity policy's constructor argument into an entry count
+			 *
+			 * Capacity policies whose argument is not an entry count (a byte
+			 * limit, say) provide a static entry_capacity(std::size_t); for
+			 * all others the argument is the entry count.
+			 *
+			 * @param p_argument The capacity policy's constructor argument
+			 * @return The number of entries the other policies should be sized for
+			 */
+			template <typename capacity_policy_t> auto entry_capacity(std::size_t p_argument) -> std::size_t
+			{
+				return detail::entry_capacity_of<capacity_policy_t>(p_argument, 0);
+			}
+
+			/**
+			 * @brief Visit the entries of one bucket range of an unordered map
+			 *
+			 * The buckets are split into p_partition_count contiguous ranges; the
+			 * ranges cover every entry exactly once and can be walked from
+			 * different threads while the map is not modified.
+			 *
+			 * @param p_map The map
+			 * @param p_partition Index of the range to visit
+			 * @param p_partition_count Number of ranges
+			 * @param p_visitor Called with (key, value) for every entry in the range
+			 */
+			template <typename map_t, typename visitor_t>
+			auto visit_bucket_range(const map_t& p_map, std::size_t p_partition, std::size_t p_partition_count, const visitor_t& p_visitor) -> void
+			{
+				const std::size_t buckets = p_map.bucket_count();
+				const std::size_t first	  = buckets * p_partition / p_partition_count;
+				const std::size_t last	  = buckets * (p_partition + 1) / p_partition_count;
+
+				for (std::size_t idx_bucket = first; idx_bucket < last; ++idx_bucket)
+				{
+					for (auto iter = p_map.begin(idx_bucket); iter != p_map.end(idx_bucket); ++iter)
+					{
+						p_visitor(iter->first, iter->second);
+					}
+				}
+			}
+
+			/**
+			 * @brief Heap footprint estimates for the containers above, used by memory_usage()
+			 *
+			 * Node sizes follow the libstdc++ layouts; other standard libraries
+			 * differ by at most a pointer per node. List nodes carry two links,
+			 * tree nodes three links and a colour, hash nodes one link plus the
+			 * cached hash code for keys whose hash is not trivially cheap.
+			 * Allocator headers and arena slack are not counted. Everything is
+			 * O(1): it only reads size(), capacity() and bucket_count().
+			 */
+			namespace detail
+			{
+				constexpr auto round_up(std::size_t p_bytes, std::size_t p_alignment) -> std::size_t { return (p_bytes + p_alignment - 1) / p_alignment * p_alignment; }
+
+				// Node holding p_links pointers (plus p_header_extra bytes) followed by the element
+				template <typename element_t> constexpr auto node_bytes(std::size_t p_links, std::size_t p_header_extra) -> std::size_t
+				{
+					return round_up(round_up(p_links * sizeof(void*) + p_header_extra, alignof(element_t)) + sizeof(element_t),
+									(alignof(element_t) > alignof(void*)) ? alignof(element_t) : alignof(void*));
+				}
+
+				// libstdc++ keeps 512-byte blocks (or one element) plus a map of at least 8 block pointers
+				template <typename element_t> auto deque_bytes(std::size_t p_size) -> std::size_t
+				{
+					const std::size_t per_block = (sizeof(element_t) < 512) ? 512 / sizeof(element_t) : 1;
+					const std::size_t blocks	= p_size / per_block + 1;
+					return blocks * per_block * sizeof(element_t) + ((blocks + 2 > 8) ? blocks + 2 : 8) * sizeof(void*);
+				}
+			} // namespace detail
+
+			/**
+			 * @brief Bytes of one std::list node holding an element_t
+			 */
+			template <typename element_t> constexpr auto list_node_bytes() -> std::size_t { return detail::node_bytes<element_t>(2, 0); }
+
+			/**
+			 * @brief Bytes of one std::map node holding a (key_t, mapped_t) pair
+			 */
+			template <typename key_t, typename mapped_t> constexpr auto map_node_bytes() -> std::size_t
+			{
+				return detail::node_bytes<std::pair<const key_t, mapped_t>>(3, sizeof(void*));
+			}
+
+			/**
+			 * @brief Bytes of one std::unordered_map node holding a (key_t, mapped_t) pair
+			 */
+			template <typename key_t, typename mapped_t> constexpr auto hash_node_bytes() -> std::size_t
+			{
+				return detail::node_bytes<std::pair<const key_t, mapped_t>>(1, 0) + (std::is_scalar<key_t>::value ? 0 : sizeof(std::size_t));
+			}
+
+			template <typename element_t, typename allocator_t> auto heap_bytes(const std::vector<element_t, allocator_t>& p_vector) -> std::size_t
+			{
+				return p_vector.capacity() * sizeof(element_t);
+			}
+
+			template <typename element_t, typename allocator_t> auto heap_bytes(const std::list<element_t, allocator_t>& p_list) -> std::size_t
+			{
+				return p_list.size() * list_node_bytes<element_t>();
+			}
+
+			template <typename element_t, typename allocator_t> auto heap_bytes(const std::deque<element_t, allocator_t>& p_deque) -> std::size_t
+			{
+				return detail::deque_bytes<element_t>(p_deque.size());
+			}
+
+			template <typename element_t, typename allocator_t> auto heap_bytes(const std::queue<element_t, std::deque<element_t, allocator_t>>& p_queue) -> std::size_t
+			{
+				return detail::deque_bytes<element_t>(p_queue.size());
+			}
+
+			/**
+			 * @brief Bytes of the nodes of a std::map; heap owned by the mapped values themselves is not included
+			 */
+			template <typename key_t, typename mapped_t, typename compare_t, typename allocator_t>
+			auto heap_bytes(const std::map<key_t, mapped_t, compare_t, allocator_t>& p_map) -> std::size_t
+			{
+				return p_map.size() * map_node_bytes<key_t, mapped_t>();
+			}
+
+			/**
+			 * @brief Bytes of the nodes of a std::unordered_map, without its bucket array
+			 */
+			template <typename key_t, typename mapped_t, typename hash_t, typename equal_t, typename allocator_t>
+			auto node_bytes(const std::unordered_map<key_t, mapped_t, hash_t, equal_t, allocator_t>& p_map) -> std::size_t
+			{
+				return p_map.size() * hash_node_bytes<key_t, mapped_t>();
+			}
+
+			/**
+			 * @brief Bytes of the bucket array of a std::unordered_map (a single bucket lives inside the map object)
+			 */
+			template <typename key_t, typename mapped_t, typename hash_t, typename equal_t, typename allocator_t>
+			auto bucket_bytes(const std::unordered_map<key_t, mapped_t, hash_t, equal_t, allocator_t>& p_map) -> std::size_t
+			{
+				return (p_map.bucket_count() > 1) ? p_map.bucket_count() * sizeof(void*) : 0;
+			}
+
+			template <typename key_t, typename mapped_t, typename hash_t, typename equal_t, typename allocator_t>
+			auto heap_bytes(const std::unordered_map<key_t, mapped_t, hash_t, equal_t, allocator_t>& p_map) -> std::size_t
+			{
+				return node_bytes(p_map) + bucket_bytes(p_map);
+			}
+		} // namespace containers
+	} // namespace policies
+} // namespace cache_engine
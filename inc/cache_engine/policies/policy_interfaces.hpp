@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 
@@ -96,6 +97,12 @@ namespace cache_engine
 			 * @brief Clear all tracked keys
 			 */
 			virtual auto clear() -> void = 0;
+
+			/**
+			 * @brief Get the heap bytes held by the policy's bookkeeping (lists, maps, vectors)
+			 * @return The estimated bytes; policies that do not report their usage return 0
+			 */
+			virtual auto memory_usage() const -> std::size_t { return 0; }
 		};
 
 		/**
@@ -110,9 +117,10 @@ namespace cache_engine
 		template <typename key_t, typename value_t> class storage_policy_base
 		{
 		  public:
-			using self_t	 = storage_policy_base<key_t, value_t>;
-			using key_type	 = key_t;
-			using value_type = value_t;
+			using self_t		= storage_policy_base<key_t, value_t>;
+			using key_type		= key_t;
+			using value_type	= value_t;
+			using entry_visitor = std::function<void(const key_t&, const value_t&)>;
 
 		  public:
 			// Virtual destructor for proper cleanup
@@ -183,6 +191,43 @@ namespace cache_engine
 			 * @brief Clear all stored entries
 			 */
 			virtual auto clear() -> void = 0;
+
+			/**
+			 * @brief Visit every entry of one partition of the storage
+			 *
+			 * The storage is split into p_partition_count disjoint partitions
+			 * that together hold every entry exactly once. Different partitions
+			 * may be visited from different threads at the same time, provided
+			 * nothing modifies the storage meanwhile.
+			 *
+			 * Storage policies that cannot enumerate their entries keep this
+			 * default; for_each and erase_if of a cache over them then throw,
+			 * and so does set_heap_size_function once the cache holds entries.
+			 *
+			 * @param p_partition Index of the partition to visit, below p_partition_count
+			 * @param p_partition_count Number of partitions
+			 * @param p_visitor Called with (key, value) for every entry of the partition
+			 * @throws std::logic_error unless overridden
+			 */
+			virtual auto visit_partition(std::size_t p_partition, std::size_t p_partition_count, const entry_visitor& p_visitor) const -> void
+			{
+				static_cast<void>(p_partition);
+				static_cast<void>(p_partition_count);
+				static_cast<void>(p_visitor);
+				throw std::logic_error("Storage policy does not support visiting its entries");
+			}
+
+			/**
+			 * @brief Get the heap bytes of the entry nodes, keys and values stored inline
+			 * @return The estimated bytes; policies that do not report their usage return 0
+			 */
+			virtual auto node_bytes() const -> std::size_t { return 0; }
+
+			/**
+			 * @brief Get the heap bytes of the bucket (or slot index) arrays
+			 * @return The estimated bytes; policies that do not report their usage return 0
+			 */
+			virtual auto bucket_bytes() const -> std::size_t { return 0; }
 		};
 
 		/**
@@ -232,6 +277,12 @@ namespace cache_engine
 			 * @return true if the miss should be recorded
 			 */
 			virtual auto on_miss(const key_t& p_key) -> bool = 0;
+
+			/**
+			 * @brief Get the heap bytes held by the policy's per-key state
+			 * @return The estimated bytes; stateless policies return 0
+			 */
+			virtual auto memory_usage() const -> std::size_t { return 0; }
 		};
 
 		/**
@@ -1,7 +1,7 @@
 #pragma once
 
+#include "policy_containers.hpp"
 #include "policy_interfaces.hpp"
-#include <unordered_map>
 #include <stdexcept>
 
 namespace cache_engine
@@ -29,12 +29,20 @@ namespace cache_engine
 			using base_t = storage_policy_base<key_t, value_t>;
 
 		  private:
-			std::unordered_map<key_t, value_t> m_storage;
+			containers::unordered_map<key_t, value_t> m_storage;
 
 		  public:
 			// Constructor
 			hash_storage_policy() = default;
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit hash_storage_policy(containers::memory_resource* p_resource) : m_storage(p_resource) {}
+#endif
+
+			// Constructor sized for the cache capacity
+			explicit hash_storage_policy(const containers::policy_context& p_context) : m_storage(p_context.get_allocator()) { m_storage.reserve(p_context.capacity()); }
+
 			// Destructor
 			~hash_storage_policy() override = default;
 
@@ -79,6 +87,21 @@ namespace cache_engine
 			auto empty() const -> bool override { return m_storage.empty(); }
 
 			auto clear() -> void override { m_storage.clear(); }
+
+			auto visit_partition(std::size_t p_partition, std::size_t p_partition_count, const typename base_t::entry_visitor& p_visitor) const -> void override
+			{
+				containers::visit_bucket_range(m_storage, p_partition, p_partition_count, p_visitor);
+			}
+
+			auto node_bytes() const -> std::size_t override { return containers::node_bytes(m_storage); }
+
+			auto bucket_bytes() const -> std::size_t override { return containers::bucket_bytes(m_storage); }
+
+			/**
+			 * @brief Get the number of hash buckets, fixed while the cache fills up to its reserved capacity
+			 * @return The bucket count
+			 */
+			auto bucket_count() const -> std::size_t { return m_storage.bucket_count(); }
 		};
 
 		/**
@@ -97,13 +120,27 @@ namespace cache_engine
 			using base_t = storage_policy_base<key_t, value_t>;
 
 		  private:
-			std::unordered_map<key_t, value_t> m_storage;
+			containers::unordered_map<key_t, value_t> m_storage;
 			std::size_t m_reserved_capacity;
 
 		  public:
 			// Constructor with capacity hint
 			explicit reserved_hash_storage_policy(std::size_t p_capacity = 100) : m_reserved_capacity(p_capacity) { m_storage.reserve(m_reserved_capacity); }
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit reserved_hash_storage_policy(containers::memory_resource* p_resource, std::size_t p_capacity = 100) : m_storage(p_resource), m_reserved_capacity(p_capacity)
+			{
+				m_storage.reserve(m_reserved_capacity);
+			}
+#endif
+
+			// Constructor reserving the real cache capacity instead of the default hint
+			explicit reserved_hash_storage_policy(const containers::policy_context& p_context) : m_storage(p_context.get_allocator()), m_reserved_capacity(p_context.capacity())
+			{
+				m_storage.reserve(m_reserved_capacity);
+			}
+
 			// Destructor
 			~reserved_hash_storage_policy() override = default;
 
@@ -154,6 +191,21 @@ namespace cache_engine
 				m_storage.reserve(m_reserved_capacity);
 			}
 
+			auto visit_partition(std::size_t p_partition, std::size_t p_partition_count, const typename base_t::entry_visitor& p_visitor) const -> void override
+			{
+				containers::visit_bucket_range(m_storage, p_partition, p_partition_count, p_visitor);
+			}
+
+			auto node_bytes() const -> std::size_t override { return containers::node_bytes(m_storage); }
+
+			auto bucket_bytes() const -> std::size_t override { return containers::bucket_bytes(m_storage); }
+
+			/**
+			 * @brief Get the number of hash buckets, fixed while the cache fills up to its reserved capacity
+			 * @return The bucket count
+			 */
+			auto bucket_count() const -> std::size_t { return m_storage.bucket_count(); }
+
 		  public:
 			/**
 			 * @brief Set the reserved capacity for the hash table
@@ -188,7 +240,7 @@ namespace cache_engine
 			using base_t = storage_policy_base<key_t, value_t>;
 
 		  private:
-			std::unordered_map<key_t, value_t> m_storage;
+			containers::unordered_map<key_t, value_t> m_storage;
 
 		  public:
 			// Constructor
@@ -198,6 +250,18 @@ namespace cache_engine
 				m_storage.max_load_factor(0.75F); // Reduce memory usage
 			}
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor allocating from a memory resource
+			explicit compact_storage_policy(containers::memory_resource* p_resource) : m_storage(p_resource) { m_storage.max_load_factor(0.75F); }
+#endif
+
+			// Constructor sized for the cache capacity at the compact load factor
+			explicit compact_storage_policy(const containers::policy_context& p_context) : m_storage(p_context.get_allocator())
+			{
+				m_storage.max_load_factor(0.75F);
+				m_storage.reserve(p_context.capacity());
+			}
+
 			// Destructor
 			~compact_storage_policy() override = default;
 
@@ -258,6 +322,21 @@ namespace cache_engine
 				m_storage.clear();
 				m_storage.rehash(0); // Minimize memory usage
 			}
+
+			auto visit_partition(std::size_t p_partition, std::size_t p_partition_count, const typename base_t::entry_visitor& p_visitor) const -> void override
+			{
+				containers::visit_bucket_range(m_storage, p_partition, p_partition_count, p_visitor);
+			}
+
+			auto node_bytes() const -> std::size_t override { return containers::node_bytes(m_storage); }
+
+			auto bucket_bytes() const -> std::size_t override { return containers::bucket_bytes(m_storage); }
+
+			/**
+			 * @brief Get the number of hash buckets, fixed while the cache fills up to its reserved capacity
+			 * @return The bucket count
+			 */
+			auto bucket_count() const -> std::size_t { return m_storage.bucket_count(); }
 		};
 
 		/**
@@ -287,6 +366,20 @@ namespace cache_engine
 			// Constructor
 			debug_storage_policy() : m_wrapped_policy(std::unique_ptr<wrapped_t>(new wrapped_t())), m_operation_count(0), m_hit_count(0), m_miss_count(0) {}
 
+#if defined(CACHE_ENGINE_PMR)
+			// Constructor forwarding a memory resource to the wrapped policy
+			explicit debug_storage_policy(containers::memory_resource* p_resource)
+				: m_wrapped_policy(containers::make_policy<wrapped_t>(p_resource)), m_operation_count(0), m_hit_count(0), m_miss_count(0)
+			{
+			}
+#endif
+
+			// Constructor forwarding the construction context to the wrapped policy
+			explicit debug_storage_policy(const containers::policy_context& p_context)
+				: m_wrapped_policy(containers::make_policy<wrapped_t>(p_context)), m_operation_count(0), m_hit_count(0), m_miss_count(0)
+			{
+			}
+
 			// Destructor
 			~debug_storage_policy() override = default;
 
@@ -382,6 +475,16 @@ namespace cache_engine
 				m_wrapped_policy->clear();
 			}
 
+			// Not counted as an operation: partitions may be visited concurrently
+			auto visit_partition(std::size_t p_partition, std::size_t p_partition_count, const typename base_t::entry_visitor& p_visitor) const -> void override
+			{
+				m_wrapped_policy->visit_partition(p_partition, p_partition_count, p_visitor);
+			}
+
+			auto node_bytes() const -> std::size_t override { return m_wrapped_policy->node_bytes(); }
+
+			auto bucket_bytes() const -> std::size_t override { return m_wrapped_policy->bucket_bytes(); }
+
 		  public:
 			/**
 			 * @brief Get the total number of operations performed
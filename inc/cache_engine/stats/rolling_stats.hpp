@@ -0,0 +1,426 @@
+// File: inc/cache_engine/stats/rolling_stats.hpp
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+namespace cache_engine
+{
+	namespace stats
+	{
+		/**
+		 * @brief Monotonic clock read at tick resolution (a few milliseconds)
+		 *
+		 * On Linux this is CLOCK_MONOTONIC_COARSE, a few nanoseconds per read
+		 * instead of the tens steady_clock may take, which is plenty for
+		 * per-second buckets. Elsewhere it falls back to steady_clock.
+		 */
+		struct coarse_clock
+		{
+			using duration					= std::chrono::nanoseconds;
+			using rep						= duration::rep;
+			using period					= duration::period;
+			using time_point				= std::chrono::time_point<coarse_clock>;
+			static constexpr bool is_steady = true;
+
+			static auto now() -> time_point
+			{
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+				timespec spec;
+				clock_gettime(CLOCK_MONOTONIC_COARSE, &spec);
+				return time_point(std::chrono::seconds(spec.tv_sec) + std::chrono::nanoseconds(spec.tv_nsec));
+#else
+				return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+#endif
+			}
+		};
+
+		/**
+		 * @brief Aggregate of the complete seconds of one window
+		 *
+		 * Latency percentiles are the upper edge of the histogram bin they
+		 * fall into (bins are half an octave wide, from 1 us to about 16 s),
+		 * so they overstate the true value by at most a factor of sqrt(2);
+		 * zero when the window holds no load.
+		 */
+		struct window_stats
+		{
+			std::chrono::seconds m_span			 = std::chrono::seconds(0); // Seconds actually covered; shorter than asked while the stats are young
+			std::uint64_t m_hits				 = 0;
+			std::uint64_t m_misses				 = 0;
+			std::uint64_t m_evictions			 = 0;
+			std::uint64_t m_loads				 = 0;
+			double m_hit_ratio					 = 0.0;
+			double m_ops_per_second				 = 0.0; // Lookups (hits + misses) per second
+			double m_evictions_per_second		 = 0.0;
+			std::chrono::microseconds m_load_p50 = std::chrono::microseconds(0);
+			std::chrono::microseconds m_load_p95 = std::chrono::microseconds(0);
+			std::chrono::microseconds m_load_p99 = std::chrono::microseconds(0);
+		};
+
+		/**
+		 * @brief The three standard windows, like a load average
+		 */
+		struct rolling_snapshot
+		{
+			window_stats m_last_1m;
+			window_stats m_last_5m;
+			window_stats m_last_15m;
+		};
+
+		/**
+		 * @brief Hit ratio, throughput, eviction rate and load latency over the last 1, 5 and 15 minutes
+		 *
+		 * Cumulative counters hide recent regressions; these stats keep one
+		 * bucket per second in a ring covering 15 minutes and sum the buckets
+		 * of a window when it is read.
+		 *
+		 * Writers never share a cache line: each thread records through its
+		 * own recorder from make_recorder(), which owns a padded slot with a
+		 * private ring. Recording is a coarse clock read plus relaxed loads and
+		 * stores on that ring (no read-modify-write, no lock). Readers sum
+		 * every slot's buckets of the window; a bucket that its writer
+		 * recycles for a new second during the read is skipped, and counts
+		 * of the current second are excluded, so windows cover complete
+		 * seconds only. A released slot keeps its history for the next
+		 * recorder that claims it.
+		 *
+		 * Each slot's ring holds 902 buckets of 216 bytes, about 190 KiB.
+		 *
+		 * @tparam clock_t Clock with a static now(); coarse_clock by default
+		 */
+		template <typename clock_t = coarse_clock> class rolling_stats
+		{
+		  public:
+			using self_t = rolling_stats<clock_t>;
+
+			static constexpr std::size_t default_max_recorders = 16;
+			static constexpr std::size_t latency_bins		   = 49;
+
+		  private:
+			static constexpr std::size_t ring_seconds = 15 * 60 + 2;
+			static constexpr std::size_t hit_field	  = 0;
+			static constexpr std::size_t miss_field	  = 1;
+			static constexpr std::size_t evict_field  = 2;
+			static constexpr std::size_t load_field	  = 3;
+			static constexpr std::size_t count_fields = 4;
+			static constexpr std::size_t cache_line	  = 64;
+
+			// Counts of one second; m_second is 0 while the owner resets the bucket
+			struct bucket
+			{
+				std::atomic<std::uint32_t> m_second;
+				std::atomic<std::uint32_t> m_counts[count_fields];
+				std::atomic<std::uint32_t> m_latency[latency_bins];
+
+				bucket() : m_second(0)
+				{
+					for (std::atomic<std::uint32_t>& count : m_counts)
+					{
+						count.store(0, std::memory_order_relaxed);
+					}
+					for (std::atomic<std::uint32_t>& count : m_latency)
+					{
+						count.store(0, std::memory_order_relaxed);
+					}
+				}
+			};
+
+			struct writer_slot
+			{
+				std::atomic<std::uint8_t> m_claimed;
+				std::unique_ptr<bucket[]> m_ring;
+				char m_padding[cache_line];
+
+				writer_slot() : m_claimed(0), m_ring(new bucket[ring_seconds]) {}
+			};
+
+			typename clock_t::time_point m_start;
+			std::size_t m_slot_count;
+			std::unique_ptr<writer_slot[]> m_slots;
+
+		  public:
+			/**
+			 * @brief Per-thread write handle owning one slot
+			 */
+			class recorder
+			{
+			  private:
+				const self_t* m_owner;
+				writer_slot* m_slot;
+				std::uint32_t m_second;
+				bucket* m_bucket;
+
+			  public:
+				// Constructor
+				recorder(const self_t* p_owner, writer_slot* p_slot) : m_owner(p_owner), m_slot(p_slot), m_second(0), m_bucket(nullptr) {}
+
+				// Destructor
+				~recorder()
+				{
+					if (m_slot != nullptr)
+					{
+						m_slot->m_claimed.store(0, std::memory_order_release);
+					}
+				}
+
+				recorder(const recorder&)					 = delete;
+				auto operator=(const recorder&) -> recorder& = delete;
+
+				recorder(recorder&& p_other) noexcept : m_owner(p_other.m_owner), m_slot(p_other.m_slot), m_second(p_other.m_second), m_bucket(p_other.m_bucket)
+				{
+					p_other.m_slot = nullptr;
+				}
+
+				auto operator=(recorder&&) -> recorder& = delete;
+
+				auto record_hit() -> void { bump(this->current().m_counts[hit_field], 1); }
+
+				auto record_miss() -> void { bump(this->current().m_counts[miss_field], 1); }
+
+				auto record_eviction(std::uint32_t p_count = 1) -> void { bump(this->current().m_counts[evict_field], p_count); }
+
+				/**
+				 * @brief Record one completed load and how long it took
+				 */
+				template <typename rep_t, typename period_t> auto record_load(std::chrono::duration<rep_t, period_t> p_latency) -> void
+				{
+					bucket& target = this->current();
+					bump(target.m_counts[load_field], 1);
+					bump(target.m_latency[latency_bin(std::chrono::duration_cast<std::chrono::microseconds>(p_latency))], 1);
+				}
+
+			  private:
+				// Only this recorder writes its slot, so a load and a store replace an atomic increment
+				static auto bump(std::atomic<std::uint32_t>& p_count, std::uint32_t p_by) -> void
+				{
+					p_count.store(p_count.load(std::memory_order_relaxed) + p_by, std::memory_order_relaxed);
+				}
+
+				auto current() -> bucket&
+				{
+					const std::uint32_t second = m_owner->second_now();
+					if (second != m_second)
+					{
+						m_second = second;
+						m_bucket = &m_slot->m_ring[second % ring_seconds];
+						if (m_bucket->m_second.load(std::memory_order_relaxed) != second)
+						{
+							// Recycle the bucket of second - ring_seconds; readers skip it meanwhile
+							m_bucket->m_second.store(0, std::memory_order_relaxed);
+							std::atomic_thread_fence(std::memory_order_release);
+							for (std::atomic<std::uint32_t>& count : m_bucket->m_counts)
+							{
+								count.store(0, std::memory_order_relaxed);
+							}
+							for (std::atomic<std::uint32_t>& count : m_bucket->m_latency)
+							{
+								count.store(0, std::memory_order_relaxed);
+							}
+							m_bucket->m_second.store(second, std::memory_order_release);
+						}
+					}
+					return *m_bucket;
+				}
+			};
+
+			/**
+			 * @brief Stats with room for p_max_recorders recorders at a time
+			 * @throws std::invalid_argument if p_max_recorders is 0
+			 */
+			explicit rolling_stats(std::size_t p_max_recorders = default_max_recorders) : m_start(clock_t::now()), m_slot_count(p_max_recorders), m_slots()
+			{
+				if (p_max_recorders == 0)
+				{
+					throw std::invalid_argument("rolling_stats needs at least one recorder slot");
+				}
+				m_slots.reset(new writer_slot[p_max_recorders]);
+			}
+
+			// Destructor
+			~rolling_stats() = default;
+
+			// Deleted copy constructor and assignment operator
+			rolling_stats(const self_t&)			 = delete;
+			auto operator=(const self_t&) -> self_t& = delete;
+
+			/**
+			 * @brief Claim a free slot for the calling thread
+			 * @throws std::runtime_error if every slot is taken
+			 */
+			auto make_recorder() -> recorder
+			{
+				for (std::size_t idx_for = 0; idx_for < m_slot_count; ++idx_for)
+				{
+					if (m_slots[idx_for].m_claimed.exchange(1, std::memory_order_acq_rel) == 0)
+					{
+						return recorder(this, &m_slots[idx_for]);
+					}
+				}
+				throw std::runtime_error("All rolling_stats recorder slots are in use");
+			}
+
+			/**
+			 * @brief Aggregate the last p_span complete seconds (at most 15 minutes)
+			 * @throws std::invalid_argument if p_span is zero or longer than 15 minutes
+			 */
+			auto window(std::chrono::seconds p_span) const -> window_stats
+			{
+				if (p_span.count() <= 0 || static_cast<std::size_t>(p_span.count()) > ring_seconds - 2)
+				{
+					throw std::invalid_argument("rolling_stats window must be between 1 second and 15 minutes");
+				}
+
+				// Second 1 starts at construction; the current second is still being written
+				const std::uint32_t now	  = this->second_now();
+				const std::uint32_t first = (now > static_cast<std::uint32_t>(p_span.count())) ? now - static_cast<std::uint32_t>(p_span.count()) : 1;
+
+				std::uint64_t counts[count_fields]	= {};
+				std::uint64_t latency[latency_bins] = {};
+				for (std::size_t idx_slot = 0; idx_slot < m_slot_count; ++idx_slot)
+				{
+					for (std::uint32_t second = first; second < now; ++second)
+					{
+						add_bucket(m_slots[idx_slot].m_ring[second % ring_seconds], second, counts, latency);
+					}
+				}
+
+				window_stats result;
+				result.m_span	   = std::chrono::seconds(now - first);
+				result.m_hits	   = counts[hit_field];
+				result.m_misses	   = counts[miss_field];
+				result.m_evictions = counts[evict_field];
+				result.m_loads	   = counts[load_field];
+
+				const std::uint64_t lookups	  = result.m_hits + result.m_misses;
+				const double seconds		  = static_cast<double>(result.m_span.count());
+				result.m_hit_ratio			  = (lookups > 0) ? static_cast<double>(result.m_hits) / static_cast<double>(lookups) : 0.0;
+				result.m_ops_per_second		  = (seconds > 0.0) ? static_cast<double>(lookups) / seconds : 0.0;
+				result.m_evictions_per_second = (seconds > 0.0) ? static_cast<double>(result.m_evictions) / seconds : 0.0;
+				result.m_load_p50			  = percentile(latency, 0.50);
+				result.m_load_p95			  = percentile(latency, 0.95);
+				result.m_load_p99			  = percentile(latency, 0.99);
+				return result;
+			}
+
+			auto snapshot() const -> rolling_snapshot
+			{
+				rolling_snapshot result;
+				result.m_last_1m  = this->window(std::chrono::seconds(60));
+				result.m_last_5m  = this->window(std::chrono::seconds(5 * 60));
+				result.m_last_15m = this->window(std::chrono::seconds(15 * 60));
+				return result;
+			}
+
+			auto max_recorders() const -> std::size_t { return m_slot_count; }
+
+			/**
+			 * @brief Histogram bin of a latency: 0 below 1 us, then two bins per octave
+			 */
+			static auto latency_bin(std::chrono::microseconds p_latency) -> std::size_t
+			{
+				if (p_latency.count() <= 0)
+				{
+					return 0;
+				}
+				const std::uint64_t micros = static_cast<std::uint64_t>(p_latency.count());
+				std::size_t octave		   = 0;
+				while (octave < 63 && (micros >> (octave + 1)) != 0)
+				{
+					++octave;
+				}
+				// Upper half of the octave once micros >= 2^octave * sqrt(2), i.e. micros^2 >= 2^(2 octave + 1)
+				const bool upper	  = (octave < 31) ? micros * micros >= (std::uint64_t(1) << (2 * octave + 1)) : true;
+				const std::size_t bin = 1 + 2 * octave + (upper ? 1U : 0U);
+				return (bin < latency_bins) ? bin : latency_bins - 1;
+			}
+
+			/**
+			 * @brief Upper edge of a latency bin, in microseconds
+			 */
+			static auto bin_upper_edge(std::size_t p_bin) -> std::chrono::microseconds
+			{
+				if (p_bin == 0)
+				{
+					return std::chrono::microseconds(1);
+				}
+				// Bin 1 + 2k + h covers [2^k * sqrt(2)^h, 2^k * sqrt(2)^(h + 1)) us
+				const std::size_t octave = (p_bin - 1) / 2;
+				const double edge		 = static_cast<double>(std::uint64_t(1) << octave) * (((p_bin - 1) % 2 == 0) ? 1.4142135623730951 : 2.0);
+				return std::chrono::microseconds(static_cast<std::int64_t>(edge + 0.5));
+			}
+
+		  private:
+			auto second_now() const -> std::uint32_t
+			{
+				return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(clock_t::now() - m_start).count()) + 1U;
+			}
+
+			static auto add_bucket(const bucket& p_bucket, std::uint32_t p_second, std::uint64_t* p_counts, std::uint64_t* p_latency) -> void
+			{
+				if (p_bucket.m_second.load(std::memory_order_acquire) != p_second)
+				{
+					return;
+				}
+				std::uint32_t counts[count_fields];
+				std::uint32_t latency[latency_bins];
+				for (std::size_t idx_for = 0; idx_for < count_fields; ++idx_for)
+				{
+					counts[idx_for] = p_bucket.m_counts[idx_for].load(std::memory_order_relaxed);
+				}
+				for (std::size_t idx_for = 0; idx_for < latency_bins; ++idx_for)
+				{
+					latency[idx_for] = p_bucket.m_latency[idx_for].load(std::memory_order_relaxed);
+				}
+				// Recycled while we read: its counts may belong to the new second
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (p_bucket.m_second.load(std::memory_order_relaxed) != p_second)
+				{
+					return;
+				}
+				for (std::size_t idx_for = 0; idx_for < count_fields; ++idx_for)
+				{
+					p_counts[idx_for] += counts[idx_for];
+				}
+				for (std::size_t idx_for = 0; idx_for < latency_bins; ++idx_for)
+				{
+					p_latency[idx_for] += latency[idx_for];
+				}
+			}
+
+			static auto percentile(const std::uint64_t* p_latency, double p_quantile) -> std::chrono::microseconds
+			{
+				std::uint64_t total = 0;
+				for (std::size_t idx_for = 0; idx_for < latency_bins; ++idx_for)
+				{
+					total += p_latency[idx_for];
+				}
+				if (total == 0)
+				{
+					return std::chrono::microseconds(0);
+				}
+				// Smallest bin whose cumulative count reaches ceil(q * total)
+				const std::uint64_t rank = static_cast<std::uint64_t>(p_quantile * static_cast<double>(total) + 0.999999);
+				std::uint64_t seen		 = 0;
+				for (std::size_t idx_for = 0; idx_for < latency_bins; ++idx_for)
+				{
+					seen += p_latency[idx_for];
+					if (seen >= rank)
+					{
+						return bin_upper_edge(idx_for);
+					}
+				}
+				return bin_upper_edge(latency_bins - 1);
+			}
+		};
+	} // namespace stats
+} // namespace cache_engine
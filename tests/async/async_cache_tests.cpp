@@ -0,0 +1,151 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include <cache_engine/async/async_cache.hpp>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "manual_gate.hpp"
+
+namespace
+{
+	using cache_t = cache_engine::async::async_cache<std::int32_t, std::string>;
+} // namespace
+
+TEST_CASE("Coroutine tasks and sync_wait", "[async][task][unit]")
+{
+	SECTION("sync_wait returns the value of a task")
+	{
+		auto answer = []() -> cache_engine::async::task<std::int32_t> { co_return 42; };
+		REQUIRE((cache_engine::async::sync_wait(answer()) == 42));
+	}
+
+	SECTION("sync_wait rethrows the exception of a task")
+	{
+		auto failing = []() -> cache_engine::async::task<std::int32_t>
+		{
+			throw std::runtime_error("task failed");
+			co_return 0;
+		};
+		REQUIRE_THROWS_WITH(cache_engine::async::sync_wait(failing()), "task failed");
+	}
+
+	SECTION("sync_wait runs a void task and waits for a task finishing on another thread")
+	{
+		std::unique_ptr<cache_engine::async::thread_pool_executor> pool(new cache_engine::async::thread_pool_executor(1));
+		const std::thread::id caller = std::this_thread::get_id();
+		std::thread::id resumed_on;
+
+		auto hop = [&]() -> cache_engine::async::task<void>
+		{
+			co_await pool->schedule();
+			resumed_on = std::this_thread::get_id();
+		};
+		cache_engine::async::sync_wait(hop());
+		REQUIRE((resumed_on != caller));
+		REQUIRE((resumed_on != std::thread::id()));
+	}
+}
+
+TEST_CASE("Async cache", "[async][async_cache][unit]")
+{
+	std::unique_ptr<cache_engine::async::thread_pool_executor> pool(new cache_engine::async::thread_pool_executor(2));
+	async_test::manual_gate gate;
+	std::atomic<std::int32_t> loads(0);
+	std::atomic<bool> fail(false);
+
+	auto loader = [&](const std::int32_t& p_key) -> cache_engine::async::task<std::string>
+	{
+		const std::int32_t key = p_key;
+		++loads;
+		co_await gate.wait();
+		if (fail)
+		{
+			throw std::runtime_error("backend down");
+		}
+		co_return "v" + std::to_string(key);
+	};
+
+	SECTION("Concurrent misses on one key share a single load")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(16, loader, *pool));
+		std::vector<std::string> results(3);
+		std::vector<std::thread> callers;
+		for (std::size_t idx_for = 0; idx_for < results.size(); ++idx_for)
+		{
+			callers.emplace_back([&cache, &results, idx_for] { results[idx_for] = cache_engine::async::sync_wait(cache->async_get_or_load(7)); });
+		}
+
+		REQUIRE(gate.wait_for_waiters(1));
+		REQUIRE(async_test::eventually([&cache] { return cache->coalesced_count() == 2; }));
+		REQUIRE((cache->pending_count() == 1));
+		gate.open();
+		for (std::thread& caller : callers)
+		{
+			caller.join();
+		}
+
+		for (const std::string& result : results)
+		{
+			REQUIRE((result == "v7"));
+		}
+		REQUIRE((loads == 1));
+		REQUIRE((cache->load_count() == 1));
+		REQUIRE((cache->pending_count() == 0));
+		REQUIRE(cache->contains(7));
+
+		// Now a hit: no further load
+		REQUIRE((cache_engine::async::sync_wait(cache->async_get_or_load(7)) == "v7"));
+		REQUIRE((loads == 1));
+		REQUIRE((cache->hit_count() == 1));
+	}
+
+	SECTION("A failed load reaches every waiter and caches nothing")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(16, loader, *pool));
+		fail = true;
+		std::vector<std::string> errors(2);
+		std::vector<std::thread> callers;
+		for (std::size_t idx_for = 0; idx_for < errors.size(); ++idx_for)
+		{
+			callers.emplace_back(
+				[&cache, &errors, idx_for]
+				{
+					try
+					{
+						cache_engine::async::sync_wait(cache->async_get_or_load(7));
+					}
+					catch (const std::runtime_error& p_error)
+					{
+						errors[idx_for] = p_error.what();
+					}
+				});
+		}
+
+		REQUIRE(gate.wait_for_waiters(1));
+		REQUIRE(async_test::eventually([&cache] { return cache->coalesced_count() == 1; }));
+		gate.open();
+		for (std::thread& caller : callers)
+		{
+			caller.join();
+		}
+
+		REQUIRE((errors[0] == "backend down"));
+		REQUIRE((errors[1] == "backend down"));
+		REQUIRE_FALSE(cache->contains(7));
+		REQUIRE((cache->pending_count() == 0));
+
+		// The failure is not remembered: the next miss loads again
+		fail = false;
+		REQUIRE((cache_engine::async::sync_wait(cache->async_get_or_load(7)) == "v7"));
+		REQUIRE((cache->load_count() == 2));
+	}
+
+	SECTION("A cache needs a loader")
+	{
+		REQUIRE_THROWS_AS(std::unique_ptr<cache_t>(new cache_t(16, cache_t::loader_t(), *pool)), std::invalid_argument);
+	}
+}
@@ -0,0 +1,171 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/async/hedged_loader.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "manual_gate.hpp"
+
+namespace
+{
+	using hedged_loader_t = cache_engine::async::hedged_loader<std::int32_t, std::int32_t>;
+
+	auto fixed_delay(double p_budget) -> cache_engine::async::hedge_options
+	{
+		cache_engine::async::hedge_options options;
+		options.m_delay	 = std::chrono::milliseconds(5);
+		options.m_budget = p_budget;
+		return options;
+	}
+} // namespace
+
+TEST_CASE("Hedged loader", "[async][hedged][unit]")
+{
+	std::unique_ptr<cache_engine::async::thread_pool_executor> pool(new cache_engine::async::thread_pool_executor(2));
+
+	// The first call of every lookup holds at first_gate, the hedge at hedge_gate unless told to answer at once
+	async_test::manual_gate first_gate;
+	async_test::manual_gate hedge_gate;
+	std::atomic<std::int32_t> calls(0);
+	std::atomic<bool> first_fails(false);
+	std::atomic<bool> hedge_waits(false);
+	std::atomic<bool> hedge_fails(false);
+
+	auto backend = [&](const std::int32_t& p_key) -> cache_engine::async::task<std::int32_t>
+	{
+		const std::int32_t key = p_key;
+		if (calls.fetch_add(1) == 0)
+		{
+			co_await first_gate.wait();
+			if (first_fails)
+			{
+				throw std::runtime_error("first load failed");
+			}
+			co_return key * 10;
+		}
+		if (hedge_waits)
+		{
+			co_await hedge_gate.wait();
+		}
+		if (hedge_fails)
+		{
+			throw std::runtime_error("hedge failed");
+		}
+		co_return key * 10 + 1;
+	};
+
+	SECTION("A slow load is hedged after the delay and the hedge answers")
+	{
+		std::unique_ptr<hedged_loader_t> hedged(new hedged_loader_t(backend, *pool, fixed_delay(1.0)));
+		const auto start = std::chrono::steady_clock::now();
+		REQUIRE((cache_engine::async::sync_wait(hedged->load(4)) == 41));
+		REQUIRE((std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(5)));
+
+		const cache_engine::async::hedge_stats stats = hedged->stats();
+		REQUIRE((stats.m_loads == 1));
+		REQUIRE((stats.m_hedges == 1));
+		REQUIRE((stats.m_hedge_wins == 1));
+		REQUIRE((stats.m_budget_denied == 0));
+		first_gate.open();
+	}
+
+	SECTION("A spent budget denies the hedge and the lookup waits for the first load")
+	{
+		std::unique_ptr<hedged_loader_t> hedged(new hedged_loader_t(backend, *pool, fixed_delay(0.0)));
+		std::int32_t value = 0;
+		std::thread caller([&hedged, &value] { value = cache_engine::async::sync_wait(hedged->load(4)); });
+
+		REQUIRE(async_test::eventually([&hedged] { return hedged->stats().m_budget_denied == 1; }));
+		first_gate.open();
+		caller.join();
+
+		REQUIRE((value == 40));
+		REQUIRE((hedged->stats().m_hedges == 0));
+		REQUIRE((calls == 1));
+	}
+
+	SECTION("A failed first load falls through to the running hedge")
+	{
+		first_fails = true;
+		hedge_waits = true;
+		std::unique_ptr<hedged_loader_t> hedged(new hedged_loader_t(backend, *pool, fixed_delay(1.0)));
+		std::int32_t value = 0;
+		std::thread caller([&hedged, &value] { value = cache_engine::async::sync_wait(hedged->load(4)); });
+
+		REQUIRE(hedge_gate.wait_for_waiters(1));
+		first_gate.open();
+		hedge_gate.open();
+		caller.join();
+
+		REQUIRE((value == 41));
+		REQUIRE((hedged->stats().m_hedge_wins == 1));
+	}
+
+	SECTION("The lookup fails only once every load for it has failed")
+	{
+		first_fails = true;
+		hedge_waits = true;
+		hedge_fails = true;
+		std::unique_ptr<hedged_loader_t> hedged(new hedged_loader_t(backend, *pool, fixed_delay(1.0)));
+		std::string error;
+		std::thread caller(
+			[&hedged, &error]
+			{
+				try
+				{
+					cache_engine::async::sync_wait(hedged->load(4));
+				}
+				catch (const std::runtime_error& p_error)
+				{
+					error = p_error.what();
+				}
+			});
+
+		REQUIRE(hedge_gate.wait_for_waiters(1));
+		first_gate.open();
+		hedge_gate.open();
+		caller.join();
+
+		REQUIRE((error == "hedge failed"));
+		REQUIRE((hedged->stats().m_hedge_wins == 0));
+	}
+
+	SECTION("The destructor waits for a losing load still in flight")
+	{
+		std::unique_ptr<hedged_loader_t> hedged(new hedged_loader_t(backend, *pool, fixed_delay(1.0)));
+		REQUIRE((cache_engine::async::sync_wait(hedged->load(4)) == 41));
+
+		std::atomic<bool> destroyed(false);
+		std::thread destroyer(
+			[&hedged, &destroyed]
+			{
+				hedged.reset();
+				destroyed = true;
+			});
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		REQUIRE_FALSE(destroyed);
+
+		first_gate.open();
+		destroyer.join();
+		REQUIRE(destroyed);
+	}
+
+	SECTION("Without a fixed delay nothing is hedged until enough latencies are measured")
+	{
+		cache_engine::async::hedge_options options;
+		options.m_min_samples = 64;
+		first_gate.open();
+		std::unique_ptr<hedged_loader_t> hedged(new hedged_loader_t(backend, *pool, options));
+		REQUIRE((hedged->hedge_delay() == std::chrono::nanoseconds::zero()));
+		for (std::int32_t idx_for = 0; idx_for < 64; ++idx_for)
+		{
+			cache_engine::async::sync_wait(hedged->load(idx_for));
+		}
+		REQUIRE((hedged->stats().m_hedges == 0));
+		REQUIRE((hedged->hedge_delay() > std::chrono::nanoseconds::zero()));
+	}
+}
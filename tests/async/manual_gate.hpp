@@ -0,0 +1,98 @@
+// File: tests/async/manual_gate.hpp
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace async_test
+{
+	/**
+	 * @brief Awaitable that holds coroutines until the test opens it
+	 *
+	 * Loaders await it to stay in flight for as long as a test needs; open()
+	 * resumes the held coroutines on the calling thread.
+	 */
+	class manual_gate
+	{
+	  private:
+		std::mutex m_mutex;
+		std::condition_variable m_arrived;
+		std::vector<std::coroutine_handle<>> m_waiters;
+		bool m_open = false;
+
+	  public:
+		struct awaiter
+		{
+			manual_gate* m_gate;
+
+			auto await_ready() const noexcept -> bool { return false; }
+
+			auto await_suspend(std::coroutine_handle<> p_handle) const -> bool
+			{
+				std::lock_guard<std::mutex> lock(m_gate->m_mutex);
+				if (m_gate->m_open)
+				{
+					return false;
+				}
+				m_gate->m_waiters.push_back(p_handle);
+				m_gate->m_arrived.notify_all();
+				return true;
+			}
+
+			auto await_resume() const noexcept -> void {}
+		};
+
+		auto wait() -> awaiter { return awaiter{this}; }
+
+		/**
+		 * @brief Block until p_count coroutines are held, for at most five seconds
+		 * @return false on timeout
+		 */
+		auto wait_for_waiters(std::size_t p_count) -> bool
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			return m_arrived.wait_for(lock, std::chrono::seconds(5), [this, p_count] { return m_waiters.size() >= p_count; });
+		}
+
+		/**
+		 * @brief Let every held and future coroutine through
+		 */
+		auto open() -> void
+		{
+			std::vector<std::coroutine_handle<>> waiters;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_open = true;
+				waiters.swap(m_waiters);
+			}
+			for (auto& waiter : waiters)
+			{
+				waiter.resume();
+			}
+		}
+	};
+
+	/**
+	 * @brief Poll p_condition until it holds, for at most five seconds
+	 * @return false on timeout
+	 */
+	template <typename condition_t> auto eventually(const condition_t& p_condition) -> bool
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (!p_condition())
+		{
+			if (std::chrono::steady_clock::now() >= deadline)
+			{
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return true;
+	}
+} // namespace async_test
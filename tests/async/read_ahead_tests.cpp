@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/async/read_ahead_cache.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "manual_gate.hpp"
+
+namespace
+{
+	using cache_t = cache_engine::async::read_ahead_cache<std::int32_t, std::int32_t>;
+} // namespace
+
+TEST_CASE("Read-ahead cache", "[async][read_ahead][unit]")
+{
+	// Batches run to completion inside async_get unless the gate holds them
+	std::unique_ptr<cache_engine::async::inline_executor> executor(new cache_engine::async::inline_executor());
+	async_test::manual_gate gate;
+	bool gated = false;
+	std::atomic<std::int32_t> demand_loads(0);
+
+	auto loader = [&](const std::int32_t& p_key) -> cache_engine::async::task<std::int32_t>
+	{
+		++demand_loads;
+		co_return p_key * 10;
+	};
+	auto batch_loader = [&](std::int32_t p_first, std::size_t p_count) -> cache_engine::async::task<std::vector<std::int32_t>>
+	{
+		if (gated)
+		{
+			co_await gate.wait();
+		}
+		std::vector<std::int32_t> values;
+		for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+		{
+			values.push_back((p_first + static_cast<std::int32_t>(idx_for)) * 10);
+		}
+		co_return values;
+	};
+
+	SECTION("A confirmed stream doubles its window and hits on prefetched keys")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(1024, loader, batch_loader, *executor));
+		for (std::int32_t idx_for = 0; idx_for <= 7; ++idx_for)
+		{
+			REQUIRE((cache_engine::async::sync_wait(cache->async_get(idx_for)) == idx_for * 10));
+		}
+
+		// 0..2 start the stream and issue 3..10; reaching 7 confirms it and issues 16 more
+		const cache_engine::async::read_ahead_stats stats = cache->stats();
+		REQUIRE((demand_loads == 3));
+		REQUIRE((stats.m_misses == 3));
+		REQUIRE((stats.m_batches == 2));
+		REQUIRE((stats.m_issued == 24));
+		REQUIRE((stats.m_useful == 5));
+		REQUIRE((stats.accuracy() == Approx(5.0 / 24.0)));
+		REQUIRE((cache->window(0) == 16));
+		REQUIRE(cache->contains(26));
+	}
+
+	SECTION("A broken stream counts its unread keys as wasted and halves its window")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(1024, loader, batch_loader, *executor));
+		for (std::int32_t idx_for = 0; idx_for <= 7; ++idx_for)
+		{
+			cache_engine::async::sync_wait(cache->async_get(idx_for));
+		}
+		cache_engine::async::sync_wait(cache->async_get(1000));
+
+		const cache_engine::async::read_ahead_stats stats = cache->stats();
+		REQUIRE((stats.m_wasted == 19));
+		REQUIRE((stats.accuracy() == Approx(5.0 / 24.0)));
+		REQUIRE((cache->window(0) == 8));
+
+		// Other streams keep their own state
+		REQUIRE((cache->window(1) == 0));
+		cache_engine::async::sync_wait(cache->async_get(500, 1));
+		REQUIRE((cache->window(1) == 8));
+	}
+
+	SECTION("A stream that breaks off before its batch arrives does not insert the batch")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(1024, loader, batch_loader, *executor));
+		gated = true;
+		for (std::int32_t idx_for = 0; idx_for <= 2; ++idx_for)
+		{
+			cache_engine::async::sync_wait(cache->async_get(idx_for));
+		}
+		REQUIRE(gate.wait_for_waiters(1));
+		cache_engine::async::sync_wait(cache->async_get(1000));
+
+		gate.open();
+		cache->wait_idle();
+		for (std::int32_t idx_for = 3; idx_for <= 10; ++idx_for)
+		{
+			REQUIRE_FALSE(cache->contains(idx_for));
+		}
+		REQUIRE((cache->stats().m_wasted == 8));
+		REQUIRE((cache->stats().m_useful == 0));
+		REQUIRE((cache->size() == 4));
+	}
+
+	SECTION("Windows respect the configured bounds")
+	{
+		cache_engine::async::read_ahead_options options;
+		options.m_min_window = 4;
+		options.m_max_window = 2;
+		REQUIRE_THROWS_AS(std::unique_ptr<cache_t>(new cache_t(16, loader, batch_loader, *executor, options)), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Read-ahead at the end of the key range", "[async][read_ahead][unit]")
+{
+	using byte_cache_t = cache_engine::async::read_ahead_cache<std::uint8_t, std::int32_t>;
+	std::unique_ptr<cache_engine::async::inline_executor> executor(new cache_engine::async::inline_executor());
+
+	auto loader = [](const std::uint8_t& p_key) -> cache_engine::async::task<std::int32_t> { co_return p_key; };
+	auto batch_loader = [](std::uint8_t p_first, std::size_t p_count) -> cache_engine::async::task<std::vector<std::int32_t>>
+	{
+		std::vector<std::int32_t> values;
+		for (std::size_t idx_for = 0; idx_for < p_count; ++idx_for)
+		{
+			values.push_back(p_first + static_cast<std::int32_t>(idx_for));
+		}
+		co_return values;
+	};
+
+	std::unique_ptr<byte_cache_t> cache(new byte_cache_t(64, loader, batch_loader, *executor));
+	for (std::int32_t idx_for = 250; idx_for <= 255; ++idx_for)
+	{
+		REQUIRE((cache_engine::async::sync_wait(cache->async_get(static_cast<std::uint8_t>(idx_for))) == idx_for));
+	}
+
+	// Only 253 and 254 fit below the maximum key; nothing wraps around to 0
+	REQUIRE((cache->stats().m_issued == 2));
+	REQUIRE((cache->stats().m_useful == 2));
+	REQUIRE_FALSE(cache->contains(0));
+
+	// Breaking off at the maximum key must neither wrap nor waste anything
+	REQUIRE((cache_engine::async::sync_wait(cache->async_get(7)) == 7));
+	REQUIRE((cache->stats().m_wasted == 0));
+	REQUIRE((cache->window(0) == 16));
+}
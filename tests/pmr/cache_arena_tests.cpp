@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/memory/cache_arena.hpp>
+#include <cache_engine/policies/all_policies.hpp>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+namespace
+{
+	template <template <typename, typename> class eviction_t, template <typename, typename> class storage_t>
+	using arena_cache_t =
+		cache_engine::policy_based_cache<std::uint64_t, std::uint64_t, eviction_t, storage_t, cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	/**
+	 * @brief Routes allocations that miss the arena to a counter for the lifetime of a test
+	 */
+	class stray_allocations
+	{
+	  private:
+		cache_engine::memory::counting_resource m_counter;
+		std::pmr::memory_resource* m_previous;
+
+	  public:
+		stray_allocations() : m_counter(), m_previous(std::pmr::set_default_resource(&m_counter)) {}
+
+		~stray_allocations() { std::pmr::set_default_resource(m_previous); }
+
+		stray_allocations(const stray_allocations&)					   = delete;
+		auto operator=(const stray_allocations&) -> stray_allocations& = delete;
+
+		auto count() const -> std::size_t { return m_counter.allocation_count(); }
+	};
+
+	/**
+	 * @brief Put, get, erase, evict and clear a cache built on an arena
+	 */
+	template <typename cache_t> auto exercise_on_arena() -> void
+	{
+		std::unique_ptr<cache_engine::memory::cache_arena> arena(new cache_engine::memory::cache_arena());
+		std::unique_ptr<stray_allocations> stray(new stray_allocations());
+		{
+			std::unique_ptr<cache_t> cache(new cache_t(64, arena->resource()));
+			for (std::uint64_t idx_for = 0; idx_for < 64; ++idx_for)
+			{
+				cache->put(idx_for, idx_for * 10U);
+			}
+			REQUIRE((cache->size() == 64U));
+			REQUIRE((arena->node_bytes_in_use() > 0U));
+
+			// Key 0 is touched, so the next insert evicts key 1
+			REQUIRE((cache->get(0) == 0U));
+			cache->put(100, 1000);
+			REQUIRE((cache->size() == 64U));
+			REQUIRE(cache->contains(0));
+			REQUIRE_FALSE(cache->contains(1));
+			REQUIRE((cache->get(100) == 1000U));
+
+			REQUIRE(cache->erase(2));
+			REQUIRE_FALSE(cache->contains(2));
+			REQUIRE((cache->size() == 63U));
+
+			cache->clear();
+			REQUIRE((cache->size() == 0U));
+			cache->put(7, 70);
+			REQUIRE((cache->get(7) == 70U));
+		}
+		REQUIRE((stray->count() == 0U));
+		REQUIRE((arena->upstream_allocation_count() > 0U));
+		REQUIRE((arena->node_bytes_in_use() == 0U));
+
+		arena->release();
+		REQUIRE((arena->reserved_bytes() == 0U));
+	}
+} // namespace
+
+TEST_CASE("Caches on a cache arena", "[pmr][arena][unit]")
+{
+	SECTION("Hash storage")
+	{
+		exercise_on_arena<arena_cache_t<cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage>>();
+	}
+
+	SECTION("Reserved hash storage")
+	{
+		exercise_on_arena<arena_cache_t<cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::reserved_hash_storage>>();
+	}
+
+	SECTION("Compact storage")
+	{
+		exercise_on_arena<arena_cache_t<cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::compact_storage>>();
+	}
+
+	SECTION("Debug storage")
+	{
+		exercise_on_arena<arena_cache_t<cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::debug_storage>>();
+	}
+
+	SECTION("Frequency and sampling eviction policies stay on the arena too")
+	{
+		std::unique_ptr<cache_engine::memory::cache_arena> arena(new cache_engine::memory::cache_arena());
+		std::unique_ptr<stray_allocations> stray(new stray_allocations());
+		{
+			using lfu_cache_t = arena_cache_t<cache_engine::policy_templates::lfu_eviction, cache_engine::policy_templates::hash_storage>;
+			using sampled_cache_t = arena_cache_t<cache_engine::policy_templates::sampled_lfu_eviction, cache_engine::policy_templates::hash_storage>;
+			std::unique_ptr<lfu_cache_t> lfu(new lfu_cache_t(32, arena->resource()));
+			std::unique_ptr<sampled_cache_t> sampled(new sampled_cache_t(32, arena->resource()));
+			for (std::uint64_t idx_for = 0; idx_for < 100; ++idx_for)
+			{
+				lfu->put(idx_for, idx_for);
+				sampled->put(idx_for, idx_for);
+			}
+			REQUIRE((lfu->size() == 32U));
+			REQUIRE((sampled->size() == 32U));
+		}
+		REQUIRE((stray->count() == 0U));
+	}
+}
+
+TEST_CASE("Policy context on a memory resource", "[pmr][context][unit]")
+{
+	std::unique_ptr<cache_engine::memory::cache_arena> arena(new cache_engine::memory::cache_arena());
+
+	SECTION("Storage policies take the resource directly")
+	{
+		using hash_t	 = cache_engine::policies::hash_storage_policy<std::uint64_t, std::uint64_t>;
+		using reserved_t = cache_engine::policies::reserved_hash_storage_policy<std::uint64_t, std::uint64_t>;
+		using compact_t	 = cache_engine::policies::compact_storage_policy<std::uint64_t, std::uint64_t>;
+		std::unique_ptr<hash_t> hash(new hash_t(arena->resource()));
+		std::unique_ptr<reserved_t> reserved(new reserved_t(arena->resource(), 500));
+		std::unique_ptr<compact_t> compact(new compact_t(arena->resource()));
+
+		const std::size_t before = arena->node_bytes_in_use();
+		REQUIRE(hash->insert(1, 10));
+		REQUIRE(reserved->insert(1, 10));
+		REQUIRE(compact->insert(1, 10));
+		REQUIRE((arena->node_bytes_in_use() > before));
+		REQUIRE((reserved->reserved_capacity() == 500U));
+		REQUIRE((*compact->find(1) == 10U));
+	}
+
+	SECTION("A memory capacity cache on a resource is sized for its entry count")
+	{
+		using memory_cache_t = cache_engine::policy_based_cache<std::int32_t, std::string, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::compact_storage,
+																cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::memory_capacity>;
+		const std::size_t limit = std::size_t(1) << 20;
+		std::unique_ptr<memory_cache_t> cache(new memory_cache_t(limit, arena->resource()));
+		const std::size_t entries = limit / (sizeof(std::int32_t) + sizeof(std::string));
+
+		const std::size_t buckets = cache->storage_policy().bucket_count();
+		REQUIRE((buckets >= entries));
+		REQUIRE((buckets < 2 * entries));
+		REQUIRE((arena->reserved_bytes() < limit));
+	}
+}
@@ -0,0 +1,58 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include <cache_engine/memory/cache_arena.hpp>
+#include <cstddef>
+#include <memory>
+
+TEST_CASE("Node pool resource", "[pmr][arena][unit]")
+{
+	std::unique_ptr<cache_engine::memory::counting_resource> chunks(new cache_engine::memory::counting_resource());
+	std::unique_ptr<cache_engine::memory::counting_resource> large(new cache_engine::memory::counting_resource());
+	std::unique_ptr<cache_engine::memory::node_pool_resource> pool(new cache_engine::memory::node_pool_resource(chunks.get(), large.get()));
+
+	SECTION("A freed node is reused by the next allocation of its size class")
+	{
+		void* first = pool->allocate(24, 8);
+		REQUIRE((chunks->allocation_count() == 1U));
+		REQUIRE((pool->pooled_bytes_in_use() == 32U));
+
+		pool->deallocate(first, 24, 8);
+		REQUIRE((pool->pooled_bytes_in_use() == 0U));
+		void* second = pool->allocate(32, 8);
+		REQUIRE((second == first));
+		REQUIRE((chunks->allocation_count() == 1U));
+
+		// Another size class carves its own chunk
+		void* other = pool->allocate(100, 8);
+		REQUIRE((chunks->allocation_count() == 2U));
+		REQUIRE((pool->pooled_bytes_in_use() == 32U + 112U));
+		pool->deallocate(other, 100, 8);
+		pool->deallocate(second, 32, 8);
+		REQUIRE((large->allocation_count() == 0U));
+	}
+
+	SECTION("Large and over-aligned blocks go to the large-block resource and back")
+	{
+		void* block = pool->allocate(4096, 8);
+		void* wide	= pool->allocate(32, 64);
+		REQUIRE((large->allocation_count() == 2U));
+		REQUIRE((large->bytes_in_use() == 4096U + 32U));
+		REQUIRE((chunks->allocation_count() == 0U));
+
+		pool->deallocate(block, 4096, 8);
+		pool->deallocate(wide, 32, 64);
+		REQUIRE((large->bytes_in_use() == 0U));
+	}
+
+	SECTION("Release returns every chunk")
+	{
+		for (std::size_t idx_for = 0; idx_for < 1000; ++idx_for)
+		{
+			REQUIRE((pool->allocate(48, 8) != nullptr));
+		}
+		REQUIRE((chunks->allocation_count() > 1U));
+		pool->release();
+		REQUIRE((chunks->bytes_in_use() == 0U));
+		REQUIRE((pool->pooled_bytes_in_use() == 0U));
+	}
+}
@@ -0,0 +1,438 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/concurrent/clock_cache.hpp>
+#include <cache_engine/concurrent/rcu_cache.hpp>
+#include <cache_engine/concurrent/seqlock_cache.hpp>
+#include <cache_engine/concurrent/sharded_lru_cache.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct wide_value
+	{
+		std::uint64_t m_words[8];
+	};
+} // namespace
+
+TEST_CASE("Seqlock cache", "[concurrent][seqlock][unit]")
+{
+	using cache_t = cache_engine::concurrent::seqlock_cache<std::uint64_t, std::uint64_t>;
+
+	SECTION("Basic put, get, update and erase")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(64));
+		cache->put(1, 10);
+		cache->put(2, 20);
+		cache->put(1, 11);
+
+		REQUIRE(cache->size() == 2);
+		REQUIRE(cache->get(1) == 11);
+		REQUIRE(cache->get(2) == 20);
+		REQUIRE(cache->erase(2));
+		REQUIRE_FALSE(cache->contains(2));
+		REQUIRE_FALSE(cache->erase(2));
+		REQUIRE_THROWS_AS(cache->get(2), std::out_of_range);
+	}
+
+	SECTION("Size never exceeds the slot count")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(100));
+		for (std::uint64_t idx_for = 0; idx_for < 10000; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+		}
+
+		REQUIRE(cache->capacity() >= 100);
+		REQUIRE(cache->size() <= cache->capacity());
+	}
+
+	SECTION("Concurrent readers never observe a torn value")
+	{
+		using wide_cache_t = cache_engine::concurrent::seqlock_cache<std::uint64_t, wide_value>;
+		std::unique_ptr<wide_cache_t> cache(new wide_cache_t(16));
+		std::atomic<bool> stop(false);
+		std::atomic<std::size_t> torn(0);
+
+		std::vector<std::thread> readers;
+		for (std::size_t idx_thread = 0; idx_thread < 2; ++idx_thread)
+		{
+			readers.emplace_back(
+				[&cache, &stop, &torn]()
+				{
+					wide_value value = wide_value();
+					while (!stop.load(std::memory_order_relaxed))
+					{
+						if (cache->find(7, value))
+						{
+							for (std::size_t idx_word = 1; idx_word < 8; ++idx_word)
+							{
+								torn.fetch_add((value.m_words[idx_word] != value.m_words[0]) ? 1 : 0, std::memory_order_relaxed);
+							}
+						}
+					}
+				});
+		}
+
+		for (std::uint64_t idx_for = 0; idx_for < 20000; ++idx_for)
+		{
+			wide_value value = wide_value();
+			for (std::size_t idx_word = 0; idx_word < 8; ++idx_word)
+			{
+				value.m_words[idx_word] = idx_for;
+			}
+			cache->put(7, value);
+		}
+
+		stop.store(true);
+		for (auto& reader : readers)
+		{
+			reader.join();
+		}
+
+		REQUIRE(torn.load() == 0);
+	}
+}
+
+TEST_CASE("Concurrent CLOCK cache", "[concurrent][clock][unit]")
+{
+	using cache_t = cache_engine::concurrent::clock_cache<std::uint64_t, std::uint64_t>;
+
+	SECTION("Referenced entries get a second chance")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(3, 4));
+		cache->put(1, 10);
+		cache->put(2, 20);
+		cache->put(3, 30);
+		REQUIRE(cache->get(1) == 10);
+
+		cache->put(4, 40);
+
+		REQUIRE(cache->size() == 3);
+		REQUIRE(cache->contains(1));
+		REQUIRE_FALSE(cache->contains(2));
+		REQUIRE(cache->get(4) == 40);
+	}
+
+	SECTION("Erase frees a slot for the next insert")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(2));
+		cache->put(1, 10);
+		cache->put(2, 20);
+		REQUIRE(cache->erase(1));
+		cache->put(3, 30);
+
+		REQUIRE(cache->contains(2));
+		REQUIRE(cache->contains(3));
+		REQUIRE_THROWS_AS(cache->get(1), std::out_of_range);
+	}
+
+	SECTION("Concurrent inserts and lookups keep the index and slots consistent")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(128, 8));
+		std::atomic<std::size_t> wrong(0);
+
+		std::vector<std::thread> workers;
+		for (std::size_t idx_thread = 0; idx_thread < 4; ++idx_thread)
+		{
+			workers.emplace_back(
+				[&cache, &wrong, idx_thread]()
+				{
+					std::uint64_t value = 0;
+					for (std::uint64_t idx_for = 0; idx_for < 20000; ++idx_for)
+					{
+						const std::uint64_t key = (idx_for * 7919U + idx_thread) % 512U;
+						if (cache->find(key, value) && value != key * 3U)
+						{
+							wrong.fetch_add(1, std::memory_order_relaxed);
+						}
+						cache->put(key, key * 3U);
+					}
+				});
+		}
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		REQUIRE(wrong.load() == 0);
+		REQUIRE(cache->size() <= cache->capacity());
+	}
+}
+
+TEST_CASE("Sharded LRU cache", "[concurrent][sharded][unit]")
+{
+	using cache_t	 = cache_engine::concurrent::sharded_lru_cache<std::uint64_t, std::uint64_t>;
+	using eviction_t = cache_engine::concurrent::shard_eviction;
+
+	SECTION("Independent shards never exceed their share")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(64, eviction_t::independent, 4));
+		for (std::uint64_t idx_for = 0; idx_for < 1000; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+		}
+
+		REQUIRE(cache->size() <= 64);
+		for (std::size_t idx_shard = 0; idx_shard < cache->shard_count(); ++idx_shard)
+		{
+			REQUIRE(cache->shard_size(idx_shard) <= 16);
+		}
+		REQUIRE(cache->cross_shard_evictions() == 0);
+		REQUIRE_THROWS_AS(cache_t(2, eviction_t::independent, 4), std::invalid_argument);
+	}
+
+	SECTION("Global eviction lets a busy shard borrow capacity from idle ones")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(64, eviction_t::global, 4, 4));
+		// Fill the cache evenly, then insert only keys of shard 0
+		for (std::uint64_t idx_for = 0; idx_for < 64; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+		}
+		std::uint64_t key = 1000;
+		for (std::size_t idx_for = 0; idx_for < 200; ++key)
+		{
+			if (cache->shard_index(key) == 0)
+			{
+				cache->put(key, key);
+				++idx_for;
+			}
+		}
+
+		REQUIRE(cache->size() == 64);
+		REQUIRE(cache->shard_size(0) > 32);
+		REQUIRE(cache->cross_shard_evictions() > 0);
+	}
+
+	SECTION("A hot set survives a stream of one-time keys")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(100, eviction_t::global, 8, 8));
+		std::uint64_t value = 0;
+		for (std::uint64_t idx_round = 0; idx_round < 500; ++idx_round)
+		{
+			for (std::uint64_t idx_hot = 0; idx_hot < 50; ++idx_hot)
+			{
+				if (!cache->find(idx_hot, value))
+				{
+					cache->put(idx_hot, idx_hot);
+				}
+			}
+			cache->put(1000 + idx_round, idx_round);
+		}
+
+		REQUIRE(cache->size() == 100);
+		for (std::uint64_t idx_hot = 0; idx_hot < 50; ++idx_hot)
+		{
+			REQUIRE(cache->contains(idx_hot));
+		}
+		REQUIRE(cache->contains(1499));
+		REQUIRE_FALSE(cache->contains(1000));
+	}
+
+	SECTION("A new key alone in its shard is never its own victim")
+	{
+		// Fill shard 0 within one clock tick, so every stamp ties with the new key's
+		for (std::uint64_t idx_key = 1000; idx_key < 1032; ++idx_key)
+		{
+			std::unique_ptr<cache_t> cache(new cache_t(8, eviction_t::global, 4, 1));
+			std::uint64_t key = 0;
+			for (std::size_t idx_for = 0; idx_for < 8; ++key)
+			{
+				if (cache->shard_index(key) == 0)
+				{
+					cache->put(key, key);
+					++idx_for;
+				}
+			}
+			if (cache->shard_index(idx_key) != 0)
+			{
+				cache->put(idx_key, idx_key);
+				REQUIRE(cache->contains(idx_key));
+				REQUIRE(cache->shard_size(0) == 7);
+			}
+		}
+	}
+
+	SECTION("Racing inserts of one key evict one entry for it")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(64, eviction_t::global, 4, 4));
+		for (std::uint64_t idx_for = 0; idx_for < 64; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+		}
+
+		// Every thread inserts the same keys, so most inserts race another one for the same key
+		std::vector<std::thread> workers;
+		for (std::size_t idx_thread = 0; idx_thread < 4; ++idx_thread)
+		{
+			workers.emplace_back(
+				[&cache]()
+				{
+					for (std::uint64_t idx_key = 10000; idx_key < 60000; ++idx_key)
+					{
+						cache->put(idx_key, idx_key);
+					}
+				});
+		}
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		REQUIRE(cache->size() == 64);
+		std::size_t held = 0;
+		for (std::size_t idx_shard = 0; idx_shard < cache->shard_count(); ++idx_shard)
+		{
+			held += cache->shard_size(idx_shard);
+		}
+		REQUIRE(held == 64);
+	}
+
+	SECTION("Erase and concurrent writers keep the size bounded")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(128, eviction_t::global, 8, 2));
+		cache->put(1, 10);
+		REQUIRE(cache->erase(1));
+		REQUIRE_FALSE(cache->erase(1));
+		REQUIRE_THROWS_AS(cache->get(1), std::out_of_range);
+
+		std::atomic<std::size_t> wrong(0);
+		std::vector<std::thread> workers;
+		for (std::size_t idx_thread = 0; idx_thread < 4; ++idx_thread)
+		{
+			workers.emplace_back(
+				[&cache, &wrong, idx_thread]()
+				{
+					std::uint64_t value = 0;
+					for (std::uint64_t idx_for = 0; idx_for < 20000; ++idx_for)
+					{
+						const std::uint64_t key = (idx_for * 7919U + idx_thread) % 512U;
+						if (cache->find(key, value) && value != key * 3U)
+						{
+							wrong.fetch_add(1, std::memory_order_relaxed);
+						}
+						cache->put(key, key * 3U);
+					}
+				});
+		}
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		REQUIRE(wrong.load() == 0);
+		REQUIRE(cache->size() <= cache->capacity());
+		std::size_t held = 0;
+		for (std::size_t idx_shard = 0; idx_shard < cache->shard_count(); ++idx_shard)
+		{
+			held += cache->shard_size(idx_shard);
+		}
+		REQUIRE(held == cache->size());
+	}
+}
+
+TEST_CASE("RCU cache", "[concurrent][rcu][unit]")
+{
+	using cache_t = cache_engine::concurrent::rcu_cache<std::uint64_t, std::uint64_t>;
+
+	SECTION("Staged changes become visible together on publish")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(4));
+		cache_t::reader reader = cache->make_reader();
+
+		cache->stage_put(1, 10);
+		cache->stage_put(2, 20);
+		cache->stage_put(1, 11);
+		REQUIRE_FALSE(reader.contains(1));
+		REQUIRE(cache->pending_changes() == 3);
+
+		REQUIRE(cache->publish() == 1);
+		REQUIRE(reader.get(1) == 11);
+		REQUIRE(reader.get(2) == 20);
+		REQUIRE(cache->size() == 2);
+
+		cache->erase(2);
+		REQUIRE_FALSE(reader.contains(2));
+		REQUIRE_THROWS_AS(reader.get(2), std::out_of_range);
+		REQUIRE(cache->version() == 2);
+	}
+
+	SECTION("A pinned version is reclaimed only after the reader releases it")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(4));
+		cache_t::reader reader = cache->make_reader();
+		cache->put(7, 70);
+
+		{
+			const cache_t::snapshot pinned = reader.pin();
+			cache->put(7, 71);
+			REQUIRE(*pinned.find(7) == 70);
+			REQUIRE(cache->retired_tables() >= 1);
+		}
+
+		cache->put(8, 80);
+		REQUIRE(cache->retired_tables() == 0);
+		REQUIRE(reader.get(7) == 71);
+	}
+
+	SECTION("Reader slots are limited and released with their handle")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(1));
+		{
+			cache_t::reader first = cache->make_reader();
+			REQUIRE_THROWS_AS(cache->make_reader(), std::runtime_error);
+		}
+		cache_t::reader second = cache->make_reader();
+		REQUIRE_FALSE(second.contains(1));
+	}
+
+	SECTION("Concurrent readers always see one whole version")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(8));
+		for (std::uint64_t idx_for = 0; idx_for < 64; ++idx_for)
+		{
+			cache->stage_put(idx_for, 0);
+		}
+		cache->publish();
+
+		std::atomic<bool> stop(false);
+		std::atomic<std::size_t> mixed(0);
+		std::vector<std::thread> readers;
+		for (std::size_t idx_thread = 0; idx_thread < 2; ++idx_thread)
+		{
+			readers.emplace_back(
+				[&cache, &stop, &mixed]()
+				{
+					cache_t::reader reader = cache->make_reader();
+					while (!stop.load(std::memory_order_relaxed))
+					{
+						const cache_t::snapshot pinned = reader.pin();
+						mixed.fetch_add((*pinned.find(0) != *pinned.find(63)) ? 1 : 0, std::memory_order_relaxed);
+					}
+				});
+		}
+
+		for (std::uint64_t idx_version = 1; idx_version <= 500; ++idx_version)
+		{
+			for (std::uint64_t idx_for = 0; idx_for < 64; ++idx_for)
+			{
+				cache->stage_put(idx_for, idx_version);
+			}
+			cache->publish();
+		}
+
+		stop.store(true);
+		for (auto& reader : readers)
+		{
+			reader.join();
+		}
+		cache->synchronize();
+
+		REQUIRE(mixed.load() == 0);
+		REQUIRE(cache->retired_tables() == 0);
+	}
+}
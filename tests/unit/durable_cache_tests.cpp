@@ -0,0 +1,242 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/durable/durable_cache.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+	using lru_t = cache_engine::policy_based_cache<std::uint64_t, std::string, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+												   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+	using durable_t = cache_engine::durable::durable_cache<std::uint64_t, std::string, lru_t>;
+
+	/**
+	 * @brief Empty directory removed with its files when the test section ends
+	 */
+	class scratch_directory
+	{
+	  private:
+		std::string m_path;
+
+	  public:
+		explicit scratch_directory(const std::string& p_name) : m_path("durable_test_" + p_name)
+		{
+			this->clean();
+			cache_engine::durable::detail::file_io::make_directory(m_path);
+		}
+
+		~scratch_directory()
+		{
+			this->clean();
+			::rmdir(m_path.c_str());
+		}
+
+		scratch_directory(const scratch_directory&)						 = delete;
+		auto operator=(const scratch_directory&) -> scratch_directory& = delete;
+
+		auto path() const -> const std::string& { return m_path; }
+
+		auto files(const std::string& p_prefix, const std::string& p_suffix) const -> std::size_t
+		{
+			return cache_engine::durable::detail::file_io::list_numbered(m_path, p_prefix, p_suffix).size();
+		}
+
+	  private:
+		auto clean() -> void
+		{
+			if (::access(m_path.c_str(), F_OK) != 0)
+			{
+				return;
+			}
+			for (const char* suffix : {".log", ".seg", ".seg.tmp"})
+			{
+				for (const char* prefix : {"wal-", "ckpt-"})
+				{
+					for (const auto& file : cache_engine::durable::detail::file_io::list_numbered(m_path, prefix, suffix))
+					{
+						std::remove(file.second.c_str());
+					}
+				}
+			}
+		}
+	};
+
+	auto manual_options() -> cache_engine::durable::durability_options
+	{
+		cache_engine::durable::durability_options options;
+		options.m_checkpoint_interval = std::chrono::milliseconds(0);
+		options.m_recovery_threads	  = 3;
+		return options;
+	}
+
+	auto open_cache(const std::string& p_directory, std::size_t p_capacity, const cache_engine::durable::durability_options& p_options) -> std::unique_ptr<durable_t>
+	{
+		return std::unique_ptr<durable_t>(new durable_t(p_directory, lru_t(p_capacity), p_options));
+	}
+} // namespace
+
+TEST_CASE("Durable cache", "[durable][unit]")
+{
+	SECTION("Puts and erases survive a restart through the log alone")
+	{
+		const scratch_directory directory("log_only");
+		{
+			std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, manual_options());
+			for (std::uint64_t idx_for = 0; idx_for < 100; ++idx_for)
+			{
+				cache->put(idx_for, "value-" + std::to_string(idx_for));
+			}
+			cache->put(7, "seven");
+			REQUIRE(cache->erase(8));
+			cache->sync();
+			REQUIRE((cache->stats().m_log.m_records == 102));
+		}
+
+		std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, manual_options());
+		REQUIRE((cache->recovery().m_log_records == 102));
+		REQUIRE((cache->recovery().m_last_lsn == 102));
+		REQUIRE((cache->size() == 99));
+		REQUIRE((cache->get(7) == "seven"));
+		REQUIRE((cache->get(99) == "value-99"));
+		REQUIRE_FALSE(cache->contains(8));
+	}
+
+	SECTION("Incremental checkpoints cover dirty keys and drop covered log files")
+	{
+		const scratch_directory directory("checkpoints");
+		cache_engine::durable::durability_options options = manual_options();
+		options.m_log.m_file_bytes						  = 256;
+		{
+			std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, options);
+			for (std::uint64_t idx_for = 0; idx_for < 200; ++idx_for)
+			{
+				cache->put(idx_for, std::string(20, 'a'));
+				cache->sync();
+			}
+			REQUIRE((cache->checkpoint() == 200));
+			REQUIRE((cache->checkpoint() == 0));
+			REQUIRE((cache->stats().m_log_files == 1));
+
+			cache->put(5, "five");
+			cache->erase(6);
+			REQUIRE((cache->checkpoint() == 2));
+			cache->put(300, "tail");
+		}
+
+		std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, options);
+		REQUIRE((cache->recovery().m_segments == 2));
+		REQUIRE((cache->recovery().m_segment_records == 202));
+		REQUIRE((cache->recovery().m_log_records == 1));
+		REQUIRE((cache->size() == 200));
+		REQUIRE((cache->get(5) == "five"));
+		REQUIRE((cache->get(300) == "tail"));
+		REQUIRE_FALSE(cache->contains(6));
+	}
+
+	SECTION("A long chain is merged into one base segment")
+	{
+		const scratch_directory directory("merge");
+		cache_engine::durable::durability_options options = manual_options();
+		options.m_max_chain								  = 2;
+		{
+			std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, options);
+			for (std::uint64_t idx_round = 0; idx_round < 5; ++idx_round)
+			{
+				for (std::uint64_t idx_for = 0; idx_for < 10; ++idx_for)
+				{
+					cache->put(idx_round * 5 + idx_for, std::to_string(idx_round));
+				}
+				cache->erase(idx_round * 5);
+				cache->checkpoint();
+			}
+			REQUIRE((cache->stats().m_merges >= 1));
+			REQUIRE((directory.files("ckpt-", ".seg") <= 2));
+		}
+
+		std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, options);
+		REQUIRE((cache->recovery().m_log_records == 0));
+		REQUIRE((cache->get(21) == "4"));
+		REQUIRE((cache->get(1) == "0"));
+		REQUIRE_FALSE(cache->contains(20));
+		REQUIRE_FALSE(cache->contains(0));
+		REQUIRE((cache->size() == 25));
+	}
+
+	SECTION("A torn log tail is dropped and the log keeps working")
+	{
+		const scratch_directory directory("torn");
+		{
+			std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, manual_options());
+			cache->put(1, "one");
+			cache->put(2, "two");
+		}
+		{
+			// Half a record, as left by a crash in the middle of a write
+			const auto logs = cache_engine::durable::detail::file_io::list_numbered(directory.path(), "wal-", ".log");
+			std::ofstream out(logs.back().second.c_str(), std::ios::binary | std::ios::app);
+			out.write("\x30\x00\x00\x00\x01\x02", 6);
+		}
+		{
+			std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, manual_options());
+			REQUIRE(cache->recovery().m_torn_tail);
+			REQUIRE((cache->size() == 2));
+			cache->put(3, "three");
+		}
+
+		std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, manual_options());
+		REQUIRE_FALSE(cache->recovery().m_torn_tail);
+		REQUIRE((cache->size() == 3));
+		REQUIRE((cache->get(3) == "three"));
+	}
+
+	SECTION("An emptied log file is not reopened or removed under the live log")
+	{
+		const scratch_directory directory("empty_log");
+		{
+			std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, manual_options());
+			cache->put(1, "one");
+			cache->sync();
+		}
+		{
+			// Everything in the file torn away, as after a crash before the first write landed
+			const auto logs = cache_engine::durable::detail::file_io::list_numbered(directory.path(), "wal-", ".log");
+			cache_engine::durable::detail::file_io::truncate_file(logs.back().second, 0);
+		}
+		{
+			std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, manual_options());
+			REQUIRE((cache->size() == 0));
+			cache->put(2, "two");
+			cache->sync();
+			REQUIRE((cache->checkpoint() == 1));
+			cache->put(3, "three");
+			cache->sync();
+			REQUIRE((cache->stats().m_log_files == 1));
+		}
+
+		std::unique_ptr<durable_t> cache = open_cache(directory.path(), 1000, manual_options());
+		REQUIRE((cache->get(2) == "two"));
+		REQUIRE((cache->get(3) == "three"));
+		REQUIRE((cache->recovery().m_last_lsn == 2));
+	}
+
+	SECTION("Waiting for durability shares syncs across a batch")
+	{
+		const scratch_directory directory("wait");
+		cache_engine::durable::durability_options options = manual_options();
+		options.m_wait_for_durability					  = true;
+
+		std::unique_ptr<durable_t> cache = open_cache(directory.path(), 100, options);
+		for (std::uint64_t idx_for = 0; idx_for < 20; ++idx_for)
+		{
+			cache->put(idx_for, "x");
+		}
+		const cache_engine::durable::log_stats stats = cache->stats().m_log;
+		REQUIRE((stats.m_records == 20));
+		REQUIRE((stats.m_syncs <= 20));
+		REQUIRE((stats.m_syncs >= 1));
+	}
+}
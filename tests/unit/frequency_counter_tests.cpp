@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/policies/all_policies.hpp>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+TEST_CASE("Dense frequency counters", "[frequency][unit]")
+{
+	SECTION("Halving matches the scalar reference across the vector tail")
+	{
+		cache_engine::policies::dense_frequency_counters<std::uint8_t> counters;
+		for (std::size_t idx_for = 0; idx_for < 77U; ++idx_for)
+		{
+			counters.push_back(static_cast<std::uint8_t>((idx_for * 37U) & 0xFFU));
+		}
+
+		counters.halve_all();
+
+		for (std::size_t idx_for = 0; idx_for < 77U; ++idx_for)
+		{
+			REQUIRE((counters[idx_for] == static_cast<std::uint8_t>(((idx_for * 37U) & 0xFFU) >> 1U)));
+		}
+	}
+
+	SECTION("16-bit counters halve without borrowing from neighbours")
+	{
+		cache_engine::policies::dense_frequency_counters<std::uint16_t> counters;
+		for (std::size_t idx_for = 0; idx_for < 40U; ++idx_for)
+		{
+			counters.push_back(static_cast<std::uint16_t>(0xFFFFU - idx_for));
+		}
+
+		counters.halve_all();
+
+		for (std::size_t idx_for = 0; idx_for < 40U; ++idx_for)
+		{
+			REQUIRE((counters[idx_for] == static_cast<std::uint16_t>((0xFFFFU - idx_for) >> 1U)));
+		}
+	}
+
+	SECTION("Minimum slot search finds the first minimum in a block")
+	{
+		cache_engine::policies::dense_frequency_counters<std::uint8_t> counters;
+		for (std::size_t idx_for = 0; idx_for < 100U; ++idx_for)
+		{
+			counters.push_back(200);
+		}
+		counters.swap_remove(99);
+		counters.push_back(3);
+		counters.push_back(3);
+
+		REQUIRE((counters.min_slot(0, counters.size()) == 99U));
+		REQUIRE((counters.min_slot(0, 50) < 50U));
+		REQUIRE((counters.min_slot(100, 10) == 100U));
+	}
+
+	SECTION("Increment saturates at the counter maximum")
+	{
+		cache_engine::policies::dense_frequency_counters<std::uint8_t> counters;
+		const std::size_t slot = counters.push_back(253);
+
+		REQUIRE_FALSE(counters.increment(slot));
+		REQUIRE(counters.increment(slot));
+		REQUIRE(counters.increment(slot));
+		REQUIRE((counters[slot] == 255U));
+	}
+}
+
+TEST_CASE("Sampled LFU eviction policy", "[frequency][lfu][unit]")
+{
+	SECTION("Evicts the least frequent key when the sample covers all keys")
+	{
+		std::unique_ptr<cache_engine::policies::sampled_lfu_eviction_policy<std::int32_t, std::int32_t>> policy(new cache_engine::policies::sampled_lfu_eviction_policy<std::int32_t, std::int32_t>());
+
+		for (std::int32_t idx_for = 0; idx_for < 10; ++idx_for)
+		{
+			policy->on_insert(idx_for);
+		}
+		for (std::int32_t idx_for = 0; idx_for < 10; ++idx_for)
+		{
+			if (idx_for != 6)
+			{
+				policy->on_access(idx_for);
+			}
+		}
+
+		REQUIRE((policy->select_victim() == 6));
+		policy->remove_key(6);
+		REQUIRE((policy->size() == 9U));
+		REQUIRE((policy->frequency(6) == 0U));
+		REQUIRE((policy->frequency(9) == 2U));
+	}
+
+	SECTION("Aging halves all frequencies")
+	{
+		std::unique_ptr<cache_engine::policies::sampled_lfu16_eviction_policy<std::int32_t, std::int32_t>> policy(new cache_engine::policies::sampled_lfu16_eviction_policy<std::int32_t, std::int32_t>());
+		policy->on_insert(1);
+		for (std::int32_t idx_for = 0; idx_for < 7; ++idx_for)
+		{
+			policy->on_access(1);
+		}
+
+		REQUIRE((policy->frequency(1) == 8U));
+		policy->age();
+		REQUIRE((policy->frequency(1) == 4U));
+		REQUIRE((policy->aging_count() == 1U));
+	}
+
+	SECTION("Works as a policy_based_cache eviction policy")
+	{
+		cache_engine::policy_based_cache<std::int32_t, std::int32_t, cache_engine::policy_templates::sampled_lfu_eviction, cache_engine::policy_templates::hash_storage,
+										 cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>
+			lfu_cache(3);
+
+		lfu_cache.put(1, 10);
+		lfu_cache.put(2, 20);
+		lfu_cache.put(3, 30);
+		REQUIRE((lfu_cache.get(1) == 10));
+		REQUIRE((lfu_cache.get(3) == 30));
+
+		lfu_cache.put(4, 40);
+
+		REQUIRE_FALSE(lfu_cache.contains(2));
+		REQUIRE((lfu_cache.size() == 3U));
+	}
+
+	SECTION("Empty policy refuses to select a victim")
+	{
+		std::unique_ptr<cache_engine::policies::sampled_lfu_eviction_policy<std::int32_t, std::int32_t>> policy(new cache_engine::policies::sampled_lfu_eviction_policy<std::int32_t, std::int32_t>());
+		REQUIRE_THROWS_AS(policy->select_victim(), std::runtime_error);
+	}
+}
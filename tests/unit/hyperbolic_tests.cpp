@@ -0,0 +1,121 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+	using policy_t = cache_engine::policies::hyperbolic_eviction_policy<std::int32_t, std::int32_t>;
+	using cache_t  = cache_engine::policy_based_cache<std::int32_t, std::int32_t, cache_engine::policy_templates::hyperbolic_eviction, cache_engine::policy_templates::hash_storage,
+													  cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+} // namespace
+
+TEST_CASE("Hyperbolic eviction policy", "[hyperbolic][unit]")
+{
+	SECTION("A young key with a high rate outranks an old key with a larger count")
+	{
+		std::unique_ptr<policy_t> policy(new policy_t());
+
+		// Key 1 collects 20 hits early, key 3 keeps the clock moving, key 2 arrives late
+		policy->on_insert(1);
+		for (std::int32_t idx_for = 0; idx_for < 19; ++idx_for)
+		{
+			policy->on_access(1);
+		}
+		policy->on_insert(3);
+		for (std::int32_t idx_for = 0; idx_for < 200; ++idx_for)
+		{
+			policy->on_access(3);
+		}
+		policy->on_insert(2);
+		for (std::int32_t idx_for = 0; idx_for < 4; ++idx_for)
+		{
+			policy->on_access(2);
+		}
+
+		REQUIRE((policy->hits(1) == 20U));
+		REQUIRE((policy->hits(2) == 5U));
+		REQUIRE(policy->priority(1) == Approx(20.0 / 226.0));
+		REQUIRE(policy->priority(2) == Approx(1.0));
+		REQUIRE((policy->select_victim() == 1));
+	}
+
+	SECTION("Priorities decay as the clock moves")
+	{
+		std::unique_ptr<policy_t> policy(new policy_t());
+		policy->on_insert(1);
+		policy->on_insert(2);
+		const double before = policy->priority(1);
+		for (std::int32_t idx_for = 0; idx_for < 8; ++idx_for)
+		{
+			policy->on_access(2);
+		}
+		REQUIRE(policy->priority(1) < before);
+		REQUIRE(policy->priority(1) == Approx(0.1));
+		REQUIRE((policy->select_victim() == 1));
+
+		policy->remove_key(1);
+		REQUIRE((policy->size() == 1U));
+		REQUIRE((policy->hits(1) == 0U));
+		REQUIRE(policy->priority(1) == Approx(0.0));
+		REQUIRE((policy->select_victim() == 2));
+	}
+
+	SECTION("Sampling a large population almost never picks a hot key")
+	{
+		std::unique_ptr<policy_t> policy(new policy_t());
+		policy->set_seed(7);
+		REQUIRE((policy->sample_size() == 64U));
+		for (std::int32_t idx_for = 0; idx_for < 1000; ++idx_for)
+		{
+			policy->on_insert(idx_for);
+		}
+		for (std::int32_t idx_round = 0; idx_round < 10; ++idx_round)
+		{
+			for (std::int32_t idx_for = 0; idx_for < 500; ++idx_for)
+			{
+				policy->on_access(idx_for);
+			}
+		}
+
+		for (std::int32_t idx_for = 0; idx_for < 100; ++idx_for)
+		{
+			const std::int32_t victim = policy->select_victim();
+			REQUIRE(victim >= 500);
+			policy->remove_key(victim);
+		}
+		REQUIRE((policy->size() == 900U));
+		REQUIRE((policy->hits(0) == 11U));
+
+		policy->set_sample_size(0);
+		REQUIRE((policy->sample_size() == 1U));
+	}
+
+	SECTION("Works as a policy_based_cache eviction policy")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(3));
+		cache->put(1, 10);
+		cache->put(2, 20);
+		cache->put(3, 30);
+		REQUIRE((cache->get(1) == 10));
+		REQUIRE((cache->get(1) == 10));
+		REQUIRE((cache->get(3) == 30));
+
+		cache->put(4, 40);
+
+		REQUIRE_FALSE(cache->contains(2));
+		REQUIRE((cache->size() == 3U));
+		REQUIRE((cache->get(4) == 40));
+	}
+
+	SECTION("Empty policy refuses to select a victim")
+	{
+		std::unique_ptr<policy_t> policy(new policy_t());
+		REQUIRE_THROWS_AS(policy->select_victim(), std::runtime_error);
+		policy->on_insert(1);
+		policy->clear();
+		REQUIRE(policy->empty());
+		REQUIRE_THROWS_AS(policy->select_victim(), std::runtime_error);
+	}
+}
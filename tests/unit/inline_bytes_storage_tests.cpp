@@ -0,0 +1,154 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+	using bytes_t	= cache_engine::policies::inline_bytes;
+	using storage_t = cache_engine::policies::inline_bytes_storage_policy<std::uint64_t, bytes_t>;
+	using cache_t	= cache_engine::policy_based_cache<std::uint64_t, bytes_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::inline_bytes_storage,
+													   cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	// Value of p_size bytes derived from p_seed
+	auto make_text(std::size_t p_size, std::uint64_t p_seed) -> std::string;
+
+	auto make_text(std::size_t p_size, std::uint64_t p_seed) -> std::string
+	{
+		std::string text(p_size, ' ');
+		for (std::size_t idx_for = 0; idx_for < p_size; ++idx_for)
+		{
+			text[idx_for] = static_cast<char>('a' + (p_seed + idx_for) % 26);
+		}
+		return text;
+	}
+} // namespace
+
+TEST_CASE("Inline bytes storage", "[inline_bytes]")
+{
+	SECTION("Values up to 24 bytes stay inline and copies own their bytes")
+	{
+		const bytes_t small(make_text(24, 1));
+		REQUIRE(sizeof(bytes_t) == 32);
+		REQUIRE(small.is_inline());
+		REQUIRE(small.str() == make_text(24, 1));
+
+		const bytes_t large(make_text(25, 2));
+		REQUIRE_FALSE(large.is_inline());
+		bytes_t copy(large);
+		REQUIRE(copy == large);
+		REQUIRE(copy.data() != large.data());
+
+		bytes_t moved(std::move(copy));
+		REQUIRE(moved.str() == make_text(25, 2));
+		REQUIRE(copy.empty());
+
+		moved = small;
+		REQUIRE(moved.is_inline());
+		REQUIRE(moved == small);
+		REQUIRE(bytes_t().empty());
+	}
+
+	SECTION("Large values go to the value heap and are given back on update and erase")
+	{
+		std::unique_ptr<storage_t> storage(new storage_t());
+		REQUIRE(storage->insert(1, bytes_t(make_text(8, 1))));
+		REQUIRE(storage->insert(2, bytes_t(make_text(100, 2))));
+		REQUIRE(storage->out_of_line_count() == 1);
+		REQUIRE(storage->heap_bytes() == 128);
+		REQUIRE(storage->find(1)->is_inline());
+		REQUIRE(storage->find(2)->str() == make_text(100, 2));
+
+		// Replacing a large value with a small one frees its block, and the other way round
+		REQUIRE_FALSE(storage->insert(2, bytes_t(make_text(3, 9))));
+		REQUIRE(storage->heap_bytes() == 0);
+		REQUIRE_FALSE(storage->insert(1, bytes_t(make_text(5000, 3))));
+		REQUIRE(storage->heap_bytes() == 5000);
+		REQUIRE(storage->find(1)->str() == make_text(5000, 3));
+
+		// A value read out of the storage survives the entry
+		const bytes_t kept = *storage->find(1);
+		REQUIRE(storage->erase(1));
+		REQUIRE_FALSE(storage->erase(1));
+		REQUIRE(storage->heap_bytes() == 0);
+		REQUIRE(kept.str() == make_text(5000, 3));
+		REQUIRE(storage->find(1) == nullptr);
+		REQUIRE(storage->size() == 1);
+	}
+
+	SECTION("Random inserts and erases match a reference map through growth")
+	{
+		std::unique_ptr<storage_t> storage(new storage_t());
+		std::map<std::uint64_t, std::string> model;
+		std::mt19937_64 rng(7);
+		for (std::size_t idx_for = 0; idx_for < 20000; ++idx_for)
+		{
+			const std::uint64_t key = rng() % 3000;
+			if (rng() % 3 == 0)
+			{
+				REQUIRE(storage->erase(key) == (model.erase(key) > 0));
+			}
+			else
+			{
+				const std::string text = make_text(static_cast<std::size_t>(rng() % 80), key + idx_for);
+				REQUIRE(storage->insert(key, bytes_t(text)) == (model.find(key) == model.end()));
+				model[key] = text;
+			}
+		}
+
+		REQUIRE(storage->size() == model.size());
+		std::size_t out_of_line = 0;
+		for (const auto& entry : model)
+		{
+			const bytes_t* value = storage->find(entry.first);
+			REQUIRE(value != nullptr);
+			REQUIRE(value->str() == entry.second);
+			out_of_line += entry.second.size() > bytes_t::inline_capacity ? 1U : 0U;
+		}
+		REQUIRE(storage->out_of_line_count() == out_of_line);
+		for (std::uint64_t key = 0; key < 3000; ++key)
+		{
+			REQUIRE(storage->contains(key) == (model.find(key) != model.end()));
+		}
+
+		// Partitions cover every entry once
+		std::size_t visited = 0;
+		for (std::size_t idx_part = 0; idx_part < 5; ++idx_part)
+		{
+			storage->visit_partition(idx_part, 5,
+									 [&model, &visited](const std::uint64_t& p_key, const bytes_t& p_value)
+									 {
+										 ++visited;
+										 REQUIRE(model.at(p_key) == p_value.str());
+									 });
+		}
+		REQUIRE(visited == model.size());
+
+		storage->clear();
+		REQUIRE(storage->empty());
+		REQUIRE(storage->heap_bytes() == 0);
+		REQUIRE(storage->out_of_line_count() == 0);
+		REQUIRE(storage->insert(5, bytes_t(make_text(40, 5))));
+		REQUIRE(storage->find(5)->str() == make_text(40, 5));
+	}
+
+	SECTION("Works as the storage of a policy based cache")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(100));
+		for (std::uint64_t idx_for = 0; idx_for < 250; ++idx_for)
+		{
+			cache->put(idx_for, bytes_t(make_text(static_cast<std::size_t>(idx_for % 60), idx_for)));
+		}
+		REQUIRE(cache->size() == 100);
+		REQUIRE_FALSE(cache->contains(149));
+		REQUIRE(cache->get(249).str() == make_text(249 % 60, 249));
+		REQUIRE(cache->get(150).str() == make_text(150 % 60, 150));
+		REQUIRE(cache->storage_policy().out_of_line_count() < 100);
+		REQUIRE_THROWS_AS(cache->get(0), std::out_of_range);
+	}
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/lazy/lazy_value.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	std::atomic<std::size_t> g_decodes(0);
+
+	/**
+	 * @brief String decoder that counts its calls and rejects "bad"
+	 */
+	struct counting_decoder
+	{
+		auto operator()(const char* p_data, std::size_t p_bytes, std::string& p_value) const -> bool
+		{
+			g_decodes.fetch_add(1, std::memory_order_relaxed);
+			p_value.assign(p_data, p_bytes);
+			return p_value != "bad";
+		}
+	};
+
+	using lazy_t  = cache_engine::lazy::lazy_value<std::string, counting_decoder>;
+	using cache_t = cache_engine::policy_based_cache<std::uint64_t, lazy_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+													 cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::ledger_capacity>;
+} // namespace
+
+TEST_CASE("Lazy values", "[lazy][unit]")
+{
+	g_decodes.store(0);
+
+	SECTION("Decodes once, on the first read of any copy")
+	{
+		const lazy_t value(std::string("payload"));
+		const lazy_t copy = value;
+		REQUIRE_FALSE(value.is_decoded());
+		REQUIRE(g_decodes.load() == 0);
+
+		REQUIRE(copy.get() == "payload");
+		REQUIRE(value.is_decoded());
+		REQUIRE(value.get() == "payload");
+		REQUIRE(g_decodes.load() == 1);
+
+		REQUIRE_THROWS_AS(lazy_t().get(), std::logic_error);
+		REQUIRE_THROWS_AS(lazy_t(std::string("bad")).get(), std::runtime_error);
+	}
+
+	SECTION("The ledger charge switches from serialized to decoded size")
+	{
+		std::shared_ptr<cache_engine::lazy::byte_ledger> ledger = std::make_shared<cache_engine::lazy::byte_ledger>();
+		{
+			const lazy_t value(std::string(100, 'x'), ledger);
+			REQUIRE(ledger->bytes() == 100);
+			REQUIRE(value.charged_bytes() == 100);
+
+			value.get();
+			const std::size_t decoded = cache_engine::lazy::decoded_size<std::string>()(value.get());
+			REQUIRE(value.charged_bytes() == decoded);
+			REQUIRE(ledger->bytes() == decoded);
+
+			const lazy_t eager = lazy_t::from_value(std::string(10, 'y'), ledger);
+			REQUIRE(eager.is_decoded());
+			REQUIRE(ledger->bytes() == decoded + eager.charged_bytes());
+		}
+		REQUIRE(ledger->bytes() == 0);
+	}
+
+	SECTION("A cache on the ledger capacity policy evicts once decoded values outgrow the byte budget")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(1000));
+		cache->capacity_policy().set_byte_limit(2000);
+		const std::shared_ptr<cache_engine::lazy::byte_ledger>& ledger = cache->capacity_policy().ledger();
+		for (std::uint64_t idx_for = 0; idx_for < 100; ++idx_for)
+		{
+			cache->put(idx_for, lazy_t(std::string(16, 'a'), ledger));
+		}
+		REQUIRE(cache->size() == 100);
+		REQUIRE(cache->capacity_policy().charged_bytes() == 1600);
+		REQUIRE(g_decodes.load() == 0);
+
+		// Reading through the cache decodes the stored value, not just the returned copy
+		for (std::uint64_t idx_for = 50; idx_for < 100; ++idx_for)
+		{
+			REQUIRE(cache->get(idx_for).get() == std::string(16, 'a'));
+		}
+		REQUIRE(g_decodes.load() == 50);
+		REQUIRE(cache->capacity_policy().charged_bytes() > 2000);
+
+		for (std::uint64_t idx_for = 100; idx_for < 110; ++idx_for)
+		{
+			cache->put(idx_for, lazy_t(std::string(16, 'b'), ledger));
+		}
+		REQUIRE(cache->size() < 100);
+		REQUIRE(cache->capacity_policy().charged_bytes() <= 2000 + 16);
+		REQUIRE(g_decodes.load() == 50);
+
+		// The entry limit still applies on its own
+		cache->capacity_policy().set_byte_limit(std::size_t(1) << 20U);
+		cache->capacity_policy().set_capacity(cache->size());
+		cache->put(200, lazy_t(std::string(16, 'c'), ledger));
+		REQUIRE(cache->size() <= cache->capacity_policy().capacity());
+	}
+
+	SECTION("Concurrent first reads decode once")
+	{
+		const lazy_t value(std::string("shared"));
+		std::atomic<std::size_t> wrong(0);
+		std::vector<std::thread> readers;
+		for (std::size_t idx_thread = 0; idx_thread < 4; ++idx_thread)
+		{
+			readers.emplace_back(
+				[value, &wrong]()
+				{
+					for (std::size_t idx_for = 0; idx_for < 1000; ++idx_for)
+					{
+						if (value.get() != "shared")
+						{
+							wrong.fetch_add(1, std::memory_order_relaxed);
+						}
+					}
+				});
+		}
+		for (auto& reader : readers)
+		{
+			reader.join();
+		}
+
+		REQUIRE(wrong.load() == 0);
+		REQUIRE(g_decodes.load() == 1);
+	}
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace
+{
+	using lru_cache_t = cache_engine::policy_based_cache<std::int32_t, std::string, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+														 cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+	using threshold_cache_t =
+		cache_engine::policy_based_cache<std::int32_t, std::int32_t, cache_engine::policy_templates::lfu_eviction, cache_engine::policy_templates::hash_storage,
+										 cache_engine::policy_templates::threshold_access, cache_engine::policy_templates::fixed_capacity>;
+
+	auto string_heap(const std::int32_t&, const std::string& p_value) -> std::size_t { return p_value.size(); }
+
+	/**
+	 * @brief Drive a cache specialization through updates, evictions and clear while checking its report
+	 */
+	template <typename cache_t> auto check_specialization() -> void
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(4));
+		REQUIRE((cache->memory_usage().m_storage_nodes == 0U));
+		REQUIRE((cache->memory_usage().m_bucket_arrays == 0U));
+
+		cache->put(1, "a");
+		cache->set_heap_size_function(string_heap);
+		REQUIRE((cache->memory_usage().m_owned_heap == 1U));
+
+		cache->put(2, "bb");
+		cache->put(3, "ccc");
+		cache->put(1, "aaaa");
+		REQUIRE((cache->memory_usage().m_owned_heap == 9U));
+
+		// Each insert beyond capacity drops one entry, whose bytes leave the total
+		for (std::int32_t idx_for = 10; idx_for < 20; ++idx_for)
+		{
+			cache->put(idx_for, "xxxxx");
+		}
+		std::size_t expected = 0;
+		for (std::int32_t idx_for = 0; idx_for < 20; ++idx_for)
+		{
+			expected += cache->contains(idx_for) ? ((idx_for >= 10) ? 5U : (idx_for == 1) ? 4U : static_cast<std::size_t>(idx_for)) : 0U;
+		}
+		const cache_engine::memory_report report = cache->memory_usage();
+		REQUIRE((report.m_owned_heap == expected));
+		REQUIRE((report.m_storage_nodes >= 4U * (sizeof(std::int32_t) + sizeof(std::string))));
+		REQUIRE((report.m_bucket_arrays > 0U));
+		REQUIRE((report.m_eviction_metadata > 0U));
+		REQUIRE((report.m_access_metadata == 0U));
+
+		cache->clear();
+		REQUIRE((cache->memory_usage().m_owned_heap == 0U));
+		REQUIRE((cache->memory_usage().m_storage_nodes == 0U));
+	}
+} // namespace
+
+TEST_CASE("Memory usage reports", "[memory_usage][unit]")
+{
+	SECTION("Storage nodes and eviction metadata follow the entry count")
+	{
+		std::unique_ptr<lru_cache_t> cache(new lru_cache_t(64));
+		const cache_engine::memory_report empty = cache->memory_usage();
+		REQUIRE((empty.m_storage_nodes == 0U));
+		REQUIRE((empty.m_eviction_metadata == empty.m_bucket_arrays));
+		REQUIRE((empty.m_owned_heap == 0U));
+
+		for (std::int32_t idx_for = 0; idx_for < 40; ++idx_for)
+		{
+			cache->put(idx_for, "value");
+		}
+		const std::size_t node = cache_engine::policies::containers::hash_node_bytes<std::int32_t, std::string>();
+		REQUIRE((node >= sizeof(void*) + sizeof(std::int32_t) + sizeof(std::string)));
+		REQUIRE((cache->memory_usage().m_storage_nodes == 40U * node));
+		REQUIRE((cache->memory_usage().m_bucket_arrays >= 64U * sizeof(void*)));
+
+		// The LRU list holds one node per key, the key index one more hash node per key
+		const std::size_t list_node = cache_engine::policies::containers::list_node_bytes<std::int32_t>();
+		REQUIRE((list_node == 2U * sizeof(void*) + sizeof(void*)));
+		REQUIRE((cache->memory_usage().m_eviction_metadata > 40U * list_node));
+
+		const std::size_t before = cache->memory_usage().m_storage_nodes;
+		REQUIRE(cache->erase(7));
+		REQUIRE((cache->memory_usage().m_storage_nodes == before - node));
+		REQUIRE((cache->memory_usage().m_access_metadata == 0U));
+	}
+
+	SECTION("The owned heap follows inserts, updates, evictions, erases and clear")
+	{
+		std::unique_ptr<lru_cache_t> cache(new lru_cache_t(3));
+		cache->put(1, "one");
+		cache->put(2, "two");
+		cache->set_heap_size_function(string_heap);
+		REQUIRE((cache->memory_usage().m_owned_heap == 6U));
+
+		cache->put(2, "second");
+		REQUIRE((cache->memory_usage().m_owned_heap == 9U));
+		cache->put(3, "3");
+		cache->put(4, "four");
+		REQUIRE_FALSE(cache->contains(1));
+		REQUIRE((cache->memory_usage().m_owned_heap == 11U));
+
+		REQUIRE(cache->erase(2));
+		REQUIRE_FALSE(cache->erase(2));
+		REQUIRE((cache->memory_usage().m_owned_heap == 5U));
+		REQUIRE((cache->erase_if([](const std::int32_t& p_key, const std::string&) { return p_key == 4; }) == 1U));
+		REQUIRE((cache->memory_usage().m_owned_heap == 1U));
+
+		cache->clear();
+		REQUIRE((cache->memory_usage().m_owned_heap == 0U));
+
+		cache->set_heap_size_function(lru_cache_t::size_function());
+		cache->put(5, "five");
+		REQUIRE((cache->memory_usage().m_owned_heap == 0U));
+		REQUIRE((cache->memory_usage().total() > 0U));
+	}
+
+	SECTION("Threshold access counts show up as access metadata and outlive evictions")
+	{
+		std::unique_ptr<threshold_cache_t> cache(new threshold_cache_t(8));
+		const std::size_t empty = cache->memory_usage().m_access_metadata;
+
+		for (std::int32_t idx_for = 0; idx_for < 32; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+			REQUIRE((cache->get(idx_for) == idx_for));
+		}
+		REQUIRE((cache->size() == 8U));
+		const std::size_t counted = cache->memory_usage().m_access_metadata;
+		REQUIRE((counted >= empty + 32U * cache_engine::policies::containers::hash_node_bytes<std::int32_t, std::size_t>()));
+
+		// Clearing the counts frees the nodes; the grown bucket array stays
+		cache->access_policy().clear_access_counts();
+		REQUIRE((cache->memory_usage().m_access_metadata == counted - 32U * cache_engine::policies::containers::hash_node_bytes<std::int32_t, std::size_t>()));
+	}
+
+	SECTION("Cache specializations report their structures and owned heap")
+	{
+		check_specialization<cache_engine::cache<std::int32_t, std::string, cache_engine::algorithm::lru>>();
+		check_specialization<cache_engine::cache<std::int32_t, std::string, cache_engine::algorithm::mru>>();
+		check_specialization<cache_engine::cache<std::int32_t, std::string, cache_engine::algorithm::fifo>>();
+		check_specialization<cache_engine::cache<std::int32_t, std::string, cache_engine::algorithm::lfu>>();
+		check_specialization<cache_engine::cache<std::int32_t, std::string, cache_engine::algorithm::mfu>>();
+		check_specialization<cache_engine::cache<std::int32_t, std::string, cache_engine::algorithm::random_cache>>();
+	}
+}
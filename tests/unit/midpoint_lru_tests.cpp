@@ -0,0 +1,168 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	/**
+	 * @brief Clock the tests move by hand
+	 */
+	struct manual_clock
+	{
+		using rep						= std::int64_t;
+		using period					= std::nano;
+		using duration					= std::chrono::nanoseconds;
+		using time_point				= std::chrono::time_point<manual_clock>;
+		static constexpr bool is_steady = true;
+
+		static std::int64_t s_now;
+
+		static auto now() -> time_point { return time_point(duration(s_now)); }
+
+		static auto advance(std::chrono::seconds p_by) -> void { s_now += std::chrono::duration_cast<duration>(p_by).count(); }
+	};
+
+	std::int64_t manual_clock::s_now = 0;
+
+	using policy_t = cache_engine::policies::basic_midpoint_lru_eviction_policy<std::int32_t, std::int32_t, manual_clock>;
+	using cache_t  = cache_engine::policy_based_cache<std::int32_t, std::int32_t, cache_engine::policy_templates::midpoint_lru_eviction, cache_engine::policy_templates::hash_storage,
+													  cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+} // namespace
+
+TEST_CASE("Midpoint insertion LRU eviction policy", "[midpoint_lru][unit]")
+{
+	SECTION("A second access promotes a new key only after the dwell time")
+	{
+		std::unique_ptr<policy_t> policy(new policy_t());
+		REQUIRE(policy->min_dwell() == std::chrono::seconds(1));
+		policy->on_insert(1);
+		policy->on_insert(2);
+		policy->on_insert(3);
+
+		policy->on_access(1);
+		REQUIRE_FALSE(policy->is_young(1));
+		REQUIRE((policy->select_victim() == 1));
+
+		manual_clock::advance(std::chrono::seconds(2));
+		policy->on_access(1);
+		REQUIRE(policy->is_young(1));
+		REQUIRE((policy->promotions() == 1U));
+		REQUIRE((policy->young_size() == 1U));
+		REQUIRE((policy->old_size() == 2U));
+		REQUIRE((policy->select_victim() == 2));
+	}
+
+	SECTION("The young sublist keeps to its share and demotes its tail")
+	{
+		std::unique_ptr<policy_t> policy(new policy_t());
+		for (std::int32_t idx_for = 1; idx_for <= 8; ++idx_for)
+		{
+			policy->on_insert(idx_for);
+		}
+		manual_clock::advance(std::chrono::seconds(2));
+		for (std::int32_t idx_for = 1; idx_for <= 8; ++idx_for)
+		{
+			policy->on_access(idx_for);
+		}
+
+		REQUIRE((policy->young_size() == 5U));
+		REQUIRE((policy->old_size() == 3U));
+		REQUIRE_FALSE(policy->is_young(3));
+		REQUIRE(policy->is_young(4));
+		REQUIRE((policy->select_victim() == 1));
+
+		// A demoted key has already dwelled, so its next access promotes it again
+		policy->on_access(1);
+		REQUIRE(policy->is_young(1));
+		REQUIRE_FALSE(policy->is_young(4));
+
+		policy->remove_key(1);
+		policy->remove_key(2);
+		REQUIRE((policy->size() == 6U));
+		REQUIRE((policy->young_size() + policy->old_size() == 6U));
+	}
+
+	SECTION("Monotonic runs of keys are inserted at the tail")
+	{
+		std::unique_ptr<policy_t> policy(new policy_t());
+		policy->set_scan_detection(4, 2);
+		policy->on_insert(100);
+		policy->on_insert(7);
+		policy->on_insert(55);
+		for (std::int32_t idx_for = 1000; idx_for < 1010; ++idx_for)
+		{
+			policy->on_insert(idx_for);
+		}
+		REQUIRE((policy->scan_inserts() == 7U));
+		REQUIRE((policy->select_victim() == 1009));
+
+		// Descending runs and runs with small gaps count too; a large jump ends the run
+		for (std::int32_t idx_for = 0; idx_for < 5; ++idx_for)
+		{
+			policy->on_insert(-2 * idx_for);
+		}
+		REQUIRE((policy->scan_inserts() == 9U));
+		policy->on_insert(500);
+		REQUIRE((policy->scan_inserts() == 9U));
+		REQUIRE((policy->select_victim() == -8));
+
+		policy->set_scan_detection(0);
+		for (std::int32_t idx_for = 2000; idx_for < 2010; ++idx_for)
+		{
+			policy->on_insert(idx_for);
+		}
+		REQUIRE((policy->scan_inserts() == 9U));
+	}
+
+	SECTION("Keys without an order are never treated as a scan")
+	{
+		std::unique_ptr<cache_engine::policies::midpoint_lru_eviction_policy<std::string, std::int32_t>> policy(new cache_engine::policies::midpoint_lru_eviction_policy<std::string, std::int32_t>());
+		policy->set_scan_detection(2);
+		for (std::int32_t idx_for = 0; idx_for < 10; ++idx_for)
+		{
+			policy->on_insert(std::to_string(idx_for));
+		}
+		REQUIRE((policy->scan_inserts() == 0U));
+		REQUIRE((policy->select_victim() == "0"));
+	}
+
+	SECTION("A scan through a policy_based_cache leaves the hot keys in place")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(100));
+		cache->eviction_policy().set_min_dwell(std::chrono::steady_clock::duration::zero());
+		for (std::int32_t idx_for = 0; idx_for < 50; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+			REQUIRE((cache->get(idx_for) == idx_for));
+		}
+
+		for (std::int32_t idx_for = 1000; idx_for < 2000; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+		}
+
+		REQUIRE((cache->size() == 100U));
+		for (std::int32_t idx_for = 0; idx_for < 50; ++idx_for)
+		{
+			REQUIRE(cache->contains(idx_for));
+		}
+		REQUIRE(cache->eviction_policy().scan_inserts() > 900U);
+	}
+
+	SECTION("Invalid settings and empty policies are rejected")
+	{
+		std::unique_ptr<policy_t> policy(new policy_t());
+		REQUIRE_THROWS_AS(policy->select_victim(), std::runtime_error);
+		REQUIRE_THROWS_AS(policy->set_old_fraction(0.0), std::invalid_argument);
+		REQUIRE_THROWS_AS(policy->set_old_fraction(1.0), std::invalid_argument);
+		policy->set_old_fraction(0.5);
+		REQUIRE(policy->old_fraction() == Approx(0.5));
+		policy->on_insert(1);
+		policy->clear();
+		REQUIRE(policy->empty());
+	}
+}
@@ -0,0 +1,188 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/immutable/mph_table.hpp>
+#include <cache_engine/immutable/tiered_cache.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	using builder_t = cache_engine::immutable::mph_builder<std::uint64_t, std::uint64_t>;
+	using table_t	= cache_engine::immutable::mph_table<std::uint64_t, std::uint64_t>;
+
+	struct point_key
+	{
+		std::uint32_t m_x;
+		std::uint32_t m_y;
+	};
+
+	/**
+	 * @brief Removes the table file when the test section ends
+	 */
+	class scratch_file
+	{
+	  private:
+		std::string m_path;
+
+	  public:
+		explicit scratch_file(const std::string& p_name) : m_path("mph_table_test_" + p_name + ".mph") {}
+
+		~scratch_file() { std::remove(m_path.c_str()); }
+
+		scratch_file(const scratch_file&)					 = delete;
+		auto operator=(const scratch_file&) -> scratch_file& = delete;
+
+		auto path() const -> const std::string& { return m_path; }
+	};
+
+	auto scrambled(std::uint64_t p_index) -> std::uint64_t { return p_index * 0x9E3779B97F4A7C15ULL + 17U; }
+} // namespace
+
+TEST_CASE("Minimal perfect hash table", "[immutable][mph][unit]")
+{
+	const std::size_t count = 100000;
+
+	SECTION("Every built key is found with its value and absent keys are rejected")
+	{
+		const scratch_file file("round_trip");
+		builder_t builder(count);
+		for (std::uint64_t idx_for = 0; idx_for < count; ++idx_for)
+		{
+			builder.add(scrambled(idx_for), idx_for);
+		}
+		const cache_engine::immutable::mph_build_info info = builder.write(file.path());
+
+		REQUIRE((info.m_entries == count));
+		REQUIRE((info.m_index_bits_per_key < 8.0));
+
+		const table_t table(file.path());
+		REQUIRE((table.size() == count));
+		REQUIRE(table.has_keys());
+
+		std::size_t wrong = 0;
+		for (std::uint64_t idx_for = 0; idx_for < count; ++idx_for)
+		{
+			std::uint64_t value = 0;
+			wrong += (table.find(scrambled(idx_for), value) && value == idx_for) ? 0U : 1U;
+		}
+		REQUIRE((wrong == 0));
+
+		std::size_t false_hits = 0;
+		for (std::uint64_t idx_for = count; idx_for < 2 * count; ++idx_for)
+		{
+			false_hits += table.contains(scrambled(idx_for)) ? 1U : 0U;
+		}
+		REQUIRE((false_hits == 0));
+		REQUIRE_THROWS_AS(table.get(scrambled(count)), std::out_of_range);
+	}
+
+	SECTION("Fingerprint-only files keep every key and reject most absent ones")
+	{
+		const scratch_file file("no_keys");
+		builder_t builder;
+		for (std::uint64_t idx_for = 0; idx_for < count; ++idx_for)
+		{
+			builder.add(scrambled(idx_for), idx_for + 1);
+		}
+		cache_engine::immutable::mph_build_options options;
+		options.m_store_keys = false;
+		builder.write(file.path(), options);
+
+		const table_t table(file.path(), cache_engine::immutable::mph_open_mode::prefault);
+		REQUIRE_FALSE(table.has_keys());
+
+		std::size_t wrong = 0;
+		for (std::uint64_t idx_for = 0; idx_for < count; ++idx_for)
+		{
+			wrong += (table.get(scrambled(idx_for)) == idx_for + 1) ? 0U : 1U;
+		}
+		REQUIRE((wrong == 0));
+
+		std::size_t false_hits = 0;
+		for (std::uint64_t idx_for = count; idx_for < 2 * count; ++idx_for)
+		{
+			false_hits += table.contains(scrambled(idx_for)) ? 1U : 0U;
+		}
+		REQUIRE((false_hits < count / 1000));
+	}
+
+	SECTION("Struct keys and an empty table")
+	{
+		const scratch_file points_file("points");
+		cache_engine::immutable::mph_builder<point_key, double> points;
+		for (std::uint32_t idx_for = 0; idx_for < 1000; ++idx_for)
+		{
+			points.add(point_key{idx_for, idx_for * 3U}, static_cast<double>(idx_for) / 2.0);
+		}
+		points.write(points_file.path());
+
+		const cache_engine::immutable::mph_table<point_key, double> point_table(points_file.path());
+		REQUIRE((point_table.get(point_key{10, 30}) > 4.9));
+		REQUIRE_FALSE(point_table.contains(point_key{10, 31}));
+
+		const scratch_file empty_file("empty");
+		builder_t().write(empty_file.path());
+		const table_t empty_table(empty_file.path());
+		REQUIRE(empty_table.empty());
+		REQUIRE_FALSE(empty_table.contains(1));
+	}
+
+	SECTION("Duplicate keys, bad gamma and mismatched types are rejected")
+	{
+		const scratch_file file("errors");
+		builder_t duplicates;
+		duplicates.add(1, 1);
+		duplicates.add(2, 2);
+		duplicates.add(1, 3);
+		REQUIRE_THROWS_AS(duplicates.write(file.path()), std::invalid_argument);
+
+		builder_t builder;
+		builder.add(1, 1);
+		cache_engine::immutable::mph_build_options options;
+		options.m_gamma = 0.5;
+		REQUIRE_THROWS_AS(builder.write(file.path(), options), std::invalid_argument);
+
+		builder.write(file.path());
+		using narrow_table_t = cache_engine::immutable::mph_table<std::uint32_t, std::uint64_t>;
+		REQUIRE_THROWS_AS(narrow_table_t(file.path()), std::runtime_error);
+		REQUIRE_THROWS_AS(table_t("mph_table_test_missing.mph"), std::runtime_error);
+	}
+
+	SECTION("Tiered cache serves the lower tier and lets the upper cache shadow it")
+	{
+		const scratch_file file("tiered");
+		builder_t builder;
+		for (std::uint64_t idx_for = 0; idx_for < 1000; ++idx_for)
+		{
+			builder.add(idx_for, idx_for * 10);
+		}
+		builder.write(file.path());
+
+		using upper_t  = cache_engine::cache<std::uint64_t, std::uint64_t, cache_engine::algorithm::lru>;
+		using tiered_t = cache_engine::immutable::tiered_cache<upper_t, table_t>;
+		std::shared_ptr<const table_t> lower(new table_t(file.path()));
+		std::unique_ptr<tiered_t> tiered(new tiered_t(upper_t(2), lower));
+
+		REQUIRE((tiered->get(5) == 50));
+		REQUIRE((tiered->lower_hits() == 1));
+		REQUIRE(tiered->upper().contains(5));
+		REQUIRE((tiered->get(5) == 50));
+		REQUIRE((tiered->upper_hits() == 1));
+
+		tiered->put(7, 1);
+		REQUIRE((tiered->get(7) == 1));
+
+		// Evicting the shadowing entry makes the lower value visible again
+		tiered->get(8);
+		tiered->get(9);
+		REQUIRE((tiered->get(7) == 70));
+
+		std::uint64_t value = 0;
+		REQUIRE_FALSE(tiered->find(5000, value));
+		REQUIRE((tiered->misses() == 1));
+		REQUIRE_THROWS_AS(tiered->get(5000), std::out_of_range);
+	}
+}
@@ -0,0 +1,188 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/policies/all_policies.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+	template <template <typename, typename> class storage_t>
+	using scan_cache_t = cache_engine::policy_based_cache<std::int32_t, std::int32_t, cache_engine::policy_templates::lru_eviction, storage_t,
+														  cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+
+	template <template <typename, typename> class storage_t> auto make_filled_cache(std::int32_t p_count) -> std::unique_ptr<scan_cache_t<storage_t>>
+	{
+		std::unique_ptr<scan_cache_t<storage_t>> cache(new scan_cache_t<storage_t>(static_cast<std::size_t>(p_count)));
+		for (std::int32_t idx_for = 0; idx_for < p_count; ++idx_for)
+		{
+			cache->put(idx_for, idx_for * 2);
+		}
+		return cache;
+	}
+} // namespace
+
+TEST_CASE("Parallel for_each and erase_if", "[policy][scan][unit]")
+{
+	const std::int32_t count = 10000;
+
+	SECTION("for_each visits every entry once on one and several threads")
+	{
+		std::unique_ptr<scan_cache_t<cache_engine::policy_templates::hash_storage>> cache = make_filled_cache<cache_engine::policy_templates::hash_storage>(count);
+
+		for (std::size_t threads = 1; threads <= 4; ++threads)
+		{
+			cache_engine::scan_options options;
+			options.m_threads = threads;
+
+			std::atomic<std::int64_t> key_sum(0);
+			std::atomic<std::size_t> visited(0);
+			std::atomic<bool> values_match(true);
+			cache->for_each(
+				[&](const std::int32_t& p_key, const std::int32_t& p_value)
+				{
+					key_sum.fetch_add(p_key);
+					visited.fetch_add(1);
+					if (p_value != p_key * 2)
+					{
+						values_match.store(false);
+					}
+				},
+				options);
+
+			REQUIRE((visited.load() == static_cast<std::size_t>(count)));
+			REQUIRE((key_sum.load() == static_cast<std::int64_t>(count) * (count - 1) / 2));
+			REQUIRE(values_match.load());
+		}
+	}
+
+	SECTION("erase_if removes matches and keeps the eviction policy consistent")
+	{
+		std::unique_ptr<scan_cache_t<cache_engine::policy_templates::compact_storage>> cache = make_filled_cache<cache_engine::policy_templates::compact_storage>(count);
+
+		cache_engine::scan_options options;
+		options.m_threads = 3;
+
+		const std::size_t erased = cache->erase_if([](const std::int32_t& p_key, const std::int32_t&) { return (p_key % 2) == 0; }, options);
+
+		REQUIRE((erased == static_cast<std::size_t>(count / 2)));
+		REQUIRE((cache->size() == static_cast<std::size_t>(count / 2)));
+		REQUIRE_FALSE(cache->contains(0));
+		REQUIRE(cache->contains(1));
+
+		// Refilling evicts only surviving keys, so the eviction policy no longer tracks the erased ones
+		for (std::int32_t idx_for = count; idx_for < count + count / 2 + 10; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+		}
+		REQUIRE((cache->size() == static_cast<std::size_t>(count)));
+		REQUIRE_FALSE(cache->contains(1));
+		REQUIRE(cache->contains(count));
+	}
+
+	SECTION("erase_if calls the between-chunks hook and rechecks the predicate")
+	{
+		std::unique_ptr<scan_cache_t<cache_engine::policy_templates::reserved_hash_storage>> cache =
+			make_filled_cache<cache_engine::policy_templates::reserved_hash_storage>(count);
+
+		std::size_t hook_calls = 0;
+		bool changed_pending   = false;
+		cache_engine::scan_options options;
+		options.m_threads		 = 2;
+		options.m_erase_chunk	 = 1000;
+		options.m_between_chunks = [&]()
+		{
+			// Another user changes a still pending match so it no longer qualifies
+			if (hook_calls++ == 0 && cache->contains(count - 1))
+			{
+				cache->put(count - 1, 1);
+				changed_pending = true;
+			}
+		};
+
+		const std::size_t erased = cache->erase_if([](const std::int32_t&, const std::int32_t& p_value) { return p_value >= 2000; }, options);
+
+		REQUIRE((hook_calls == (erased + 999) / 1000));
+		REQUIRE((cache->contains(count - 1) == changed_pending));
+		REQUIRE((erased == static_cast<std::size_t>(count - 1000) - (changed_pending ? 1U : 0U)));
+		REQUIRE((cache->size() == static_cast<std::size_t>(count) - erased));
+	}
+
+	SECTION("A throwing predicate removes nothing and propagates")
+	{
+		std::unique_ptr<scan_cache_t<cache_engine::policy_templates::debug_storage>> cache = make_filled_cache<cache_engine::policy_templates::debug_storage>(count);
+
+		cache_engine::scan_options options;
+		options.m_threads = 4;
+
+		REQUIRE_THROWS_AS(cache->erase_if(
+							  [](const std::int32_t& p_key, const std::int32_t&) -> bool
+							  {
+								  if (p_key == 1234)
+								  {
+									  throw std::runtime_error("predicate failed");
+								  }
+								  return true;
+							  },
+							  options),
+						  std::runtime_error);
+		REQUIRE((cache->size() == static_cast<std::size_t>(count)));
+	}
+}
+
+namespace
+{
+	// Storage written against the interface before visit_partition existed
+	template <typename key_t, typename value_t> class map_only_storage : public cache_engine::policies::storage_policy_base<key_t, value_t>
+	{
+	  private:
+		std::unordered_map<key_t, value_t> m_storage;
+
+	  public:
+		auto insert(const key_t& p_key, const value_t& p_value) -> bool override
+		{
+			const auto inserted = m_storage.emplace(p_key, p_value);
+			if (!inserted.second)
+			{
+				inserted.first->second = p_value;
+			}
+			return inserted.second;
+		}
+
+		auto find(const key_t& p_key) -> value_t* override
+		{
+			auto iter = m_storage.find(p_key);
+			return (iter != m_storage.end()) ? &iter->second : nullptr;
+		}
+
+		auto find(const key_t& p_key) const -> const value_t* override
+		{
+			auto iter = m_storage.find(p_key);
+			return (iter != m_storage.end()) ? &iter->second : nullptr;
+		}
+
+		auto erase(const key_t& p_key) -> bool override { return m_storage.erase(p_key) > 0; }
+
+		auto contains(const key_t& p_key) const -> bool override { return m_storage.find(p_key) != m_storage.end(); }
+
+		auto size() const -> std::size_t override { return m_storage.size(); }
+
+		auto empty() const -> bool override { return m_storage.empty(); }
+
+		auto clear() -> void override { m_storage.clear(); }
+	};
+} // namespace
+
+TEST_CASE("Scans over a storage policy without visit_partition", "[policy][scan][unit]")
+{
+	std::unique_ptr<scan_cache_t<map_only_storage>> cache(new scan_cache_t<map_only_storage>(4));
+	cache->set_heap_size_function([](const std::int32_t&, const std::int32_t&) -> std::size_t { return 0; });
+	cache->put(1, 2);
+	REQUIRE((cache->get(1) == 2));
+
+	REQUIRE_THROWS_AS(cache->for_each([](const std::int32_t&, const std::int32_t&) {}), std::logic_error);
+	REQUIRE_THROWS_AS(cache->erase_if([](const std::int32_t&, const std::int32_t&) { return true; }), std::logic_error);
+	REQUIRE((cache->size() == 1));
+}
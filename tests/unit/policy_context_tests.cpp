@@ -0,0 +1,91 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/cache.hpp>
+#include <cache_engine/policies/all_policies.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+TEST_CASE("Policy construction context", "[policy][context][unit]")
+{
+	SECTION("Context defaults key and value sizes from the types")
+	{
+		const auto context = cache_engine::policies::containers::make_policy_context<std::int32_t, std::int64_t>(1000);
+
+		REQUIRE((context.capacity() == 1000U));
+		REQUIRE((context.key_bytes() == sizeof(std::int32_t)));
+		REQUIRE((context.value_bytes() == sizeof(std::int64_t)));
+		REQUIRE((context.expected_payload_bytes() == 1000U * (sizeof(std::int32_t) + sizeof(std::int64_t))));
+	}
+
+	SECTION("Reserved hash storage reserves the real capacity")
+	{
+		const cache_engine::policies::containers::policy_context context(5000);
+		std::unique_ptr<cache_engine::policies::reserved_hash_storage_policy<std::int32_t, std::int32_t>> storage =
+			cache_engine::policies::containers::make_policy<cache_engine::policies::reserved_hash_storage_policy<std::int32_t, std::int32_t>>(context);
+
+		REQUIRE((storage->reserved_capacity() == 5000U));
+	}
+
+	SECTION("Policies without a context constructor are default constructed")
+	{
+		const cache_engine::policies::containers::policy_context context(16);
+		std::unique_ptr<cache_engine::policies::update_on_access_policy<std::int32_t, std::int32_t>> access =
+			cache_engine::policies::containers::make_policy<cache_engine::policies::update_on_access_policy<std::int32_t, std::int32_t>>(context);
+
+		REQUIRE((access != nullptr));
+	}
+
+	SECTION("Cache built from a context with larger expected values")
+	{
+		cache_engine::policy_based_cache<std::int32_t, std::string, cache_engine::policy_templates::random_eviction, cache_engine::policy_templates::reserved_hash_storage,
+										 cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>
+			string_cache(cache_engine::policies::containers::policy_context(64, sizeof(std::int32_t), 128));
+
+		for (std::int32_t idx_for = 0; idx_for < 200; ++idx_for)
+		{
+			string_cache.put(idx_for, std::string(100, 'x'));
+		}
+
+		REQUIRE((string_cache.size() == 64U));
+		REQUIRE((string_cache.capacity() == 64U));
+	}
+
+	SECTION("Filling a cache to capacity keeps its bucket count")
+	{
+		using lru_cache_t = cache_engine::policy_based_cache<std::int32_t, std::int32_t, cache_engine::policy_templates::lru_eviction, cache_engine::policy_templates::hash_storage,
+															 cache_engine::policy_templates::update_on_access, cache_engine::policy_templates::fixed_capacity>;
+		std::unique_ptr<lru_cache_t> cache(new lru_cache_t(10000));
+		const std::size_t buckets = cache->storage_policy().bucket_count();
+		REQUIRE((buckets >= 10000U));
+
+		std::size_t rehashes = 0;
+		for (std::int32_t idx_for = 0; idx_for < 10000; ++idx_for)
+		{
+			cache->put(idx_for, idx_for);
+			rehashes += (cache->storage_policy().bucket_count() != buckets) ? 1U : 0U;
+		}
+		REQUIRE((cache->size() == 10000U));
+		REQUIRE((rehashes == 0U));
+	}
+
+	SECTION("A memory capacity cache is sized for its entry count, not its byte limit")
+	{
+		using memory_cache_t = decltype(cache_engine::make_memory_efficient_cache<std::int32_t, std::string>(0));
+		const std::size_t limit = std::size_t(1) << 20;
+		std::unique_ptr<memory_cache_t> cache(new memory_cache_t(limit));
+		const std::size_t entries = cache->capacity();
+		REQUIRE((entries == limit / (sizeof(std::int32_t) + sizeof(std::string))));
+
+		const std::size_t buckets = cache->storage_policy().bucket_count();
+		REQUIRE((buckets >= entries));
+		REQUIRE((buckets < 2 * entries));
+		REQUIRE((cache->memory_usage().total() < limit));
+
+		for (std::int32_t idx_for = 0; idx_for < static_cast<std::int32_t>(entries); ++idx_for)
+		{
+			cache->put(idx_for, "x");
+		}
+		REQUIRE((cache->size() == entries));
+		REQUIRE((cache->storage_policy().bucket_count() == buckets));
+	}
+}
@@ -0,0 +1,180 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/stats/rolling_stats.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Clock the tests move by hand
+	 */
+	struct manual_clock
+	{
+		using rep						= std::int64_t;
+		using period					= std::nano;
+		using duration					= std::chrono::nanoseconds;
+		using time_point				= std::chrono::time_point<manual_clock>;
+		static constexpr bool is_steady = true;
+
+		static std::atomic<std::int64_t> s_now;
+
+		static auto now() -> time_point { return time_point(duration(s_now.load())); }
+
+		static auto advance(std::chrono::seconds p_by) -> void { s_now.fetch_add(std::chrono::duration_cast<duration>(p_by).count()); }
+	};
+
+	std::atomic<std::int64_t> manual_clock::s_now(0);
+
+	using stats_t = cache_engine::stats::rolling_stats<manual_clock>;
+} // namespace
+
+TEST_CASE("Rolling window stats", "[rolling_stats]")
+{
+	SECTION("Windows cover complete seconds only")
+	{
+		std::unique_ptr<stats_t> stats(new stats_t());
+		stats_t::recorder recorder = stats->make_recorder();
+		for (std::size_t idx_for = 0; idx_for < 30; ++idx_for)
+		{
+			recorder.record_hit();
+		}
+		for (std::size_t idx_for = 0; idx_for < 10; ++idx_for)
+		{
+			recorder.record_miss();
+		}
+		recorder.record_eviction(4);
+		REQUIRE(stats->window(std::chrono::seconds(60)).m_hits == 0);
+
+		manual_clock::advance(std::chrono::seconds(1));
+		const cache_engine::stats::window_stats last = stats->window(std::chrono::seconds(60));
+		REQUIRE(last.m_span == std::chrono::seconds(1));
+		REQUIRE(last.m_hits == 30);
+		REQUIRE(last.m_misses == 10);
+		REQUIRE(last.m_evictions == 4);
+		REQUIRE(last.m_hit_ratio == Approx(0.75));
+		REQUIRE(last.m_ops_per_second == Approx(40.0));
+		REQUIRE(last.m_evictions_per_second == Approx(4.0));
+	}
+
+	SECTION("A recent collapse shows in the short windows first")
+	{
+		std::unique_ptr<stats_t> stats(new stats_t());
+		stats_t::recorder recorder = stats->make_recorder();
+
+		// Nine minutes of hits, then one minute of misses, ten lookups a second
+		for (std::size_t idx_second = 0; idx_second < 600; ++idx_second)
+		{
+			for (std::size_t idx_for = 0; idx_for < 10; ++idx_for)
+			{
+				if (idx_second < 540)
+				{
+					recorder.record_hit();
+				}
+				else
+				{
+					recorder.record_miss();
+				}
+			}
+			manual_clock::advance(std::chrono::seconds(1));
+		}
+
+		const cache_engine::stats::rolling_snapshot snapshot = stats->snapshot();
+		REQUIRE(snapshot.m_last_1m.m_hit_ratio == Approx(0.0));
+		REQUIRE(snapshot.m_last_5m.m_hit_ratio == Approx(0.8));
+		REQUIRE(snapshot.m_last_15m.m_span == std::chrono::seconds(600));
+		REQUIRE(snapshot.m_last_15m.m_hit_ratio == Approx(0.9));
+		REQUIRE(snapshot.m_last_15m.m_ops_per_second == Approx(10.0));
+
+		// Twenty more minutes of hits wrap the ring; the old misses age out
+		for (std::size_t idx_second = 0; idx_second < 1200; ++idx_second)
+		{
+			recorder.record_hit();
+			manual_clock::advance(std::chrono::seconds(1));
+		}
+		const cache_engine::stats::window_stats last_15m = stats->window(std::chrono::seconds(15 * 60));
+		REQUIRE(last_15m.m_span == std::chrono::seconds(900));
+		REQUIRE(last_15m.m_hits == 900);
+		REQUIRE(last_15m.m_misses == 0);
+	}
+
+	SECTION("Load latency percentiles come from half-octave bins")
+	{
+		REQUIRE(stats_t::latency_bin(std::chrono::microseconds(0)) == 0);
+		REQUIRE(stats_t::latency_bin(std::chrono::microseconds(1)) == 1);
+		REQUIRE(stats_t::latency_bin(std::chrono::microseconds(2)) == 3);
+		REQUIRE(stats_t::latency_bin(std::chrono::microseconds(3)) == 4);
+		REQUIRE(stats_t::latency_bin(std::chrono::hours(1)) == stats_t::latency_bins - 1);
+
+		std::unique_ptr<stats_t> stats(new stats_t());
+		stats_t::recorder recorder = stats->make_recorder();
+		for (std::size_t idx_for = 0; idx_for < 100; ++idx_for)
+		{
+			recorder.record_load(std::chrono::microseconds(100));
+		}
+		for (std::size_t idx_for = 0; idx_for < 5; ++idx_for)
+		{
+			recorder.record_load(std::chrono::milliseconds(50));
+		}
+		manual_clock::advance(std::chrono::seconds(1));
+
+		const cache_engine::stats::window_stats last = stats->window(std::chrono::seconds(60));
+		REQUIRE(last.m_loads == 105);
+		REQUIRE(last.m_load_p50 >= std::chrono::microseconds(100));
+		REQUIRE(last.m_load_p50 <= std::chrono::microseconds(142));
+		REQUIRE(last.m_load_p95 == last.m_load_p50);
+		REQUIRE(last.m_load_p99 >= std::chrono::milliseconds(50));
+		REQUIRE(last.m_load_p99 <= std::chrono::microseconds(70711));
+	}
+
+	SECTION("Each thread records into its own slot")
+	{
+		std::unique_ptr<stats_t> stats(new stats_t(4));
+		std::vector<std::thread> writers;
+		for (std::size_t idx_thread = 0; idx_thread < 4; ++idx_thread)
+		{
+			writers.emplace_back(
+				[&stats]()
+				{
+					stats_t::recorder recorder = stats->make_recorder();
+					for (std::size_t idx_for = 0; idx_for < 1000; ++idx_for)
+					{
+						recorder.record_hit();
+					}
+				});
+		}
+		for (std::thread& writer : writers)
+		{
+			writer.join();
+		}
+		manual_clock::advance(std::chrono::seconds(1));
+		REQUIRE(stats->window(std::chrono::seconds(60)).m_hits == 4000);
+
+		// A released slot can be claimed again, and keeps its history
+		std::vector<stats_t::recorder> held;
+		for (std::size_t idx_for = 0; idx_for < 4; ++idx_for)
+		{
+			held.push_back(stats->make_recorder());
+		}
+		REQUIRE_THROWS_AS(stats->make_recorder(), std::runtime_error);
+		held.pop_back();
+		stats_t::recorder again = stats->make_recorder();
+		again.record_miss();
+		manual_clock::advance(std::chrono::seconds(1));
+		const cache_engine::stats::window_stats last = stats->window(std::chrono::seconds(60));
+		REQUIRE(last.m_hits == 4000);
+		REQUIRE(last.m_misses == 1);
+	}
+
+	SECTION("Invalid arguments are rejected")
+	{
+		REQUIRE_THROWS_AS(stats_t(0), std::invalid_argument);
+		std::unique_ptr<stats_t> stats(new stats_t(1));
+		REQUIRE_THROWS_AS(stats->window(std::chrono::seconds(0)), std::invalid_argument);
+		REQUIRE_THROWS_AS(stats->window(std::chrono::seconds(16 * 60)), std::invalid_argument);
+	}
+}
@@ -0,0 +1,281 @@
+#include <catch2/catch.hpp>
+#include <cache_engine/memory/slab_lru_cache.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+	using cache_t = cache_engine::memory::slab_lru_cache<std::uint64_t, std::uint64_t>;
+
+	/**
+	 * @brief Reference LRU the slab cache is checked against
+	 */
+	class model_lru
+	{
+	  private:
+		std::size_t m_capacity;
+		std::list<std::pair<std::uint64_t, std::uint64_t>> m_order;
+		std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, std::uint64_t>>::iterator> m_index;
+
+	  public:
+		explicit model_lru(std::size_t p_capacity) : m_capacity(p_capacity) {}
+
+		auto find(std::uint64_t p_key, std::uint64_t& p_value) -> bool
+		{
+			auto iter = m_index.find(p_key);
+			if (iter == m_index.end())
+			{
+				return false;
+			}
+			m_order.splice(m_order.begin(), m_order, iter->second);
+			p_value = iter->second->second;
+			return true;
+		}
+
+		auto put(std::uint64_t p_key, std::uint64_t p_value) -> void
+		{
+			std::uint64_t ignored = 0;
+			if (this->find(p_key, ignored))
+			{
+				m_order.front().second = p_value;
+				return;
+			}
+			this->shrink_to(m_capacity - 1);
+			m_order.emplace_front(p_key, p_value);
+			m_index[p_key] = m_order.begin();
+		}
+
+		auto erase(std::uint64_t p_key) -> bool
+		{
+			auto iter = m_index.find(p_key);
+			if (iter == m_index.end())
+			{
+				return false;
+			}
+			m_order.erase(iter->second);
+			m_index.erase(iter);
+			return true;
+		}
+
+		auto set_capacity(std::size_t p_capacity) -> void
+		{
+			m_capacity = p_capacity;
+			this->shrink_to(p_capacity);
+		}
+
+		auto size() const -> std::size_t { return m_order.size(); }
+
+	  private:
+		auto shrink_to(std::size_t p_size) -> void
+		{
+			while (m_order.size() > p_size)
+			{
+				m_index.erase(m_order.back().first);
+				m_order.pop_back();
+			}
+		}
+	};
+
+	bool g_fragile_copies_fail = false;
+
+	/**
+	 * @brief Key whose copy and move throw while g_fragile_copies_fail is set
+	 */
+	struct fragile_key
+	{
+		std::uint64_t m_id;
+
+		explicit fragile_key(std::uint64_t p_id) : m_id(p_id) {}
+
+		fragile_key(const fragile_key& p_other) : m_id(p_other.m_id)
+		{
+			if (g_fragile_copies_fail)
+			{
+				throw std::bad_alloc();
+			}
+		}
+
+		fragile_key(fragile_key&& p_other) : m_id(p_other.m_id)
+		{
+			if (g_fragile_copies_fail)
+			{
+				throw std::bad_alloc();
+			}
+		}
+
+		auto operator==(const fragile_key& p_other) const -> bool { return m_id == p_other.m_id; }
+	};
+
+	struct fragile_key_hash
+	{
+		auto operator()(const fragile_key& p_key) const -> std::size_t { return std::hash<std::uint64_t>()(p_key.m_id); }
+	};
+} // namespace
+
+TEST_CASE("Slab LRU cache", "[memory][slab][unit]")
+{
+	SECTION("Evicts the least recently used entry")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(3));
+		cache->put(1, 10);
+		cache->put(2, 20);
+		cache->put(3, 30);
+		REQUIRE(cache->get(1) == 10);
+		cache->put(4, 40);
+
+		REQUIRE(cache->size() == 3);
+		REQUIRE_FALSE(cache->contains(2));
+		REQUIRE(cache->contains(1));
+		REQUIRE(cache->erase(3));
+		REQUIRE_THROWS_AS(cache->get(3), std::out_of_range);
+		REQUIRE_THROWS_AS(cache->set_capacity(4), std::invalid_argument);
+	}
+
+	SECTION("Compaction after a shrink releases blocks and keeps entries and recency")
+	{
+		const std::size_t peak = 50000;
+		std::unique_ptr<cache_t> cache(new cache_t(peak));
+		for (std::uint64_t idx_for = 0; idx_for < peak; ++idx_for)
+		{
+			cache->put(idx_for, idx_for * 3U);
+		}
+		// Survivors of the shrink are every tenth key, spread over the whole slab
+		for (std::uint64_t idx_for = 0; idx_for < peak; idx_for += 10)
+		{
+			REQUIRE(cache->get(idx_for) == idx_for * 3U);
+		}
+		const std::size_t peak_blocks = cache->stats().m_resident_blocks;
+		cache->set_capacity(peak / 10);
+		REQUIRE(cache->stats().m_resident_blocks == peak_blocks);
+
+		const cache_engine::memory::compaction_progress first = cache->compact_step(100);
+		REQUIRE(first.m_moved + first.m_released_blocks <= 100);
+		REQUIRE_FALSE(first.m_done);
+		cache->compact();
+
+		const cache_engine::memory::slab_stats stats = cache->stats();
+		REQUIRE(stats.m_resident_blocks == stats.m_needed_blocks);
+		REQUIRE(stats.m_released_blocks == peak_blocks - stats.m_needed_blocks);
+		REQUIRE(stats.m_relocated_slots > 0);
+		REQUIRE(cache->compact_step().m_done);
+
+		// Key 0 was touched first, so it is still the LRU entry after relocation
+		cache->set_capacity(peak);
+		for (std::uint64_t idx_for = 0; idx_for < peak; idx_for += 10)
+		{
+			REQUIRE(cache->contains(idx_for));
+		}
+		cache->set_capacity(peak / 10 - 1);
+		REQUIRE_FALSE(cache->contains(0));
+		REQUIRE(cache->get(10) == 30);
+	}
+
+	SECTION("Random operations with compaction steps match a reference LRU")
+	{
+		std::unique_ptr<cache_t> cache(new cache_t(4096));
+		std::unique_ptr<model_lru> model(new model_lru(4096));
+		std::uint64_t rng = 0x2545F4914F6CDD1DULL;
+		for (std::size_t idx_for = 0; idx_for < 200000; ++idx_for)
+		{
+			rng ^= rng << 13U;
+			rng ^= rng >> 7U;
+			rng ^= rng << 17U;
+			const std::uint64_t key = (rng >> 8U) % 8192U;
+			std::uint64_t expected	= 0;
+			std::uint64_t actual	= 0;
+
+			switch (rng % 16U)
+			{
+			case 0:
+				REQUIRE(cache->erase(key) == model->erase(key));
+				break;
+			case 1:
+				cache->compact_step(8);
+				break;
+			case 2:
+				if (idx_for % 64U == 2)
+				{
+					const std::size_t capacity = 256U + static_cast<std::size_t>(rng >> 40U) % 3840U;
+					cache->set_capacity(capacity);
+					model->set_capacity(capacity);
+				}
+				break;
+			default:
+				if (rng % 2U == 0)
+				{
+					REQUIRE(cache->find(key, actual) == model->find(key, expected));
+					REQUIRE(actual == expected);
+				}
+				else
+				{
+					cache->put(key, rng);
+					model->put(key, rng);
+				}
+				break;
+			}
+			REQUIRE(cache->size() == model->size());
+		}
+	}
+
+	SECTION("Values that own memory survive relocation")
+	{
+		using string_cache_t = cache_engine::memory::slab_lru_cache<std::string, std::string>;
+		std::unique_ptr<string_cache_t> cache(new string_cache_t(2000));
+		for (std::size_t idx_for = 0; idx_for < 2000; ++idx_for)
+		{
+			cache->put("key-" + std::to_string(idx_for), std::string(40, static_cast<char>('a' + idx_for % 26)));
+		}
+		cache->set_capacity(100);
+		cache->compact();
+
+		REQUIRE(cache->size() == 100);
+		REQUIRE(cache->get("key-1999") == std::string(40, static_cast<char>('a' + 1999 % 26)));
+		REQUIRE(cache->get("key-1900") == std::string(40, static_cast<char>('a' + 1900 % 26)));
+		REQUIRE_FALSE(cache->contains("key-1899"));
+	}
+
+	SECTION("A key copy or move that throws leaves no slot marked live")
+	{
+		using fragile_cache_t = cache_engine::memory::slab_lru_cache<fragile_key, std::uint64_t, fragile_key_hash>;
+		std::unique_ptr<fragile_cache_t> cache(new fragile_cache_t(4096));
+		const std::uint64_t per_block = cache->stats().m_slots_per_block;
+
+		g_fragile_copies_fail = true;
+		REQUIRE_THROWS_AS(cache->put(fragile_key(7), 70), std::bad_alloc);
+		g_fragile_copies_fail = false;
+		REQUIRE(cache->empty());
+		REQUIRE_FALSE(cache->contains(fragile_key(7)));
+
+		// Fill two blocks and empty half of the first, so compaction has entries to move down
+		for (std::uint64_t idx_for = 0; idx_for < 2 * per_block; ++idx_for)
+		{
+			cache->put(fragile_key(idx_for), idx_for * 10U);
+		}
+		for (std::uint64_t idx_for = 0; idx_for < per_block / 2; ++idx_for)
+		{
+			cache->erase(fragile_key(idx_for));
+		}
+
+		g_fragile_copies_fail = true;
+		REQUIRE_THROWS_AS(cache->compact_step(), std::bad_alloc);
+		g_fragile_copies_fail = false;
+		for (std::uint64_t idx_for = per_block / 2; idx_for < 2 * per_block; ++idx_for)
+		{
+			REQUIRE(cache->get(fragile_key(idx_for)) == idx_for * 10U);
+		}
+
+		cache->compact();
+		REQUIRE(cache->stats().m_resident_blocks == cache->stats().m_needed_blocks);
+		REQUIRE(cache->get(fragile_key(2 * per_block - 1)) == (2 * per_block - 1) * 10U);
+
+		// Emptied, the cache gives every block back: no slot is left marked live
+		cache->clear();
+		cache->compact();
+		REQUIRE(cache->stats().m_resident_blocks == 0);
+	}
+}
@@ -0,0 +1,250 @@
+/**
+ * @file mph_build.cpp
+ * @brief Offline builder for mph_table files with 64-bit integer keys and values
+ *
+ * Reads "key value" pairs, one per line (or raw native-endian uint64 pairs
+ * with --binary), builds the minimal perfect hash table and writes it where
+ * mph_table<std::uint64_t, std::uint64_t> can map it. --verify maps the
+ * result and looks every input key up again.
+ *
+ *   cache_mph_build --input=pairs.txt --output=table.mph [--gamma=2.0] [--no-keys] [--seed=N] [--binary] [--verify]
+ */
+
+#include <cache_engine/immutable/mph_table.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace mph_tool
+{
+	using key_t		= std::uint64_t;
+	using value_t	= std::uint64_t;
+	using builder_t = cache_engine::immutable::mph_builder<key_t, value_t>;
+	using table_t	= cache_engine::immutable::mph_table<key_t, value_t>;
+
+	auto print_usage() -> void;
+	auto option_value(const char* p_argument, const char* p_name) -> const char*;
+	auto read_text(const std::string& p_path, builder_t& p_builder) -> void;
+	auto read_binary(const std::string& p_path, builder_t& p_builder) -> void;
+	auto verify(const std::string& p_input, const std::string& p_output, bool p_binary) -> std::size_t;
+	auto seconds_since(std::chrono::steady_clock::time_point p_start) -> double;
+
+	auto print_usage() -> void
+	{
+		std::cout << "Usage: cache_mph_build --input=FILE --output=FILE [options]\n"
+				  << "  --gamma=G    level bits per remaining key, >= 1 (default 2.0)\n"
+				  << "  --no-keys    store fingerprints only; absent keys may match with p = 2^-16\n"
+				  << "  --seed=N     hash seed\n"
+				  << "  --binary     input is raw native-endian uint64 key/value pairs\n"
+				  << "  --verify     map the output and look every input key up\n";
+	}
+
+	/**
+	 * @brief Value of "--name=value", or nullptr if p_argument is another option
+	 */
+	auto option_value(const char* p_argument, const char* p_name) -> const char*
+	{
+		const std::size_t length = std::strlen(p_name);
+		if (std::strncmp(p_argument, p_name, length) == 0 && p_argument[length] == '=')
+		{
+			return p_argument + length + 1;
+		}
+		return nullptr;
+	}
+
+	auto read_text(const std::string& p_path, builder_t& p_builder) -> void
+	{
+		std::ifstream in(p_path.c_str());
+		if (!in)
+		{
+			throw std::runtime_error("cannot open " + p_path);
+		}
+		key_t key	  = 0;
+		value_t value = 0;
+		while (in >> key >> value)
+		{
+			p_builder.add(key, value);
+		}
+		if (!in.eof())
+		{
+			throw std::runtime_error("malformed line after entry " + std::to_string(p_builder.size()) + " in " + p_path);
+		}
+	}
+
+	auto read_binary(const std::string& p_path, builder_t& p_builder) -> void
+	{
+		std::ifstream in(p_path.c_str(), std::ios::binary);
+		if (!in)
+		{
+			throw std::runtime_error("cannot open " + p_path);
+		}
+		key_t pair[2];
+		while (in.read(reinterpret_cast<char*>(pair), sizeof(pair)))
+		{
+			p_builder.add(pair[0], pair[1]);
+		}
+		if (in.gcount() != 0)
+		{
+			throw std::runtime_error(p_path + " does not hold a whole number of 16-byte pairs");
+		}
+	}
+
+	/**
+	 * @brief Look every input pair up in the written table; returns the number of mismatches
+	 */
+	auto verify(const std::string& p_input, const std::string& p_output, bool p_binary) -> std::size_t
+	{
+		const table_t table(p_output, cache_engine::immutable::mph_open_mode::prefault);
+		std::size_t mismatches = 0;
+		std::size_t checked	   = 0;
+
+		auto check = [&](key_t p_key, value_t p_value)
+		{
+			value_t found = 0;
+			if (!table.find(p_key, found) || found != p_value)
+			{
+				++mismatches;
+			}
+			++checked;
+		};
+
+		if (p_binary)
+		{
+			std::ifstream in(p_input.c_str(), std::ios::binary);
+			key_t pair[2];
+			while (in.read(reinterpret_cast<char*>(pair), sizeof(pair)))
+			{
+				check(pair[0], pair[1]);
+			}
+		}
+		else
+		{
+			std::ifstream in(p_input.c_str());
+			key_t key	  = 0;
+			value_t value = 0;
+			while (in >> key >> value)
+			{
+				check(key, value);
+			}
+		}
+
+		// A size difference means the table holds entries the input does not
+		return (checked == table.size()) ? mismatches : mismatches + 1;
+	}
+
+	auto seconds_since(std::chrono::steady_clock::time_point p_start) -> double
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - p_start).count();
+	}
+} // namespace mph_tool
+
+auto main(int p_argc, char** p_argv) -> int
+{
+	std::string input;
+	std::string output;
+	cache_engine::immutable::mph_build_options options;
+	bool binary		 = false;
+	bool verify_file = false;
+
+	for (int idx_for = 1; idx_for < p_argc; ++idx_for)
+	{
+		const char* argument = p_argv[idx_for];
+		const char* value	 = nullptr;
+
+		if ((value = mph_tool::option_value(argument, "--input")) != nullptr)
+		{
+			input = value;
+		}
+		else if ((value = mph_tool::option_value(argument, "--output")) != nullptr)
+		{
+			output = value;
+		}
+		else if ((value = mph_tool::option_value(argument, "--gamma")) != nullptr)
+		{
+			options.m_gamma = std::strtod(value, nullptr);
+		}
+		else if ((value = mph_tool::option_value(argument, "--seed")) != nullptr)
+		{
+			options.m_seed = std::strtoull(value, nullptr, 0);
+		}
+		else if (std::strcmp(argument, "--no-keys") == 0)
+		{
+			options.m_store_keys = false;
+		}
+		else if (std::strcmp(argument, "--binary") == 0)
+		{
+			binary = true;
+		}
+		else if (std::strcmp(argument, "--verify") == 0)
+		{
+			verify_file = true;
+		}
+		else if (std::strcmp(argument, "--help") == 0)
+		{
+			mph_tool::print_usage();
+			return EXIT_SUCCESS;
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << argument << "\n";
+			mph_tool::print_usage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (input.empty() || output.empty())
+	{
+		mph_tool::print_usage();
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		const auto read_start = std::chrono::steady_clock::now();
+		mph_tool::builder_t builder;
+		if (binary)
+		{
+			mph_tool::read_binary(input, builder);
+		}
+		else
+		{
+			mph_tool::read_text(input, builder);
+		}
+		const double read_seconds = mph_tool::seconds_since(read_start);
+
+		const auto build_start							   = std::chrono::steady_clock::now();
+		const cache_engine::immutable::mph_build_info info = builder.write(output, options);
+		const double build_seconds						   = mph_tool::seconds_since(build_start);
+
+		std::cout << "entries:            " << info.m_entries << "\n"
+				  << "levels:             " << info.m_levels << "\n"
+				  << "fallback entries:   " << info.m_fallback_entries << "\n"
+				  << "index bits per key: " << info.m_index_bits_per_key << "\n"
+				  << "file bytes:         " << info.m_file_bytes << "\n"
+				  << "read seconds:       " << read_seconds << "\n"
+				  << "build seconds:      " << build_seconds << "\n";
+
+		if (verify_file)
+		{
+			const std::size_t mismatches = mph_tool::verify(input, output, binary);
+			std::cout << "verify mismatches:  " << mismatches << "\n";
+			if (mismatches != 0)
+			{
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& p_error)
+	{
+		std::cerr << "cache_mph_build: " << p_error.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}